@@ -32,5 +32,6 @@
 #define CDSLIB_ALGO_FLAT_COMBINING_H
 
 #include <cds/algo/flat_combining/kernel.h>
+#include <cds/algo/flat_combining/hierarchical_kernel.h>
 
 #endif // #ifndef CDSLIB_ALGO_FLAT_COMBINING_H
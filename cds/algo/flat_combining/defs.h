@@ -41,6 +41,7 @@ namespace cds { namespace algo { namespace flat_combining {
     {
         req_EmptyRecord,    ///< Publication record is empty
         req_Response,       ///< Operation is done
+        req_Delegated,      ///< Operation is delegated by the combiner to the owner of the record, see \p kernel::parallel_combine()
 
         req_Operation       ///< First operation id for derived classes
     };
@@ -62,6 +63,7 @@ namespace cds { namespace algo { namespace flat_combining {
         atomics::atomic<unsigned int>           nAge;       ///< Age of the record
         atomics::atomic<publication_record *>   pNext;      ///< Next record in active publication list
         atomics::atomic<publication_record *>   pNextAllocated; ///< Next record in allocated publication list
+        unsigned int                            nDelegatedOp; ///< Operation id of the delegated request
 
         /// Initializes publication record
         publication_record()
@@ -69,6 +71,7 @@ namespace cds { namespace algo { namespace flat_combining {
             , nAge( 0 )
             , pNext( nullptr )
             , pNextAllocated( nullptr )
+            , nDelegatedOp( req_EmptyRecord )
         {
             nState.store( inactive, atomics::memory_order_release );
         }
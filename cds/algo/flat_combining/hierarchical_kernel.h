@@ -0,0 +1,426 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
+#define CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
+
+#include <type_traits>
+#include <cds/algo/flat_combining/kernel.h>
+#include <cds/os/topology.h>
+
+namespace cds { namespace algo { namespace flat_combining {
+
+    //@cond
+    namespace details {
+
+        template <typename PublicationRecord>
+        struct node_publication_record: public PublicationRecord
+        {
+            unsigned int nNode; // node index of the record
+
+            node_publication_record()
+                : nNode( 0 )
+            {}
+        };
+
+        // Statistics of a node kernel: all events are forwarded to the statistics of hierarchical kernel
+        template <typename Stat, bool Empty = std::is_base_of< flat_combining::empty_stat, Stat >::value >
+        struct node_stat: public flat_combining::empty_stat
+        {
+            void bind( Stat* ) {}
+        };
+
+        template <typename Stat>
+        struct node_stat< Stat, false >
+        {
+            Stat * m_pStat;
+
+            node_stat()
+                : m_pStat( nullptr )
+            {}
+
+            void bind( Stat* pStat )
+            {
+                m_pStat = pStat;
+            }
+
+            void    onOperation()               { m_pStat->onOperation();               }
+            void    onCombining()               { m_pStat->onCombining();               }
+            void    onCompactPublicationList()  { m_pStat->onCompactPublicationList();  }
+            void    onDeactivatePubRecord()     { m_pStat->onDeactivatePubRecord();     }
+            void    onActivatePubRecord()       { m_pStat->onActivatePubRecord();       }
+            void    onDeletePubRecord()         { m_pStat->onDeletePubRecord();         }
+            void    onPassiveWait()             { m_pStat->onPassiveWait();             }
+            void    onPassiveWaitIteration()    { m_pStat->onPassiveWaitIteration();    }
+            void    onPassiveWaitWakeup()       { m_pStat->onPassiveWaitWakeup();       }
+            void    onInvokeExclusive()         { m_pStat->onInvokeExclusive();         }
+            void    onWakeupByNotifying()       { m_pStat->onWakeupByNotifying();       }
+            void    onPassiveToCombiner()       { m_pStat->onPassiveToCombiner();       }
+            void    onDelegated()               { m_pStat->onDelegated();               }
+
+            void    onCreatePubRecord()
+            {
+                // The first record is created by the node kernel ctor before binding
+                if ( m_pStat )
+                    m_pStat->onCreatePubRecord();
+            }
+        };
+
+        template <typename Traits>
+        struct node_traits: public Traits
+        {
+            typedef node_stat< typename Traits::stat > stat;
+        };
+
+    } // namespace details
+    //@endcond
+
+    /// Hierarchical (NUMA-aware) flat combining kernel
+    /**
+        The kernel is intended for multi-socket systems. The classic \p flat_combining::kernel has
+        one publication list and one global lock, so the combiner pulls the publication records of
+        all threads and the cache lines of the sequential structure across the sockets.
+
+        \p %hierarchical_kernel splits the publication list by NUMA nodes. Each node has its own
+        publication list and its own node lock, i.e. it is a \p flat_combining::kernel in itself.
+        A thread publishes its request in the list of the node it is currently running on.
+        The node-level combiner collects the requests of its node and acquires the global lock
+        once per the batch; the global lock is held until all combining passes of the node are done.
+        Thus, the requests of threads running on one socket are applied to the sequential structure
+        by one thread of that socket, and the global lock is transferred between sockets once per batch,
+        not once per operation.
+
+        The node of the current thread is determined by \p cds::OS::topology::current_node().
+        If the node count specified in the constructor differs from the number of NUMA nodes of the system,
+        the processors are split into \p nNodeCount equal groups by their numbers.
+
+        The kernel has the same interface as \p flat_combining::kernel and is selected
+        for flat combining containers by \p opt::kernel_selector< \p kernel_selector::hierarchical > option:
+        \code
+        #include <cds/container/fcqueue.h>
+
+        typedef cds::container::FCQueue< int, std::queue<int>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        > numa_queue;
+        \endcode
+
+        Template parameters are the same as for \p flat_combining::kernel.
+        The traits options are also the same; \p Traits::lock_type is used both for the node locks and for the global lock.
+
+        In batch mode (\p batch_combine()) the container's \p fc_process() obtains the iterators
+        of the node's publication list only, so the elimination is performed inside a node.
+    */
+    template <
+        typename PublicationRecord
+        ,typename Traits = traits
+    >
+    class hierarchical_kernel
+    {
+    public:
+        typedef Traits   traits;                               ///< Type traits
+        typedef typename traits::lock_type global_lock_type;   ///< Global lock type
+        typedef typename traits::wait_strategy wait_strategy;  ///< Wait strategy type
+        typedef typename traits::allocator allocator;          ///< Allocator type
+        typedef typename traits::stat      stat;               ///< Internal statistics
+        typedef typename traits::memory_model memory_model;    ///< C++ memory model
+
+        /// Node-level kernel
+        typedef flat_combining::kernel< details::node_publication_record< PublicationRecord >, details::node_traits< traits >> node_kernel;
+
+        typedef typename node_kernel::publication_record_type publication_record_type; ///< Publication record type
+        typedef typename node_kernel::iterator iterator; ///< Publication list iterator of a node, see \p flat_combining::kernel::iterator
+
+    protected:
+        //@cond
+        struct node: public node_kernel
+        {
+            node( unsigned int nCompactFactor, unsigned int nCombinePassCount )
+                : node_kernel( nCompactFactor, nCombinePassCount )
+            {}
+
+            char pad_[cds::c_nCacheLineSize];   // separates the nodes allocated contiguously
+        };
+
+        typedef cds::details::Allocator< node, allocator > node_allocator;
+        typedef cds::details::Allocator< node*, allocator > node_array_allocator;
+
+        // Passes requests of a node to the container under the global lock
+        template <class Container>
+        class global_combiner
+        {
+        public:
+            global_combiner( hierarchical_kernel& kernel, Container& owner )
+                : m_Kernel( kernel )
+                , m_Owner( owner )
+                , m_bLocked( false )
+            {}
+
+            ~global_combiner()
+            {
+                if ( m_bLocked )
+                    m_Kernel.m_Mutex.unlock();
+            }
+
+            template <typename PubRecord>
+            void fc_apply( PubRecord * pRec )
+            {
+                lock();
+                m_Owner.fc_apply( pRec );
+            }
+
+            template <typename Iterator>
+            void fc_process( Iterator itBegin, Iterator itEnd )
+            {
+                lock();
+                m_Owner.fc_process( itBegin, itEnd );
+            }
+
+        private:
+            void lock()
+            {
+                // The global lock is acquired once per the node batch
+                if ( !m_bLocked ) {
+                    m_Kernel.m_Mutex.lock();
+                    m_bLocked = true;
+                    m_Kernel.m_Stat.onGlobalCombining();
+                }
+            }
+
+        private:
+            hierarchical_kernel&    m_Kernel;
+            Container&              m_Owner;
+            bool                    m_bLocked;
+        };
+        //@endcond
+
+    protected:
+        node **                     m_arrNodes;     ///< Node kernels
+        unsigned int const          m_nNodeCount;   ///< Node count
+        bool const                  m_bNativeNodes; ///< \p true if the nodes are the NUMA nodes of the system
+        mutable global_lock_type    m_Mutex;        ///< Global mutex
+        mutable stat                m_Stat;         ///< Internal statistics
+
+    public:
+        /// Initializes the object
+        /**
+            Compact factor = 1024
+
+            Combiner pass count = 8
+
+            Node count = \p cds::OS::topology::node_count()
+        */
+        hierarchical_kernel()
+            : hierarchical_kernel( 1024, 8 )
+        {}
+
+        /// Initializes the object, the node count is \p cds::OS::topology::node_count()
+        hierarchical_kernel(
+            unsigned int nCompactFactor  ///< Publication list compacting factor (the list will be compacted through \p nCompactFactor combining passes)
+            ,unsigned int nCombinePassCount ///< Number of combining passes for combiner thread
+            )
+            : hierarchical_kernel( nCompactFactor, nCombinePassCount, cds::OS::topology::node_count())
+        {}
+
+        /// Initializes the object
+        hierarchical_kernel(
+            unsigned int nCompactFactor  ///< Publication list compacting factor (the list will be compacted through \p nCompactFactor combining passes)
+            ,unsigned int nCombinePassCount ///< Number of combining passes for combiner thread
+            ,unsigned int nNodeCount ///< Node count, 0 means \p cds::OS::topology::node_count()
+            )
+            : m_arrNodes( nullptr )
+            , m_nNodeCount( nNodeCount ? nNodeCount : cds::OS::topology::node_count())
+            , m_bNativeNodes( m_nNodeCount == cds::OS::topology::node_count())
+        {
+            m_arrNodes = node_array_allocator().NewArray( m_nNodeCount, nullptr );
+            for ( unsigned int i = 0; i < m_nNodeCount; ++i ) {
+                node * pNode = node_allocator().New( nCompactFactor, nCombinePassCount );
+                pNode->internal_statistics().bind( &m_Stat );
+                m_Stat.onCreatePubRecord();
+                m_arrNodes[i] = pNode;
+            }
+        }
+
+        /// Destroys the object and all publication records
+        ~hierarchical_kernel()
+        {
+            for ( unsigned int i = 0; i < m_nNodeCount; ++i )
+                node_allocator().Delete( m_arrNodes[i] );
+            node_array_allocator().Delete( m_arrNodes, m_nNodeCount );
+        }
+
+        /// Gets publication list record for the current thread
+        /**
+            The record is taken from the publication list of the node the current thread is running on.
+            If the thread has no record in this node the function allocates it.
+        */
+        publication_record_type * acquire_record()
+        {
+            unsigned int const nNode = current_node();
+            publication_record_type * pRec = m_arrNodes[nNode]->acquire_record();
+            pRec->nNode = nNode;
+            return pRec;
+        }
+
+        /// Marks publication record for the current thread as empty
+        void release_record( publication_record_type * pRec )
+        {
+            get_node( *pRec ).release_record( pRec );
+        }
+
+        /// Trying to execute operation \p nOpId
+        /**
+            The function is similar to \p flat_combining::kernel::combine().
+            If the current thread becomes the combiner of its node, it acquires the global lock
+            and calls \p owner.fc_apply() for each active non-empty publication record of the node.
+        */
+        template <class Container>
+        void combine( unsigned int nOpId, publication_record_type * pRec, Container& owner )
+        {
+            global_combiner<Container> combiner( *this, owner );
+            get_node( *pRec ).combine( nOpId, pRec, combiner );
+        }
+
+        /// Trying to execute operation \p nOpId in batch-combine mode
+        /**
+            The function is similar to \p flat_combining::kernel::batch_combine().
+            \p owner.fc_process() obtains the publication list of the node of the combiner thread.
+        */
+        template <class Container>
+        void batch_combine( unsigned int nOpId, publication_record_type* pRec, Container& owner )
+        {
+            global_combiner<Container> combiner( *this, owner );
+            get_node( *pRec ).batch_combine( nOpId, pRec, combiner );
+        }
+
+        /// Trying to execute operation \p nOpId in parallel-combine mode
+        /**
+            The hierarchical kernel does not delegate requests to the waiting threads,
+            the function is equivalent to \p batch_combine().
+        */
+        template <class Container>
+        void parallel_combine( unsigned int nOpId, publication_record_type* pRec, Container& owner )
+        {
+            batch_combine( nOpId, pRec, owner );
+        }
+
+        /// Invokes \p Func in exclusive mode
+        /**
+            The current thread acquires the global lock and invokes \p f.
+            The node-level combiners do not process any request while \p f is executing.
+        */
+        template <typename Func>
+        void invoke_exclusive( Func f )
+        {
+            {
+                std::lock_guard<global_lock_type> l( m_Mutex );
+                f();
+            }
+            m_Stat.onInvokeExclusive();
+        }
+
+        /// Marks \p rec as executed
+        /**
+            This function should be called by container if \p batch_combine() mode is used.
+        */
+        void operation_done( publication_record& rec )
+        {
+            get_node( static_cast<publication_record_type&>( rec )).operation_done( rec );
+        }
+
+        /// Internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+        //@cond
+        // For container classes based on flat combining
+        stat& internal_statistics() const
+        {
+            return m_Stat;
+        }
+        //@endcond
+
+        /// Returns the compact factor
+        unsigned int compact_factor() const
+        {
+            return m_arrNodes[0]->compact_factor();
+        }
+
+        /// Returns number of combining passes for combiner thread
+        unsigned int combine_pass_count() const
+        {
+            return m_arrNodes[0]->combine_pass_count();
+        }
+
+        /// Returns node count
+        unsigned int node_count() const
+        {
+            return m_nNodeCount;
+        }
+
+    private:
+        //@cond
+        unsigned int current_node() const
+        {
+            if ( m_nNodeCount == 1 )
+                return 0;
+            if ( m_bNativeNodes )
+                return cds::OS::topology::current_node();
+
+            unsigned int const nProcCount = cds::OS::topology::processor_count();
+            unsigned int const nProc = cds::OS::topology::current_processor();
+            return nProc < nProcCount ? nProc * m_nNodeCount / nProcCount : nProc % m_nNodeCount;
+        }
+
+        node_kernel& get_node( publication_record_type& rec ) const
+        {
+            assert( rec.nNode < m_nNodeCount );
+            return *m_arrNodes[ rec.nNode ];
+        }
+        //@endcond
+    };
+
+    namespace kernel_selector {
+        /// Hierarchical (NUMA-aware) kernel, see \p flat_combining::hierarchical_kernel
+        struct hierarchical {
+            /// Metafunction returning the kernel type
+            template <typename PublicationRecord, typename Traits>
+            struct make_kernel {
+                typedef flat_combining::hierarchical_kernel< PublicationRecord, Traits > type; ///< Metafunction result
+            };
+        };
+    } // namespace kernel_selector
+
+}}} // namespace cds::algo::flat_combining
+
+#endif // #ifndef CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
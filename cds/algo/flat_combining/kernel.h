@@ -38,6 +38,44 @@
 #include <cds/details/allocator.h>
 #include <cds/opt/options.h>
 #include <cds/algo/int_algo.h>
+#include <cds/threading/thread_slot.h>
+
+#include <vector>
+
+namespace cds { namespace opt {
+
+    /// Kernel selector option for flat combining containers
+    /**
+        \p Selector specifies which flat combining kernel is used by a container,
+        see \p cds::algo::flat_combining::kernel_selector namespace.
+    */
+    template <typename Selector>
+    struct kernel_selector {
+        //@cond
+        template <typename Base> struct pack: public Base
+        {
+            typedef Selector kernel_selector;
+        };
+        //@endcond
+    };
+
+    /// Parallel combining option for flat combining containers
+    /**
+        If \p Enable is \p true, the container uses \p flat_combining::kernel::parallel_combine():
+        the combiner delegates independent (read-only) requests back to the waiting threads
+        to execute them concurrently.
+    */
+    template <bool Enable>
+    struct parallel_combining {
+        //@cond
+        template <typename Base> struct pack: public Base
+        {
+            static CDS_CONSTEXPR const bool parallel_combining = Enable;
+        };
+        //@endcond
+    };
+
+}} // namespace cds::opt
 
 namespace cds { namespace algo {
 
@@ -93,6 +131,9 @@ namespace cds { namespace algo {
         like stack, queue, deque. For intrusive concurrent containers the flat combining demonstrates
         less impressive results.
 
+        On multi-socket systems \p hierarchical_kernel may be used instead of the classic \p kernel:
+        it has a publication list per NUMA node, see \p opt::kernel_selector option.
+
         \ref cds_flat_combining_container "List of FC-based containers" in libcds.
 
         \ref cds_flat_combining_intrusive "List of intrusive FC-based containers" in libcds.
@@ -118,6 +159,8 @@ namespace cds { namespace algo {
             counter_type    m_nInvokeExclusive;     ///< Count of call \p kernel::invoke_exclusive()
             counter_type    m_nWakeupByNotifying;   ///< How many times the passive thread be waked up by a notification
             counter_type    m_nPassiveToCombiner;   ///< How many times the passive thread becomes the combiner
+            counter_type    m_nGlobalCombiningCount;///< How many times a node-level combiner acquired the global lock (\p hierarchical_kernel only)
+            counter_type    m_nDelegatedCount;      ///< How many requests have been delegated to the waiting threads (\p kernel::parallel_combine())
 
             /// Returns current combining factor
             /**
@@ -143,6 +186,8 @@ namespace cds { namespace algo {
             void    onInvokeExclusive()         { ++m_nInvokeExclusive;         }
             void    onWakeupByNotifying()       { ++m_nWakeupByNotifying;       }
             void    onPassiveToCombiner()       { ++m_nPassiveToCombiner;       }
+            void    onGlobalCombining()         { ++m_nGlobalCombiningCount;    }
+            void    onDelegated()               { ++m_nDelegatedCount;          }
 
             //@endcond
         };
@@ -164,9 +209,34 @@ namespace cds { namespace algo {
             void    onInvokeExclusive()         const {}
             void    onWakeupByNotifying()       const {}
             void    onPassiveToCombiner()       const {}
+            void    onGlobalCombining()         const {}
+            void    onDelegated()               const {}
             //@endcond
         };
 
+        //@cond
+        template <typename PublicationRecord, typename Traits>
+        class kernel;
+        //@endcond
+
+        /// Flat combining kernel selectors
+        /**
+            The selector specifies which kernel is used by flat combining containers.
+            It is a traits option, see \p opt::kernel_selector.
+            The selector is a struct with \p make_kernel metafunction that builds the kernel type
+            from the publication record type of the container and the container's traits.
+        */
+        namespace kernel_selector {
+            /// Classic kernel with one publication list and one global lock, see \p flat_combining::kernel
+            struct flat {
+                /// Metafunction returning the kernel type
+                template <typename PublicationRecord, typename Traits>
+                struct make_kernel {
+                    typedef flat_combining::kernel< PublicationRecord, Traits > type; ///< Metafunction result
+                };
+            };
+        } // namespace kernel_selector
+
         /// Type traits of \ref kernel class
         /**
             You can define different type traits for \ref kernel
@@ -180,6 +250,7 @@ namespace cds { namespace algo {
             typedef CDS_DEFAULT_ALLOCATOR       allocator;  ///< Allocator used for TLS data (allocating \p publication_record derivatives)
             typedef empty_stat                  stat;       ///< Internal statistics
             typedef opt::v::relaxed_ordering  memory_model; ///< /// C++ memory ordering model
+            typedef cds::algo::flat_combining::kernel_selector::flat kernel_selector; ///< Kernel used by flat combining containers
         };
 
         /// Metafunction converting option list to traits
@@ -192,6 +263,8 @@ namespace cds { namespace algo {
             - \p opt::memory_model - C++ memory ordering model.
                 List of all available memory ordering see \p opt::memory_model.
                 Default is \p cds::opt::v::relaxed_ordering
+            - \p opt::kernel_selector - the kernel type for flat combining containers, see \p kernel_selector namespace.
+                Default is \p kernel_selector::flat
         */
         template <typename... Options>
         struct make_traits {
@@ -205,6 +278,15 @@ namespace cds { namespace algo {
 #   endif
         };
 
+        /// Metafunction returning the kernel type selected by \p Traits::kernel_selector
+        /**
+            Flat combining containers use this metafunction to declare their kernel.
+        */
+        template <typename PublicationRecord, typename Traits>
+        struct make_kernel {
+            typedef typename Traits::kernel_selector::template make_kernel< PublicationRecord, Traits >::type type; ///< Metafunction result
+        };
+
         /// The kernel of flat combining
         /**
             Template parameters:
@@ -230,6 +312,18 @@ namespace cds { namespace algo {
               multiple pass through active records of publication list. For each processed record the container
               should call \p operation_done() function. On the end, the container should release
               its record by \p release_record().
+            - Parallel combining - \p parallel_combine() function. It is the batch mode where the combiner
+              first asks the container by \p fc_can_delegate() which requests are independent (for example,
+              read-only lookups), and hands these requests back to the waiting threads. The waiting threads
+              execute their requests by \p fc_apply() concurrently while the combiner holds the lock and does
+              not change the container. When all delegated requests are done, the combiner processes
+              the rest of the publication list as in \p batch_combine(). The mode cuts combiner latency under
+              wide fan-in when most of requests are lookups.
+
+            The publication record of a thread attached to \p libcds is kept in \p cds::threading::thread_slot;
+            the record is excluded from the publication list when the thread is detached.
+            A thread that is not attached to \p libcds takes a record from the kernel's pool
+            for each operation, that is slower since the pool is protected by a lock.
         */
         template <
             typename PublicationRecord
@@ -257,12 +351,15 @@ namespace cds { namespace algo {
             atomics::atomic<unsigned int>  m_nCount;    ///< Total count of combining passes. Used as an age.
             publication_record_type*    m_pHead;        ///< Head of active publication list
             publication_record_type*    m_pAllocatedHead; ///< Head of allocated publication list
-            boost::thread_specific_ptr< publication_record_type > m_pThreadRec;   ///< Thread-local publication record
+            cds::threading::thread_slot< publication_record_type > m_ThreadRec;   ///< Thread-local publication record
+            std::vector< publication_record_type* > m_arrUnboundRecords; ///< Free records for threads not attached to \p libcds
+            global_lock_type            m_UnboundLock;  ///< Lock for \p m_arrUnboundRecords
             mutable global_lock_type    m_Mutex;        ///< Global mutex
             mutable stat                m_Stat;         ///< Internal statistics
             unsigned int const          m_nCompactFactor;    ///< Publication list compacting factor (the list will be compacted through \p %m_nCompactFactor combining passes)
             unsigned int const          m_nCombinePassCount; ///< Number of combining passes
             wait_strategy               m_waitStrategy;      ///< Wait strategy
+            atomics::atomic<unsigned int> m_nDelegated;      ///< Count of delegated requests in progress
 
         public:
             /// Initializes the object
@@ -283,22 +380,24 @@ namespace cds { namespace algo {
                 : m_nCount(0)
                 , m_pHead( nullptr )
                 , m_pAllocatedHead( nullptr )
-                , m_pThreadRec( tls_cleanup )
+                , m_ThreadRec( tls_cleanup )
                 , m_nCompactFactor( static_cast<unsigned>( cds::beans::ceil2( static_cast<size_t>( nCompactFactor )) - 1 ))   // binary mask
                 , m_nCombinePassCount( nCombinePassCount )
+                , m_nDelegated( 0 )
             {
-                assert( m_pThreadRec.get() == nullptr );
+                // The head record is not owned by any thread,
+                // so the kernel may be constructed by a thread that is not attached to libcds
                 publication_record_type* pRec = cxx11_allocator().New();
                 m_pAllocatedHead =
                     m_pHead = pRec;
-                m_pThreadRec.reset( pRec );
                 m_Stat.onCreatePubRecord();
             }
 
             /// Destroys the object and all publication records
             ~kernel()
             {
-                m_pThreadRec.reset();   // calls tls_cleanup()
+                // A thread being detached must not access the records after they are freed
+                m_ThreadRec.detach();
 
                 // delete all publication records
                 for ( publication_record* p = m_pAllocatedHead; p; ) {
@@ -312,26 +411,26 @@ namespace cds { namespace algo {
             /**
                 If there is no publication record for the current thread
                 the function allocates it.
+
+                If the current thread is attached to \p libcds, the record is kept in
+                the thread's \p cds::threading::thread_slot and is excluded from the publication list
+                when the thread is detached. Otherwise, the record is taken from the pool of records
+                that are not bound to any thread, and \p release_record() returns it to the pool.
             */
             publication_record_type * acquire_record()
             {
-                publication_record_type * pRec = m_pThreadRec.get();
-                if ( !pRec ) {
-                    // Allocate new publication record
-                    pRec = cxx11_allocator().New();
-                    m_pThreadRec.reset( pRec );
-                    m_Stat.onCreatePubRecord();
-
-                    // Insert in allocated list
-                    assert( m_pAllocatedHead != nullptr );
-                    publication_record* p = m_pAllocatedHead->pNextAllocated.load( memory_model::memory_order_relaxed );
-                    do {
-                        pRec->pNextAllocated.store( p, memory_model::memory_order_release );
-                    } while ( !m_pAllocatedHead->pNextAllocated.compare_exchange_weak( p, pRec, memory_model::memory_order_release, atomics::memory_order_acquire ));
-
-                    publish( pRec );
+                publication_record_type * pRec;
+                if ( cds_likely( cds::threading::Manager::isThreadAttached())) {
+                    pRec = m_ThreadRec.get();
+                    if ( !pRec ) {
+                        pRec = alloc_publication_record();
+                        m_ThreadRec.reset( pRec );
+                    }
                 }
-                else if ( pRec->nState.load( memory_model::memory_order_acquire ) != active )
+                else
+                    pRec = acquire_unbound_record();
+
+                if ( pRec->nState.load( memory_model::memory_order_acquire ) != active )
                     publish( pRec );
 
                 assert( pRec->op() == req_EmptyRecord );
@@ -344,6 +443,11 @@ namespace cds { namespace algo {
             {
                 assert( pRec->is_done());
                 pRec->nRequest.store( req_EmptyRecord, memory_model::memory_order_release );
+
+                if ( cds_unlikely( !cds::threading::Manager::isThreadAttached())) {
+                    lock_guard l( m_UnboundLock );
+                    m_arrUnboundRecords.push_back( pRec );
+                }
             }
 
             /// Trying to execute operation \p nOpId
@@ -399,6 +503,37 @@ namespace cds { namespace algo {
                 try_batch_combining( owner, pRec );
             }
 
+            /// Trying to execute operation \p nOpId in parallel-combine mode
+            /**
+                \p pRec is the publication record acquiring by \p acquire_record() earlier.
+                \p owner is a container that owns flat combining kernel object.
+
+                If the current thread becomes a combiner, the kernel calls \p owner.fc_can_delegate()
+                for each pending record:
+                \code
+                bool fc_can_delegate( publication_record_type const& rec );
+                \endcode
+                The function should return \p true if the request of \p rec does not change the container
+                and may be executed concurrently with other such requests. These requests are handed back
+                to their owners; each owner calls \p owner.fc_apply() for its own record while
+                the combiner waits. The combiner helps by executing its own delegated request if any.
+                Then the rest of publication list is processed as in \p batch_combine().
+
+                A thread waiting in any combine mode executes its request when the combiner delegates it,
+                so the container may mix \p %parallel_combine() with \p combine() and \p batch_combine().
+            */
+            template <class Container>
+            void parallel_combine( unsigned int nOpId, publication_record_type* pRec, Container& owner )
+            {
+                assert( nOpId >= req_Operation );
+                assert( pRec );
+
+                pRec->nRequest.store( nOpId, memory_model::memory_order_release );
+                m_Stat.onOperation();
+
+                try_parallel_combining( owner, pRec );
+            }
+
             /// Invokes \p Func in exclusive mode
             /**
                 Some operation in flat combining containers should be called in exclusive mode
@@ -582,11 +717,40 @@ namespace cds { namespace algo {
             //@cond
             static void tls_cleanup( publication_record_type* pRec )
             {
-                // Thread done
+                // Thread is detached
                 // pRec that is TLS data should be excluded from publication list
                 pRec->nState.store( removed, memory_model::memory_order_release );
             }
 
+            publication_record_type * alloc_publication_record()
+            {
+                publication_record_type * pRec = cxx11_allocator().New();
+                m_Stat.onCreatePubRecord();
+
+                // Insert in allocated list
+                assert( m_pAllocatedHead != nullptr );
+                publication_record* p = m_pAllocatedHead->pNextAllocated.load( memory_model::memory_order_relaxed );
+                do {
+                    pRec->pNextAllocated.store( p, memory_model::memory_order_release );
+                } while ( !m_pAllocatedHead->pNextAllocated.compare_exchange_weak( p, pRec, memory_model::memory_order_release, atomics::memory_order_acquire ));
+
+                return pRec;
+            }
+
+            publication_record_type * acquire_unbound_record()
+            {
+                // The records of the pool are never removed, they are freed by the kernel destructor
+                {
+                    lock_guard l( m_UnboundLock );
+                    if ( !m_arrUnboundRecords.empty()) {
+                        publication_record_type * pRec = m_arrUnboundRecords.back();
+                        m_arrUnboundRecords.pop_back();
+                        return pRec;
+                    }
+                }
+                return alloc_publication_record();
+            }
+
             void free_publication_record( publication_record_type* pRec )
             {
                 cxx11_allocator().Delete( pRec );
@@ -637,7 +801,7 @@ namespace cds { namespace algo {
                 }
                 else {
                     // There is another combiner, wait while it executes our request
-                    if ( !wait_for_combining( pRec )) {
+                    if ( !wait_for_combining( pRec, owner )) {
                         // The thread becomes a combiner
                         lock_guard l( m_Mutex, std::adopt_lock_t());
 
@@ -665,7 +829,7 @@ namespace cds { namespace algo {
                 }
                 else {
                     // There is another combiner, wait while it executes our request
-                    if ( !wait_for_combining( pRec )) {
+                    if ( !wait_for_combining( pRec, owner )) {
                         // The thread becomes a combiner
                         lock_guard l( m_Mutex, std::adopt_lock_t());
 
@@ -678,6 +842,34 @@ namespace cds { namespace algo {
                 }
             }
 
+            template <class Container>
+            void try_parallel_combining( Container& owner, publication_record_type * pRec )
+            {
+                if ( m_Mutex.try_lock()) {
+                    // The thread becomes a combiner
+                    lock_guard l( m_Mutex, std::adopt_lock_t());
+
+                    // The record pRec can be excluded from publication list. Re-publish it
+                    republish( pRec );
+
+                    parallel_combining( owner, pRec );
+                    assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+                }
+                else {
+                    // There is another combiner, wait while it executes our request
+                    if ( !wait_for_combining( pRec, owner )) {
+                        // The thread becomes a combiner
+                        lock_guard l( m_Mutex, std::adopt_lock_t());
+
+                        // The record pRec can be excluded from publication list. Re-publish it
+                        republish( pRec );
+
+                        parallel_combining( owner, pRec );
+                        assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+                    }
+                }
+            }
+
             template <class Container>
             void combining( Container& owner )
             {
@@ -748,7 +940,55 @@ namespace cds { namespace algo {
                     compact_list( nCurAge );
             }
 
-            bool wait_for_combining( publication_record_type* pRec )
+            template <class Container>
+            void parallel_combining( Container& owner, publication_record_type* pRec )
+            {
+                // The thread is a combiner
+                assert( !m_Mutex.try_lock());
+
+                // Delegate independent requests to their owners
+                bool bDelegated = false;
+                for ( publication_record* p = m_pHead; p; p = p->pNext.load( memory_model::memory_order_acquire )) {
+                    if ( p->nState.load( memory_model::memory_order_acquire ) == active ) {
+                        unsigned int const nOp = p->op( memory_model::memory_order_acquire );
+                        if ( nOp >= req_Operation && owner.fc_can_delegate( static_cast<publication_record_type const&>( *p ))) {
+                            p->nDelegatedOp = nOp;
+                            m_nDelegated.fetch_add( 1, memory_model::memory_order_relaxed );
+                            p->nRequest.store( req_Delegated, memory_model::memory_order_release );
+                            m_waitStrategy.notify( *this, static_cast<publication_record_type&>( *p ));
+                            m_Stat.onDelegated();
+                            bDelegated = true;
+                        }
+                    }
+                }
+
+                if ( bDelegated ) {
+                    // Wait until the delegated requests are done; the container must not be changed meanwhile
+                    cds::backoff::exponential<> bkoff;
+                    while ( m_nDelegated.load( memory_model::memory_order_acquire ) != 0 ) {
+                        if ( pRec->op( memory_model::memory_order_relaxed ) == req_Delegated )
+                            execute_delegated( owner, pRec );
+                        else
+                            bkoff();
+                    }
+                }
+
+                batch_combining( owner );
+            }
+
+            template <class Container>
+            void execute_delegated( Container& owner, publication_record_type* pRec )
+            {
+                // The combiner holds the lock and does not change the container
+                // until all delegated requests are done
+                pRec->nRequest.store( pRec->nDelegatedOp, memory_model::memory_order_relaxed );
+                owner.fc_apply( pRec );
+                pRec->nRequest.store( req_Response, memory_model::memory_order_release );
+                m_nDelegated.fetch_sub( 1, memory_model::memory_order_release );
+            }
+
+            template <class Container>
+            bool wait_for_combining( publication_record_type* pRec, Container& owner )
             {
                 m_waitStrategy.prepare( *pRec );
                 m_Stat.onPassiveWait();
@@ -763,6 +1003,12 @@ namespace cds { namespace algo {
                     if ( m_waitStrategy.wait( *this, *pRec ))
                         m_Stat.onWakeupByNotifying();
 
+                    if ( pRec->op( memory_model::memory_order_acquire ) == req_Delegated ) {
+                        // The combiner asks us to execute the request
+                        execute_delegated( owner, pRec );
+                        break;
+                    }
+
                     if ( m_Mutex.try_lock()) {
                         if ( pRec->op( memory_model::memory_order_acquire ) == req_Response ) {
                             // Operation is done
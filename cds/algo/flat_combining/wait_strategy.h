@@ -33,9 +33,9 @@
 
 #include <cds/algo/flat_combining/defs.h>
 #include <cds/algo/backoff_strategy.h>
+#include <cds/os/futex.h>
 #include <mutex>
 #include <condition_variable>
-#include <boost/thread/tss.hpp>  // thread_specific_ptr
 
 
 namespace cds { namespace opt {
@@ -436,6 +436,137 @@ namespace cds { namespace algo { namespace flat_combining {
             }
         };
 
+        /// Adaptive wait strategy: spinning, yielding and parking
+        /**
+            The strategy adapts to the load that alternates between bursts and idle periods.
+            Each wait passes through three phases:
+            - spinning on the request field with processor pause hint;
+            - yielding the processor by \p std::this_thread::yield();
+            - parking the thread on a futex word of its publication record, see \p cds::OS::futex.
+
+            Each publication record keeps the average cost of its recent waits measured in spin units
+            (one spin iteration is one unit, one yield is \p c_nYieldCost units, parking is \p MaxSpinCount units).
+            Before every wait the spin budget is recomputed: if recent waits were short, the thread spins
+            up to twice the average; if the waits were longer than \p MaxSpinCount units, spinning is useless
+            and the thread spins only \p c_nMinSpinCount iterations before yielding and parking.
+
+            The combiner wakes only the records it has served, and only if the record is actually parked;
+            records that are spinning or yielding cost the combiner one load.
+            On platforms without futex support the parking degrades to a short sleep.
+
+            Template parameters:
+            - \p Milliseconds - parking duration; the minimal value is 1
+            - \p MaxSpinCount - maximal spin budget, in spin iterations
+            - \p YieldCount - how many times the thread yields before parking
+        */
+        template <int Milliseconds = 2, unsigned int MaxSpinCount = 256, unsigned int YieldCount = 16>
+        class adaptive
+        {
+        public:
+            enum {
+                c_nWaitMilliseconds = Milliseconds < 1 ? 1 : Milliseconds,  ///< Parking duration
+                c_nMaxSpinCount = MaxSpinCount < 16 ? 16 : MaxSpinCount,    ///< Maximal spin budget
+                c_nMinSpinCount = 4,                                        ///< Minimal spin budget
+                c_nYieldCount = YieldCount,                                 ///< Yield count before parking
+                c_nYieldCost = 8,                                           ///< Cost of a yield in spin units
+                c_nSpinBatch = 16                                           ///< Pause hints per spin iteration
+            };
+
+            /// Incorporates a futex word and wait statistics into \p PublicationRecord
+            template <typename PublicationRecord>
+            struct make_publication_record {
+                /// Metafunction result
+                struct type: public PublicationRecord
+                {
+                    //@cond
+                    cds::OS::futex::word_type   m_nParked;      // 1 if the thread is parked
+                    unsigned int                m_nWaitCost;    // cost of current wait
+                    unsigned int                m_nAvgWaitCost; // average cost of recent waits
+                    unsigned int                m_nSpinLimit;   // spin budget of current wait
+
+                    type()
+                        : m_nParked( 0 )
+                        , m_nWaitCost( 0 )
+                        , m_nAvgWaitCost( 0 )
+                        , m_nSpinLimit( c_nMaxSpinCount )
+                    {}
+                    //@endcond
+                };
+            };
+
+            /// Folds the previous wait into the average and computes the spin budget
+            template <typename PublicationRecord>
+            void prepare( PublicationRecord& rec )
+            {
+                rec.m_nAvgWaitCost = ( rec.m_nAvgWaitCost * 3 + rec.m_nWaitCost ) / 4;
+                rec.m_nWaitCost = 0;
+
+                if ( rec.m_nAvgWaitCost > c_nMaxSpinCount )
+                    rec.m_nSpinLimit = c_nMinSpinCount;
+                else {
+                    unsigned int const nLimit = rec.m_nAvgWaitCost * 2;
+                    unsigned int const nMin = c_nMinSpinCount;
+                    unsigned int const nMax = c_nMaxSpinCount;
+                    rec.m_nSpinLimit = nLimit < nMin ? nMin : ( nLimit > nMax ? nMax : nLimit );
+                }
+            }
+
+            /// Spins, yields or parks depending on the time already spent in waiting
+            template <typename FCKernel, typename PublicationRecord>
+            bool wait( FCKernel& /*fc*/, PublicationRecord& rec )
+            {
+                if ( rec.op( atomics::memory_order_acquire ) < req_Operation )
+                    return false;
+
+                if ( rec.m_nWaitCost < rec.m_nSpinLimit ) {
+                    ++rec.m_nWaitCost;
+                    cds::backoff::pause pause;
+                    for ( unsigned int i = 0; i < c_nSpinBatch; ++i )
+                        pause();
+                    return false;
+                }
+
+                if ( rec.m_nWaitCost < rec.m_nSpinLimit + c_nYieldCount * c_nYieldCost ) {
+                    rec.m_nWaitCost += c_nYieldCost;
+                    std::this_thread::yield();
+                    return false;
+                }
+
+                // Parking
+                if ( rec.m_nWaitCost < c_nMaxSpinCount * 2 )
+                    rec.m_nWaitCost += c_nMaxSpinCount;
+
+                rec.m_nParked.store( 1, atomics::memory_order_seq_cst );
+                if ( rec.op( atomics::memory_order_seq_cst ) >= req_Operation )
+                    cds::OS::futex::wait( rec.m_nParked, 1, c_nWaitMilliseconds * 1000 );
+
+                // If the word has been reset by notify() the thread has been waked up by the combiner
+                return rec.m_nParked.exchange( 0, atomics::memory_order_acquire ) == 0;
+            }
+
+            /// Wakes up \p rec if it is parked
+            template <typename FCKernel, typename PublicationRecord>
+            void notify( FCKernel& /*fc*/, PublicationRecord& rec )
+            {
+                // The response has been stored with release semantics; the fence prevents
+                // the load of m_nParked below from being reordered before that store.
+                // Pairs with seq_cst store of m_nParked / load of the request state in wait()
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+                if ( rec.m_nParked.load( atomics::memory_order_seq_cst ) != 0
+                  && rec.m_nParked.exchange( 0, atomics::memory_order_seq_cst ) != 0 )
+                {
+                    cds::OS::futex::wake( rec.m_nParked );
+                }
+            }
+
+            /// Calls \p fc.wakeup_any() to wake up any pending thread
+            template <typename FCKernel>
+            void wakeup( FCKernel& fc )
+            {
+                fc.wakeup_any();
+            }
+        };
+
     } // namespace wait_strategy
 }}} // namespace cds::algo::flat_combining
 
@@ -0,0 +1,221 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_ALGO_PER_CPU_H
+#define CDSLIB_ALGO_PER_CPU_H
+
+#include <cds/os/topology.h>
+#include <cds/opt/options.h>
+#include <cds/details/aligned_allocator.h>
+#include <cds/algo/int_algo.h>
+#include <algorithm>
+
+namespace cds { namespace algo {
+
+    /// Per-CPU array of objects
+    /**
+        The class contains an array of objects of type \p T, one object (a cell) per logical processor.
+        Each cell is padded to the cache line, so the threads running on different processors
+        do not share cache lines. The cell of the current processor is selected by
+        \p cds::OS::topology::current_processor() that is a plain memory read on Linux with rseq support
+        for the threads attached to libcds.
+
+        Since a thread may be migrated to another processor at any time, and several threads
+        may run on one processor in turn, \p local() does not grant exclusive access to the cell:
+        the cell must be thread-safe itself, for example, \p T may be an atomic counter or a lock-free free-list.
+        Per-CPU sharding just reduces contention and cache-line ping-pong.
+
+        The number of cells is processor count rounded up to the power of two,
+        the processor number is mapped to the cell by bit mask.
+
+        Template arguments:
+        - \p T - cell type, must be default-constructible
+        - \p Alloc - aligned allocator, default is \p CDS_DEFAULT_ALIGNED_ALLOCATOR
+
+        Example: per-CPU event counter
+        \code
+        #include <cds/algo/per_cpu.h>
+
+        cds::algo::per_cpu< atomics::atomic<size_t>> counter;
+
+        // increment
+        counter.local().fetch_add( 1, atomics::memory_order_relaxed );
+
+        // read
+        size_t n = 0;
+        for ( auto const& cell: counter )
+            n += cell.load( atomics::memory_order_relaxed );
+        \endcode
+    */
+    template <typename T, typename Alloc = CDS_DEFAULT_ALIGNED_ALLOCATOR >
+    class per_cpu
+    {
+    public:
+        typedef T value_type;   ///< Cell type
+
+    private:
+        //@cond
+        typedef typename cds::opt::details::apply_padding< value_type, cds::opt::cache_line_padding >::type cell_type;
+        typedef cds::details::AlignedAllocator< cell_type, Alloc > cell_allocator;
+
+        template <typename Cell, typename Value>
+        class iterator_type
+        {
+            Cell * m_pCell;
+        public:
+            explicit iterator_type( Cell * p )
+                : m_pCell( p )
+            {}
+
+            Value& operator*() const
+            {
+                return m_pCell->data;
+            }
+
+            Value* operator->() const
+            {
+                return &m_pCell->data;
+            }
+
+            iterator_type& operator++()
+            {
+                ++m_pCell;
+                return *this;
+            }
+
+            bool operator==( iterator_type const& i ) const
+            {
+                return m_pCell == i.m_pCell;
+            }
+
+            bool operator!=( iterator_type const& i ) const
+            {
+                return m_pCell != i.m_pCell;
+            }
+        };
+        //@endcond
+
+    public:
+        typedef iterator_type< cell_type, value_type > iterator;                    ///< Forward iterator over cells
+        typedef iterator_type< cell_type const, value_type const > const_iterator;  ///< Const forward iterator over cells
+
+    public:
+        /// Creates the array of cells for each processor
+        per_cpu()
+            : per_cpu( cds::OS::topology::processor_count())
+        {}
+
+        /// Creates the array of \p nCellCount cells rounded up to power of two
+        /**
+            If \p nCellCount is 0 the processor count is used.
+        */
+        explicit per_cpu( size_t nCellCount )
+            : m_nMask( cds::beans::ceil2( nCellCount ? nCellCount : std::max( cds::OS::topology::processor_count(), 1u )) - 1 )
+        {
+            m_arrCells = cell_allocator().NewArray( cds::c_nCacheLineSize, m_nMask + 1 );
+        }
+
+        //@cond
+        per_cpu( per_cpu const& ) = delete;
+        per_cpu& operator=( per_cpu const& ) = delete;
+        //@endcond
+
+        /// Destroys the cells
+        ~per_cpu()
+        {
+            cell_allocator().Delete( m_arrCells, m_nMask + 1 );
+        }
+
+        /// Returns the cell of current processor
+        value_type& local()
+        {
+            return m_arrCells[ cds::OS::topology::current_processor() & m_nMask ].data;
+        }
+
+        /// Returns the cell of current processor
+        value_type const& local() const
+        {
+            return m_arrCells[ cds::OS::topology::current_processor() & m_nMask ].data;
+        }
+
+        /// Returns the cell by its index; \p nIndex should be less than \p size()
+        value_type& operator[]( size_t nIndex )
+        {
+            assert( nIndex < size());
+            return m_arrCells[ nIndex ].data;
+        }
+
+        /// Returns the cell by its index; \p nIndex should be less than \p size()
+        value_type const& operator[]( size_t nIndex ) const
+        {
+            assert( nIndex < size());
+            return m_arrCells[ nIndex ].data;
+        }
+
+        /// Returns the number of cells
+        size_t size() const
+        {
+            return m_nMask + 1;
+        }
+
+        /// Returns an iterator to the first cell
+        iterator begin()
+        {
+            return iterator( m_arrCells );
+        }
+
+        /// Returns an iterator to the end of cell array
+        iterator end()
+        {
+            return iterator( m_arrCells + size());
+        }
+
+        /// Returns a const iterator to the first cell
+        const_iterator begin() const
+        {
+            return const_iterator( m_arrCells );
+        }
+
+        /// Returns a const iterator to the end of cell array
+        const_iterator end() const
+        {
+            return const_iterator( m_arrCells + size());
+        }
+
+    private:
+        //@cond
+        size_t const    m_nMask;
+        cell_type *     m_arrCells;
+        //@endcond
+    };
+
+}} // namespace cds::algo
+
+#endif // #ifndef CDSLIB_ALGO_PER_CPU_H
@@ -0,0 +1,248 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_ALGO_SHARDED_COUNTER_H
+#define CDSLIB_ALGO_SHARDED_COUNTER_H
+
+#include <cds/algo/atomic.h>
+#include <cds/algo/per_cpu.h>
+
+namespace cds { namespace atomicity {
+
+#if CDS_COMPILER == CDS_COMPILER_CLANG
+    // CLang unhappy: pad1_ and pad2_ - unused private field warning
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wunused-private-field"
+#endif
+    /// Per-CPU sharded item counter
+    /**
+        The counter is split to per-CPU shards (see \p cds::algo::per_cpu) padded to cache line,
+        and to a central part. An increment or decrement changes the shard of the current processor only.
+        When the absolute value of the shard exceeds \p Batch the shard is folded to the central part.
+        So, the hot path of a container's insert/erase does not bounce one cache line between all processors,
+        and the central part is changed once per \p Batch operations on a processor.
+
+        The counter provides two reading modes:
+        - exact: \p value() sums the central part and all the shards. It is expensive for many processors
+          but exact in quiescent state. \p size() of the containers uses it.
+        - approximate: \p approx_value() returns the central part only. It is cheap, its error is
+          no more than <tt>(Batch - 1) * shard_count()</tt>. The pre- and post-increment/decrement operations
+          and \p inc()/dec() return an approximate value that includes the central part and the current shard.
+          For example, the load-factor check of \p cds::intrusive::SplitListSet uses the result of <tt>++counter</tt>,
+          so the bucket table grows a bit later than with \p item_counter but without reading all the shards.
+
+        The class may be used as \p opt::item_counter option of any container instead of \p item_counter or
+        \p cache_friendly_item_counter, and as \p Counter template argument of container's internal statistics
+        instead of \p event_counter (see \p sharded_event_counter). Use it when many threads modify
+        one container heavily; for a single-thread or low-contention workload
+        \p item_counter is cheaper since the sharded counter allocates
+        <tt>shard_count() * cds::c_nCacheLineSize</tt> bytes.
+
+        Template arguments:
+        - \p Batch - max absolute value of a shard before folding into the central part, default 64.
+            Must be greater than 0.
+        - \p Alloc - aligned allocator for the shards
+    */
+    template <size_t Batch = 64, typename Alloc = CDS_DEFAULT_ALIGNED_ALLOCATOR >
+    class sharded_item_counter
+    {
+    public:
+        typedef size_t counter_type;                    ///< Integral item counter type (size_t)
+        static CDS_CONSTEXPR const size_t c_nBatch = Batch; ///< Folding threshold
+
+        static_assert( Batch > 0, "Batch must be greater than 0" );
+
+    private:
+        //@cond
+        typedef atomics::atomic<ptrdiff_t>  shard_type;
+
+        char                            pad1_[cds::c_nCacheLineSize];
+        atomics::atomic<counter_type>   m_Central;
+        char                            pad2_[cds::c_nCacheLineSize - sizeof( atomics::atomic<counter_type> )];
+        cds::algo::per_cpu< shard_type, Alloc > m_Shards;
+        //@endcond
+
+    public:
+        /// Default ctor initializes the counter to zero.
+        sharded_item_counter()
+            : m_Central( counter_type( 0 ))
+        {}
+
+        /// Returns the exact value of the counter (sum of all shards)
+        /**
+            The value is exact only if there are no concurrent modifications.
+        */
+        counter_type value( atomics::memory_order order = atomics::memory_order_relaxed ) const
+        {
+            counter_type n = m_Central.load( order );
+            for ( auto const& shard : m_Shards )
+                n += static_cast<counter_type>( shard.load( order ));
+            return n;
+        }
+
+        /// Returns the approximate value of the counter (central part only)
+        counter_type approx_value( atomics::memory_order order = atomics::memory_order_relaxed ) const
+        {
+            return m_Central.load( order );
+        }
+
+        /// Same as \ref value() with relaxed memory ordering
+        operator counter_type() const
+        {
+            return value();
+        }
+
+        /// Same as \ref value() with relaxed memory ordering, for compatibility with \p event_counter
+        counter_type get() const
+        {
+            return value();
+        }
+
+        /// Returns the number of shards
+        size_t shard_count() const
+        {
+            return m_Shards.size();
+        }
+
+        /// Increments the counter. Semantics: approximate postincrement
+        counter_type inc( atomics::memory_order order = atomics::memory_order_relaxed )
+        {
+            return add( 1, order );
+        }
+
+        /// Increments the counter. Semantics: approximate postincrement
+        counter_type inc( counter_type count, atomics::memory_order order = atomics::memory_order_relaxed )
+        {
+            return add( static_cast<ptrdiff_t>( count ), order );
+        }
+
+        /// Decrements the counter. Semantics: approximate postdecrement
+        counter_type dec( atomics::memory_order order = atomics::memory_order_relaxed )
+        {
+            return add( -1, order );
+        }
+
+        /// Decrements the counter. Semantics: approximate postdecrement
+        counter_type dec( counter_type count, atomics::memory_order order = atomics::memory_order_relaxed )
+        {
+            return add( -static_cast<ptrdiff_t>( count ), order );
+        }
+
+        /// Preincrement
+        counter_type operator ++()
+        {
+            return inc() + 1;
+        }
+        /// Postincrement
+        counter_type operator ++(int)
+        {
+            return inc();
+        }
+
+        /// Predecrement
+        counter_type operator --()
+        {
+            return dec() - 1;
+        }
+        /// Postdecrement
+        counter_type operator --(int)
+        {
+            return dec();
+        }
+
+        /// Increment by \p count
+        counter_type operator +=( counter_type count )
+        {
+            return inc( count ) + count;
+        }
+
+        /// Decrement by \p count
+        counter_type operator -=( counter_type count )
+        {
+            return dec( count ) - count;
+        }
+
+        /// Assigns \p n to the counter, for compatibility with \p event_counter
+        /**
+            The function is not atomic with respect to concurrent modifications.
+        */
+        counter_type operator =( counter_type n )
+        {
+            for ( auto& shard : m_Shards )
+                shard.store( 0, atomics::memory_order_relaxed );
+            m_Central.store( n, atomics::memory_order_release );
+            return n;
+        }
+
+        /// Resets count to 0
+        /**
+            The function is not atomic with respect to concurrent modifications.
+        */
+        void reset( atomics::memory_order order = atomics::memory_order_relaxed )
+        {
+            for ( auto& shard : m_Shards )
+                shard.store( 0, atomics::memory_order_relaxed );
+            m_Central.store( 0, order );
+        }
+
+    private:
+        //@cond
+        counter_type add( ptrdiff_t nDelta, atomics::memory_order order )
+        {
+            shard_type& shard = m_Shards.local();
+            ptrdiff_t const nPrev = shard.fetch_add( nDelta, order );
+            ptrdiff_t const nCur = nPrev + nDelta;
+
+            if ( static_cast<size_t>( nCur < 0 ? -nCur : nCur ) >= c_nBatch ) {
+                // Fold the shard into the central part.
+                // The shard may be changed by a thread on the same processor in between, so it is exchanged
+                ptrdiff_t const nFold = shard.exchange( 0, atomics::memory_order_relaxed );
+                return m_Central.fetch_add( static_cast<counter_type>( nFold ), order ) + static_cast<counter_type>( nFold - nDelta );
+            }
+            return m_Central.load( atomics::memory_order_relaxed ) + static_cast<counter_type>( nPrev );
+        }
+        //@endcond
+    };
+#if CDS_COMPILER == CDS_COMPILER_CLANG
+#   pragma GCC diagnostic pop
+#endif
+
+    /// Per-CPU sharded event counter for containers' internal statistics
+    /**
+        The type can be passed as \p Counter template argument of statistics,
+        for example, <tt>cds::intrusive::split_list::stat< cds::atomicity::sharded_event_counter<> ></tt>.
+        See \p sharded_item_counter.
+    */
+    template <size_t Batch = 64, typename Alloc = CDS_DEFAULT_ALIGNED_ALLOCATOR >
+    using sharded_event_counter = sharded_item_counter< Batch, Alloc >;
+
+}} // namespace cds::atomicity
+
+#endif // #ifndef CDSLIB_ALGO_SHARDED_COUNTER_H
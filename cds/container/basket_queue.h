@@ -78,6 +78,24 @@ namespace cds { namespace container {
 
             /// Padding for internal critical atomic data. Default is \p opt::cache_line_padding
             enum { padding = opt::cache_line_padding };
+
+            /// Enable \ref cds::intrusive::queue_elimination "elimination back-off"; by default, it is disabled
+            /**
+                The following traits is used only if elimination enabled
+            */
+            static CDS_CONSTEXPR const bool enable_elimination = false;
+
+            /// Back-off strategy to wait for elimination, default is 2 microseconds \p cds::backoff::delay_of
+            typedef cds::backoff::delay_of< 2, std::chrono::microseconds > elimination_backoff;
+
+            /// Buffer type for elimination array, default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>
+            typedef opt::v::initialized_static_buffer< int, 4 > buffer;
+
+            /// Random engine to generate a random position in elimination array
+            typedef opt::v::c_rand  random_engine;
+
+            /// Lock type used in elimination, default is cds::sync::spin
+            typedef cds::sync::spin lock_type;
         };
 
         /// Metafunction converting option list to \p basket_queue::traits
@@ -94,6 +112,18 @@ namespace cds { namespace container {
             - \p opt::memory_model - C++ memory ordering model. Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
                 or \p opt::v::sequential_consistent (sequentially consisnent memory model).
 
+            - \p opt::enable_elimination - enable \ref cds::intrusive::queue_elimination "elimination back-off" for the queue.
+                Default value is \p false.
+
+            If elimination back-off is enabled, additional options can be specified:
+            - \p opt::buffer - a buffer type for elimination array, see \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+                Default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>.
+            - \p opt::random_engine - a random engine to generate a random position in elimination array.
+                Default is \p opt::v::c_rand.
+            - \p opt::elimination_backoff - back-off strategy to wait for elimination, default is
+                <tt>cds::backoff::delay_of< 2, std::chrono::microseconds ></tt>
+            - \p opt::lock_type - a lock type used in elimination back-off, default is \p cds::sync::spin
+
             Example: declare \p %BasketQueue with item counting and internal statistics
             \code
             typedef cds::container::BasketQueue< cds::gc::HP, Foo,
@@ -298,6 +328,44 @@ namespace cds { namespace container {
             }
         };
         typedef std::unique_ptr< node_type, node_disposer > scoped_node_ptr;
+
+        // Private chain of new nodes for enqueue_batch(); frees the nodes if they are not enqueued
+        struct node_chain
+        {
+            node_type * pFirst;
+            node_type * pLast;
+            size_t      nCount;
+
+            node_chain()
+                : pFirst( nullptr )
+                , pLast( nullptr )
+                , nCount( 0 )
+            {}
+
+            ~node_chain()
+            {
+                while ( pFirst ) {
+                    node_type * p = pFirst;
+                    pFirst = static_cast<node_type *>( p->m_pNext.load( atomics::memory_order_relaxed ).ptr());
+                    free_node( p );
+                }
+            }
+
+            void push_back( node_type * p )
+            {
+                if ( pLast )
+                    pLast->m_pNext.store( typename base_class::marked_ptr( p ), atomics::memory_order_relaxed );
+                else
+                    pFirst = p;
+                pLast = p;
+                ++nCount;
+            }
+
+            void release()
+            {
+                pFirst = pLast = nullptr;
+            }
+        };
         //@endcond
 
     public:
@@ -305,6 +373,15 @@ namespace cds { namespace container {
         BasketQueue()
         {}
 
+        /// Initializes empty queue and elimination back-off data
+        /**
+            This form should be used if you use elimination back-off with dynamically allocated collision array,
+            see \p cds::intrusive::BasketQueue::BasketQueue( size_t )
+        */
+        explicit BasketQueue( size_t nCollisionCapacity )
+            : base_class( nCollisionCapacity )
+        {}
+
         /// Destructor clears the queue
         ~BasketQueue()
         {}
@@ -370,6 +447,27 @@ namespace cds { namespace container {
             return enqueue( std::move( val ));
         }
 
+        /// Enqueues copies of the values from the range <tt>[first, last)</tt>
+        /**
+            The function allocates the nodes for all values, links them into a private chain
+            and appends the chain to the queue with a single CAS on the tail,
+            so the values are enqueued contiguously in the order of the range.
+            Returns the number of enqueued values.
+        */
+        template <typename Iterator>
+        size_t enqueue_batch( Iterator first, Iterator last )
+        {
+            node_chain chain;
+            for ( ; first != last; ++first )
+                chain.push_back( alloc_node( *first ));
+
+            if ( chain.nCount ) {
+                base_class::do_enqueue_chain( chain.pFirst, chain.pLast, chain.nCount );
+                chain.release();
+            }
+            return chain.nCount;
+        }
+
         /// Synonym for \p enqueue_with() function
         template <typename Func>
         bool push_with( Func f )
@@ -428,6 +526,31 @@ namespace cds { namespace container {
             return false;
         }
 
+        /// Dequeues up to \p nMax values into array \p pOut
+        /**
+            See \p dequeue_batch_with() for details.
+            Returns the number of dequeued values, 0 if the queue is empty.
+        */
+        size_t dequeue_batch( value_type * pOut, size_t nMax )
+        {
+            return dequeue_batch_with( [&pOut]( value_type& src ) { *pOut++ = std::move( src ); }, nMax );
+        }
+
+        /// Dequeues up to \p nMax values using a functor
+        /**
+            \p Func is called for each dequeued value in FIFO order:
+            \code
+            void f( value_type& src );
+            \endcode
+            Each value is dequeued with its own CAS, see \p cds::intrusive::BasketQueue::dequeue_batch().
+            Returns the number of dequeued values, 0 if the queue is empty.
+        */
+        template <typename Func>
+        size_t dequeue_batch_with( Func f, size_t nMax )
+        {
+            return base_class::dequeue_batch( [&f]( node_type& node ) { f( node.m_value ); }, nMax );
+        }
+
         /// Synonym for \p dequeue() function
         bool pop( value_type& dest )
         {
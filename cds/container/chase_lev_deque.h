@@ -0,0 +1,541 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_CHASE_LEV_DEQUE_H
+#define CDSLIB_CONTAINER_CHASE_LEV_DEQUE_H
+
+#include <cds/container/details/base.h>
+#include <cds/algo/atomic.h>
+#include <cds/algo/int_algo.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/details/allocator.h>
+#include <limits>
+#include <type_traits>
+
+namespace cds { namespace container {
+
+    /// \p ChaseLevDeque related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace chase_lev_deque {
+
+        /// \p ChaseLevDeque internal statistics
+        template <typename Counter = cds::atomicity::event_counter>
+        struct stat
+        {
+            typedef Counter counter_type;   ///< Counter type
+
+            counter_type m_PushCount;       ///< \p push_bottom() call count
+            counter_type m_PopCount;        ///< Count of success \p pop_bottom() call
+            counter_type m_EmptyPop;        ///< Count of \p pop_bottom() call for empty deque
+            counter_type m_PopRace;         ///< Count of the last item lost by \p pop_bottom() to a thief
+            counter_type m_StealCount;      ///< Count of items stolen by \p steal() and \p steal_half()
+            counter_type m_EmptySteal;      ///< Count of \p steal() call for empty deque
+            counter_type m_StealRace;       ///< Count of steal race conditions encountered
+            counter_type m_StealHalfCount;  ///< Count of success \p steal_half() call
+            counter_type m_GrowCount;       ///< Count of internal array growing
+
+            //@cond
+            void onPush()           { ++m_PushCount; }
+            void onPop()            { ++m_PopCount; }
+            void onEmptyPop()       { ++m_EmptyPop; }
+            void onPopRace()        { ++m_PopRace; }
+            void onSteal()          { ++m_StealCount; }
+            void onEmptySteal()     { ++m_EmptySteal; }
+            void onStealRace()      { ++m_StealRace; }
+            void onStealHalf()      { ++m_StealHalfCount; }
+            void onGrow()           { ++m_GrowCount; }
+            //@endcond
+        };
+
+        /// Dummy \p ChaseLevDeque statistics - no counting is performed. Support interface like \p chase_lev_deque::stat
+        struct empty_stat
+        {
+            //@cond
+            void onPush()           const {}
+            void onPop()            const {}
+            void onEmptyPop()       const {}
+            void onPopRace()        const {}
+            void onSteal()          const {}
+            void onEmptySteal()     const {}
+            void onStealRace()      const {}
+            void onStealHalf()      const {}
+            void onGrow()           const {}
+            //@endcond
+        };
+
+        /// \p ChaseLevDeque default traits
+        struct traits
+        {
+            /// Allocator for the internal cyclic arrays
+            typedef CDS_DEFAULT_ALLOCATOR allocator;
+
+            /// Back-off strategy for \p steal() retrying
+            typedef cds::backoff::Default back_off;
+
+            /// Internal statistics, possible types: \p chase_lev_deque::stat, \p chase_lev_deque::empty_stat (the default)
+            typedef chase_lev_deque::empty_stat stat;
+
+            /// Padding for internal critical atomic data. Default is \p opt::cache_line_padding
+            enum { padding = opt::cache_line_padding };
+        };
+
+        /// Metafunction converting option list to \p chase_lev_deque::traits
+        /**
+            Supported \p Options are:
+            - \p opt::allocator - allocator for the internal cyclic arrays. Default is \ref CDS_DEFAULT_ALLOCATOR
+            - \p opt::back_off - back-off strategy used in \p steal() on race condition.
+                Default is \p cds::backoff::Default
+            - \p opt::stat - internal statistics, possible types: \p chase_lev_deque::stat,
+                \p chase_lev_deque::empty_stat (the default)
+            - \p opt::padding - padding for internal critical atomic data. Default is \p opt::cache_line_padding
+
+            Example: declare \p %ChaseLevDeque with internal statistics
+            \code
+            typedef cds::container::ChaseLevDeque< cds::gc::HP, Task*,
+                typename cds::container::chase_lev_deque::make_traits<
+                    cds::opt::stat< cds::container::chase_lev_deque::stat<> >
+                >::type
+            > myDeque;
+            \endcode
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                , Options...
+            >::type type;
+#   endif
+        };
+
+    } // namespace chase_lev_deque
+
+    /// Chase-Lev work-stealing deque
+    /** @ingroup cds_nonintrusive_deque
+        Source:
+        - [2005] David Chase, Yossi Lev. Dynamic Circular Work-Stealing Deque. SPAA'05
+        - [2013] Nhat Minh Le, Antoniu Pop, Albert Cohen, Francesco Zappa Nardelli. Correct and Efficient
+            Work-Stealing for Weak Memory Models. PPoPP'13
+
+        The deque has one owner thread and any number of thief threads. Only the owner can call
+        \p push_bottom() and \p pop_bottom(), these operations are wait-free in the common case
+        and need no atomic read-modify-write instruction except when the deque contains the last item.
+        Any thread may call \p steal() or \p steal_half() to take items from the top end of the deque.
+        Such a deque is the core primitive of a work-stealing task scheduler.
+
+        The items are stored in a growable cyclic array. When the array is full, \p push_bottom()
+        allocates a new array of twice the capacity, copies the items and retires the old array
+        via the garbage collector \p GC since concurrent thieves can still read it.
+        The array never shrinks.
+
+        Template arguments:
+        - \p GC - garbage collector: \p gc::HP or \p gc::DHP. The owner thread and all thieves
+            should be attached to \p GC.
+        - \p T - type of the item. Thieves read the cells of the array concurrently with the owner,
+            so each cell is an <tt>atomics::atomic<T></tt> and \p T must be trivially copyable.
+            For big \p T use a pointer to your task instead, otherwise the atomic cell is not lock-free.
+        - \p Traits - deque traits, default is \p chase_lev_deque::traits. You can use \p chase_lev_deque::make_traits
+            metafunction to make your traits or just derive your traits from \p %chase_lev_deque::traits.
+
+        Example:
+        \code
+        #include <cds/container/chase_lev_deque.h>
+        #include <cds/gc/hp.h>
+
+        typedef cds::container::ChaseLevDeque< cds::gc::HP, Task* > task_deque;
+
+        // owner thread
+        void worker( task_deque& myDeque, task_deque& victim )
+        {
+            Task* t;
+            while ( true ) {
+                if ( !myDeque.pop_bottom( t )) {
+                    // our deque is empty - move a half of the victim's tasks into it
+                    if ( victim.steal_half( [&myDeque]( Task* p ) { myDeque.push_bottom( p ); } ) == 0 )
+                        break;
+                    continue;
+                }
+                t->run();
+            }
+        }
+        \endcode
+    */
+    template <typename GC, typename T, typename Traits = chase_lev_deque::traits>
+    class ChaseLevDeque
+    {
+    public:
+        typedef GC      gc;             ///< Garbage collector
+        typedef T       value_type;     ///< Type of value stored in the deque
+        typedef Traits  traits;         ///< Deque traits
+
+        typedef typename traits::allocator  allocator;  ///< Allocator type used for the internal arrays
+        typedef typename traits::back_off   back_off;   ///< Back-off strategy used
+        typedef typename traits::stat       stat;       ///< Internal statistics type
+
+        /// Rebind template arguments
+        template <typename GC2, typename T2, typename Traits2>
+        struct rebind {
+            typedef ChaseLevDeque< GC2, T2, Traits2 > other;   ///< Rebinding result
+        };
+
+#if !( (CDS_COMPILER == CDS_COMPILER_GCC) && (CDS_COMPILER_VERSION < 50000))
+        // libstdc++ of g++ 4.x has no std::is_trivially_copyable
+        static_assert( std::is_trivially_copyable<value_type>::value, "T must be trivially copyable since steal() reads the cells concurrently with the owner" );
+#endif
+
+        static CDS_CONSTEXPR const size_t c_nHazardPtrCount = 1; ///< Count of hazard pointer required for the algorithm
+
+        //@cond
+        // Only for tests
+        typedef size_t item_counter;
+        //@endcond
+
+    protected:
+        //@cond
+        typedef std::make_signed<size_t>::type  index_type;
+        typedef atomics::atomic<value_type>     cell_type;
+
+        struct cell_array
+        {
+            size_t const    nCapacity;  // power of 2
+            cell_type *     pCells;
+
+            cell_array( size_t nCap, cell_type * pArr )
+                : nCapacity( nCap )
+                , pCells( pArr )
+            {}
+
+            cell_type& operator[]( index_type i ) const
+            {
+                return pCells[ static_cast<size_t>( i ) & ( nCapacity - 1 )];
+            }
+
+            value_type get( index_type i ) const
+            {
+                return (*this)[i].load( atomics::memory_order_relaxed );
+            }
+
+            void put( index_type i, value_type v ) const
+            {
+                (*this)[i].store( v, atomics::memory_order_relaxed );
+            }
+        };
+
+        typedef cds::details::Allocator< cell_array, allocator > array_allocator;
+        typedef cds::details::Allocator< cell_type, allocator >  cell_allocator;
+
+        static cell_array * alloc_array( size_t nCapacity )
+        {
+            return array_allocator().New( nCapacity, cell_allocator().NewArray( nCapacity ));
+        }
+
+        static void free_array( cell_array * p )
+        {
+            cell_allocator().Delete( p->pCells, p->nCapacity );
+            array_allocator().Delete( p );
+        }
+
+        struct array_disposer {
+            void operator()( cell_array * p ) const
+            {
+                free_array( p );
+            }
+        };
+        //@endcond
+
+    public:
+        /// Constructs empty deque
+        /**
+            \p nInitialCapacity is the initial capacity of the internal cyclic array.
+            It is rounded up to nearest power of two.
+        */
+        ChaseLevDeque( size_t nInitialCapacity = 64 )
+            : m_nTop( 0 )
+            , m_nBottom( 0 )
+            , m_pArray( alloc_array( beans::ceil2( nInitialCapacity < 2 ? 2 : nInitialCapacity )))
+        {}
+
+        /// \p %ChaseLevDeque is not copy-constructible
+        ChaseLevDeque( ChaseLevDeque const& ) = delete;
+
+        /// Destroys the deque
+        /**
+            No thief can access the deque when the destructor is called.
+        */
+        ~ChaseLevDeque()
+        {
+            free_array( m_pArray.load( atomics::memory_order_relaxed ));
+        }
+
+        /// Pushes \p val to the bottom of the deque (owner only)
+        /**
+            If the internal array is full, it is doubled; the old array is retired via \p GC.
+            The function always returns \p true.
+        */
+        bool push_bottom( value_type val )
+        {
+            index_type b = m_nBottom.load( atomics::memory_order_relaxed );
+            index_type t = m_nTop.load( atomics::memory_order_acquire );
+            cell_array * a = m_pArray.load( atomics::memory_order_relaxed );
+
+            if ( b - t > static_cast<index_type>( a->nCapacity ) - 1 )
+                a = grow( a, t, b );
+
+            a->put( b, val );
+            atomics::atomic_thread_fence( atomics::memory_order_release );
+            m_nBottom.store( b + 1, atomics::memory_order_relaxed );
+
+            m_Stat.onPush();
+            return true;
+        }
+
+        /// Pops an item from the bottom of the deque (owner only)
+        /**
+            If the deque is empty the function returns \p false, \p val is unchanged.
+        */
+        bool pop_bottom( value_type& val )
+        {
+            index_type b = m_nBottom.load( atomics::memory_order_relaxed ) - 1;
+            cell_array * a = m_pArray.load( atomics::memory_order_relaxed );
+            m_nBottom.store( b, atomics::memory_order_relaxed );
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            index_type t = m_nTop.load( atomics::memory_order_relaxed );
+
+            if ( t > b ) {
+                // the deque is empty
+                m_nBottom.store( b + 1, atomics::memory_order_relaxed );
+                m_Stat.onEmptyPop();
+                return false;
+            }
+
+            value_type v = a->get( b );
+            if ( t == b ) {
+                // The last item - compete with thieves
+                bool bSuccess = m_nTop.compare_exchange_strong( t, t + 1, atomics::memory_order_seq_cst, atomics::memory_order_relaxed );
+                m_nBottom.store( b + 1, atomics::memory_order_relaxed );
+                if ( !bSuccess ) {
+                    m_Stat.onPopRace();
+                    return false;
+                }
+            }
+
+            val = v;
+            m_Stat.onPop();
+            return true;
+        }
+
+        /// Steals an item from the top of the deque
+        /**
+            The function can be called by any thread including the owner.
+            Returns \p false if the deque is empty.
+        */
+        bool steal( value_type& val )
+        {
+            typename gc::Guard guard;
+            back_off bkoff;
+
+            while ( true ) {
+                switch ( try_steal( guard, val )) {
+                case steal_success:
+                    m_Stat.onSteal();
+                    return true;
+                case steal_empty:
+                    m_Stat.onEmptySteal();
+                    return false;
+                default:
+                    m_Stat.onStealRace();
+                    bkoff();
+                }
+            }
+        }
+
+        /// Steals up to a half of items from the top of the deque
+        /**
+            The function is intended for load balancing: a thief that has found its own deque empty
+            moves a half of the victim's items to itself in one call.
+            For each stolen item, in the order from the top to the bottom, functor \p f is called:
+            \code
+            void f( value_type val );
+            \endcode
+
+            The items are taken one by one with the same protocol as \p steal() does:
+            claiming a range of items with one CAS on the top index is not safe since
+            the owner removes items from the bottom without any atomic RMW.
+            The function stops on the first race with another thief or with the owner,
+            so the deque is never blocked by a thief.
+
+            Returns the number of stolen items.
+        */
+        template <typename Func>
+        size_t steal_half( Func f )
+        {
+            return do_steal_half( f, std::numeric_limits<size_t>::max());
+        }
+
+        /// Steals up to a half of items from the top of the deque into array \p arr of size \p nMax
+        /**
+            Returns the number of stolen items. See \p steal_half( Func ) for details.
+        */
+        size_t steal_half( value_type * arr, size_t nMax )
+        {
+            size_t n = 0;
+            return do_steal_half( [arr, &n]( value_type v ) { arr[n++] = v; }, nMax );
+        }
+
+        /// Clears the deque (owner only)
+        void clear()
+        {
+            value_type v;
+            while ( pop_bottom( v ));
+        }
+
+        /// Checks if the deque is empty
+        /**
+            The result is a snapshot and can be out of date when returned if thieves work concurrently.
+        */
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// Returns the approximate number of items in the deque
+        size_t size() const
+        {
+            index_type b = m_nBottom.load( atomics::memory_order_relaxed );
+            index_type t = m_nTop.load( atomics::memory_order_relaxed );
+            return b > t ? static_cast<size_t>( b - t ) : 0;
+        }
+
+        /// Returns current capacity of the internal array
+        size_t capacity() const
+        {
+            return m_pArray.load( atomics::memory_order_relaxed )->nCapacity;
+        }
+
+        /// Returns reference to internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+    protected:
+        //@cond
+        enum steal_result {
+            steal_success,
+            steal_empty,
+            steal_race
+        };
+
+        steal_result try_steal( typename gc::Guard& guard, value_type& val )
+        {
+            index_type t = m_nTop.load( atomics::memory_order_acquire );
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            index_type b = m_nBottom.load( atomics::memory_order_acquire );
+
+            if ( t >= b )
+                return steal_empty;
+
+            // The array loaded after the bottom contains the cell t, or t has been stolen already
+            cell_array * a = guard.protect( m_pArray );
+            value_type v = a->get( t );
+            if ( !m_nTop.compare_exchange_strong( t, t + 1, atomics::memory_order_seq_cst, atomics::memory_order_relaxed ))
+                return steal_race;
+
+            val = v;
+            return steal_success;
+        }
+
+        template <typename Func>
+        size_t do_steal_half( Func f, size_t nMax )
+        {
+            typename gc::Guard guard;
+
+            index_type t = m_nTop.load( atomics::memory_order_acquire );
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            index_type b = m_nBottom.load( atomics::memory_order_acquire );
+            if ( t >= b ) {
+                m_Stat.onEmptySteal();
+                return 0;
+            }
+
+            size_t nHalf = static_cast<size_t>( b - t + 1 ) / 2;
+            if ( nHalf > nMax )
+                nHalf = nMax;
+
+            size_t nStolen = 0;
+            value_type v;
+            while ( nStolen < nHalf ) {
+                steal_result res = try_steal( guard, v );
+                if ( res != steal_success ) {
+                    if ( res == steal_race )
+                        m_Stat.onStealRace();
+                    break;
+                }
+                m_Stat.onSteal();
+                ++nStolen;
+                f( v );
+            }
+
+            if ( nStolen )
+                m_Stat.onStealHalf();
+            return nStolen;
+        }
+
+        cell_array * grow( cell_array * pOld, index_type t, index_type b )
+        {
+            cell_array * pNew = alloc_array( pOld->nCapacity * 2 );
+            for ( index_type i = t; i < b; ++i )
+                pNew->put( i, pOld->get( i ));
+
+            m_pArray.store( pNew, atomics::memory_order_release );
+            gc::template retire<array_disposer>( pOld );
+
+            m_Stat.onGrow();
+            return pNew;
+        }
+        //@endcond
+
+    private:
+        //@cond
+        atomics::atomic<index_type>   m_nTop;
+        typename opt::details::apply_padding< atomics::atomic<index_type>, traits::padding >::padding_type pad1_;
+        atomics::atomic<index_type>   m_nBottom;
+        typename opt::details::apply_padding< atomics::atomic<index_type>, traits::padding >::padding_type pad2_;
+        atomics::atomic<cell_array *> m_pArray;
+        stat                          m_Stat;
+        //@endcond
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_CHASE_LEV_DEQUE_H
@@ -0,0 +1,459 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_DETAILS_FC_ASSOCIATIVE_H
+#define CDSLIB_CONTAINER_DETAILS_FC_ASSOCIATIVE_H
+
+#include <cds/algo/flat_combining.h>
+#include <vector>
+#include <algorithm>
+
+namespace cds { namespace container {
+
+    //@cond
+    namespace details {
+
+        /// Internal statistics of flat-combining associative containers
+        template <typename Counter = cds::atomicity::event_counter >
+        struct fc_associative_stat: public cds::algo::flat_combining::stat<Counter>
+        {
+            typedef cds::algo::flat_combining::stat<Counter>    flat_combining_stat; ///< Flat-combining statistics
+            typedef typename flat_combining_stat::counter_type  counter_type;        ///< Counter type
+
+            counter_type    m_nInsertSuccess;   ///< Count of success \p insert() operations
+            counter_type    m_nInsertFailed;    ///< Count of failed \p insert() operations (the key already exists)
+            counter_type    m_nUpdateNew;       ///< Count of \p update() operations that have inserted new item
+            counter_type    m_nUpdateExisting;  ///< Count of \p update() operations that have found an existing item
+            counter_type    m_nUpdateFailed;    ///< Count of failed \p update() operations (the key is not found and inserting is not allowed)
+            counter_type    m_nEraseSuccess;    ///< Count of success \p erase() operations
+            counter_type    m_nEraseFailed;     ///< Count of failed \p erase() operations (the key is not found)
+            counter_type    m_nFindSuccess;     ///< Count of success \p find() / \p contains() operations
+            counter_type    m_nFindFailed;      ///< Count of failed \p find() / \p contains() operations
+            counter_type    m_nBatchCount;      ///< Count of sorted batches processed by a combiner
+            counter_type    m_nBatchedOps;      ///< Count of operations processed in sorted batches
+            counter_type    m_nSharedLookup;    ///< Count of batched operations that have reused the lookup of the preceding request with the same key
+
+            //@cond
+            void onInsert( bool bOk )       { if ( bOk ) ++m_nInsertSuccess; else ++m_nInsertFailed; }
+            void onUpdate( std::pair<bool, bool> res )
+            {
+                if ( !res.first )
+                    ++m_nUpdateFailed;
+                else if ( res.second )
+                    ++m_nUpdateNew;
+                else
+                    ++m_nUpdateExisting;
+            }
+            void onErase( bool bOk )        { if ( bOk ) ++m_nEraseSuccess; else ++m_nEraseFailed; }
+            void onFind( bool bOk )         { if ( bOk ) ++m_nFindSuccess; else ++m_nFindFailed; }
+            void onBatch( size_t nSize )    { ++m_nBatchCount; m_nBatchedOps += nSize; }
+            void onSharedLookup()           { ++m_nSharedLookup; }
+            //@endcond
+        };
+
+        /// Dummy statistics of flat-combining associative containers, no overhead
+        struct fc_associative_empty_stat: public cds::algo::flat_combining::empty_stat
+        {
+            //@cond
+            void onInsert( bool )                   {}
+            void onUpdate( std::pair<bool, bool> )  {}
+            void onErase( bool )                    {}
+            void onFind( bool )                     {}
+            void onBatch( size_t )                  {}
+            void onSharedLookup()                   {}
+            //@endcond
+        };
+
+        template <typename T>
+        struct fc_void {
+            typedef void type;
+        };
+
+        // Key order of a batch for hash-based containers: by hash value; equal keys are adjacent
+        // if there is no collision
+        template <class Container, class = void>
+        struct fc_hash_batch_order
+        {
+            static CDS_CONSTEXPR const bool enabled = false;
+
+            explicit fc_hash_batch_order( Container const& )
+            {}
+
+            template <typename Key>
+            bool less( Key const&, Key const& ) const
+            {
+                return false;
+            }
+
+            template <typename Key>
+            bool equal( Key const&, Key const& ) const
+            {
+                return false;
+            }
+        };
+
+        template <class Container>
+        struct fc_hash_batch_order< Container, typename fc_void< typename Container::hasher >::type >
+        {
+            static CDS_CONSTEXPR const bool enabled = true;
+
+            typename Container::hasher      m_Hash;
+            typename Container::key_equal   m_Equal;
+
+            explicit fc_hash_batch_order( Container const& c )
+                : m_Hash( c.hash_function())
+                , m_Equal( c.key_eq())
+            {}
+
+            template <typename Key>
+            bool less( Key const& k1, Key const& k2 ) const
+            {
+                return m_Hash( k1 ) < m_Hash( k2 );
+            }
+
+            template <typename Key>
+            bool equal( Key const& k1, Key const& k2 ) const
+            {
+                return m_Equal( k1, k2 );
+            }
+        };
+
+        // Key order of a batch: ordered containers use their comparator, hash-based containers use hasher,
+        // other containers are not sorted
+        template <class Container, class = void>
+        struct fc_batch_order: public fc_hash_batch_order< Container >
+        {
+            explicit fc_batch_order( Container const& c )
+                : fc_hash_batch_order< Container >( c )
+            {}
+        };
+
+        template <class Container>
+        struct fc_batch_order< Container, typename fc_void< typename Container::key_compare >::type >
+        {
+            static CDS_CONSTEXPR const bool enabled = true;
+
+            typename Container::key_compare m_Less;
+
+            explicit fc_batch_order( Container const& c )
+                : m_Less( c.key_comp())
+            {}
+
+            template <typename Key>
+            bool less( Key const& k1, Key const& k2 ) const
+            {
+                return m_Less( k1, k2 );
+            }
+
+            template <typename Key>
+            bool equal( Key const& k1, Key const& k2 ) const
+            {
+                return !m_Less( k1, k2 ) && !m_Less( k2, k1 );
+            }
+        };
+
+        /// Flat-combining wrapper for sequential associative containers
+        /**
+            The class is the common base of \p FCSet and \p FCMap.
+
+            Template parameters:
+            - \p Container - sequential set or map. The container should provide \p find(key_type const&),
+                \p insert(value_type&&) returning <tt>std::pair<iterator, bool></tt>, \p erase(iterator),
+                \p clear(), \p size(), \p empty(), \p begin() and \p end()
+            - \p Traits - flat combining traits with \p stat of \p fc_associative_stat interface
+                and \p parallel_combining flag
+            - \p ValueMaker - a functor that makes container's \p value_type from \p key_type
+        */
+        template <class Container, typename Traits, class ValueMaker>
+        class fc_associative
+#ifndef CDS_DOXYGEN_INVOKED
+            : public cds::algo::flat_combining::container
+#endif
+        {
+        public:
+            typedef Container                               container_type; ///< Sequential container
+            typedef typename container_type::key_type       key_type;       ///< Key type
+            typedef typename container_type::value_type     value_type;     ///< Value type
+            typedef Traits                                  traits;         ///< Type traits
+            typedef typename traits::stat                   stat;           ///< Internal statistics
+
+        protected:
+            //@cond
+            typedef typename container_type::iterator       container_iterator;
+            typedef fc_batch_order< container_type >        batch_order;
+
+            enum fc_operation {
+                op_insert = cds::algo::flat_combining::req_Operation,
+                op_update,
+                op_erase,
+                op_find,
+                op_clear
+            };
+
+            struct fc_record: public cds::algo::flat_combining::publication_record
+            {
+                key_type const* pKey;                           // key of the operation
+                void*           pFunc;                          // user functor
+                void (*         fnInvoke)( void*, bool, value_type& ); // functor invoker
+                bool            bAllowInsert;                   // update(): insert if the key is not found
+                bool            bResult;                        // operation result
+                bool            bNew;                           // true if new item has been inserted
+            };
+
+            typedef typename cds::algo::flat_combining::make_kernel< fc_record, traits >::type fc_kernel;
+            //@endcond
+
+        protected:
+            //@cond
+            mutable fc_kernel           m_FlatCombining;
+            container_type              m_Container;
+            std::vector< fc_record* >   m_Batch;    // combiner's buffer for sorting the publication list
+            //@endcond
+
+        protected:
+            //@cond
+            fc_associative()
+            {}
+
+            fc_associative( unsigned int nCompactFactor, unsigned int nCombinePassCount )
+                : m_FlatCombining( nCompactFactor, nCombinePassCount )
+            {}
+
+            template <typename Func>
+            static void invoke( void* pFunc, bool bNew, value_type& item )
+            {
+                ( *reinterpret_cast<Func*>( pFunc ))( bNew, item );
+            }
+
+            template <typename Func>
+            std::pair<bool, bool> execute( unsigned int nOp, key_type const& key, Func& f, bool bAllowInsert = false )
+            {
+                auto pRec = m_FlatCombining.acquire_record();
+                pRec->pKey = &key;
+                pRec->pFunc = reinterpret_cast<void*>( &f );
+                pRec->fnInvoke = &invoke<Func>;
+                pRec->bAllowInsert = bAllowInsert;
+
+                if ( traits::parallel_combining )
+                    m_FlatCombining.parallel_combine( nOp, pRec, *this );
+                else
+                    m_FlatCombining.batch_combine( nOp, pRec, *this );
+
+                assert( pRec->is_done());
+                std::pair<bool, bool> res( pRec->bResult, pRec->bNew );
+                m_FlatCombining.release_record( pRec );
+                return res;
+            }
+            //@endcond
+
+        public:
+            /// Clears the container
+            void clear()
+            {
+                auto pRec = m_FlatCombining.acquire_record();
+
+                m_FlatCombining.combine( op_clear, pRec, *this );
+
+                assert( pRec->is_done());
+                m_FlatCombining.release_record( pRec );
+            }
+
+            /// Returns the number of items in the container
+            /**
+                Note that <tt>size() == 0</tt> does not mean that the container is empty because
+                combining record can be in process.
+                To check emptiness use \ref empty function.
+            */
+            size_t size() const
+            {
+                return m_Container.size();
+            }
+
+            /// Checks if the container is empty
+            /**
+                If the combining is in process the function waits while combining done.
+            */
+            bool empty() const
+            {
+                bool bRet = false;
+                auto const& c = m_Container;
+                m_FlatCombining.invoke_exclusive( [&c, &bRet]() { bRet = c.empty(); } );
+                return bRet;
+            }
+
+            /// Internal statistics
+            stat const& statistics() const
+            {
+                return m_FlatCombining.statistics();
+            }
+
+        public: // flat combining cooperation, not for direct use!
+            //@cond
+            /*
+                The function is called by \ref cds::algo::flat_combining::kernel "flat combining kernel"
+                object if the current thread becomes a combiner. Invocation of the function means that
+                the container should perform an action recorded in \p pRec.
+            */
+            void fc_apply( fc_record * pRec )
+            {
+                assert( pRec );
+
+                if ( pRec->op() == op_clear ) {
+                    m_Container.clear();
+                    return;
+                }
+
+                assert( pRec->pKey );
+                container_iterator it = m_Container.find( *pRec->pKey );
+                apply( *pRec, it, it != m_Container.end());
+            }
+
+            /*
+                Parallel combining: lookups do not change the container, so the combiner
+                delegates them to the waiting threads
+            */
+            bool fc_can_delegate( fc_record const& rec ) const
+            {
+                return rec.op() == op_find;
+            }
+
+            /*
+                Batch processing: the combiner collects all pending keyed requests, sorts them by key
+                and applies them in that order, so consecutive lookups touch neighbouring nodes
+                (ordered containers) or the same bucket chain (hash containers).
+                Requests with equal keys share one lookup. Pending requests of different threads
+                are concurrent, so any order of them is linearizable.
+            */
+            void fc_process( typename fc_kernel::iterator itBegin, typename fc_kernel::iterator itEnd )
+            {
+                if ( !batch_order::enabled )
+                    return;
+
+                m_Batch.clear();
+                for ( auto it = itBegin; it != itEnd; ++it ) {
+                    switch ( it->op( atomics::memory_order_acquire )) {
+                    case op_insert:
+                    case op_update:
+                    case op_erase:
+                    case op_find:
+                        m_Batch.push_back( &*it );
+                        break;
+                    }
+                }
+
+                // A single request is applied by the ordinary combining pass
+                size_t const nSize = m_Batch.size();
+                if ( nSize < 2 )
+                    return;
+
+                batch_order order( m_Container );
+                std::sort( m_Batch.begin(), m_Batch.end(), [&order]( fc_record const* r1, fc_record const* r2 ) {
+                    return order.less( *r1->pKey, *r2->pKey );
+                });
+
+                for ( size_t i = 0; i < nSize; ) {
+                    // The key belongs to the waiting thread and becomes invalid when its request is done,
+                    // so find the group of equal keys first
+                    size_t nLast = i + 1;
+                    while ( nLast < nSize && order.equal( *m_Batch[i]->pKey, *m_Batch[nLast]->pKey ))
+                        ++nLast;
+
+                    container_iterator it = m_Container.find( *m_Batch[i]->pKey );
+                    bool bFound = it != m_Container.end();
+                    for ( size_t k = i; k < nLast; ++k ) {
+                        bFound = apply( *m_Batch[k], it, bFound );
+                        m_FlatCombining.operation_done( *m_Batch[k] );
+                        if ( k != i )
+                            m_FlatCombining.internal_statistics().onSharedLookup();
+                    }
+                    i = nLast;
+                }
+
+                m_FlatCombining.internal_statistics().onBatch( nSize );
+            }
+            //@endcond
+
+        private:
+            //@cond
+            // Applies the request to the item pointed by it (if bFound).
+            // Returns true if the item with the key of rec is in the container after the request
+            bool apply( fc_record& rec, container_iterator& it, bool bFound )
+            {
+                rec.bNew = false;
+                switch ( rec.op()) {
+                case op_insert:
+                    rec.bResult = !bFound;
+                    if ( !bFound ) {
+                        it = m_Container.insert( ValueMaker()( *rec.pKey )).first;
+                        rec.fnInvoke( rec.pFunc, true, const_cast<value_type&>( *it ));
+                        rec.bNew = bFound = true;
+                    }
+                    break;
+                case op_update:
+                    if ( bFound ) {
+                        rec.fnInvoke( rec.pFunc, false, const_cast<value_type&>( *it ));
+                        rec.bResult = true;
+                    }
+                    else if ( rec.bAllowInsert ) {
+                        it = m_Container.insert( ValueMaker()( *rec.pKey )).first;
+                        rec.fnInvoke( rec.pFunc, true, const_cast<value_type&>( *it ));
+                        rec.bResult = rec.bNew = bFound = true;
+                    }
+                    else
+                        rec.bResult = false;
+                    break;
+                case op_erase:
+                    rec.bResult = bFound;
+                    if ( bFound ) {
+                        rec.fnInvoke( rec.pFunc, false, const_cast<value_type&>( *it ));
+                        m_Container.erase( it );
+                        bFound = false;
+                    }
+                    break;
+                case op_find:
+                    rec.bResult = bFound;
+                    if ( bFound )
+                        rec.fnInvoke( rec.pFunc, false, const_cast<value_type&>( *it ));
+                    break;
+                default:
+                    assert( false );
+                    break;
+                }
+                return bFound;
+            }
+            //@endcond
+        };
+
+    } // namespace details
+    //@endcond
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_DETAILS_FC_ASSOCIATIVE_H
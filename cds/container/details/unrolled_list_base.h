@@ -0,0 +1,368 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_DETAILS_UNROLLED_LIST_BASE_H
+#define CDSLIB_CONTAINER_DETAILS_UNROLLED_LIST_BASE_H
+
+#include <cds/container/details/base.h>
+#include <cds/algo/atomic.h>
+#include <cds/opt/compare.h>
+#include <cds/details/marked_ptr.h>
+#include <cds/details/make_const_type.h>
+#include <cds/sync/spinlock.h>
+#include <cds/user_setup/cache_line.h>
+
+namespace cds { namespace container {
+
+    /// \p UnrolledList ordered list related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace unrolled_list {
+
+        /// Node capacity option
+        /**
+            @copydetails traits::node_capacity
+        */
+        template <size_t Capacity>
+        struct node_capacity {
+            //@cond
+            template <typename Base> struct pack: public Base
+            {
+                enum: size_t {
+                    node_capacity = Capacity
+                };
+            };
+            //@endcond
+        };
+
+        //@cond
+        static CDS_CONSTEXPR size_t const c_nMinNodeCapacity = 4;
+
+        // Header of an unrolled list node: link, lock and the number of items.
+        // The list head is a node without items.
+        template <class GC, typename Lock>
+        struct node_base
+        {
+            typedef GC      gc;
+            typedef Lock    lock_type;
+
+            typedef cds::details::marked_ptr< node_base, 1 >          marked_ptr;
+            typedef typename gc::template atomic_marked_ptr< marked_ptr > atomic_marked_ptr;
+
+            atomic_marked_ptr   m_pNext;    // next node; the mark means the node is unlinked
+            mutable lock_type   m_Lock;     // node lock
+            size_t              m_nCount;   // item count, immutable after the node has been linked into the list
+
+            node_base()
+                : m_pNext( nullptr )
+                , m_nCount( 0 )
+            {}
+
+            bool is_marked() const
+            {
+                return m_pNext.load( atomics::memory_order_relaxed ).bits() != 0;
+            }
+        };
+
+        // Data node: up to Capacity sorted items stored in-place
+        template <class GC, typename T, typename Lock, size_t Capacity>
+        struct node: public node_base< GC, Lock >
+        {
+            typedef T value_type;
+            static CDS_CONSTEXPR size_t const c_nCapacity = Capacity;
+
+            typename std::aligned_storage< sizeof( value_type ), alignof( value_type ) >::type m_arrData[c_nCapacity];
+
+            node()
+            {}
+
+            node( node const& ) = delete;
+
+            ~node()
+            {
+                for ( size_t i = 0; i < this->m_nCount; ++i )
+                    data( i ).~value_type();
+            }
+
+            value_type& data( size_t i )
+            {
+                assert( i < c_nCapacity );
+                return *reinterpret_cast<value_type *>( &m_arrData[i] );
+            }
+
+            value_type const& data( size_t i ) const
+            {
+                assert( i < c_nCapacity );
+                return *reinterpret_cast<value_type const *>( &m_arrData[i] );
+            }
+
+            // Appends a copy of item to the node under construction
+            template <typename... Args>
+            value_type& push_back( Args&&... args )
+            {
+                assert( this->m_nCount < c_nCapacity );
+                value_type * p = new( &m_arrData[this->m_nCount] ) value_type( std::forward<Args>( args )... );
+                ++this->m_nCount;
+                return *p;
+            }
+        };
+
+        // Default node capacity: as many items as fit into one cache line, but not less than c_nMinNodeCapacity
+        template <class GC, typename T, typename Lock, size_t Capacity>
+        struct select_node_capacity
+        {
+            static CDS_CONSTEXPR size_t const c_nHeaderSize = sizeof( node_base< GC, Lock > );
+            static CDS_CONSTEXPR size_t const c_nFit = c_nCacheLineSize > c_nHeaderSize ? ( c_nCacheLineSize - c_nHeaderSize ) / sizeof( T ) : 0;
+
+            static CDS_CONSTEXPR size_t const value = Capacity != 0
+                ? Capacity
+                : ( c_nFit < c_nMinNodeCapacity ? c_nMinNodeCapacity : c_nFit );
+        };
+        //@endcond
+
+        /// \p UnrolledList internal statistics
+        template <typename EventCounter = cds::atomicity::event_counter>
+        struct stat {
+            typedef EventCounter event_counter; ///< Event counter type
+
+            event_counter   m_nInsertSuccess;   ///< Number of success \p insert() operations
+            event_counter   m_nInsertFailed;    ///< Number of failed \p insert() operations
+            event_counter   m_nInsertRetry;     ///< Number of attempts to insert new item
+            event_counter   m_nUpdateNew;       ///< Number of new item inserted for \p update()
+            event_counter   m_nUpdateExisting;  ///< Number of existing item updates
+            event_counter   m_nUpdateFailed;    ///< Number of failed \p update() call
+            event_counter   m_nUpdateRetry;     ///< Number of attempts to \p update() the item
+            event_counter   m_nEraseSuccess;    ///< Number of successful \p erase(), \p extract() operations
+            event_counter   m_nEraseFailed;     ///< Number of failed \p erase(), \p extract() operations
+            event_counter   m_nEraseRetry;      ///< Number of attempts to \p erase() an item
+            event_counter   m_nFindSuccess;     ///< Number of successful \p find() and \p get() operations
+            event_counter   m_nFindFailed;      ///< Number of failed \p find() and \p get() operations
+
+            event_counter   m_nNodeCreated;     ///< Number of data nodes created (including node copies)
+            event_counter   m_nNodeRemoved;     ///< Number of data nodes unlinked from the list
+            event_counter   m_nNodeSplit;       ///< Number of full node splits
+            event_counter   m_nNodeMerge;       ///< Number of sparse node merges
+            event_counter   m_nValidationFailed; ///< Number of validation failures after locking the nodes
+
+            //@cond
+            void onInsertSuccess()      { ++m_nInsertSuccess;   }
+            void onInsertFailed()       { ++m_nInsertFailed;    }
+            void onInsertRetry()        { ++m_nInsertRetry;     }
+            void onUpdateNew()          { ++m_nUpdateNew;       }
+            void onUpdateExisting()     { ++m_nUpdateExisting;  }
+            void onUpdateFailed()       { ++m_nUpdateFailed;    }
+            void onUpdateRetry()        { ++m_nUpdateRetry;     }
+            void onEraseSuccess()       { ++m_nEraseSuccess;    }
+            void onEraseFailed()        { ++m_nEraseFailed;     }
+            void onEraseRetry()         { ++m_nEraseRetry;      }
+            void onFindSuccess()        { ++m_nFindSuccess;     }
+            void onFindFailed()         { ++m_nFindFailed;      }
+
+            void onNodeCreated()        { ++m_nNodeCreated;     }
+            void onNodeRemoved()        { ++m_nNodeRemoved;     }
+            void onNodeSplit()          { ++m_nNodeSplit;       }
+            void onNodeMerge()          { ++m_nNodeMerge;       }
+            void onValidationFailed()   { ++m_nValidationFailed; }
+            //@endcond
+        };
+
+        /// \p UnrolledList empty internal statistics
+        struct empty_stat {
+            //@cond
+            void onInsertSuccess()      const {}
+            void onInsertFailed()       const {}
+            void onInsertRetry()        const {}
+            void onUpdateNew()          const {}
+            void onUpdateExisting()     const {}
+            void onUpdateFailed()       const {}
+            void onUpdateRetry()        const {}
+            void onEraseSuccess()       const {}
+            void onEraseFailed()        const {}
+            void onEraseRetry()         const {}
+            void onFindSuccess()        const {}
+            void onFindFailed()         const {}
+
+            void onNodeCreated()        const {}
+            void onNodeRemoved()        const {}
+            void onNodeSplit()          const {}
+            void onNodeMerge()          const {}
+            void onValidationFailed()   const {}
+            //@endcond
+        };
+
+        //@cond
+        template <typename Stat = unrolled_list::stat<>>
+        struct wrapped_stat {
+            typedef Stat stat_type;
+
+            wrapped_stat( stat_type& st )
+                : m_stat( st )
+            {}
+
+            void onInsertSuccess()      { m_stat.onInsertSuccess();     }
+            void onInsertFailed()       { m_stat.onInsertFailed();      }
+            void onInsertRetry()        { m_stat.onInsertRetry();       }
+            void onUpdateNew()          { m_stat.onUpdateNew();         }
+            void onUpdateExisting()     { m_stat.onUpdateExisting();    }
+            void onUpdateFailed()       { m_stat.onUpdateFailed();      }
+            void onUpdateRetry()        { m_stat.onUpdateRetry();       }
+            void onEraseSuccess()       { m_stat.onEraseSuccess();      }
+            void onEraseFailed()        { m_stat.onEraseFailed();       }
+            void onEraseRetry()         { m_stat.onEraseRetry();        }
+            void onFindSuccess()        { m_stat.onFindSuccess();       }
+            void onFindFailed()         { m_stat.onFindFailed();        }
+
+            void onNodeCreated()        { m_stat.onNodeCreated();       }
+            void onNodeRemoved()        { m_stat.onNodeRemoved();       }
+            void onNodeSplit()          { m_stat.onNodeSplit();         }
+            void onNodeMerge()          { m_stat.onNodeMerge();         }
+            void onValidationFailed()   { m_stat.onValidationFailed();  }
+
+            stat_type& m_stat;
+        };
+
+        template <typename Stat>
+        struct select_stat_wrapper
+        {
+            typedef Stat stat;
+            typedef unrolled_list::wrapped_stat<Stat> wrapped_stat;
+            enum {
+                empty = false
+            };
+        };
+
+        template <>
+        struct select_stat_wrapper< empty_stat >
+        {
+            typedef empty_stat stat;
+            typedef empty_stat wrapped_stat;
+            enum {
+                empty = true
+            };
+        };
+
+        template <typename Stat>
+        struct select_stat_wrapper< unrolled_list::wrapped_stat<Stat>>: public select_stat_wrapper< Stat >
+        {};
+        //@endcond
+
+        /// \p UnrolledList traits
+        struct traits
+        {
+            /// allocator used to allocate new node
+            typedef CDS_DEFAULT_ALLOCATOR   allocator;
+
+            /// Key comparing functor
+            /**
+                No default functor is provided. If the option is not specified, the \p less is used.
+            */
+            typedef opt::none                       compare;
+
+            /// Specifies binary predicate used for key comparing
+            /**
+                Default is \p std::less<T>.
+            */
+            typedef opt::none                       less;
+
+            /// Maximum number of items stored in one node
+            /**
+                Value \p 0 (the default) means "as many items as fit into one cache line
+                together with the node header", but not less than 4.
+            */
+            static CDS_CONSTEXPR size_t const node_capacity = 0;
+
+            /// Lock type used to lock the nodes
+            /**
+                Default is cds::sync::spin
+            */
+            typedef cds::sync::spin                 lock_type;
+
+            /// back-off strategy used
+            typedef cds::backoff::Default           back_off;
+
+            /// Item counting feature; by default, disabled. Use \p cds::atomicity::item_counter to enable item counting
+            typedef atomicity::empty_item_counter   item_counter;
+
+            /// Internal statistics
+            /**
+                By default, internal statistics is disabled (\p unrolled_list::empty_stat).
+                Use \p unrolled_list::stat to enable it.
+            */
+            typedef empty_stat                      stat;
+
+            /// C++ memory ordering model
+            /**
+                Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
+                or \p opt::v::sequential_consistent (sequentially consistent memory model).
+            */
+            typedef opt::v::relaxed_ordering        memory_model;
+        };
+
+        /// Metafunction converting option list to \p unrolled_list::traits
+        /**
+            \p Options are:
+            - \p opt::compare - key compare functor. No default functor is provided.
+                If the option is not specified, the \p opt::less is used.
+            - \p opt::less - specifies binary predicate used for key compare. Default is \p std::less<T>.
+            - \p unrolled_list::node_capacity - maximum number of items per node.
+                @copydetails traits::node_capacity
+            - \p opt::lock_type - lock type for node-level locking. Default \p is cds::sync::spin. Note that <b>each</b> node
+                of the list has member of type \p lock_type, therefore, heavy-weighted locking primitive is not
+                acceptable as candidate for \p lock_type.
+            - \p opt::back_off - back-off strategy used. If the option is not specified, \p cds::backoff::Default is used.
+            - \p opt::item_counter - the type of item counting feature. Default is disabled (\p atomicity::empty_item_counter).
+                To enable item counting use \p atomicity::item_counter or \p atomicity::cache_friendly_item_counter
+            - \p opt::stat - internal statistics. By default, it is disabled (\p unrolled_list::empty_stat).
+                To enable it use \p unrolled_list::stat
+            - \p opt::allocator - the allocator used for creating and freeing list's nodes. Default is \ref CDS_DEFAULT_ALLOCATOR macro.
+            - \p opt::memory_model - C++ memory ordering model. Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
+                or \p opt::v::sequential_consistent (sequentially consistent memory model).
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type ;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                ,Options...
+            >::type   type;
+#endif
+        };
+
+    } // namespace unrolled_list
+
+    // Forward declarations
+    template <typename GC, typename T, typename Traits=unrolled_list::traits>
+    class UnrolledList;
+
+}}  // namespace cds::container
+
+#endif  // #ifndef CDSLIB_CONTAINER_DETAILS_UNROLLED_LIST_BASE_H
@@ -0,0 +1,379 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_DETAILS_UNROLLED_SKIP_LIST_BASE_H
+#define CDSLIB_CONTAINER_DETAILS_UNROLLED_SKIP_LIST_BASE_H
+
+#include <cds/container/details/base.h>
+#include <cds/container/details/skip_list_base.h>
+#include <cds/opt/compare.h>
+#include <cds/sync/spinlock.h>
+#include <cds/user_setup/cache_line.h>
+
+namespace cds { namespace container {
+
+    /// \p UnrolledSkipListMap related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace unrolled_skip_list {
+
+        /// Chunk capacity option
+        /**
+            @copydetails traits::chunk_capacity
+        */
+        template <size_t Capacity>
+        struct chunk_capacity {
+            //@cond
+            template <typename Base> struct pack: public Base
+            {
+                enum: size_t {
+                    chunk_capacity = Capacity
+                };
+            };
+            //@endcond
+        };
+
+        //@cond
+        static CDS_CONSTEXPR size_t const c_nMinChunkCapacity = 8;
+
+        // Bottom-level node of the skip-list: up to Capacity sorted items stored in-place.
+        // Each chunk except the head covers the key range [low_key(), m_pNext->low_key()).
+        // The chunks are the items of the index skip-list keyed by low_key();
+        // the head chunk has no low key and is never indexed.
+        template <class GC, typename Key, typename T, typename Lock, size_t Capacity>
+        struct chunk: public cds::intrusive::skip_list::node< GC >
+        {
+            typedef Key     key_type;
+            typedef T       value_type;
+            typedef Lock    lock_type;
+            static CDS_CONSTEXPR size_t const c_nCapacity = Capacity;
+
+            mutable lock_type   m_Lock;     // chunk lock
+            chunk *             m_pNext;    // next chunk, guarded by m_Lock
+            size_t              m_nCount;   // item count, guarded by m_Lock
+            bool                m_bRemoved; // the chunk has been unlinked, guarded by m_Lock
+            bool                m_bIndexed; // the chunk is in the index, guarded by the lock of the previous chunk
+            bool const          m_bHead;
+
+            typename std::aligned_storage< sizeof( key_type ), alignof( key_type ) >::type     m_LowKey;
+            typename std::aligned_storage< sizeof( value_type ), alignof( value_type ) >::type m_arrData[c_nCapacity];
+
+            // Head chunk
+            chunk()
+                : m_pNext( nullptr )
+                , m_nCount( 0 )
+                , m_bRemoved( false )
+                , m_bIndexed( false )
+                , m_bHead( true )
+            {}
+
+            explicit chunk( key_type const& lowKey )
+                : m_pNext( nullptr )
+                , m_nCount( 0 )
+                , m_bRemoved( false )
+                , m_bIndexed( false )
+                , m_bHead( false )
+            {
+                new( &m_LowKey ) key_type( lowKey );
+            }
+
+            chunk( chunk const& ) = delete;
+
+            ~chunk()
+            {
+                clear();
+                if ( !m_bHead )
+                    low_key().~key_type();
+            }
+
+            key_type const& low_key() const
+            {
+                assert( !m_bHead );
+                return *reinterpret_cast<key_type const *>( &m_LowKey );
+            }
+
+            value_type& data( size_t i )
+            {
+                assert( i < c_nCapacity );
+                return *reinterpret_cast<value_type *>( &m_arrData[i] );
+            }
+
+            value_type const& data( size_t i ) const
+            {
+                assert( i < c_nCapacity );
+                return *reinterpret_cast<value_type const *>( &m_arrData[i] );
+            }
+
+            bool full() const
+            {
+                return m_nCount == c_nCapacity;
+            }
+
+            // Constructs new item at position nPos shifting the tail right
+            template <typename... Args>
+            value_type& emplace( size_t nPos, Args&&... args )
+            {
+                assert( m_nCount < c_nCapacity );
+                assert( nPos <= m_nCount );
+
+                // Construct the item in the free slot first so that an exception leaves the chunk unchanged
+                new( &m_arrData[m_nCount] ) value_type( std::forward<Args>( args )... );
+                if ( nPos != m_nCount ) {
+                    value_type tmp( std::move( data( m_nCount )));
+                    data( m_nCount ).~value_type();
+                    for ( size_t i = m_nCount; i > nPos; --i )
+                        move_item( i, i - 1 );
+                    new( &m_arrData[nPos] ) value_type( std::move( tmp ));
+                }
+                ++m_nCount;
+                return data( nPos );
+            }
+
+            // Destroys the item at position nPos shifting the tail left
+            void erase( size_t nPos )
+            {
+                assert( nPos < m_nCount );
+
+                data( nPos ).~value_type();
+                for ( size_t i = nPos + 1; i < m_nCount; ++i )
+                    move_item( i - 1, i );
+                --m_nCount;
+            }
+
+            // Moves items [nFrom, m_nCount) to the end of dest
+            void move_to( chunk& dest, size_t nFrom )
+            {
+                assert( nFrom <= m_nCount );
+                assert( dest.m_nCount + m_nCount - nFrom <= c_nCapacity );
+
+                for ( size_t i = nFrom; i < m_nCount; ++i ) {
+                    new( &dest.m_arrData[dest.m_nCount++] ) value_type( std::move( data( i )));
+                    data( i ).~value_type();
+                }
+                m_nCount = nFrom;
+            }
+
+            void clear()
+            {
+                for ( size_t i = 0; i < m_nCount; ++i )
+                    data( i ).~value_type();
+                m_nCount = 0;
+            }
+
+        private:
+            // Moves the item from slot nFrom to free slot nTo
+            void move_item( size_t nTo, size_t nFrom )
+            {
+                new( &m_arrData[nTo] ) value_type( std::move( data( nFrom )));
+                data( nFrom ).~value_type();
+            }
+        };
+
+        // Default chunk capacity: as many items as fit into four cache lines, but not less than c_nMinChunkCapacity
+        template <typename T, size_t Capacity>
+        struct select_chunk_capacity
+        {
+            static CDS_CONSTEXPR size_t const c_nFit = c_nCacheLineSize * 4 / sizeof( T );
+
+            static CDS_CONSTEXPR size_t const value = Capacity != 0
+                ? Capacity
+                : ( c_nFit < c_nMinChunkCapacity ? c_nMinChunkCapacity : c_nFit );
+        };
+        //@endcond
+
+        /// \p UnrolledSkipListMap internal statistics
+        template <typename EventCounter = cds::atomicity::event_counter>
+        struct stat {
+            typedef EventCounter event_counter; ///< Event counter type
+
+            event_counter   m_nInsertSuccess;       ///< Number of success \p insert() operations
+            event_counter   m_nInsertFailed;        ///< Number of failed \p insert() operations
+            event_counter   m_nUpdateNew;           ///< Number of new item inserted for \p update()
+            event_counter   m_nUpdateExisting;      ///< Number of existing item updates
+            event_counter   m_nEraseSuccess;        ///< Number of successful \p erase(), \p extract() operations
+            event_counter   m_nEraseFailed;         ///< Number of failed \p erase(), \p extract() operations
+            event_counter   m_nExtractMinSuccess;   ///< Number of successful \p extract_min() operations
+            event_counter   m_nExtractMinFailed;    ///< Number of \p extract_min() calls for the empty map
+            event_counter   m_nExtractMaxSuccess;   ///< Number of successful \p extract_max() operations
+            event_counter   m_nExtractMaxFailed;    ///< Number of \p extract_max() calls for the empty map
+            event_counter   m_nFindSuccess;         ///< Number of successful \p find() and \p get() operations
+            event_counter   m_nFindFailed;          ///< Number of failed \p find() and \p get() operations
+
+            event_counter   m_nChunkSplit;          ///< Number of full chunk splits
+            event_counter   m_nChunkMerge;          ///< Number of sparse chunk merges
+            event_counter   m_nChunkIndexFailed;    ///< Number of new chunks that have not been added to the index
+            event_counter   m_nChunkRemovedRetry;   ///< Number of retries since the chunk found in the index has been removed
+            event_counter   m_nChunkStepRight;      ///< Number of steps to the right along the bottom level after the index lookup
+
+            //@cond
+            void onInsertSuccess()      { ++m_nInsertSuccess;       }
+            void onInsertFailed()       { ++m_nInsertFailed;        }
+            void onUpdateNew()          { ++m_nUpdateNew;           }
+            void onUpdateExisting()     { ++m_nUpdateExisting;      }
+            void onEraseSuccess()       { ++m_nEraseSuccess;        }
+            void onEraseFailed()        { ++m_nEraseFailed;         }
+            void onExtractMinSuccess()  { ++m_nExtractMinSuccess;   }
+            void onExtractMinFailed()   { ++m_nExtractMinFailed;    }
+            void onExtractMaxSuccess()  { ++m_nExtractMaxSuccess;   }
+            void onExtractMaxFailed()   { ++m_nExtractMaxFailed;    }
+            void onFindSuccess()        { ++m_nFindSuccess;         }
+            void onFindFailed()         { ++m_nFindFailed;          }
+
+            void onChunkSplit()         { ++m_nChunkSplit;          }
+            void onChunkMerge()         { ++m_nChunkMerge;          }
+            void onChunkIndexFailed()   { ++m_nChunkIndexFailed;    }
+            void onChunkRemovedRetry()  { ++m_nChunkRemovedRetry;   }
+            void onChunkStepRight()     { ++m_nChunkStepRight;      }
+            //@endcond
+        };
+
+        /// \p UnrolledSkipListMap empty internal statistics
+        struct empty_stat {
+            //@cond
+            void onInsertSuccess()      const {}
+            void onInsertFailed()       const {}
+            void onUpdateNew()          const {}
+            void onUpdateExisting()     const {}
+            void onEraseSuccess()       const {}
+            void onEraseFailed()        const {}
+            void onExtractMinSuccess()  const {}
+            void onExtractMinFailed()   const {}
+            void onExtractMaxSuccess()  const {}
+            void onExtractMaxFailed()   const {}
+            void onFindSuccess()        const {}
+            void onFindFailed()         const {}
+
+            void onChunkSplit()         const {}
+            void onChunkMerge()         const {}
+            void onChunkIndexFailed()   const {}
+            void onChunkRemovedRetry()  const {}
+            void onChunkStepRight()     const {}
+            //@endcond
+        };
+
+        /// \p UnrolledSkipListMap traits
+        struct traits
+        {
+            /// Allocator used to allocate chunks, index towers and values returned by \p extract() and \p get()
+            typedef CDS_DEFAULT_ALLOCATOR   allocator;
+
+            /// Key comparing functor
+            /**
+                No default functor is provided. If the option is not specified, the \p less is used.
+            */
+            typedef opt::none                       compare;
+
+            /// Specifies binary predicate used for key comparing
+            /**
+                Default is \p std::less<Key>.
+            */
+            typedef opt::none                       less;
+
+            /// Maximum number of items stored in one chunk
+            /**
+                Value \p 0 (the default) means "as many items as fit into four cache lines",
+                but not less than 8.
+            */
+            static CDS_CONSTEXPR size_t const chunk_capacity = 0;
+
+            /// Lock type used to lock the chunks
+            /**
+                Default is cds::sync::spin. For RCU-based map the lock type must support \p try_lock()
+            */
+            typedef cds::sync::spin                 lock_type;
+
+            /// Random level generator of the index skip-list, see \p skip_list::random_level_generator
+            typedef skip_list::turbo32              random_level_generator;
+
+            /// back-off strategy used
+            typedef cds::backoff::Default           back_off;
+
+            /// Item counting feature; by default, disabled. Use \p cds::atomicity::item_counter to enable item counting
+            typedef atomicity::empty_item_counter   item_counter;
+
+            /// Internal statistics
+            /**
+                By default, internal statistics is disabled (\p unrolled_skip_list::empty_stat).
+                Use \p unrolled_skip_list::stat to enable it.
+            */
+            typedef empty_stat                      stat;
+
+            /// C++ memory ordering model
+            /**
+                Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
+                or \p opt::v::sequential_consistent (sequentially consistent memory model).
+            */
+            typedef opt::v::relaxed_ordering        memory_model;
+        };
+
+        /// Metafunction converting option list to \p unrolled_skip_list::traits
+        /**
+            \p Options are:
+            - \p opt::compare - key compare functor. No default functor is provided.
+                If the option is not specified, the \p opt::less is used.
+            - \p opt::less - specifies binary predicate used for key compare. Default is \p std::less<Key>.
+            - \p unrolled_skip_list::chunk_capacity - maximum number of items per chunk.
+                @copydetails traits::chunk_capacity
+            - \p opt::lock_type - lock type for chunk-level locking. Default \p is cds::sync::spin. Note that <b>each</b> chunk
+                has member of type \p lock_type, therefore, heavy-weighted locking primitive is not
+                acceptable as candidate for \p lock_type.
+            - \p skip_list::random_level_generator - random level generator of the index skip-list.
+                Default is \p skip_list::turbo32.
+            - \p opt::back_off - back-off strategy used. If the option is not specified, \p cds::backoff::Default is used.
+            - \p opt::item_counter - the type of item counting feature. Default is disabled (\p atomicity::empty_item_counter).
+                To enable item counting use \p atomicity::item_counter or \p atomicity::cache_friendly_item_counter
+            - \p opt::stat - internal statistics. By default, it is disabled (\p unrolled_skip_list::empty_stat).
+                To enable it use \p unrolled_skip_list::stat
+            - \p opt::allocator - the allocator used for chunks and for values returned by \p extract() and \p get().
+                Default is \ref CDS_DEFAULT_ALLOCATOR macro.
+            - \p opt::memory_model - C++ memory ordering model. Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
+                or \p opt::v::sequential_consistent (sequentially consistent memory model).
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type ;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                ,Options...
+            >::type   type;
+#endif
+        };
+
+    } // namespace unrolled_skip_list
+
+    // Forward declarations
+    template <typename GC, typename Key, typename T, typename Traits=unrolled_skip_list::traits>
+    class UnrolledSkipListMap;
+
+}}  // namespace cds::container
+
+#endif  // #ifndef CDSLIB_CONTAINER_DETAILS_UNROLLED_SKIP_LIST_BASE_H
@@ -0,0 +1,299 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_FCMAP_H
+#define CDSLIB_CONTAINER_FCMAP_H
+
+#include <cds/container/details/fc_associative.h>
+#include <map>
+
+namespace cds { namespace container {
+
+    /// FCMap related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace fcmap {
+
+        /// FCMap internal statistics
+        template <typename Counter = cds::atomicity::event_counter >
+        struct stat: public cds::container::details::fc_associative_stat<Counter>
+        {};
+
+        /// FCMap dummy statistics, no overhead
+        struct empty_stat: public cds::container::details::fc_associative_empty_stat
+        {};
+
+        /// FCMap type traits
+        struct traits: public cds::algo::flat_combining::traits
+        {
+            typedef empty_stat      stat;   ///< Internal statistics
+            static CDS_CONSTEXPR const bool parallel_combining = false; ///< Parallel combining of lookups
+        };
+
+        /// Metafunction converting option list to traits
+        /**
+            \p Options are:
+            - any \p cds::algo::flat_combining::make_traits options
+            - \p opt::stat - internal statistics, possible type: \p fcmap::stat, \p fcmap::empty_stat (the default)
+            - \p opt::parallel_combining - if \p true, the combiner hands pending \p find() / \p contains() requests
+                back to the waiting threads, which execute them concurrently, see \p cds::algo::flat_combining::kernel::parallel_combine().
+                Default is \p false
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type ;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                ,Options...
+            >::type   type;
+#   endif
+        };
+
+        //@cond
+        namespace details {
+            template <typename Key, typename Value>
+            struct make_value
+            {
+                Value operator()( Key const& key ) const
+                {
+                    return Value( key, typename Value::second_type());
+                }
+            };
+        } // namespace details
+        //@endcond
+
+    } // namespace fcmap
+
+    /// Flat-combining map
+    /**
+        @ingroup cds_nonintrusive_map
+        @ingroup cds_flat_combining_container
+
+        \ref cds_flat_combining_description "Flat combining" sequential map.
+        The class can be considered as a concurrent FC-based wrapper for \p std::map, \p std::unordered_map
+        or any other sequential map with similar interface. Flat combining is profitable for small, hot,
+        write-heavy maps like routing tables.
+
+        In batch mode the combiner sorts pending requests by key before applying them: by \p key_compare
+        for ordered maps, by the hash value for hash maps that provide \p hasher and \p key_equal.
+        Requests with equal keys share one lookup. A map that has neither \p key_compare nor \p hasher
+        is processed request by request.
+
+        Template parameters:
+        - \p Key - a key type
+        - \p T - a mapped type, should be default-constructible
+        - \p Map - sequential map implementation, default is \p std::map<Key, T>.
+            The map should provide \p find(), \p insert() returning <tt>std::pair<iterator, bool></tt>,
+            \p erase(iterator), \p clear(), \p size() and \p empty()
+        - \p Traits - type traits of flat combining, default is \p fcmap::traits.
+            \p fcmap::make_traits metafunction can be used to construct \p %fcmap::traits specialization.
+
+        Unlike the lock-free maps of \p libcds, the functors passed to \p %FCMap functions are called
+        by the combiner thread under the combiner lock. Keys of other types should be convertible to \p key_type;
+        \p find_with() / \p erase_with() with an alternative predicate are not supported.
+    */
+    template <typename Key,
+        typename T,
+        class Map = std::map<Key, T>,
+        typename Traits = fcmap::traits
+    >
+    class FCMap
+#ifndef CDS_DOXYGEN_INVOKED
+        : public cds::container::details::fc_associative< Map, Traits, fcmap::details::make_value< Key, typename Map::value_type > >
+#endif
+    {
+        //@cond
+        typedef cds::container::details::fc_associative< Map, Traits, fcmap::details::make_value< Key, typename Map::value_type > > base_class;
+        //@endcond
+    public:
+        typedef Key         key_type;       ///< Key type
+        typedef T           mapped_type;    ///< Mapped type
+        typedef typename Map::value_type value_type; ///< Key-value pair type, <tt>std::pair<key_type const, mapped_type></tt>
+        typedef Map         map_type;       ///< Sequential map class
+        typedef Traits      traits;         ///< Map type traits
+
+        typedef typename traits::stat  stat;   ///< Internal statistics type
+
+        static_assert( std::is_same< key_type, typename map_type::key_type >::value, "Key must be the key type of Map" );
+        static_assert( std::is_same< mapped_type, typename map_type::mapped_type >::value, "T must be the mapped type of Map" );
+
+    protected:
+        //@cond
+        using base_class::m_FlatCombining;
+        //@endcond
+
+    public:
+        /// Initializes empty map object
+        FCMap()
+        {}
+
+        /// Initializes empty map object and gives flat combining parameters
+        FCMap(
+            unsigned int nCompactFactor     ///< Flat combining: publication list compacting factor
+            ,unsigned int nCombinePassCount ///< Flat combining: number of combining passes for combiner thread
+            )
+            : base_class( nCompactFactor, nCombinePassCount )
+        {}
+
+        /// Inserts new item with key \p key and default value
+        /**
+            \p key_type should be constructible from a value of type \p K.
+
+            Returns \p true if inserting successful, \p false otherwise.
+        */
+        template <typename K>
+        bool insert( K const& key )
+        {
+            return insert_with( key, []( value_type& ) {} );
+        }
+
+        /// Inserts new item
+        /**
+            The function creates an item with key \p key and value \p val and inserts it into the map.
+            - \p key_type should be constructible from \p key of type \p K.
+            - \p mapped_type should be assignable from \p val of type \p V.
+
+            Returns \p true if \p val is inserted into the map, \p false otherwise.
+        */
+        template <typename K, typename V>
+        bool insert( K const& key, V const& val )
+        {
+            return insert_with( key, [&val]( value_type& item ) { item.second = val; } );
+        }
+
+        /// Inserts new item and initializes it by a functor
+        /**
+            This function inserts new item with key \p key and if inserting is successful then it calls
+            \p func functor with signature
+            \code
+                void func( value_type& item );
+            \endcode
+            The functor is called by the combiner thread.
+        */
+        template <typename K, typename Func>
+        bool insert_with( K const& key, Func func )
+        {
+            key_type k( key );
+            auto f = [&func]( bool, value_type& item ) { func( item ); };
+            bool const bRet = base_class::execute( base_class::op_insert, k, f ).first;
+            m_FlatCombining.internal_statistics().onInsert( bRet );
+            return bRet;
+        }
+
+        /// Updates the item
+        /**
+            If \p key is not found in the map, then \p key is inserted iff \p bAllowInsert is \p true.
+            Otherwise, the functor \p func is called with item found.
+
+            The functor signature is:
+            \code
+                void func( bool bNew, value_type& item );
+            \endcode
+            with arguments:
+            - \p bNew - \p true if the item has been inserted, \p false otherwise
+            - \p item - item of the map
+
+            The functor is called by the combiner thread.
+
+            Returns <tt> std::pair<bool, bool> </tt> where \p first is true if operation is successful,
+            \p second is true if new item has been added or \p false if the item with \p key
+            already is in the map.
+        */
+        template <typename K, typename Func>
+        std::pair<bool, bool> update( K const& key, Func func, bool bAllowInsert = true )
+        {
+            key_type k( key );
+            std::pair<bool, bool> res = base_class::execute( base_class::op_update, k, func, bAllowInsert );
+            m_FlatCombining.internal_statistics().onUpdate( res );
+            return res;
+        }
+
+        /// Deletes \p key from the map
+        /**
+            Returns \p true if \p key is found and deleted, \p false otherwise.
+        */
+        template <typename K>
+        bool erase( K const& key )
+        {
+            return erase( key, []( value_type& ) {} );
+        }
+
+        /// Deletes \p key from the map and calls \p f for the item deleted
+        /**
+            The functor \p f is called by the combiner thread just before the item is removed:
+            \code
+                void func( value_type& item );
+            \endcode
+        */
+        template <typename K, typename Func>
+        bool erase( K const& key, Func f )
+        {
+            key_type k( key );
+            auto func = [&f]( bool, value_type& item ) { f( item ); };
+            bool const bRet = base_class::execute( base_class::op_erase, k, func ).first;
+            m_FlatCombining.internal_statistics().onErase( bRet );
+            return bRet;
+        }
+
+        /// Finds \p key and calls \p f for the item found
+        /**
+            The functor signature is:
+            \code
+                void func( value_type& item );
+            \endcode
+            The functor may change <tt>item.second</tt>. It is called by the combiner thread.
+            If \p opt::parallel_combining is enabled, the functor may be called concurrently by several threads
+            for the same item, so it should not change the item.
+
+            Returns \p true if \p key is found, \p false otherwise.
+        */
+        template <typename K, typename Func>
+        bool find( K const& key, Func f )
+        {
+            key_type k( key );
+            auto func = [&f]( bool, value_type& item ) { f( item ); };
+            bool const bRet = base_class::execute( base_class::op_find, k, func ).first;
+            m_FlatCombining.internal_statistics().onFind( bRet );
+            return bRet;
+        }
+
+        /// Checks whether the map contains \p key
+        template <typename K>
+        bool contains( K const& key )
+        {
+            return find( key, []( value_type& ) {} );
+        }
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_FCMAP_H
@@ -157,7 +157,7 @@ namespace cds { namespace container {
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename cds::algo::flat_combining::make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
@@ -0,0 +1,295 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_FCSET_H
+#define CDSLIB_CONTAINER_FCSET_H
+
+#include <cds/container/details/fc_associative.h>
+#include <set>
+
+namespace cds { namespace container {
+
+    /// FCSet related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace fcset {
+
+        /// FCSet internal statistics
+        template <typename Counter = cds::atomicity::event_counter >
+        struct stat: public cds::container::details::fc_associative_stat<Counter>
+        {};
+
+        /// FCSet dummy statistics, no overhead
+        struct empty_stat: public cds::container::details::fc_associative_empty_stat
+        {};
+
+        /// FCSet type traits
+        struct traits: public cds::algo::flat_combining::traits
+        {
+            typedef empty_stat      stat;   ///< Internal statistics
+            static CDS_CONSTEXPR const bool parallel_combining = false; ///< Parallel combining of lookups
+        };
+
+        /// Metafunction converting option list to traits
+        /**
+            \p Options are:
+            - any \p cds::algo::flat_combining::make_traits options
+            - \p opt::stat - internal statistics, possible type: \p fcset::stat, \p fcset::empty_stat (the default)
+            - \p opt::parallel_combining - if \p true, the combiner hands pending \p find() / \p contains() requests
+                back to the waiting threads, which execute them concurrently, see \p cds::algo::flat_combining::kernel::parallel_combine().
+                Default is \p false
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type ;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                ,Options...
+            >::type   type;
+#   endif
+        };
+
+        //@cond
+        namespace details {
+            template <typename Value>
+            struct make_value
+            {
+                Value operator()( Value const& key ) const
+                {
+                    return key;
+                }
+            };
+        } // namespace details
+        //@endcond
+
+    } // namespace fcset
+
+    /// Flat-combining set
+    /**
+        @ingroup cds_nonintrusive_set
+        @ingroup cds_flat_combining_container
+
+        \ref cds_flat_combining_description "Flat combining" sequential set.
+        The class can be considered as a concurrent FC-based wrapper for \p std::set, \p std::unordered_set
+        or any other sequential set with similar interface. Flat combining is profitable for small, hot,
+        write-heavy sets where one combiner applying the requests of all threads
+        beats fine-grained synchronization.
+
+        In batch mode the combiner sorts pending requests by key before applying them: by \p key_compare
+        for ordered sets, by the hash value for hash sets that provide \p hasher and \p key_equal.
+        Requests with equal keys share one lookup. A set that has neither \p key_compare nor \p hasher
+        is processed request by request.
+
+        Template parameters:
+        - \p T - a value type stored in the set
+        - \p Set - sequential set implementation, default is \p std::set<T>.
+            The set should provide \p find(), \p insert() returning <tt>std::pair<iterator, bool></tt>,
+            \p erase(iterator), \p clear(), \p size() and \p empty()
+        - \p Traits - type traits of flat combining, default is \p fcset::traits.
+            \p fcset::make_traits metafunction can be used to construct \p %fcset::traits specialization.
+
+        Unlike the lock-free sets of \p libcds, the functors passed to \p %FCSet functions are called
+        by the combiner thread under the combiner lock. Keys of other types should be convertible to \p value_type;
+        \p find_with() / \p erase_with() with an alternative predicate are not supported.
+    */
+    template <typename T,
+        class Set = std::set<T>,
+        typename Traits = fcset::traits
+    >
+    class FCSet
+#ifndef CDS_DOXYGEN_INVOKED
+        : public cds::container::details::fc_associative< Set, Traits, fcset::details::make_value< typename Set::value_type > >
+#endif
+    {
+        //@cond
+        typedef cds::container::details::fc_associative< Set, Traits, fcset::details::make_value< typename Set::value_type > > base_class;
+        //@endcond
+    public:
+        typedef T           value_type;     ///< Value type
+        typedef Set         set_type;       ///< Sequential set class
+        typedef Traits      traits;         ///< Set type traits
+
+        typedef typename traits::stat  stat;   ///< Internal statistics type
+
+        static_assert( std::is_same< value_type, typename set_type::value_type >::value, "T must be the value type of Set" );
+
+    protected:
+        //@cond
+        using base_class::m_FlatCombining;
+        //@endcond
+
+    public:
+        /// Initializes empty set object
+        FCSet()
+        {}
+
+        /// Initializes empty set object and gives flat combining parameters
+        FCSet(
+            unsigned int nCompactFactor     ///< Flat combining: publication list compacting factor
+            ,unsigned int nCombinePassCount ///< Flat combining: number of combining passes for combiner thread
+            )
+            : base_class( nCompactFactor, nCombinePassCount )
+        {}
+
+        /// Inserts new item
+        /**
+            The function creates an item from \p val and inserts it into the set
+            if the set does not contain an item with key equal to \p val.
+            \p value_type should be constructible from a value of type \p Q.
+
+            Returns \p true if \p val is inserted into the set, \p false otherwise.
+        */
+        template <typename Q>
+        bool insert( Q const& val )
+        {
+            return insert( val, []( value_type& ) {} );
+        }
+
+        /// Inserts new item and initializes it by a functor
+        /**
+            The function inserts a new item created from \p val and if inserting is successful
+            calls \p f functor to initialize the non-key fields of the item:
+            \code
+                void func( value_type& item );
+            \endcode
+            The functor is called by the combiner thread.
+        */
+        template <typename Q, typename Func>
+        bool insert( Q const& val, Func f )
+        {
+            value_type key( val );
+            auto func = [&f]( bool, value_type& item ) { f( item ); };
+            bool const bRet = base_class::execute( base_class::op_insert, key, func ).first;
+            m_FlatCombining.internal_statistics().onInsert( bRet );
+            return bRet;
+        }
+
+        /// Updates the item
+        /**
+            If \p val is not found in the set, then \p val is inserted iff \p bAllowInsert is \p true.
+            Otherwise, the functor \p func is called with item found.
+            The functor signature is:
+            \code
+                void func( bool bNew, value_type& item, const Q& val );
+            \endcode
+            with arguments:
+            - \p bNew - \p true if the item has been inserted, \p false otherwise
+            - \p item - item of the set
+            - \p val - argument \p val passed into the \p %update() function
+
+            The functor may change non-key fields of the \p item. It is called by the combiner thread.
+            If \p opt::parallel_combining is enabled, the functor may be called concurrently by several threads
+            for the same item, so it should not change the item.
+
+            Returns <tt> std::pair<bool, bool> </tt> where \p first is \p true if operation is successful,
+            \p second is \p true if new item has been added or \p false if the item with \p val
+            already is in the set.
+        */
+        template <typename Q, typename Func>
+        std::pair<bool, bool> update( Q const& val, Func func, bool bAllowInsert = true )
+        {
+            value_type key( val );
+            auto f = [&func, &val]( bool bNew, value_type& item ) { func( bNew, item, val ); };
+            std::pair<bool, bool> res = base_class::execute( base_class::op_update, key, f, bAllowInsert );
+            m_FlatCombining.internal_statistics().onUpdate( res );
+            return res;
+        }
+
+        /// Deletes \p key from the set
+        /**
+            Returns \p true if \p key is found and deleted, \p false otherwise.
+        */
+        template <typename Q>
+        bool erase( Q const& key )
+        {
+            return erase( key, []( value_type const& ) {} );
+        }
+
+        /// Deletes \p key from the set and calls \p f for the item deleted
+        /**
+            The functor \p f is called by the combiner thread just before the item is removed:
+            \code
+                void func( value_type const& item );
+            \endcode
+        */
+        template <typename Q, typename Func>
+        bool erase( Q const& key, Func f )
+        {
+            value_type k( key );
+            auto func = [&f]( bool, value_type& item ) { f( item ); };
+            bool const bRet = base_class::execute( base_class::op_erase, k, func ).first;
+            m_FlatCombining.internal_statistics().onErase( bRet );
+            return bRet;
+        }
+
+        /// Finds \p key and calls \p f for the item found
+        /**
+            The functor signature is:
+            \code
+                void func( value_type& item, Q& key );
+            \endcode
+            The functor may change non-key fields of the \p item. It is called by the combiner thread.
+
+            Returns \p true if \p key is found, \p false otherwise.
+        */
+        template <typename Q, typename Func>
+        bool find( Q& key, Func f )
+        {
+            value_type k( key );
+            auto func = [&f, &key]( bool, value_type& item ) { f( item, key ); };
+            bool const bRet = base_class::execute( base_class::op_find, k, func ).first;
+            m_FlatCombining.internal_statistics().onFind( bRet );
+            return bRet;
+        }
+        //@cond
+        template <typename Q, typename Func>
+        bool find( Q const& key, Func f )
+        {
+            value_type k( key );
+            auto func = [&f, &key]( bool, value_type& item ) { f( item, key ); };
+            bool const bRet = base_class::execute( base_class::op_find, k, func ).first;
+            m_FlatCombining.internal_statistics().onFind( bRet );
+            return bRet;
+        }
+        //@endcond
+
+        /// Checks whether the set contains \p key
+        template <typename Q>
+        bool contains( Q const& key )
+        {
+            return find( key, []( value_type&, Q const& ) {} );
+        }
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_FCSET_H
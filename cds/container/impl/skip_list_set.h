@@ -166,6 +166,9 @@ namespace cds { namespace container {
         /// Guarded pointer
         typedef typename gc::template guarded_ptr< node_type, value_type, details::guarded_ptr_cast_set<node_type, value_type> > guarded_ptr;
 
+        /// Search hint for \p insert_hint() and \p find_hint(), see \p cds::intrusive::SkipListSet::hint
+        typedef typename base_class::hint hint;
+
     protected:
         //@cond
         unsigned int random_level()
@@ -320,6 +323,40 @@ namespace cds { namespace container {
             return false;
         }
 
+        /// Inserts new node using search hint
+        /**
+            The function is similar to \ref insert( Q const& val ) but the search
+            is resumed from the item remembered in \p h if it is still valid, see \p hint.
+            After the call \p h refers to the item inserted or to the item with the same key
+            found in the set.
+        */
+        template <typename Q>
+        bool insert_hint( hint& h, Q const& val )
+        {
+            scoped_node_ptr sp( node_allocator().New( random_level(), val ));
+            if ( base_class::insert_hint( h, *sp.get())) {
+                sp.release();
+                return true;
+            }
+            return false;
+        }
+
+        /// Inserts new node using search hint
+        /**
+            The function is similar to \ref insert( Q const& val, Func f ) but uses
+            the search hint \p h like \ref insert_hint( hint&, Q const& ).
+        */
+        template <typename Q, typename Func>
+        bool insert_hint( hint& h, Q const& val, Func f )
+        {
+            scoped_node_ptr sp( node_allocator().New( random_level(), val ));
+            if ( base_class::insert_hint( h, *sp.get(), [&f]( node_type& val ) { f( val.m_Value ); } )) {
+                sp.release();
+                return true;
+            }
+            return false;
+        }
+
         /// Updates the item
         /**
             The operation performs inserting or changing data with lock-free manner.
@@ -660,6 +697,33 @@ namespace cds { namespace container {
         }
         //@endcond
 
+        /// Finds \p key using search hint
+        /**
+            The function is similar to \ref cds_nonintrusive_SkipListSet_find_func "find(Q&, Func)"
+            but the search is resumed from the item remembered in \p h if it is still valid, see \p hint.
+            After the call \p h refers to the item found or, if \p key is not found,
+            to the nearest item preceding \p key.
+        */
+        template <typename Q, typename Func>
+        bool find_hint( hint& h, Q& key, Func f )
+        {
+            return base_class::find_hint( h, key, [&f]( node_type& node, Q& v ) { f( node.m_Value, v ); });
+        }
+        //@cond
+        template <typename Q, typename Func>
+        bool find_hint( hint& h, Q const& key, Func f )
+        {
+            return base_class::find_hint( h, key, [&f]( node_type& node, Q const& v ) { f( node.m_Value, v ); } );
+        }
+        //@endcond
+
+        /// Checks whether the set contains \p key using search hint
+        template <typename Q>
+        bool find_hint( hint& h, Q const& key )
+        {
+            return base_class::find_hint( h, key );
+        }
+
         /// Finds \p key and return the item found
         /** \anchor cds_nonintrusive_SkipListSet_hp_get
             The function searches the item with key equal to \p key
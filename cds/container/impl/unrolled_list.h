@@ -0,0 +1,1278 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_IMPL_UNROLLED_LIST_H
+#define CDSLIB_CONTAINER_IMPL_UNROLLED_LIST_H
+
+#include <memory>
+#include <mutex>    // unique_lock
+#include <cds/details/allocator.h>
+
+namespace cds { namespace container {
+
+    /// Unrolled ordered list
+    /** @ingroup cds_nonintrusive_list
+        @anchor cds_nonintrusive_UnrolledList_gc
+
+        The unrolled list stores up to \p Traits::node_capacity sorted items in each node,
+        so a lookup over \p N items follows about <tt>N / node_capacity</tt> pointers instead of \p N.
+        By default the node is sized to fit into one cache line. It makes the list a good
+        bucket for \p MichaelHashSet when buckets hold several items.
+
+        Source:
+        - [2005] Steve Heller, Maurice Herlihy, Victor Luchangco, Mark Moir, William N. Scherer III, and Nir Shavit
+                 "A Lazy Concurrent List-Based Set Algorithm"
+        - [2019] Kenneth Platz, Neeraj Mittal, S. Venkatesan "Concurrent Unrolled Skiplist"
+
+        The list follows the lazy synchronization scheme of \p LazyList applied to whole nodes.
+        The items of a node are immutable after the node has been linked into the list:
+        an insertion or a removal locks the predecessor and the target node, builds
+        a copy of the target node with the item inserted or removed and replaces the target node by the copy.
+        A full node is split into two halves, a sparse node is merged with its successor.
+        The replaced node is marked and retired via \p GC, so the lookup functions do not lock anything.
+
+        Since the items are copied when their node is replaced, \p T must be copy-constructible.
+        The modification of an item in \p update() functor is made under node lock and it is preserved.
+        The functor of \p find() is called under node lock too.
+        The value obtained by \p get() or by an iterator is not locked, it should be treated as read-only:
+        if the node is replaced concurrently, the changes made through it can be lost.
+
+        Template arguments:
+        - \p GC - garbage collector: \p gc::HP, \p gp::DHP
+        - \p T - type to be stored in the list, should be copy-constructible.
+        - \p Traits - type traits, default is \p unrolled_list::traits.
+            It is possible to declare option-based list with \p unrolled_list::make_traits metafunction instead of \p Traits template
+            argument. For example:
+            \code
+            #include <cds/container/unrolled_list_hp.h>
+
+            typedef cds::container::UnrolledList< cds::gc::HP, int,
+                typename cds::container::unrolled_list::make_traits<
+                    cds::opt::less< std::less<int>>
+                    ,cds::container::unrolled_list::node_capacity< 8 >
+                >::type
+            > list_type;
+            \endcode
+
+        \par Usage
+        There are different specializations of this template for each garbage collecting schema used.
+        You should include appropriate .h-file depending on GC you are using:
+        - for gc::HP: <tt> <cds/container/unrolled_list_hp.h> </tt>
+        - for gc::DHP: <tt> <cds/container/unrolled_list_dhp.h> </tt>
+    */
+    template <
+        typename GC,
+        typename T,
+#ifdef CDS_DOXYGEN_INVOKED
+        typename Traits = unrolled_list::traits
+#else
+        typename Traits
+#endif
+    >
+    class UnrolledList
+    {
+    public:
+        typedef GC gc;           ///< Garbage collector used
+        typedef T  value_type;   ///< Type of value stored in the list
+        typedef Traits traits;   ///< List traits
+
+        typedef typename traits::back_off     back_off;       ///< Back-off strategy used
+        typedef typename traits::item_counter item_counter;   ///< Item counting policy used
+        typedef typename traits::memory_model memory_model;   ///< Memory ordering. See cds::opt::memory_model option
+        typedef typename traits::stat         stat;           ///< Internal statistics
+        typedef typename traits::lock_type    lock_type;      ///< Node lock type
+
+        /// key comparison functor
+        typedef typename opt::details::make_comparator< value_type, traits >::type key_comparator;
+
+        /// Maximum number of items stored in a node
+        static CDS_CONSTEXPR const size_t c_nNodeCapacity = unrolled_list::select_node_capacity< gc, value_type, lock_type, traits::node_capacity >::value;
+
+        static CDS_CONSTEXPR const size_t c_nHazardPtrCount = 4; ///< Count of hazard pointer required for the algorithm
+
+        //@cond
+        // Rebind traits (MichaelHashSet support)
+        template <typename... Options>
+        struct rebind_traits {
+            typedef UnrolledList<
+                gc
+                , value_type
+                , typename cds::opt::make_options< traits, Options...>::type
+            > type;
+        };
+
+        // Stat selector
+        template <typename Stat>
+        using select_stat_wrapper = unrolled_list::select_stat_wrapper< Stat >;
+        //@endcond
+
+    protected:
+        //@cond
+        typedef unrolled_list::node_base< gc, lock_type > head_type;
+        typedef unrolled_list::node< gc, value_type, lock_type, c_nNodeCapacity > node_type;
+        typedef typename head_type::marked_ptr marked_node_ptr;
+
+        typedef typename traits::allocator::template rebind< node_type >::other allocator_type;
+        typedef cds::details::Allocator< node_type, allocator_type > cxx_allocator;
+        typedef cds::details::Allocator< value_type, typename traits::allocator > cxx_value_allocator;
+
+        typedef std::unique_lock< lock_type > scoped_lock;
+
+        static CDS_CONSTEXPR const size_t c_nMergeThreshold = c_nNodeCapacity / 4;
+
+        struct node_disposer {
+            void operator()( node_type * pNode )
+            {
+                cxx_allocator().Delete( pNode );
+            }
+        };
+        typedef std::unique_ptr< node_type, node_disposer > scoped_node_ptr;
+
+        struct value_disposer {
+            void operator()( value_type * p )
+            {
+                cxx_value_allocator().Delete( p );
+            }
+        };
+
+        struct empty_insert_functor {
+            void operator()( value_type& ) const
+            {}
+        };
+
+        struct empty_erase_functor {
+            void operator()( value_type const& ) const
+            {}
+        };
+
+        // Search result
+        struct position {
+            head_type * pPred;      // predecessor of pTarget
+            node_type * pTarget;    // the node that contains the key or should contain it; nullptr for empty list
+            size_t      nIndex;     // index of the key in pTarget (lower bound)
+            bool        bFound;     // pTarget contains the key at nIndex
+
+            node_type * arrRetired[2];  // nodes unlinked by the operation
+
+            typename gc::template GuardArray<3> guards;
+
+            position()
+            {
+                arrRetired[0] = arrRetired[1] = nullptr;
+            }
+        };
+        //@endcond
+
+    public:
+        /// Guarded pointer
+        /**
+            The guarded pointer is a result of \p get() and \p extract() functions.
+            It holds a GC guard on the list node and a pointer to the item inside the node,
+            so the item cannot be freed while the guarded pointer is not empty.
+
+            The guarded pointer is movable but not copyable.
+
+            @note Each \p guarded_ptr object uses one GC's guard which can be limited resource.
+        */
+        class guarded_ptr
+        {
+            //@cond
+            friend class UnrolledList;
+            //@endcond
+        public:
+            /// Creates empty guarded pointer
+            guarded_ptr() CDS_NOEXCEPT
+                : m_guard( nullptr )
+                , m_pValue( nullptr )
+            {}
+
+            /// Move ctor
+            guarded_ptr( guarded_ptr&& gp ) CDS_NOEXCEPT
+                : m_guard( std::move( gp.m_guard ))
+                , m_pValue( gp.m_pValue )
+            {
+                gp.m_pValue = nullptr;
+            }
+
+            /// The guarded pointer is not copy-constructible
+            guarded_ptr( guarded_ptr const& ) = delete;
+
+            /// Move-assignment operator
+            guarded_ptr& operator=( guarded_ptr&& gp ) CDS_NOEXCEPT
+            {
+                m_guard = std::move( gp.m_guard );
+                std::swap( m_pValue, gp.m_pValue );
+                return *this;
+            }
+
+            /// The guarded pointer is not copy-assignable
+            guarded_ptr& operator=( guarded_ptr const& ) = delete;
+
+            /// Returns a pointer to guarded value
+            value_type * operator ->() const CDS_NOEXCEPT
+            {
+                assert( !empty());
+                return m_pValue;
+            }
+
+            /// Returns a reference to guarded value
+            value_type& operator *() const CDS_NOEXCEPT
+            {
+                assert( !empty());
+                return *m_pValue;
+            }
+
+            /// Checks if the guarded pointer is \p nullptr
+            bool empty() const CDS_NOEXCEPT
+            {
+                return m_pValue == nullptr;
+            }
+
+            /// \p bool operator returns <tt>!empty()</tt>
+            explicit operator bool() const CDS_NOEXCEPT
+            {
+                return !empty();
+            }
+
+            /// Clears guarded pointer
+            /**
+                If the guarded pointer has been released, the pointer can be disposed (freed) at any time.
+                Dereferncing the guarded pointer after \p release() is dangerous.
+            */
+            void release() CDS_NOEXCEPT
+            {
+                m_guard.unlink();
+                m_pValue = nullptr;
+            }
+
+        private:
+            //@cond
+            guarded_ptr( typename gc::Guard&& g, value_type * pValue ) CDS_NOEXCEPT
+                : m_guard( std::move( g ))
+                , m_pValue( pValue )
+            {}
+
+            typename gc::Guard  m_guard;
+            value_type *        m_pValue;
+            //@endcond
+        };
+
+    protected:
+        //@cond
+        template <bool IsConst>
+        class iterator_type
+        {
+            friend class UnrolledList;
+            template <bool> friend class iterator_type;
+
+        public:
+            typedef typename cds::details::make_const_type<value_type, IsConst>::pointer   value_ptr;
+            typedef typename cds::details::make_const_type<value_type, IsConst>::reference value_ref;
+
+        protected:
+            node_type *         m_pNode;
+            size_t              m_nIndex;
+            typename gc::Guard  m_Guard;
+
+            explicit iterator_type( head_type const& head )
+                : m_pNode( nullptr )
+                , m_nIndex( 0 )
+            {
+                set( head );
+            }
+
+            void set( head_type const& node )
+            {
+                typename gc::Guard g;
+                m_pNode = static_cast<node_type *>( g.protect( node.m_pNext, []( marked_node_ptr p ) { return p.ptr(); } ).ptr());
+                m_Guard.assign( m_pNode );
+                m_nIndex = 0;
+            }
+
+        public:
+            iterator_type()
+                : m_pNode( nullptr )
+                , m_nIndex( 0 )
+            {}
+
+            iterator_type( iterator_type const& src )
+                : m_pNode( src.m_pNode )
+                , m_nIndex( src.m_nIndex )
+            {
+                m_Guard.copy( src.m_Guard );
+            }
+
+            iterator_type& operator =( iterator_type const& src )
+            {
+                m_pNode = src.m_pNode;
+                m_nIndex = src.m_nIndex;
+                m_Guard.copy( src.m_Guard );
+                return *this;
+            }
+
+            value_ptr operator ->() const
+            {
+                return m_pNode ? &m_pNode->data( m_nIndex ) : nullptr;
+            }
+
+            value_ref operator *() const
+            {
+                assert( m_pNode != nullptr );
+                return m_pNode->data( m_nIndex );
+            }
+
+            /// Pre-increment
+            iterator_type& operator ++()
+            {
+                if ( m_pNode ) {
+                    if ( ++m_nIndex >= m_pNode->m_nCount )
+                        set( *m_pNode );
+                }
+                return *this;
+            }
+
+            template <bool C>
+            bool operator ==( iterator_type<C> const& i ) const
+            {
+                return m_pNode == i.m_pNode && m_nIndex == i.m_nIndex;
+            }
+            template <bool C>
+            bool operator !=( iterator_type<C> const& i ) const
+            {
+                return !( *this == i );
+            }
+        };
+        //@endcond
+
+    public:
+    ///@name Forward iterators (only for debugging purpose)
+    //@{
+        /// Forward iterator
+        /**
+            The forward iterator for unrolled list has some features:
+            - it has no post-increment operator
+            - to protect the value, the iterator contains a GC-specific guard + another guard is required locally for increment operator.
+              For some GC (\p gc::HP), a guard is limited resource per thread, so an exception (or assertion) "no free guard"
+              may be thrown if a limit of guard count per thread is exceeded.
+            - The iterator cannot be moved across thread boundary since it contains GC's guard that is thread-private GC data.
+            - The iterator walks the nodes it has seen: if a node is replaced concurrently, the iterator
+              continues over the items of the old node. In case of concurrent modifications
+              it is no guarantee that you iterate all item in the list.
+              Moreover, a crash is possible when you try to iterate the next element that has been deleted by concurrent thread.
+
+            @warning Use this iterator on the concurrent container for debugging purpose only.
+        */
+        typedef iterator_type<false>    iterator;
+
+        /// Const forward iterator
+        /**
+            For iterator's features and requirements see \ref iterator
+        */
+        typedef iterator_type<true>     const_iterator;
+
+        /// Returns a forward iterator addressing the first element in a list
+        /**
+            For empty list \code begin() == end() \endcode
+        */
+        iterator begin()
+        {
+            return iterator( m_Head );
+        }
+
+        /// Returns an iterator that addresses the location succeeding the last element in a list
+        /**
+            Do not use the value returned by <tt>end</tt> function to access any item.
+
+            The returned value can be used only to control reaching the end of the list.
+            For empty list \code begin() == end() \endcode
+        */
+        iterator end()
+        {
+            return iterator();
+        }
+
+        /// Returns a forward const iterator addressing the first element in a list
+        const_iterator begin() const
+        {
+            return const_iterator( m_Head );
+        }
+
+        /// Returns a forward const iterator addressing the first element in a list
+        const_iterator cbegin() const
+        {
+            return const_iterator( m_Head );
+        }
+
+        /// Returns an const iterator that addresses the location succeeding the last element in a list
+        const_iterator end() const
+        {
+            return const_iterator();
+        }
+
+        /// Returns an const iterator that addresses the location succeeding the last element in a list
+        const_iterator cend() const
+        {
+            return const_iterator();
+        }
+    //@}
+
+    public:
+        /// Default constructor
+        UnrolledList()
+        {}
+
+        //@cond
+        template <typename Stat, typename = std::enable_if<std::is_same<stat, unrolled_list::wrapped_stat<Stat>>::value >>
+        explicit UnrolledList( Stat& st )
+            : m_Stat( st )
+        {}
+        //@endcond
+
+        /// Destructor clears the list
+        ~UnrolledList()
+        {
+            clear();
+        }
+
+        /// Inserts new item
+        /**
+            The function inserts a copy of \p val value into the list.
+
+            The type \p Q should contain as minimum the complete key of the item.
+            The object of \ref value_type should be constructible from \p val of type \p Q.
+            In trivial case, \p Q is equal to \ref value_type.
+
+            Returns \p true if inserting successful, \p false otherwise.
+        */
+        template <typename Q>
+        bool insert( Q&& val )
+        {
+            return insert_at( val, empty_insert_functor(), std::forward<Q>( val ));
+        }
+
+        /// Inserts new item
+        /**
+            This function inserts new item constructed from \p key and then it calls
+            \p func functor with signature
+            \code void func( value_type& item ) ;\endcode
+
+            The argument \p item of user-defined functor \p func is the reference
+            to the list's item inserted. \p func is called before the item becomes visible
+            to other threads, so it has exclusive access to the item.
+            The user-defined functor is called only if the inserting is success.
+
+            The type \p Q should contain the complete key of the item.
+            The object of \p value_type should be constructible from \p key of type \p Q.
+        */
+        template <typename Q, typename Func>
+        bool insert( Q&& key, Func func )
+        {
+            return insert_at( key, func, std::forward<Q>( key ));
+        }
+
+        /// Inserts data of type \p value_type constructed from \p args
+        /**
+            Returns \p true if inserting successful, \p false otherwise.
+        */
+        template <typename... Args>
+        bool emplace( Args&&... args )
+        {
+            value_type val( std::forward<Args>( args )... );
+            return insert_at( val, empty_insert_functor(), std::move( val ));
+        }
+
+        /// Updates data by \p key
+        /**
+            The operation performs inserting or changing data.
+
+            If the \p key not found in the list, then the new item created from \p key
+            will be inserted iff \p bAllowInsert is \p true.
+            Otherwise, if \p key is found, the functor \p func is called with item found.
+
+            The functor \p Func signature is:
+            \code
+                struct my_functor {
+                    void operator()( bool bNew, value_type& item, Q const& key );
+                };
+            \endcode
+
+            with arguments:
+            - \p bNew - \p true if the item has been inserted, \p false otherwise
+            - \p item - item of the list
+            - \p key - argument \p key passed into the \p %update() function
+
+            The functor may change non-key fields of the \p item;
+            during \p func call the node of \p item is locked so it is safe to modify the item in
+            multi-threaded environment.
+
+            Returns <tt> std::pair<bool, bool> </tt> where \p first is true if operation is successful,
+            \p second is true if new item has been added or \p false if the item with \p key
+            already exists.
+        */
+        template <typename Q, typename Func>
+        std::pair<bool, bool> update( Q const& key, Func func, bool bAllowInsert = true )
+        {
+            return update_at( key, func, bAllowInsert );
+        }
+
+        /// Deletes \p key from the list
+        /** \anchor cds_nonintrusive_UnrolledList_erase_val
+            Since the key of UnrolledList's item type \p T is not explicitly specified,
+            template parameter \p Q defines the key type searching in the list.
+            The list item comparator should be able to compare the type \p T of list item
+            and the type \p Q.
+
+            Return \p true if key is found and deleted, \p false otherwise
+        */
+        template <typename Q>
+        bool erase( Q const& key )
+        {
+            return erase_at( key, key_comparator(), empty_erase_functor());
+        }
+
+        /// Deletes the item from the list using \p pred predicate for searching
+        /**
+            The function is an analog of \ref cds_nonintrusive_UnrolledList_erase_val "erase(Q const&)"
+            but \p pred is used for key comparing.
+            \p Less functor has the interface like \p std::less.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less>
+        bool erase_with( Q const& key, Less pred )
+        {
+            CDS_UNUSED( pred );
+            return erase_at( key, cds::opt::details::make_comparator_from_less<Less>(), empty_erase_functor());
+        }
+
+        /// Deletes \p key from the list
+        /** \anchor cds_nonintrusive_UnrolledList_erase_func
+            The function searches an item with key \p key, calls \p f functor with item found
+            and deletes the item. If \p key is not found, the functor is not called.
+
+            The functor \p Func interface:
+            \code
+            struct extractor {
+                void operator()(const value_type& val) { ... }
+            };
+            \endcode
+
+            Return \p true if key is found and deleted, \p false otherwise
+        */
+        template <typename Q, typename Func>
+        bool erase( Q const& key, Func f )
+        {
+            return erase_at( key, key_comparator(), f );
+        }
+
+        /// Deletes the item from the list using \p pred predicate for searching
+        /**
+            The function is an analog of \ref cds_nonintrusive_UnrolledList_erase_func "erase(Q const&, Func)"
+            but \p pred is used for key comparing.
+            \p Less functor has the interface like \p std::less.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less, typename Func>
+        bool erase_with( Q const& key, Less pred, Func f )
+        {
+            CDS_UNUSED( pred );
+            return erase_at( key, cds::opt::details::make_comparator_from_less<Less>(), f );
+        }
+
+        /// Extracts the item from the list with specified \p key
+        /** \anchor cds_nonintrusive_UnrolledList_extract
+            The function searches an item with key equal to \p key,
+            removes it from the list, and returns it as \p guarded_ptr.
+            If \p key is not found the function returns an empty guarded pointer.
+
+            Note the compare functor should accept a parameter of type \p Q that can be not the same as \p value_type.
+
+            @note Each \p guarded_ptr object uses the GC's guard that can be limited resource.
+        */
+        template <typename Q>
+        guarded_ptr extract( Q const& key )
+        {
+            return extract_at( key, key_comparator());
+        }
+
+        /// Extracts the item from the list with comparing functor \p pred
+        /**
+            The function is an analog of \ref cds_nonintrusive_UnrolledList_extract "extract(Q const&)"
+            but \p pred predicate is used for key comparing.
+
+            \p Less functor has the semantics like \p std::less but should take arguments of type \ref value_type and \p Q
+            in any order.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less>
+        guarded_ptr extract_with( Q const& key, Less pred )
+        {
+            CDS_UNUSED( pred );
+            return extract_at( key, cds::opt::details::make_comparator_from_less<Less>());
+        }
+
+        /// Checks whether the list contains \p key
+        /**
+            The function searches the item with key equal to \p key
+            and returns \p true if it is found, and \p false otherwise.
+        */
+        template <typename Q>
+        bool contains( Q const& key )
+        {
+            return find_at( key, key_comparator());
+        }
+
+        /// Checks whether the list contains \p key using \p pred predicate for searching
+        /**
+            The function is an analog of <tt>contains( key )</tt> but \p pred is used for key comparing.
+            \p Less functor has the interface like \p std::less.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less>
+        bool contains( Q const& key, Less pred )
+        {
+            CDS_UNUSED( pred );
+            return find_at( key, cds::opt::details::make_comparator_from_less<Less>());
+        }
+
+        /// Finds the key \p key and performs an action with it
+        /** \anchor cds_nonintrusive_UnrolledList_find_func
+            The function searches an item with key equal to \p key and calls the functor \p f for the item found.
+            The interface of \p Func functor is:
+            \code
+            struct functor {
+                void operator()( value_type& item, Q& key );
+            };
+            \endcode
+            where \p item is the item found, \p key is the <tt>find</tt> function argument.
+
+            The functor may change non-key fields of \p item.
+            The functor is called under the lock of the node containing \p item,
+            so the node cannot be replaced by a concurrent insertion or removal while the functor is executing
+            and the changes are preserved.
+
+            The function returns \p true if \p key is found, \p false otherwise.
+        */
+        template <typename Q, typename Func>
+        bool find( Q& key, Func f )
+        {
+            return find_at( key, key_comparator(), f );
+        }
+        //@cond
+        template <typename Q, typename Func>
+        bool find( Q const& key, Func f )
+        {
+            return find_at( key, key_comparator(), f );
+        }
+        //@endcond
+
+        /// Finds the key \p key using \p pred predicate for searching
+        /**
+            The function is an analog of \ref cds_nonintrusive_UnrolledList_find_func "find(Q&, Func)"
+            but \p pred is used for key comparing.
+            \p Less functor has the interface like \p std::less.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less, typename Func>
+        bool find_with( Q& key, Less pred, Func f )
+        {
+            CDS_UNUSED( pred );
+            return find_at( key, cds::opt::details::make_comparator_from_less<Less>(), f );
+        }
+        //@cond
+        template <typename Q, typename Less, typename Func>
+        bool find_with( Q const& key, Less pred, Func f )
+        {
+            CDS_UNUSED( pred );
+            return find_at( key, cds::opt::details::make_comparator_from_less<Less>(), f );
+        }
+        //@endcond
+
+        /// Finds the key \p key and return the item found
+        /** \anchor cds_nonintrusive_UnrolledList_get
+            The function searches the item with key equal to \p key
+            and returns the item found as \p guarded_ptr.
+            If \p key is not found the function returns an empty guarded pointer.
+            The item pointed to by the guarded pointer should not be changed since its node
+            can be replaced concurrently; use \p find() or \p update() to change the item.
+
+            @note Each \p guarded_ptr object uses one GC's guard which can be limited resource.
+
+            Note the compare functor specified for class \p Traits template parameter
+            should accept a parameter of type \p Q that can be not the same as \p value_type.
+        */
+        template <typename Q>
+        guarded_ptr get( Q const& key )
+        {
+            return get_at( key, key_comparator());
+        }
+
+        /// Finds the key \p key and return the item found
+        /**
+            The function is an analog of \ref cds_nonintrusive_UnrolledList_get "get( Q const&)"
+            but \p pred is used for comparing the keys.
+
+            \p Less functor has the semantics like \p std::less but should take arguments of type \ref value_type and \p Q
+            in any order.
+            \p pred must imply the same element order as the comparator used for building the list.
+        */
+        template <typename Q, typename Less>
+        guarded_ptr get_with( Q const& key, Less pred )
+        {
+            CDS_UNUSED( pred );
+            return get_at( key, cds::opt::details::make_comparator_from_less<Less>());
+        }
+
+        /// Checks whether the list is empty
+        bool empty() const
+        {
+            return m_Head.m_pNext.load( memory_model::memory_order_relaxed ).ptr() == nullptr;
+        }
+
+        /// Returns list's item count
+        /**
+            The value returned depends on \p Traits::item_counter type. For \p atomicity::empty_item_counter,
+            this function always returns 0.
+
+            @note Even if you use real item counter and it returns 0, this fact is not mean that the list
+            is empty. To check list emptyness use \ref empty() method.
+        */
+        size_t size() const
+        {
+            return m_ItemCounter.value();
+        }
+
+        /// Returns const reference to internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+        /// Clears the list
+        /**
+            The function unlinks the nodes one by one. It is not atomic:
+            the items inserted concurrently can stay in the list.
+        */
+        void clear()
+        {
+            typename gc::Guard guard;
+            while ( true ) {
+                node_type * pNode = static_cast<node_type *>( guard.protect( m_Head.m_pNext, []( marked_node_ptr p ) { return p.ptr(); } ).ptr());
+                if ( !pNode )
+                    break;
+
+                bool bUnlinked = false;
+                {
+                    scoped_lock lockHead( m_Head.m_Lock );
+                    scoped_lock lockNode( pNode->m_Lock );
+                    if ( validate( &m_Head, pNode )) {
+                        m_ItemCounter -= pNode->m_nCount;
+                        unlink_node( &m_Head, pNode );
+                        bUnlinked = true;
+                    }
+                }
+                if ( bUnlinked )
+                    retire_node( pNode );
+            }
+        }
+
+    protected:
+        //@cond
+        // MichaelHashSet support: emplace() constructs the item before selecting a bucket
+        template <typename... Args>
+        static value_type * alloc_node( Args&&... args )
+        {
+            return cxx_value_allocator().MoveNew( std::forward<Args>( args )... );
+        }
+
+        static value_type& node_to_value( value_type& val )
+        {
+            return val;
+        }
+
+        bool insert_node( value_type * pVal )
+        {
+            std::unique_ptr< value_type, value_disposer > p( pVal );
+            return insert_at( *pVal, empty_insert_functor(), std::move( *pVal ));
+        }
+
+        static node_type * alloc_data_node()
+        {
+            return cxx_allocator().New();
+        }
+
+        void retire_node( node_type * pNode )
+        {
+            assert( pNode != nullptr );
+            gc::template retire<node_disposer>( pNode );
+        }
+
+        void retire_nodes( position& pos )
+        {
+            for ( node_type *& p : pos.arrRetired ) {
+                if ( p ) {
+                    retire_node( p );
+                    p = nullptr;
+                }
+            }
+        }
+
+        // Index of the first item not less than key
+        template <typename Q, typename Compare>
+        static size_t lower_bound( node_type const& node, Q const& key, Compare cmp, bool& bFound )
+        {
+            size_t nLow = 0;
+            size_t nHigh = node.m_nCount;
+            while ( nLow < nHigh ) {
+                size_t const nMid = ( nLow + nHigh ) / 2;
+                if ( cmp( node.data( nMid ), key ) < 0 )
+                    nLow = nMid + 1;
+                else
+                    nHigh = nMid;
+            }
+            bFound = nLow < node.m_nCount && cmp( node.data( nLow ), key ) == 0;
+            return nLow;
+        }
+
+        // Finds the node whose range contains key.
+        // Node range is [first item of the node, first item of the next node).
+        // If key is less than the first item of the list, pTarget is the first node (or nullptr for empty list)
+        // and pPred is the head.
+        template <typename Q, typename Compare>
+        void search( Q const& key, Compare cmp, position& pos )
+        {
+            head_type * const pHead = &m_Head;
+
+            while ( true ) {
+                head_type * pPred = pHead;
+                head_type * pCur = pHead;
+                node_type * pNext = nullptr;
+                bool bRestart = false;
+
+                while ( true ) {
+                    marked_node_ptr p = pos.guards.protect( 2, pCur->m_pNext, []( marked_node_ptr mp ) { return mp.ptr(); } );
+                    if ( p.bits()) {
+                        // pCur has been unlinked
+                        bRestart = true;
+                        break;
+                    }
+
+                    pNext = static_cast<node_type *>( p.ptr());
+                    if ( !pNext || cmp( pNext->data( 0 ), key ) > 0 )
+                        break;
+
+                    pPred = pCur;
+                    pos.guards.assign( 0, pCur );
+                    pCur = pNext;
+                    pos.guards.assign( 1, pCur );
+                }
+
+                if ( bRestart )
+                    continue;
+
+                if ( pCur == pHead ) {
+                    pos.pPred = pHead;
+                    pos.pTarget = pNext;
+                    pos.nIndex = 0;
+                    pos.bFound = false;
+                }
+                else {
+                    pos.pPred = pPred;
+                    pos.pTarget = static_cast<node_type *>( pCur );
+                    pos.nIndex = lower_bound( *pos.pTarget, key, cmp, pos.bFound );
+                }
+                return;
+            }
+        }
+
+        // pPred and pTarget must be locked
+        static bool validate( head_type * pPred, node_type * pTarget )
+        {
+            return pPred->m_pNext.load( memory_model::memory_order_acquire ) == marked_node_ptr( pTarget )
+                && ( !pTarget || !pTarget->is_marked());
+        }
+
+        // Replaces pOld with the chain started from pNew. pPred and pOld must be locked
+        static void replace_node( head_type * pPred, node_type * pOld, node_type * pNew )
+        {
+            pOld->m_pNext.store( marked_node_ptr( pOld->m_pNext.load( memory_model::memory_order_relaxed ).ptr(), 1 ), memory_model::memory_order_release );
+            pPred->m_pNext.store( marked_node_ptr( pNew ), memory_model::memory_order_release );
+        }
+
+        // Unlinks pNode. pPred and pNode must be locked
+        static void unlink_node( head_type * pPred, node_type * pNode )
+        {
+            marked_node_ptr pNext = pNode->m_pNext.load( memory_model::memory_order_relaxed );
+            pNode->m_pNext.store( marked_node_ptr( pNext.ptr(), 1 ), memory_model::memory_order_release );
+            pPred->m_pNext.store( pNext, memory_model::memory_order_release );
+        }
+
+        // Links the item constructed from args into pos.pTarget, splitting the node if it is full.
+        // pos.pPred and pos.pTarget must be locked and validated
+        template <typename Func, typename... Args>
+        void link_item( position& pos, Func f, Args&&... args )
+        {
+            node_type * pTarget = pos.pTarget;
+
+            if ( !pTarget ) {
+                // Empty list
+                scoped_node_ptr pNew( alloc_data_node());
+                f( pNew->push_back( std::forward<Args>( args )... ));
+                m_Stat.onNodeCreated();
+                pos.pPred->m_pNext.store( marked_node_ptr( pNew.release()), memory_model::memory_order_release );
+                return;
+            }
+
+            size_t const nCount = pTarget->m_nCount;
+            size_t const nIndex = pos.nIndex;
+            marked_node_ptr pNext = pTarget->m_pNext.load( memory_model::memory_order_relaxed );
+
+            if ( nCount < c_nNodeCapacity ) {
+                scoped_node_ptr pNew( alloc_data_node());
+                for ( size_t i = 0; i < nIndex; ++i )
+                    pNew->push_back( pTarget->data( i ));
+                f( pNew->push_back( std::forward<Args>( args )... ));
+                for ( size_t i = nIndex; i < nCount; ++i )
+                    pNew->push_back( pTarget->data( i ));
+                pNew->m_pNext.store( pNext, memory_model::memory_order_relaxed );
+                m_Stat.onNodeCreated();
+
+                replace_node( pos.pPred, pTarget, pNew.release());
+            }
+            else {
+                // Split the full node into two halves
+                size_t const nLeft = ( nCount + 1 ) / 2;
+                scoped_node_ptr pLeft( alloc_data_node());
+                scoped_node_ptr pRight( alloc_data_node());
+
+                size_t nSrc = 0;
+                for ( size_t i = 0; i <= nCount; ++i ) {
+                    node_type& dest = i < nLeft ? *pLeft : *pRight;
+                    if ( i == nIndex )
+                        f( dest.push_back( std::forward<Args>( args )... ));
+                    else
+                        dest.push_back( pTarget->data( nSrc++ ));
+                }
+
+                pRight->m_pNext.store( pNext, memory_model::memory_order_relaxed );
+                pLeft->m_pNext.store( marked_node_ptr( pRight.release()), memory_model::memory_order_relaxed );
+                m_Stat.onNodeCreated();
+                m_Stat.onNodeCreated();
+                m_Stat.onNodeSplit();
+
+                replace_node( pos.pPred, pTarget, pLeft.release());
+            }
+
+            pos.arrRetired[0] = pTarget;
+        }
+
+        // Removes item pos.nIndex from pos.pTarget, merging the rest with the next node if it is sparse.
+        // pos.pPred and pos.pTarget must be locked and validated
+        void unlink_item( position& pos )
+        {
+            node_type * pTarget = pos.pTarget;
+            size_t const nCount = pTarget->m_nCount;
+            size_t const nIndex = pos.nIndex;
+
+            if ( nCount == 1 ) {
+                unlink_node( pos.pPred, pTarget );
+                m_Stat.onNodeRemoved();
+                pos.arrRetired[0] = pTarget;
+                return;
+            }
+
+            marked_node_ptr pNext = pTarget->m_pNext.load( memory_model::memory_order_relaxed );
+            node_type * pSucc = static_cast<node_type *>( pNext.ptr());
+
+            // The successor cannot be changed or unlinked while pTarget is locked
+            if ( pSucc && nCount - 1 <= c_nMergeThreshold && nCount - 1 + pSucc->m_nCount <= c_nNodeCapacity ) {
+                scoped_lock lockSucc( pSucc->m_Lock );
+                assert( !pSucc->is_marked());
+
+                scoped_node_ptr pNew( alloc_data_node());
+                for ( size_t i = 0; i < nCount; ++i ) {
+                    if ( i != nIndex )
+                        pNew->push_back( pTarget->data( i ));
+                }
+                for ( size_t i = 0; i < pSucc->m_nCount; ++i )
+                    pNew->push_back( pSucc->data( i ));
+                pNew->m_pNext.store( pSucc->m_pNext.load( memory_model::memory_order_relaxed ), memory_model::memory_order_relaxed );
+                m_Stat.onNodeCreated();
+                m_Stat.onNodeMerge();
+                m_Stat.onNodeRemoved();
+
+                pSucc->m_pNext.store( marked_node_ptr( pSucc->m_pNext.load( memory_model::memory_order_relaxed ).ptr(), 1 ), memory_model::memory_order_release );
+                replace_node( pos.pPred, pTarget, pNew.release());
+                pos.arrRetired[1] = pSucc;
+            }
+            else {
+                scoped_node_ptr pNew( alloc_data_node());
+                for ( size_t i = 0; i < nCount; ++i ) {
+                    if ( i != nIndex )
+                        pNew->push_back( pTarget->data( i ));
+                }
+                pNew->m_pNext.store( pNext, memory_model::memory_order_relaxed );
+                m_Stat.onNodeCreated();
+
+                replace_node( pos.pPred, pTarget, pNew.release());
+            }
+
+            pos.arrRetired[0] = pTarget;
+        }
+
+        // Locks pos.pPred and pos.pTarget and inserts the item. Returns false if validation failed
+        template <typename Func, typename... Args>
+        bool try_insert( position& pos, Func f, Args&&... args )
+        {
+            {
+                scoped_lock lockPred( pos.pPred->m_Lock );
+                scoped_lock lockTarget;
+                if ( pos.pTarget )
+                    lockTarget = scoped_lock( pos.pTarget->m_Lock );
+
+                if ( !validate( pos.pPred, pos.pTarget )) {
+                    m_Stat.onValidationFailed();
+                    return false;
+                }
+
+                link_item( pos, f, std::forward<Args>( args )... );
+            }
+            ++m_ItemCounter;
+            retire_nodes( pos );
+            return true;
+        }
+
+        template <typename Q, typename Func, typename... Args>
+        bool insert_at( Q const& key, Func f, Args&&... args )
+        {
+            position pos;
+            back_off bkoff;
+            key_comparator cmp;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( pos.bFound ) {
+                    m_Stat.onInsertFailed();
+                    return false;
+                }
+
+                if ( try_insert( pos, f, std::forward<Args>( args )... )) {
+                    m_Stat.onInsertSuccess();
+                    return true;
+                }
+
+                m_Stat.onInsertRetry();
+                bkoff();
+            }
+        }
+
+        template <typename Q, typename Func>
+        std::pair<bool, bool> update_at( Q const& key, Func func, bool bAllowInsert )
+        {
+            position pos;
+            back_off bkoff;
+            key_comparator cmp;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( pos.bFound ) {
+                    scoped_lock lockTarget( pos.pTarget->m_Lock );
+                    if ( !pos.pTarget->is_marked()) {
+                        func( false, pos.pTarget->data( pos.nIndex ), key );
+                        m_Stat.onUpdateExisting();
+                        return std::make_pair( true, false );
+                    }
+                }
+                else {
+                    if ( !bAllowInsert ) {
+                        m_Stat.onUpdateFailed();
+                        return std::make_pair( false, false );
+                    }
+
+                    if ( try_insert( pos, [&func, &key]( value_type& item ) { func( true, item, key ); }, key )) {
+                        m_Stat.onUpdateNew();
+                        return std::make_pair( true, true );
+                    }
+                }
+
+                m_Stat.onUpdateRetry();
+                bkoff();
+            }
+        }
+
+        // Locks pos.pPred and pos.pTarget, calls f for the item found and removes it.
+        // Returns false if validation failed
+        template <typename Func>
+        bool try_erase( position& pos, Func f )
+        {
+            {
+                scoped_lock lockPred( pos.pPred->m_Lock );
+                scoped_lock lockTarget( pos.pTarget->m_Lock );
+
+                if ( !validate( pos.pPred, pos.pTarget )) {
+                    m_Stat.onValidationFailed();
+                    return false;
+                }
+
+                f( pos.pTarget->data( pos.nIndex ));
+                unlink_item( pos );
+            }
+            --m_ItemCounter;
+            retire_nodes( pos );
+            return true;
+        }
+
+        template <typename Q, typename Compare, typename Func>
+        bool erase_at( Q const& key, Compare cmp, Func f )
+        {
+            position pos;
+            back_off bkoff;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( !pos.bFound ) {
+                    m_Stat.onEraseFailed();
+                    return false;
+                }
+
+                if ( try_erase( pos, f )) {
+                    m_Stat.onEraseSuccess();
+                    return true;
+                }
+
+                m_Stat.onEraseRetry();
+                bkoff();
+            }
+        }
+
+        template <typename Q, typename Compare>
+        guarded_ptr extract_at( Q const& key, Compare cmp )
+        {
+            position pos;
+            back_off bkoff;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( !pos.bFound ) {
+                    m_Stat.onEraseFailed();
+                    return guarded_ptr();
+                }
+
+                // The old node stays alive while the guard is held
+                typename gc::Guard guard;
+                guard.assign( pos.pTarget );
+                value_type * pVal = &pos.pTarget->data( pos.nIndex );
+
+                if ( try_erase( pos, empty_erase_functor())) {
+                    m_Stat.onEraseSuccess();
+                    return guarded_ptr( std::move( guard ), pVal );
+                }
+
+                m_Stat.onEraseRetry();
+                bkoff();
+            }
+        }
+
+        template <typename Q, typename Compare>
+        bool find_at( Q const& key, Compare cmp )
+        {
+            position pos;
+            search( key, cmp, pos );
+            if ( pos.bFound ) {
+                m_Stat.onFindSuccess();
+                return true;
+            }
+            m_Stat.onFindFailed();
+            return false;
+        }
+
+        template <typename Q, typename Compare, typename Func>
+        bool find_at( Q& key, Compare cmp, Func f )
+        {
+            position pos;
+            back_off bkoff;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( !pos.bFound ) {
+                    m_Stat.onFindFailed();
+                    return false;
+                }
+
+                // The node lock prevents the node from being copied while f changes the item
+                scoped_lock lockTarget( pos.pTarget->m_Lock );
+                if ( !pos.pTarget->is_marked()) {
+                    f( pos.pTarget->data( pos.nIndex ), key );
+                    m_Stat.onFindSuccess();
+                    return true;
+                }
+
+                bkoff();
+            }
+        }
+
+        template <typename Q, typename Compare>
+        guarded_ptr get_at( Q const& key, Compare cmp )
+        {
+            position pos;
+            back_off bkoff;
+
+            while ( true ) {
+                search( key, cmp, pos );
+                if ( !pos.bFound ) {
+                    m_Stat.onFindFailed();
+                    return guarded_ptr();
+                }
+
+                typename gc::Guard guard;
+                guard.assign( pos.pTarget );
+                {
+                    scoped_lock lockTarget( pos.pTarget->m_Lock );
+                    if ( !pos.pTarget->is_marked()) {
+                        m_Stat.onFindSuccess();
+                        return guarded_ptr( std::move( guard ), &pos.pTarget->data( pos.nIndex ));
+                    }
+                }
+
+                bkoff();
+            }
+        }
+        //@endcond
+
+    private:
+        //@cond
+        head_type       m_Head;
+        item_counter    m_ItemCounter;
+        stat            m_Stat;
+        //@endcond
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_IMPL_UNROLLED_LIST_H
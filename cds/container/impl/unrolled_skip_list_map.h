@@ -0,0 +1,899 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_IMPL_UNROLLED_SKIP_LIST_MAP_H
+#define CDSLIB_CONTAINER_IMPL_UNROLLED_SKIP_LIST_MAP_H
+
+#include <memory>
+#include <mutex>    // unique_lock
+#include <tuple>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace container {
+
+    //@cond
+    namespace unrolled_skip_list { namespace details {
+
+        // The index of chunks for gc::HP and gc::DHP, see unrolled_skip_list_map_rcu.h for RCU specialization.
+        // The index encapsulates GC-specific protection of the chunk found until the chunk is locked
+        template <typename GC, typename Chunk, typename IndexTraits>
+        class chunk_index: public cds::intrusive::SkipListSet< GC, Chunk, IndexTraits >
+        {
+            typedef cds::intrusive::SkipListSet< GC, Chunk, IndexTraits > base_class;
+        public:
+            typedef GC      gc;
+            typedef Chunk   chunk_type;
+            typedef typename IndexTraits::disposer chunk_disposer;
+
+            // +1 - for the guard of the chunk found
+            static CDS_CONSTEXPR size_t const c_nHazardPtrCount = base_class::c_nHazardPtrCount + 1;
+
+            chunk_index()
+            {
+                gc::check_available_guards( c_nHazardPtrCount );
+            }
+
+            // Returns the locked chunk with the greatest low key less than key (or equal to key if bInclusive is true).
+            // If the index has no such chunk, returns head locked. The chunk returned is not removed
+            template <typename K, typename Stat>
+            chunk_type * lock_predecessor( K const& key, bool bInclusive, chunk_type& head, Stat& s )
+            {
+                typename gc::Guard guard;
+                while ( true ) {
+                    chunk_type * pChunk = lock_found( base_class::find_predecessor_( key, typename base_class::key_comparator(), bInclusive, guard ), head, s );
+                    if ( pChunk )
+                        return pChunk;
+                }
+            }
+
+            // Returns the locked chunk with the greatest low key in the index, or head locked if the index is empty.
+            // The chunk returned is not removed
+            template <typename Stat>
+            chunk_type * lock_last( chunk_type& head, Stat& s )
+            {
+                typename gc::Guard guard;
+                while ( true ) {
+                    chunk_type * pChunk = lock_found( base_class::find_max_( guard ), head, s );
+                    if ( pChunk )
+                        return pChunk;
+                }
+            }
+
+            // Unlinks the locked removed chunk from the index or retires it if it has not been indexed.
+            // The chunk is unlocked on return
+            void release_chunk( chunk_type& c )
+            {
+                assert( c.m_bRemoved );
+
+                // The index retires c on unlink, so c should be guarded until it is unlocked
+                typename gc::Guard guard;
+                guard.assign( &c );
+
+                // c is unlinked before unlocking, so the next search of the waiters will not find it
+                bool const bIndexed = c.m_bIndexed;
+                if ( bIndexed )
+                    CDS_VERIFY( base_class::unlink( c ));
+                c.m_Lock.unlock();
+
+                if ( !bIndexed )
+                    gc::template retire< chunk_disposer >( &c );
+            }
+
+        private:
+            template <typename Stat>
+            static chunk_type * lock_found( chunk_type * pChunk, chunk_type& head, Stat& s )
+            {
+                if ( !pChunk )
+                    pChunk = &head;
+
+                pChunk->m_Lock.lock();
+                if ( pChunk->m_bRemoved ) {
+                    // The chunk is being unlinked from the index, search again
+                    pChunk->m_Lock.unlock();
+                    s.onChunkRemovedRetry();
+                    return nullptr;
+                }
+                return pChunk;
+            }
+        };
+
+        template <typename GC, typename Key, typename T, typename Traits>
+        struct make_unrolled_skip_list_map
+        {
+            typedef GC      gc;
+            typedef Key     key_type;
+            typedef T       mapped_type;
+            typedef std::pair< key_type const, mapped_type> value_type;
+            typedef Traits  traits;
+
+            typedef typename opt::details::make_comparator< key_type, traits >::type key_comparator;
+
+            static CDS_CONSTEXPR size_t const c_nChunkCapacity = select_chunk_capacity< value_type, traits::chunk_capacity >::value;
+
+            typedef chunk< gc, key_type, value_type, typename traits::lock_type, c_nChunkCapacity > chunk_type;
+            typedef cds::details::Allocator< chunk_type, typename traits::allocator > cxx_chunk_allocator;
+
+            struct chunk_disposer {
+                void operator()( chunk_type * p ) const
+                {
+                    cxx_chunk_allocator().Delete( p );
+                }
+            };
+
+            // The index orders the chunks by low key
+            struct index_compare {
+                int operator()( chunk_type const& c1, chunk_type const& c2 ) const
+                {
+                    return key_comparator()( c1.low_key(), c2.low_key());
+                }
+
+                template <typename Q>
+                int operator()( chunk_type const& c, Q const& key ) const
+                {
+                    return key_comparator()( c.low_key(), key );
+                }
+
+                template <typename Q>
+                int operator()( Q const& key, chunk_type const& c ) const
+                {
+                    return key_comparator()( key, c.low_key());
+                }
+            };
+
+            struct index_traits: public cds::intrusive::skip_list::traits
+            {
+                typedef cds::intrusive::skip_list::base_hook< opt::gc< gc >> hook;
+                typedef index_compare                               compare;
+                typedef chunk_disposer                              disposer;
+                typedef typename traits::random_level_generator     random_level_generator;
+                typedef typename traits::allocator                  allocator;
+                typedef typename traits::back_off                   back_off;
+                typedef typename traits::memory_model               memory_model;
+            };
+
+            typedef chunk_index< gc, chunk_type, index_traits > type;
+        };
+
+    }} // namespace unrolled_skip_list::details
+    //@endcond
+
+    /// Skip-list based map with unrolled bottom level
+    /** @ingroup cds_nonintrusive_map
+        @anchor cds_nonintrusive_UnrolledSkipListMap_gc
+
+        The map stores its items in sorted chunks of up to \p Traits::chunk_capacity items.
+        The chunks form the bottom level of the skip-list, and the index levels
+        are built over chunks only: the index is \p cds::intrusive::SkipListSet
+        containing one tower per chunk keyed by the lowest key of the chunk at its creation time.
+        So, the map makes one allocation per chunk instead of one per item, the index is
+        about \p chunk_capacity times smaller than the index of \p SkipListMap,
+        and a range of keys is stored contiguously.
+
+        Source:
+        - [2019] Kenneth Platz, Neeraj Mittal, S. Venkatesan "Concurrent Unrolled Skiplist"
+        - [1996] Philip L. Lehman, S. Bing Yao "Efficient Locking for Concurrent Operations on B-Trees"
+
+        Each chunk except the first one covers the key range from its low key to the low key of the next chunk.
+        The index is a hint only: the search finds the chunk with the greatest low key not greater than the key
+        in the index, locks it and moves to the right along the bottom level while the key is beyond the chunk range,
+        like B-link tree does. The operations lock the chunks in left-to-right order only:
+        - an insertion into full chunk splits it: the upper half is moved into a new chunk
+          which is linked after the full one and then is added to the index;
+        - an erasure merges the chunk with its successor when the chunk becomes sparse;
+          the successor is removed from the index and retired via \p GC.
+
+        The index is lock-free but the bottom level is not: each operation, including lookup,
+        locks the chunk it works with. Since the items are moved when chunks split or merge,
+        the map cannot return a pointer to an item: \p extract() returns the item extracted
+        and \p get() returns a copy of the item found as \p value_ptr owning pointer.
+        The items are accessed in-place only in functors of \p find(), \p update(), \p insert_with()
+        which are called under chunk lock.
+
+        Template arguments:
+        - \p GC - garbage collector: \p gc::HP, \p gc::DHP or \ref cds_urcu_gc "RCU type"
+        - \p Key - key type, should be copy-constructible
+        - \p T - mapped type, should be move-constructible
+        - \p Traits - map traits, default is \p unrolled_skip_list::traits.
+            It is possible to declare option-based map with \p unrolled_skip_list::make_traits metafunction
+            instead of \p Traits template argument. For example:
+            \code
+            #include <cds/container/unrolled_skip_list_map_hp.h>
+
+            typedef cds::container::UnrolledSkipListMap< cds::gc::HP, int, int,
+                typename cds::container::unrolled_skip_list::make_traits<
+                    cds::opt::less< std::less<int>>
+                    ,cds::container::unrolled_skip_list::chunk_capacity< 64 >
+                >::type
+            > map_type;
+            \endcode
+
+        \par Usage
+        There are different specializations of this template for each garbage collecting schema used.
+        You should include appropriate .h-file depending on GC you are using:
+        - for gc::HP: <tt> <cds/container/unrolled_skip_list_map_hp.h> </tt>
+        - for gc::DHP: <tt> <cds/container/unrolled_skip_list_map_dhp.h> </tt>
+        - for \ref cds_urcu_gc "RCU type": <tt> <cds/container/unrolled_skip_list_map_rcu.h> </tt>
+
+        \par RCU
+        The chunk locks are not RCU-compatible: a thread holding a chunk lock may wait for RCU grace period
+        when it changes the index. So, for RCU the search locks the chunk found by \p try_lock() inside RCU critical section
+        and repeats the search after back-off if the chunk is busy; \p Traits::lock_type must support \p try_lock().
+        The map functions lock RCU internally, they must not be called inside RCU critical section.
+    */
+    template <
+        typename GC,
+        typename Key,
+        typename T,
+#ifdef CDS_DOXYGEN_INVOKED
+        typename Traits = unrolled_skip_list::traits
+#else
+        typename Traits
+#endif
+    >
+    class UnrolledSkipListMap:
+#ifdef CDS_DOXYGEN_INVOKED
+        protected intrusive::SkipListSet< GC, unrolled_skip_list::chunk< GC, Key, std::pair<Key const, T>, typename Traits::lock_type, Traits::chunk_capacity >, Traits >
+#else
+        protected unrolled_skip_list::details::make_unrolled_skip_list_map< GC, Key, T, Traits >::type
+#endif
+    {
+        //@cond
+        typedef unrolled_skip_list::details::make_unrolled_skip_list_map< GC, Key, T, Traits > maker;
+        typedef typename maker::type base_class;
+        //@endcond
+    public:
+        typedef GC      gc;             ///< Garbage collector used
+        typedef Key     key_type;       ///< Key type
+        typedef T       mapped_type;    ///< Mapped type
+        typedef Traits  traits;         ///< Map traits
+#   ifdef CDS_DOXYGEN_INVOKED
+        typedef std::pair< key_type const, mapped_type> value_type;   ///< Value type stored in the map
+#   else
+        typedef typename maker::value_type  value_type;
+#   endif
+
+        typedef typename maker::key_comparator  key_comparator; ///< key comparison functor
+        typedef typename traits::item_counter   item_counter;   ///< Item counting policy used
+        typedef typename traits::memory_model   memory_model;   ///< Memory ordering. See cds::opt::memory_model option
+        typedef typename traits::stat           stat;           ///< Internal statistics
+        typedef typename traits::lock_type      lock_type;      ///< Chunk lock type
+        typedef typename traits::random_level_generator random_level_generator; ///< random level generator of the index
+
+        /// Maximum number of items stored in a chunk
+        static CDS_CONSTEXPR const size_t c_nChunkCapacity = maker::c_nChunkCapacity;
+
+        /// Count of hazard pointer required for the algorithm (0 for RCU)
+        static CDS_CONSTEXPR const size_t c_nHazardPtrCount = base_class::c_nHazardPtrCount;
+
+    protected:
+        //@cond
+        typedef typename maker::chunk_type          chunk_type;
+        typedef typename maker::cxx_chunk_allocator cxx_chunk_allocator;
+        typedef cds::details::Allocator< value_type, typename traits::allocator > cxx_value_allocator;
+
+        typedef std::unique_lock< lock_type > scoped_lock;
+
+        static CDS_CONSTEXPR const size_t c_nMergeThreshold = c_nChunkCapacity / 4;
+        //@endcond
+
+    public:
+        //@cond
+        struct value_disposer {
+            void operator()( value_type * p ) const
+            {
+                cxx_value_allocator().Delete( p );
+            }
+        };
+        //@endcond
+
+        /// Owning pointer to a value detached from the map
+        /**
+            The pointer is a result of \p extract(), \p get() and their derivatives.
+            For \p extract() it owns the item removed from the map,
+            for \p get() it owns a copy of the item found.
+        */
+        typedef std::unique_ptr< value_type, value_disposer > value_ptr;
+
+    public:
+        /// Default ctor
+        UnrolledSkipListMap()
+        {}
+
+        /// Destructor clears the map
+        ~UnrolledSkipListMap()
+        {
+            clear();
+        }
+
+    public:
+        /// Inserts new node with key and default value
+        /**
+            The function creates a node with \p key and default value, and then inserts the node created into the map.
+
+            Preconditions:
+            - The \p key_type should be constructible from a value of type \p K.
+            - The \p mapped_type should be default-constructible.
+
+            Returns \p true if inserting successful, \p false otherwise.
+        */
+        template <typename K>
+        bool insert( K const& key )
+        {
+            return insert_( key, []( value_type& ) {}, key_type( key ), mapped_type());
+        }
+
+        /// Inserts new node
+        /**
+            The function creates a node with copy of \p val value
+            and then inserts the node created into the map.
+
+            Preconditions:
+            - The \p key_type should be constructible from \p key of type \p K.
+            - The \p mapped_type should be constructible from \p val of type \p V.
+
+            Returns \p true if \p val is inserted into the map, \p false otherwise.
+        */
+        template <typename K, typename V>
+        bool insert( K const& key, V const& val )
+        {
+            return insert_( key, []( value_type& ) {}, key_type( key ), mapped_type( val ));
+        }
+
+        /// Inserts new node and initialize it by a functor
+        /**
+            This function inserts new node with key \p key and if inserting is successful then it calls
+            \p func functor with signature
+            \code
+                struct functor {
+                    void operator()( value_type& item );
+                };
+            \endcode
+
+            The argument \p item of user-defined functor \p func is the reference
+            to the map's item inserted. The functor is called under chunk lock.
+
+            Returns \p true if \p key is inserted into the map, \p false otherwise.
+        */
+        template <typename K, typename Func>
+        bool insert_with( K const& key, Func func )
+        {
+            return insert_( key, func, key_type( key ), mapped_type());
+        }
+
+        /// For key \p key inserts data of type \p mapped_type created in-place from \p args
+        /**
+            Returns \p true if inserting successful, \p false otherwise.
+        */
+        template <typename K, typename... Args>
+        bool emplace( K&& key, Args&&... args )
+        {
+            key_type k( std::forward<K>( key ));
+            // The item is constructed only if the key is not found
+            return insert_( k, []( value_type& ) {}, std::piecewise_construct,
+                std::forward_as_tuple( std::move( k )), std::forward_as_tuple( std::forward<Args>( args )... ));
+        }
+
+        /// Updates data by \p key
+        /**
+            The operation performs inserting or changing data.
+
+            If the \p key not found in the map, then the new item created from \p key
+            will be inserted into the map iff \p bInsert is \p true
+            (note that in this case the \ref key_type should be constructible from type \p K).
+            Otherwise, if \p key is found, the functor \p func is called with item found.
+            The functor \p Func signature:
+            \code
+                struct my_functor {
+                    void operator()( bool bNew, value_type& item );
+                };
+            \endcode
+            where:
+            - \p bNew - \p true if the item has been inserted, \p false otherwise
+            - \p item - item of the map
+
+            The functor is called under chunk lock.
+
+            Returns <tt> std::pair<bool, bool> </tt> where \p first is \p true if operation is successful,
+            \p second is \p true if new item has been added or \p false if the item with \p key
+            already exists.
+        */
+        template <typename K, typename Func>
+        std::pair<bool, bool> update( K const& key, Func func, bool bInsert = true )
+        {
+            chunk_type * pChunk = lock_chunk( key );
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            bool bFound;
+            size_t nPos = lower_bound( *pChunk, key, bFound );
+            if ( bFound ) {
+                func( false, pChunk->data( nPos ));
+                m_Stat.onUpdateExisting();
+                return std::make_pair( true, false );
+            }
+
+            if ( !bInsert )
+                return std::make_pair( false, false );
+
+            chunk_type * pTarget;
+            value_type& item = emplace_at( pChunk, nPos, pTarget, key_type( key ), mapped_type());
+            scoped_lock alTarget;
+            if ( pTarget != pChunk )
+                alTarget = scoped_lock( pTarget->m_Lock, std::adopt_lock );
+
+            ++m_ItemCounter;
+            func( true, item );
+            m_Stat.onUpdateNew();
+            return std::make_pair( true, true );
+        }
+
+        /// Delete \p key from the map
+        /**
+            Return \p true if \p key is found and deleted, \p false otherwise
+        */
+        template <typename K>
+        bool erase( K const& key )
+        {
+            return erase_( key, []( value_type const& ) {} );
+        }
+
+        /// Delete \p key from the map
+        /**
+            The function searches an item with key \p key, calls \p f functor
+            and deletes the item. If \p key is not found, the functor is not called.
+
+            The functor \p Func interface:
+            \code
+            struct extractor {
+                void operator()(value_type& item) { ... }
+            };
+            \endcode
+
+            Return \p true if key is found and deleted, \p false otherwise
+        */
+        template <typename K, typename Func>
+        bool erase( K const& key, Func f )
+        {
+            return erase_( key, f );
+        }
+
+        /// Extracts the item from the map with specified \p key
+        /**
+            The function searches an item with key equal to \p key in the map,
+            removes it from the map and returns the owning pointer to the item found.
+            If \p key is not found the function returns an empty pointer.
+        */
+        template <typename K>
+        value_ptr extract( K const& key )
+        {
+            value_ptr p;
+            erase_( key, [&p]( value_type& item ) { p.reset( cxx_value_allocator().MoveNew( std::move( item ))); } );
+            return p;
+        }
+
+        /// Extracts the item with minimal key from the map
+        /**
+            The function searches an item with minimal key, removes it
+            and returns the owning pointer to the item found.
+            If the map is empty the function returns an empty pointer.
+        */
+        value_ptr extract_min()
+        {
+            value_ptr p;
+            chunk_type * pChunk = lock_min();
+            if ( !pChunk ) {
+                m_Stat.onExtractMinFailed();
+                return p;
+            }
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            p.reset( cxx_value_allocator().MoveNew( std::move( pChunk->data( 0 ))));
+            remove_at( pChunk, 0 );
+            m_Stat.onExtractMinSuccess();
+            return p;
+        }
+
+        /// Extracts the item with maximal key from the map
+        /**
+            The function searches an item with maximal key, removes it
+            and returns the owning pointer to the item found.
+            If the map is empty the function returns an empty pointer.
+        */
+        value_ptr extract_max()
+        {
+            value_ptr p;
+            chunk_type * pChunk = lock_max();
+            if ( !pChunk ) {
+                m_Stat.onExtractMaxFailed();
+                return p;
+            }
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            size_t const nPos = pChunk->m_nCount - 1;
+            p.reset( cxx_value_allocator().MoveNew( std::move( pChunk->data( nPos ))));
+            remove_at( pChunk, nPos );
+            m_Stat.onExtractMaxSuccess();
+            return p;
+        }
+
+        /// Finds the key \p key
+        /**
+            The function searches the item with key equal to \p key and calls the functor \p f for item found.
+            The interface of \p Func functor is:
+            \code
+            struct functor {
+                void operator()( value_type& item );
+            };
+            \endcode
+            where \p item is the item found.
+
+            The functor may change \p item.second. The functor is called under chunk lock.
+
+            The function returns \p true if \p key is found, \p false otherwise.
+        */
+        template <typename K, typename Func>
+        bool find( K const& key, Func f )
+        {
+            chunk_type * pChunk = lock_chunk( key );
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            bool bFound;
+            size_t nPos = lower_bound( *pChunk, key, bFound );
+            if ( bFound ) {
+                f( pChunk->data( nPos ));
+                m_Stat.onFindSuccess();
+                return true;
+            }
+            m_Stat.onFindFailed();
+            return false;
+        }
+
+        /// Checks whether the map contains \p key
+        template <typename K>
+        bool contains( K const& key )
+        {
+            return find( key, []( value_type& ) {} );
+        }
+
+        /// Finds \p key and returns a copy of the item found
+        /**
+            The function searches the item with key equal to \p key
+            and returns the owning pointer to a copy of the item found.
+            If \p key is not found the function returns an empty pointer.
+        */
+        template <typename K>
+        value_ptr get( K const& key )
+        {
+            value_ptr p;
+            find( key, [&p]( value_type& item ) { p.reset( cxx_value_allocator().New( item )); } );
+            return p;
+        }
+
+        /// Returns a copy of the item with minimal key
+        /**
+            If the map is empty the function returns an empty pointer.
+        */
+        value_ptr get_min()
+        {
+            value_ptr p;
+            chunk_type * pChunk = lock_min();
+            if ( pChunk ) {
+                scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+                p.reset( cxx_value_allocator().New( pChunk->data( 0 )));
+            }
+            return p;
+        }
+
+        /// Returns a copy of the item with maximal key
+        /**
+            If the map is empty the function returns an empty pointer.
+        */
+        value_ptr get_max()
+        {
+            value_ptr p;
+            chunk_type * pChunk = lock_max();
+            if ( pChunk ) {
+                scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+                p.reset( cxx_value_allocator().New( pChunk->data( pChunk->m_nCount - 1 )));
+            }
+            return p;
+        }
+
+        /// Clears the map
+        /**
+            The function is not atomic: the items inserted concurrently can remain in the map.
+        */
+        void clear()
+        {
+            chunk_type * pHead = &m_Head;
+            scoped_lock al( pHead->m_Lock );
+            while ( true ) {
+                m_ItemCounter -= pHead->m_nCount;
+                pHead->clear();
+
+                chunk_type * pNext = pHead->m_pNext;
+                if ( !pNext )
+                    break;
+
+                pNext->m_Lock.lock();
+                m_ItemCounter -= pNext->m_nCount;
+                pNext->clear();
+                merge_next( pHead, pNext );
+            }
+        }
+
+        /// Checks if the map is empty
+        bool empty() const
+        {
+            // Only the last chunk can be empty, see remove_at()
+            scoped_lock al( m_Head.m_Lock );
+            return m_Head.m_nCount == 0 && m_Head.m_pNext == nullptr;
+        }
+
+        /// Returns item count in the map
+        /**
+            The value returned depends on item counter type provided by \p Traits template parameter.
+            For \p atomicity::empty_item_counter the function always returns 0.
+            Therefore, the function is not suitable for checking the map emptiness, use \p empty()
+            member function for this purpose.
+        */
+        size_t size() const
+        {
+            return m_ItemCounter.value();
+        }
+
+        /// Returns const reference to internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+    protected:
+        //@cond
+        template <typename K>
+        size_t lower_bound( chunk_type const& c, K const& key, bool& bFound ) const
+        {
+            key_comparator cmp;
+            size_t nLow = 0;
+            size_t nHigh = c.m_nCount;
+            while ( nLow < nHigh ) {
+                size_t const nMid = ( nLow + nHigh ) / 2;
+                if ( cmp( c.data( nMid ).first, key ) < 0 )
+                    nLow = nMid + 1;
+                else
+                    nHigh = nMid;
+            }
+            bFound = nLow < c.m_nCount && cmp( c.data( nLow ).first, key ) == 0;
+            return nLow;
+        }
+
+        // Returns the locked chunk whose range contains key
+        template <typename K>
+        chunk_type * lock_chunk( K const& key )
+        {
+            chunk_type * pChunk = base_class::lock_predecessor( key, true, m_Head, m_Stat );
+
+            // While pChunk is locked its successor cannot be removed
+            key_comparator cmp;
+            for ( chunk_type * pNext = pChunk->m_pNext; pNext && cmp( pNext->low_key(), key ) <= 0; pNext = pChunk->m_pNext ) {
+                pNext->m_Lock.lock();
+                pChunk->m_Lock.unlock();
+                pChunk = pNext;
+                m_Stat.onChunkStepRight();
+            }
+            return pChunk;
+        }
+
+        // Returns the locked first non-empty chunk or nullptr if the map is empty
+        chunk_type * lock_min()
+        {
+            chunk_type * pChunk = &m_Head;
+            pChunk->m_Lock.lock();
+            while ( pChunk->m_nCount == 0 ) {
+                chunk_type * pNext = pChunk->m_pNext;
+                if ( !pNext ) {
+                    pChunk->m_Lock.unlock();
+                    return nullptr;
+                }
+                pNext->m_Lock.lock();
+                pChunk->m_Lock.unlock();
+                pChunk = pNext;
+            }
+            return pChunk;
+        }
+
+        // Returns the locked last non-empty chunk or nullptr if the map is empty
+        chunk_type * lock_max()
+        {
+            chunk_type * pChunk = base_class::lock_last( m_Head, m_Stat );
+
+            while ( true ) {
+                // Only the last chunk can be empty
+                for ( chunk_type * pNext = pChunk->m_pNext; pNext; pNext = pChunk->m_pNext ) {
+                    pNext->m_Lock.lock();
+                    if ( pNext->m_nCount == 0 && pNext->m_pNext == nullptr ) {
+                        pNext->m_Lock.unlock();
+                        return pChunk;
+                    }
+                    pChunk->m_Lock.unlock();
+                    pChunk = pNext;
+                }
+
+                // pChunk is the last chunk
+                if ( pChunk->m_nCount != 0 )
+                    return pChunk;
+                if ( pChunk == &m_Head ) {
+                    pChunk->m_Lock.unlock();
+                    return nullptr;
+                }
+
+                // The last chunk is empty: search again from the chunk preceding it in the index.
+                // The key is copied since the chunk can be retired after unlocking
+                key_type const key( pChunk->low_key());
+                pChunk->m_Lock.unlock();
+                pChunk = base_class::lock_predecessor( key, false, m_Head, m_Stat );
+            }
+        }
+
+        template <typename K, typename Func, typename... Args>
+        bool insert_( K const& key, Func f, Args&&... args )
+        {
+            chunk_type * pChunk = lock_chunk( key );
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            bool bFound;
+            size_t nPos = lower_bound( *pChunk, key, bFound );
+            if ( bFound ) {
+                m_Stat.onInsertFailed();
+                return false;
+            }
+
+            chunk_type * pTarget;
+            value_type& item = emplace_at( pChunk, nPos, pTarget, std::forward<Args>( args )... );
+            scoped_lock alTarget;
+            if ( pTarget != pChunk )
+                alTarget = scoped_lock( pTarget->m_Lock, std::adopt_lock );
+
+            ++m_ItemCounter;
+            f( item );
+            m_Stat.onInsertSuccess();
+            return true;
+        }
+
+        template <typename K, typename Func>
+        bool erase_( K const& key, Func f )
+        {
+            chunk_type * pChunk = lock_chunk( key );
+            scoped_lock al( pChunk->m_Lock, std::adopt_lock );
+
+            bool bFound;
+            size_t nPos = lower_bound( *pChunk, key, bFound );
+            if ( !bFound ) {
+                m_Stat.onEraseFailed();
+                return false;
+            }
+
+            f( pChunk->data( nPos ));
+            remove_at( pChunk, nPos );
+            m_Stat.onEraseSuccess();
+            return true;
+        }
+
+        // Inserts new item at position nPos of the locked chunk pChunk, splits the chunk if it is full.
+        // On return pTarget is the chunk containing the item inserted; pTarget is locked as well as pChunk
+        template <typename... Args>
+        value_type& emplace_at( chunk_type * pChunk, size_t nPos, chunk_type *& pTarget, Args&&... args )
+        {
+            pTarget = pChunk;
+            if ( pChunk->full()) {
+                chunk_type * pNew = split( pChunk );
+                if ( nPos > pChunk->m_nCount ) {
+                    nPos -= pChunk->m_nCount;
+                    pTarget = pNew;
+                }
+                else
+                    pNew->m_Lock.unlock();
+            }
+            return pTarget->emplace( nPos, std::forward<Args>( args )... );
+        }
+
+        // Moves the upper half of the locked full chunk into new chunk linked after it.
+        // Returns new chunk locked
+        chunk_type * split( chunk_type * pChunk )
+        {
+            size_t const nHalf = pChunk->m_nCount / 2;
+            chunk_type * pNew = cxx_chunk_allocator().New( pChunk->data( nHalf ).first );
+            pChunk->move_to( *pNew, nHalf );
+
+            pNew->m_Lock.lock();
+            pNew->m_pNext = pChunk->m_pNext;
+            pChunk->m_pNext = pNew;
+
+            // The index is changed under the lock of the previous chunk,
+            // so merge_next() sees the actual m_bIndexed
+            pNew->m_bIndexed = base_class::insert( *pNew );
+            if ( !pNew->m_bIndexed ) {
+                // A removed chunk with the same low key is still in the index.
+                // The new chunk is reachable from the bottom level only
+                m_Stat.onChunkIndexFailed();
+            }
+            m_Stat.onChunkSplit();
+            return pNew;
+        }
+
+        // Removes the item at nPos from the locked chunk and merges the chunk with its successor if it becomes sparse.
+        // An empty chunk is always merged, so only the last chunk can be empty
+        void remove_at( chunk_type * pChunk, size_t nPos )
+        {
+            pChunk->erase( nPos );
+            --m_ItemCounter;
+
+            if ( pChunk->m_nCount >= c_nMergeThreshold )
+                return;
+
+            chunk_type * pNext = pChunk->m_pNext;
+            if ( !pNext )
+                return;
+
+            pNext->m_Lock.lock();
+            if ( pChunk->m_nCount == 0 || pChunk->m_nCount + pNext->m_nCount <= c_nChunkCapacity / 2 ) {
+                pNext->move_to( *pChunk, 0 );
+                merge_next( pChunk, pNext );
+            }
+            else
+                pNext->m_Lock.unlock();
+        }
+
+        // Unlinks empty locked chunk pNext following locked pChunk. pNext is unlocked on return
+        void merge_next( chunk_type * pChunk, chunk_type * pNext )
+        {
+            assert( pChunk->m_pNext == pNext );
+            assert( pNext->m_nCount == 0 );
+            assert( !pNext->m_bRemoved );
+
+            pChunk->m_pNext = pNext->m_pNext;
+            pNext->m_bRemoved = true;
+
+            // The index is changed under the lock of pChunk, see split()
+            base_class::release_chunk( *pNext );
+            m_Stat.onChunkMerge();
+        }
+        //@endcond
+
+    private:
+        //@cond
+        chunk_type      m_Head;         // the first chunk, it is never removed
+        item_counter    m_ItemCounter;
+        mutable stat    m_Stat;
+        //@endcond
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_IMPL_UNROLLED_SKIP_LIST_MAP_H
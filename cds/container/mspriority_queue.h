@@ -75,7 +75,8 @@ namespace cds { namespace container {
         /// Metafunction converting option list to traits
         /**
             \p Options are:
-            - \p opt::buffer - the buffer type for heap array. Possible type are: \p opt::v::initiaized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+            - \p opt::buffer - the buffer type for heap array. Possible type are: \p opt::v::initiaized_static_buffer, \p opt::v::initialized_dynamic_buffer,
+                \p opt::v::initialized_segmented_buffer (growable heap, see \p cds::intrusive::MSPriorityQueue).
                 Default is \p %opt::v::initialized_dynamic_buffer.
                 You may specify any type of values for the buffer since at instantiation time
                 the \p buffer::rebind member metafunction is called to change the type of values stored in the buffer.
@@ -148,6 +149,8 @@ namespace cds { namespace container {
         typedef typename traits::allocator::template rebind<value_type>::other allocator_type; ///< Value allocator
         typedef typename traits::move_policy   move_policy; ///< Move policy for type \p T
 
+        static CDS_CONSTEXPR const bool c_bGrowable = base_class::c_bGrowable; ///< \p true if the heap grows when full
+
     protected:
         //@cond
         typedef cds::details::Allocator< value_type, allocator_type >  cxx_allocator;
@@ -165,6 +168,7 @@ namespace cds { namespace container {
         /// Constructs empty priority queue
         /**
             For \p cds::opt::v::initialized_static_buffer the \p nCapacity parameter is ignored.
+            For \p cds::opt::v::initialized_segmented_buffer \p nCapacity is the initial capacity.
         */
         MSPriorityQueue( size_t nCapacity )
             : base_class( nCapacity )
@@ -0,0 +1,539 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_MULTI_PRIORITY_QUEUE_H
+#define CDSLIB_CONTAINER_MULTI_PRIORITY_QUEUE_H
+
+#include <mutex>        // std::unique_lock
+#include <vector>
+#include <algorithm>    // std::push_heap, std::pop_heap
+#include <cds/container/details/base.h>
+#include <cds/sync/spinlock.h>
+#include <cds/opt/compare.h>
+#include <cds/os/topology.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace container {
+
+    /// MultiPriorityQueue related definitions
+    /** @ingroup cds_nonintrusive_helper
+    */
+    namespace multi_priority_queue {
+
+        /// MultiPriorityQueue statistics
+        template <typename Counter = cds::atomicity::event_counter>
+        struct stat {
+            typedef Counter   event_counter ; ///< Event counter type
+
+            event_counter   m_nPushCount;       ///< Count of push operations
+            event_counter   m_nPopCount;        ///< Count of success pop operations
+            event_counter   m_nPopFailCount;    ///< Count of failed ("the queue is empty") pop operations
+            event_counter   m_nPushContention;  ///< Count of events when \p push() failed to lock the chosen heap and has chosen another one
+            event_counter   m_nPopContention;   ///< Count of events when \p pop() failed to lock the chosen heap
+            event_counter   m_nPopEmptyPair;    ///< Count of events when both heaps chosen by \p pop() were empty
+            event_counter   m_nPopScan;         ///< Count of full heap scans performed by \p pop()
+
+            //@cond
+            void onPushSuccess()        { ++m_nPushCount;     }
+            void onPopSuccess()         { ++m_nPopCount;      }
+            void onPopFailed()          { ++m_nPopFailCount;  }
+            void onPushContention()     { ++m_nPushContention;}
+            void onPopContention()      { ++m_nPopContention; }
+            void onPopEmptyPair()       { ++m_nPopEmptyPair;  }
+            void onPopScan()            { ++m_nPopScan;       }
+            //@endcond
+        };
+
+        /// MultiPriorityQueue empty statistics
+        struct empty_stat {
+            //@cond
+            void onPushSuccess()        const {}
+            void onPopSuccess()         const {}
+            void onPopFailed()          const {}
+            void onPushContention()     const {}
+            void onPopContention()      const {}
+            void onPopEmptyPair()       const {}
+            void onPopScan()            const {}
+            //@endcond
+        };
+
+        /// MultiPriorityQueue traits
+        struct traits {
+            /// Priority compare functor
+            /**
+                No default functor is provided. If the option is not specified, the \p less is used.
+            */
+            typedef opt::none       compare;
+
+            /// Specifies binary predicate used for priority comparing.
+            /**
+                Default is \p std::less<T>.
+            */
+            typedef opt::none       less;
+
+            /// Type of the lock protecting each sequential heap. The lock should support \p try_lock()
+            typedef cds::sync::spin lock_type;
+
+            /// Random number generator used to choose the heaps
+            /**
+                The generator is shared by all threads working with the queue, so it must be thread-safe.
+                Default is \p cds::opt::v::xorshift_rand that keeps its state in thread-local storage.
+            */
+            typedef cds::opt::v::xorshift_rand random_engine;
+
+            /// The allocator used to allocate the heaps and their items
+            typedef CDS_DEFAULT_ALLOCATOR   allocator;
+
+            /// Move policy
+            /**
+                The move policy used in \p MultiPriorityQueue::pop() function to move item's value.
+                Default is \p opt::v::assignment_move_policy.
+            */
+            typedef cds::opt::v::assignment_move_policy  move_policy;
+
+            /// Padding for the sequential heaps
+            /**
+                Each heap with its lock is padded to avoid false sharing.
+                Default is \p opt::cache_line_padding
+            */
+            enum { padding = opt::cache_line_padding };
+
+            /// Internal statistics
+            /**
+                Possible types: \p multi_priority_queue::empty_stat (the default, no overhead), \p multi_priority_queue::stat
+                or any other with interface like \p %multi_priority_queue::stat
+            */
+            typedef empty_stat      stat;
+        };
+
+        /// Metafunction converting option list to traits
+        /**
+            \p Options:
+            - \p opt::compare - priority compare functor. No default functor is provided.
+                If the option is not specified, the \p opt::less is used.
+            - \p opt::less - specifies binary predicate used for priority compare. Default is \p std::less<T>.
+            - \p opt::lock_type - lock type of each heap, it should support \p try_lock(). Default is \p cds::sync::spin
+            - \p opt::random_engine - thread-safe random number generator used to choose the heaps.
+                Default is \p opt::v::xorshift_rand
+            - \p opt::allocator - allocator (like \p std::allocator) for the heaps and their items.
+                Default is \ref CDS_DEFAULT_ALLOCATOR
+            - \p opt::move_policy - policy for moving item's value. Default is \p opt::v::assignment_move_policy.
+            - \p opt::padding - padding for the heaps. Default is \p opt::cache_line_padding
+            - \p opt::stat - internal statistics. Available types: \p multi_priority_queue::stat, \p multi_priority_queue::empty_stat (the default, no overhead)
+        */
+        template <typename... Options>
+        struct make_traits {
+#   ifdef CDS_DOXYGEN_INVOKED
+            typedef implementation_defined type ;   ///< Metafunction result
+#   else
+            typedef typename cds::opt::make_options<
+                typename cds::opt::find_type_traits< traits, Options... >::type
+                ,Options...
+            >::type   type;
+#   endif
+        };
+
+    }   // namespace multi_priority_queue
+
+    /// Relaxed concurrent priority queue based on MultiQueue
+    /** @ingroup cds_nonintrusive_priority_queue
+        Source:
+            - [2015] H.Rihani, P.Sanders, R.Dementiev "MultiQueues: Simple Relaxed Concurrent Priority Queues"
+
+        The queue consists of \p c*p sequential binary heaps, where \p p is the number of threads
+        and \p c is a small constant; each heap is protected by its own lock.
+        \p push() inserts the item into a randomly chosen heap that is not locked at the moment.
+        \p pop() chooses two heaps at random and removes the top item of the heap whose top
+        has the higher priority. Thus, no operation serializes on a single lock or a combiner,
+        and the queue scales with the number of threads.
+
+        The price is relaxed semantics: \p pop() returns an item with a high priority,
+        but not necessarily the item with the highest priority in the queue.
+        The expected rank of the popped item is \p O(c*p). Items with the same priority
+        are popped in arbitrary order. The queue is well suited for schedulers
+        and for other algorithms that tolerate priority inversions, like parallel SSSP.
+
+        \p pop() returns \p false only if it has found all heaps empty during the full scan;
+        the item being pushed concurrently may be missed.
+
+        Template parameters:
+        - \p T - type to be stored in the queue. The priority is a part of \p T type.
+            The type should be default-constructible and movable.
+        - \p Traits - type traits. See \p multi_priority_queue::traits for explanation.
+            It is possible to declare option-based queue with \p multi_priority_queue::make_traits
+            metafunction instead of \p Traits template argument.
+    */
+    template <typename T, class Traits = multi_priority_queue::traits >
+    class MultiPriorityQueue
+    {
+    public:
+        typedef T           value_type  ;   ///< Value type stored in the queue
+        typedef Traits      traits      ;   ///< Traits template parameter
+
+#   ifdef CDS_DOXYGEN_INVOKED
+        typedef implementation_defined key_comparator  ;    ///< priority comparing functor based on opt::compare and opt::less option setter.
+#   else
+        typedef typename opt::details::make_comparator< value_type, traits >::type key_comparator;
+#   endif
+
+        typedef typename traits::lock_type      lock_type;      ///< heap's lock type
+        typedef typename traits::random_engine  random_engine;  ///< Random number generator
+        typedef typename traits::move_policy    move_policy;    ///< Move policy for type \p T
+        typedef typename traits::stat           stat;           ///< internal statistics type
+
+        /// Default heap count per processor (\p c constant of the algorithm)
+        static CDS_CONSTEXPR const size_t c_nDefaultHeapFactor = 2;
+
+    protected:
+        //@cond
+        struct heap_less {
+            bool operator()( value_type const& v1, value_type const& v2 ) const
+            {
+                return key_comparator()( v1, v2 ) < 0;
+            }
+        };
+
+        typedef typename traits::allocator::template rebind<value_type>::other value_allocator;
+
+        struct heap_type {
+            lock_type                           lock;
+            atomics::atomic<size_t>             nSize;  // the size of items, can be read without lock
+            std::vector<value_type, value_allocator> items;
+
+            heap_type()
+                : nSize( 0 )
+            {}
+        };
+
+        typedef typename opt::details::apply_padding< heap_type, traits::padding >::type padded_heap;
+        typedef typename traits::allocator::template rebind<padded_heap>::other heap_allocator;
+        typedef cds::details::Allocator< padded_heap, heap_allocator > cxx_heap_allocator;
+
+        typedef std::unique_lock<lock_type> scoped_lock;
+        //@endcond
+
+    public:
+        /// Constructs empty priority queue with <tt>c_nDefaultHeapFactor * processor_count</tt> heaps
+        MultiPriorityQueue()
+            : MultiPriorityQueue( c_nDefaultHeapFactor * cds::OS::topology::processor_count())
+        {}
+
+        /// Constructs empty priority queue with \p nHeapCount heaps
+        /**
+            \p nHeapCount should be about <tt>c * p</tt>, where \p p is the number of threads working with the queue
+            and \p c is 2..4. The more heaps, the less contention and the more relaxed the queue is.
+            If \p nHeapCount is less than 2, two heaps are used.
+        */
+        explicit MultiPriorityQueue( size_t nHeapCount )
+            : m_nHeapCount( nHeapCount < 2 ? 2 : nHeapCount )
+            , m_Heaps( cxx_heap_allocator().NewArray( m_nHeapCount ))
+        {}
+
+        /// Clears priority queue and destructs the object
+        ~MultiPriorityQueue()
+        {
+            cxx_heap_allocator().Delete( m_Heaps, m_nHeapCount );
+        }
+
+        /// Inserts a copy of \p val into priority queue
+        /**
+            The queue is unbounded, so the function always returns \p true.
+        */
+        bool push( value_type const& val )
+        {
+            do_push( [&val]( std::vector<value_type, value_allocator>& items ) { items.push_back( val ); } );
+            return true;
+        }
+
+        /// Inserts \p val into priority queue by moving
+        bool push( value_type&& val )
+        {
+            do_push( [&val]( std::vector<value_type, value_allocator>& items ) { items.push_back( std::move( val )); } );
+            return true;
+        }
+
+        /// Inserts an item into the queue using a functor
+        /**
+            \p Func is a functor called to initialize new item.
+            The functor \p f takes one argument - a reference to a new item of type \ref value_type :
+            \code
+            cds::container::MultiPriorityQueue< Foo > myQueue;
+            Bar bar;
+            myQueue.push_with( [&bar]( Foo& dest ) { dest = bar; } );
+            \endcode
+            The functor is called without any lock held.
+        */
+        template <typename Func>
+        bool push_with( Func f )
+        {
+            value_type val;
+            f( val );
+            return push( std::move( val ));
+        }
+
+        /// Inserts an item constructed from \p args into priority queue
+        template <typename... Args>
+        bool emplace( Args&&... args )
+        {
+            return push( value_type( std::forward<Args>( args )... ));
+        }
+
+        /// Extracts an item with high priority
+        /**
+            If the priority queue is empty, the function returns \p false.
+            Otherwise, it returns \p true and \p dest contains the extracted item.
+            Note that the item extracted may be not the item with the highest priority in the queue,
+            see the class description.
+
+            The function uses \ref move_policy to move extracted value from the heap's top
+            to \p dest.
+        */
+        bool pop( value_type& dest )
+        {
+            return pop_with( [&dest]( value_type& src ) { move_policy()( dest, std::move( src )); } );
+        }
+
+        /// Extracts an item with high priority
+        /**
+            If the priority queue is empty, the function returns \p false.
+            Otherwise, it calls \p f for the extracted item and returns \p true.
+
+            \p Func is a functor called to move popped value.
+            The functor takes one argument - a reference to removed item:
+            \code
+            cds:container::MultiPriorityQueue< Foo > myQueue;
+            Bar bar;
+            myQueue.pop_with( [&bar]( Foo& src ) { bar = std::move( src );});
+            \endcode
+            The functor is called under the lock of the heap the item is extracted from.
+        */
+        template <typename Func>
+        bool pop_with( Func f )
+        {
+            while ( true ) {
+                heap_type * pHeap1 = &heap_at( m_Rand());
+                heap_type * pHeap2 = &heap_at( m_Rand());
+                if ( pHeap1 == pHeap2 || pHeap2->nSize.load( atomics::memory_order_acquire ) == 0 )
+                    pHeap2 = nullptr;
+                if ( pHeap1->nSize.load( atomics::memory_order_acquire ) == 0 ) {
+                    pHeap1 = pHeap2;
+                    pHeap2 = nullptr;
+                }
+
+                if ( !pHeap1 ) {
+                    m_Stat.onPopEmptyPair();
+                    return pop_scan( f );
+                }
+
+                scoped_lock l1( pHeap1->lock, std::try_to_lock );
+                if ( !l1.owns_lock()) {
+                    m_Stat.onPopContention();
+                    continue;
+                }
+
+                scoped_lock l2;
+                if ( pHeap2 ) {
+                    l2 = scoped_lock( pHeap2->lock, std::try_to_lock );
+                    if ( !l2.owns_lock()) {
+                        // Relax further: pop from the first heap only
+                        m_Stat.onPopContention();
+                        pHeap2 = nullptr;
+                    }
+                    else if ( pHeap2->items.empty()) {
+                        l2.unlock();
+                        pHeap2 = nullptr;
+                    }
+                }
+
+                if ( pHeap1->items.empty()) {
+                    if ( !pHeap2 )
+                        continue;
+                    l1.unlock();
+                    pHeap1 = pHeap2;
+                }
+                else if ( pHeap2 ) {
+                    if ( heap_less()( pHeap1->items.front(), pHeap2->items.front())) {
+                        l1.unlock();
+                        pHeap1 = pHeap2;
+                    }
+                    else
+                        l2.unlock();
+                }
+
+                pop_top( *pHeap1, f );
+                m_Stat.onPopSuccess();
+                return true;
+            }
+        }
+
+        /// Clears the queue (not atomic)
+        /**
+            This function is not atomic, but thread-safe
+        */
+        void clear()
+        {
+            clear_with( []( value_type& ) {} );
+        }
+
+        /// Clears the queue (not atomic)
+        /**
+            This function is not atomic, but thread-safe.
+
+            For each item removed the functor \p f is called.
+            \p Func interface is:
+            \code
+                struct clear_functor
+                {
+                    void operator()( value_type& item );
+                };
+            \endcode
+        */
+        template <typename Func>
+        void clear_with( Func f )
+        {
+            for ( size_t i = 0; i < m_nHeapCount; ++i ) {
+                heap_type& h = m_Heaps[i].data;
+                scoped_lock l( h.lock );
+                for ( auto& item : h.items )
+                    f( item );
+                h.items.clear();
+                h.nSize.store( 0, atomics::memory_order_release );
+            }
+        }
+
+        /// Checks is the priority queue is empty
+        /**
+            The function scans all heaps, its complexity is <tt>O( heap_count())</tt>.
+        */
+        bool empty() const
+        {
+            for ( size_t i = 0; i < m_nHeapCount; ++i ) {
+                if ( m_Heaps[i].data.nSize.load( atomics::memory_order_acquire ) != 0 )
+                    return false;
+            }
+            return true;
+        }
+
+        /// Returns current size of priority queue
+        /**
+            The function sums the sizes of all heaps, its complexity is <tt>O( heap_count())</tt>.
+            The result is approximate when the queue is modified concurrently.
+        */
+        size_t size() const
+        {
+            size_t nSize = 0;
+            for ( size_t i = 0; i < m_nHeapCount; ++i )
+                nSize += m_Heaps[i].data.nSize.load( atomics::memory_order_relaxed );
+            return nSize;
+        }
+
+        /// Returns the number of sequential heaps
+        size_t heap_count() const
+        {
+            return m_nHeapCount;
+        }
+
+        /// Returns const reference to internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+    protected:
+        //@cond
+        heap_type& heap_at( size_t nRandom )
+        {
+            return m_Heaps[ nRandom % m_nHeapCount ].data;
+        }
+
+        template <typename Func>
+        void do_push( Func fAppend )
+        {
+            while ( true ) {
+                heap_type& h = heap_at( m_Rand());
+                scoped_lock l( h.lock, std::try_to_lock );
+                if ( l.owns_lock()) {
+                    fAppend( h.items );
+                    std::push_heap( h.items.begin(), h.items.end(), heap_less());
+                    h.nSize.store( h.items.size(), atomics::memory_order_release );
+                    break;
+                }
+                m_Stat.onPushContention();
+            }
+            m_Stat.onPushSuccess();
+        }
+
+        template <typename Func>
+        void pop_top( heap_type& h, Func& f )
+        {
+            // h must be locked and not empty
+            assert( !h.items.empty());
+            std::pop_heap( h.items.begin(), h.items.end(), heap_less());
+            f( h.items.back());
+            h.items.pop_back();
+            h.nSize.store( h.items.size(), atomics::memory_order_release );
+        }
+
+        template <typename Func>
+        bool pop_scan( Func& f )
+        {
+            // Both random heaps are empty, look through all heaps starting from a random one
+            m_Stat.onPopScan();
+            size_t const nStart = m_Rand();
+            for ( size_t i = 0; i < m_nHeapCount; ++i ) {
+                heap_type& h = heap_at( nStart + i );
+                if ( h.nSize.load( atomics::memory_order_acquire ) == 0 )
+                    continue;
+
+                scoped_lock l( h.lock );
+                if ( !h.items.empty()) {
+                    pop_top( h, f );
+                    m_Stat.onPopSuccess();
+                    return true;
+                }
+            }
+
+            m_Stat.onPopFailed();
+            return false;
+        }
+        //@endcond
+
+    private:
+        //@cond
+        size_t const        m_nHeapCount;
+        padded_heap * const m_Heaps;
+        random_engine       m_Rand;
+        stat                m_Stat;
+        //@endcond
+    };
+
+}} // namespace cds::container
+
+#endif // #ifndef CDSLIB_CONTAINER_MULTI_PRIORITY_QUEUE_H
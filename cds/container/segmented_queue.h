@@ -327,6 +327,26 @@ namespace cds { namespace container {
             return enqueue( std::move( val ));
         }
 
+        /// Enqueues copies of the values from the range <tt>[first, last)</tt>
+        /**
+            See \p cds::intrusive::SegmentedQueue::enqueue_batch() for details.
+            Returns the number of enqueued values.
+        */
+        template <typename Iterator>
+        size_t enqueue_batch( Iterator first, Iterator last )
+        {
+            scoped_node_ptr p;
+            return base_class::do_enqueue_batch( [&first, &last, &p]() -> value_type * {
+                // the previous node has been enqueued
+                p.release();
+                if ( first == last )
+                    return nullptr;
+                p.reset( alloc_node( *first ));
+                ++first;
+                return p.get();
+            });
+        }
+
         /// Synonym for \p enqueue_with() member function
         template <typename Func>
         bool push_with( Func f )
@@ -380,6 +400,33 @@ namespace cds { namespace container {
             return false;
         }
 
+        /// Dequeues up to \p nMax values into array \p pOut
+        /**
+            Returns the number of dequeued values, 0 if the queue is empty.
+        */
+        size_t dequeue_batch( value_type * pOut, size_t nMax )
+        {
+            return dequeue_batch_with( [&pOut]( value_type& src ) { *pOut++ = std::move( src ); }, nMax );
+        }
+
+        /// Dequeues up to \p nMax values using a functor
+        /**
+            \p Func is called for each dequeued value:
+            \code
+            void f( value_type& src );
+            \endcode
+            See \p cds::intrusive::SegmentedQueue::dequeue_batch() for details.
+            Returns the number of dequeued values, 0 if the queue is empty.
+        */
+        template <typename Func>
+        size_t dequeue_batch_with( Func f, size_t nMax )
+        {
+            return base_class::do_dequeue_batch( [&f]( value_type * p ) {
+                f( *p );
+                gc::template retire< typename maker::node_disposer >( p );
+            }, nMax );
+        }
+
         /// Synonym for \p dequeue_with() function
         template <typename Func>
         bool pop_with( Func f )
@@ -97,7 +97,7 @@ namespace cds { namespace container {
 
         The \p Options are:
             - \p cds::opt::mutex_policy - concurrent access policy.
-                Available policies: \p striped_set::striping, \p striped_set::refinable.
+                Available policies: \p striped_set::striping, \p striped_set::seqlock_striping, \p striped_set::refinable.
                 Default is \p %striped_set::striping.
             - \p cds::opt::hash - hash functor. Default option value see <tt>opt::v::hash_selector<opt::none> </tt>
                 which selects default hash functor for your compiler.
@@ -278,6 +278,24 @@ namespace cds { namespace container {
                     <td>
                     </td>
                 </tr>
+                <tr>
+                    <td> \p striped_set::rcu_list</td>
+                    <td><tt><cds/container/striped_map/rcu_list.h></tt></td>
+                    <td>\code
+                        #include <cds/container/striped_map/rcu_list.h>
+                        #include <cds/container/striped_map.h>
+                        typedef cds::container::StripedMap<
+                            cds::container::striped_set::rcu_list< rcu_type, std::pair< Key const, T > >,
+                            cds::opt::mutex_policy< cds::container::striped_set::seqlock_striping<>>,
+                            cds::opt::less< std::less<Key> >
+                        > striped_map;
+                    \endcode
+                    </td>
+                    <td>
+                        The list is ordered; \p opt::less or \p opt::compare is required.
+                        With \p striped_set::seqlock_striping policy \p contains() does not lock the bucket.
+                    </td>
+                </tr>
             </table>
 
 
@@ -519,6 +537,9 @@ template <class Container, typename... Options>
         typedef typename base_class::allocator_type     allocator_type  ; ///< allocator type specified in options.
         typedef typename base_class::mutex_policy       mutex_policy    ; ///< Mutex policy
 
+        /// \p true if \p contains() does not lock the bucket, see \p striped_set::seqlock_striping
+        static CDS_CONSTEXPR const bool c_bOptimisticRead = base_class::c_bOptimisticRead;
+
     protected:
         //@cond
         typedef typename base_class::scoped_cell_lock   scoped_cell_lock;
@@ -0,0 +1,220 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_STRIPED_MAP_RCU_LIST_ADAPTER_H
+#define CDSLIB_CONTAINER_STRIPED_MAP_RCU_LIST_ADAPTER_H
+
+#include <utility>      // std::pair
+#include <cds/container/striped_set/rcu_list.h>
+
+//@cond
+namespace cds { namespace intrusive { namespace striped_set {
+
+    /// \p cds::container::striped_set::rcu_list adapter for hash map bucket
+    template <class RCU, typename Key, typename T, class Alloc, typename... Options>
+    class adapt< cds::container::striped_set::rcu_list< RCU, std::pair< Key const, T >, Alloc >, Options... >
+    {
+    public:
+        typedef cds::container::striped_set::rcu_list< RCU, std::pair< Key const, T >, Alloc > container_type; ///< underlying container type
+
+    private:
+        /// Adapted container type
+        class adapted_container
+            : public cds::container::striped_set::adapted_sequential_container
+            , public cds::container::striped_set::details::rcu_list_bucket< RCU, std::pair< Key const, T >, Alloc >
+        {
+            typedef cds::container::striped_set::details::rcu_list_bucket< RCU, std::pair< Key const, T >, Alloc > base_class;
+            typedef typename base_class::node       node;
+            typedef typename base_class::link_type  link_type;
+
+        public:
+            typedef typename base_class::value_type     value_type;
+            typedef typename value_type::first_type     key_type;
+            typedef typename value_type::second_type    mapped_type;
+            typedef typename base_class::iterator       iterator;
+            typedef typename base_class::const_iterator const_iterator;
+
+            static bool const has_find_with = true;
+            static bool const has_erase_with = true;
+
+        private:
+            typedef typename cds::opt::details::make_comparator_from_option_list< value_type, Options... >::type key_comparator;
+
+            struct find_predicate
+            {
+                bool operator()( value_type const& i1, value_type const& i2 ) const
+                {
+                    return key_comparator()( i1.first, i2.first ) < 0;
+                }
+
+                template <typename Q>
+                bool operator()( Q const& i1, value_type const& i2 ) const
+                {
+                    return key_comparator()( i1, i2.first ) < 0;
+                }
+
+                template <typename Q>
+                bool operator()( value_type const& i1, Q const& i2 ) const
+                {
+                    return key_comparator()( i1.first, i2 ) < 0;
+                }
+            };
+
+        public:
+            template <typename Q, typename Func>
+            bool insert( const Q& key, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( key, pCur->m_Value.first ) != 0 ) {
+                    node * pNew = base_class::alloc_node( key_type( key ), mapped_type());
+                    f( pNew->m_Value );
+                    base_class::link( pPrev, pCur, pNew );
+                    return true;
+                }
+
+                // key already exists
+                return false;
+            }
+
+            template <typename K, typename... Args>
+            bool emplace( K&& key, Args&&... args )
+            {
+                node * pNew = base_class::alloc_node( key_type( std::forward<K>( key )), mapped_type( std::forward<Args>( args )... ));
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( pNew->m_Value.first, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( pNew->m_Value.first, pCur->m_Value.first ) != 0 ) {
+                    base_class::link( pPrev, pCur, pNew );
+                    return true;
+                }
+                base_class::free_node( pNew );
+                return false;
+            }
+
+            template <typename Q, typename Func>
+            std::pair<bool, bool> update( const Q& key, Func func, bool bAllowInsert )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( key, pCur->m_Value.first ) != 0 ) {
+                    // insert new
+                    if ( !bAllowInsert )
+                        return std::make_pair( false, false );
+
+                    node * pNew = base_class::alloc_node( key_type( key ), mapped_type());
+                    func( true, pNew->m_Value );
+                    base_class::link( pPrev, pCur, pNew );
+                    return std::make_pair( true, true );
+                }
+
+                // already exists
+                func( false, pCur->m_Value );
+                return std::make_pair( true, false );
+            }
+
+            template <typename Q, typename Func>
+            bool erase( Q const& key, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( key, pCur->m_Value.first ) != 0 )
+                    return false;
+
+                // key exists
+                f( pCur->m_Value );
+                base_class::unlink( pPrev, pCur );
+                return true;
+            }
+
+            template <typename Q, typename Less, typename Func>
+            bool erase( Q const& key, Less pred, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, pred, pCur );
+                if ( pCur == nullptr || pred( key, pCur->m_Value.first ) || pred( pCur->m_Value.first, key ))
+                    return false;
+
+                // key exists
+                f( pCur->m_Value );
+                base_class::unlink( pPrev, pCur );
+                return true;
+            }
+
+            template <typename Q, typename Func>
+            bool find( Q& val, Func f )
+            {
+                node * pCur;
+                base_class::lower_bound( val, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( val, pCur->m_Value.first ) != 0 )
+                    return false;
+
+                // key exists
+                f( pCur->m_Value, val );
+                return true;
+            }
+
+            template <typename Q, typename Less, typename Func>
+            bool find( Q& val, Less pred, Func f )
+            {
+                node * pCur;
+                base_class::lower_bound( val, pred, pCur );
+                if ( pCur == nullptr || pred( val, pCur->m_Value.first ) || pred( pCur->m_Value.first, val ))
+                    return false;
+
+                // key exists
+                f( pCur->m_Value, val );
+                return true;
+            }
+
+            template <typename Q>
+            bool optimistic_contains( Q const& key ) const
+            {
+                return base_class::lookup( key, find_predicate());
+            }
+
+            template <typename Q, typename Less>
+            bool optimistic_contains( Q const& key, Less pred ) const
+            {
+                return base_class::lookup( key, pred );
+            }
+
+            void move_item( adapted_container& from, iterator itWhat )
+            {
+                base_class::move_node( from, itWhat, find_predicate());
+            }
+        };
+
+    public:
+        typedef adapted_container type ; ///< Result of \p adapt metafunction
+    };
+}}} // namespace cds::intrusive::striped_set
+//@endcond
+
+#endif // #ifndef CDSLIB_CONTAINER_STRIPED_MAP_RCU_LIST_ADAPTER_H
@@ -62,7 +62,8 @@ namespace cds { namespace container {
 
         The \p Options are:
             - \p opt::mutex_policy - concurrent access policy.
-                Available policies: \p intrusive::striped_set::striping, \p intrusive::striped_set::refinable.
+                Available policies: \p intrusive::striped_set::striping, \p intrusive::striped_set::seqlock_striping,
+                \p intrusive::striped_set::refinable.
                 Default is \p %striped_set::striping.
             - \p opt::hash - hash functor. Default option value see <tt>opt::v::hash_selector<opt::none> </tt>
                 which selects default hash functor for your compiler.
@@ -294,6 +295,24 @@ namespace cds { namespace container {
                         For the best result, \p h1 and \p h2 must be orthogonal i.e. <tt> h1(X) != h2(X) </tt> for any value \p X.
                     </td>
                 </tr>
+                <tr>
+                    <td> \p striped_set::rcu_list</td>
+                    <td><tt><cds/container/striped_set/rcu_list.h></tt></td>
+                    <td>\code
+                        #include <cds/container/striped_set/rcu_list.h>
+                        #include <cds/container/striped_set.h>
+                        typedef cds::container::StripedSet<
+                            cds::container::striped_set::rcu_list< rcu_type, T >,
+                            cds::opt::mutex_policy< cds::container::striped_set::seqlock_striping<>>,
+                            cds::opt::less< std::less<T> >
+                        > striped_set;
+                    \endcode
+                    </td>
+                    <td>
+                        The list is ordered; \p opt::less or \p opt::compare is required.
+                        With \p striped_set::seqlock_striping policy \p contains() does not lock the bucket.
+                    </td>
+                </tr>
             </table>
 
             You can use another container type as set's bucket.
@@ -510,11 +529,15 @@ namespace cds { namespace container {
         typedef typename base_class::allocator_type     allocator_type  ; ///< allocator type specified in options.
         typedef typename base_class::mutex_policy       mutex_policy    ; ///< Mutex policy
 
+        /// \p true if \p contains() does not lock the bucket, see \p striped_set::seqlock_striping
+        static CDS_CONSTEXPR const bool c_bOptimisticRead = base_class::c_bOptimisticRead;
+
     protected:
         //@cond
         typedef typename base_class::scoped_cell_lock   scoped_cell_lock;
         typedef typename base_class::scoped_full_lock   scoped_full_lock;
         typedef typename base_class::scoped_resize_lock scoped_resize_lock;
+        typedef typename base_class::scoped_retire      scoped_retire;
         //@endcond
 
     public:
@@ -744,6 +767,7 @@ namespace cds { namespace container {
             bool bOk;
             size_t nHash = base_class::hashing( key );
             {
+                scoped_retire sr;
                 scoped_cell_lock sl( base_class::m_MutexPolicy, nHash );
                 bucket_type * pBucket = base_class::bucket( nHash );
 
@@ -773,6 +797,7 @@ namespace cds { namespace container {
             bool bOk;
             size_t nHash = base_class::hashing( key );
             {
+                scoped_retire sr;
                 scoped_cell_lock sl( base_class::m_MutexPolicy, nHash );
                 bucket_type * pBucket = base_class::bucket( nHash );
 
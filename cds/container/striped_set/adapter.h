@@ -226,6 +226,10 @@ namespace cds { namespace container {
         template <class Lock = std::mutex, class Alloc = CDS_DEFAULT_ALLOCATOR >
         using striping = cds::intrusive::striped_set::striping<Lock, Alloc>;
 
+        ///@copydoc cds::intrusive::striped_set::seqlock_striping
+        template <class Lock = cds::sync::spin, unsigned ReadAttempts = 4, class Alloc = CDS_DEFAULT_ALLOCATOR >
+        using seqlock_striping = cds::intrusive::striped_set::seqlock_striping<Lock, ReadAttempts, Alloc>;
+
         ///@copydoc cds::intrusive::striped_set::refinable
         template <
             class RecursiveLock = std::recursive_mutex,
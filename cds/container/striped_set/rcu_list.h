@@ -0,0 +1,512 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_STRIPED_SET_RCU_LIST_ADAPTER_H
+#define CDSLIB_CONTAINER_STRIPED_SET_RCU_LIST_ADAPTER_H
+
+#include <cds/container/striped_set/adapter.h>
+#include <cds/urcu/details/base.h>
+#include <cds/details/allocator.h>
+#include <functional>
+
+namespace cds { namespace container { namespace striped_set {
+
+    /// Ordered list bucket with lock-free lookup for \p StripedSet and \p StripedMap
+    /**
+        The bucket is a sorted singly-linked list that can be searched concurrently with modification.
+        The list is modified under the bucket lock as usual; the nodes deleted are freed by RCU
+        after the grace period, so a reader traversing the list never sees freed memory.
+        Retiring a node may wait for the end of the grace period, so the deleted nodes are collected
+        in a per-thread list and passed to RCU after the bucket lock is released.
+        Such bucket allows \p striped_set::seqlock_striping policy to perform \p contains() without locking.
+        With other mutex policies the list works like \p std::list.
+
+        The key part of the item must not be changed after inserting, and the comparator
+        must access only the key part: an optimistic reader compares the keys concurrently with \p update()
+        that can change non-key fields.
+
+        The bucket adapter is defined in <tt><cds/container/striped_set/rcu_list.h></tt> for the set
+        and in <tt><cds/container/striped_map/rcu_list.h></tt> for the map, where \p T should be
+        <tt>std::pair<Key const, Value></tt>.
+
+        Template arguments:
+        - \p RCU - one of \ref cds_urcu_gc "RCU type". The RCU singleton must be constructed
+            and each thread working with the set must be attached to the RCU.
+            The set modifying functions must not be called inside RCU read-side critical section
+            since they can wait for the end of the grace period.
+        - \p T - value type
+        - \p Alloc - node allocator, default is \p CDS_DEFAULT_ALLOCATOR
+
+        Example:
+        \code
+        #include <cds/urcu/general_buffered.h>
+        #include <cds/container/striped_set/rcu_list.h>
+        #include <cds/container/striped_set.h>
+
+        typedef cds::urcu::gc< cds::urcu::general_buffered<>> rcu_type;
+
+        typedef cds::container::StripedSet<
+            cds::container::striped_set::rcu_list< rcu_type, int >,
+            cds::opt::mutex_policy< cds::container::striped_set::seqlock_striping<>>,
+            cds::opt::less< std::less<int>>
+        > set_type;
+        \endcode
+    */
+    template <class RCU, typename T, class Alloc = CDS_DEFAULT_ALLOCATOR>
+    class rcu_list
+    {
+    public:
+        typedef RCU     gc;             ///< RCU type
+        typedef T       value_type;     ///< value type
+        typedef Alloc   allocator_type; ///< node allocator
+    };
+
+    //@cond
+    namespace details {
+
+        template <class RCU, typename T, class Alloc>
+        class rcu_list_bucket
+        {
+        public:
+            typedef RCU gc;
+            typedef T   value_type;
+
+            static bool const has_optimistic_contains = true;
+            static bool const has_deferred_retire = true;
+
+        protected:
+            struct node
+            {
+                atomics::atomic<node *> m_pNext;
+                node *                  m_pNextRetired; // m_pNext must be unchanged after unlinking
+                value_type              m_Value;
+
+                template <typename... Args>
+                explicit node( Args&&... args )
+                    : m_pNext( nullptr )
+                    , m_pNextRetired( nullptr )
+                    , m_Value( std::forward<Args>( args )... )
+                {}
+            };
+
+            typedef cds::details::Allocator< node, Alloc > node_allocator;
+
+            struct node_disposer {
+                void operator()( node * p ) const
+                {
+                    node_allocator().Delete( p );
+                }
+            };
+
+            typedef atomics::atomic<node *> link_type;
+
+            template <bool IsConst>
+            class iterator_type
+            {
+                friend class rcu_list_bucket;
+
+                node * m_pNode;
+
+            public:
+                typedef typename std::conditional< IsConst, value_type const&, value_type& >::type value_ref;
+                typedef typename std::conditional< IsConst, value_type const*, value_type* >::type value_ptr;
+
+                iterator_type()
+                    : m_pNode( nullptr )
+                {}
+
+                explicit iterator_type( node * p )
+                    : m_pNode( p )
+                {}
+
+                value_ref operator*() const
+                {
+                    assert( m_pNode );
+                    return m_pNode->m_Value;
+                }
+
+                value_ptr operator->() const
+                {
+                    assert( m_pNode );
+                    return &m_pNode->m_Value;
+                }
+
+                iterator_type& operator++()
+                {
+                    assert( m_pNode );
+                    m_pNode = m_pNode->m_pNext.load( atomics::memory_order_relaxed );
+                    return *this;
+                }
+
+                bool operator==( iterator_type const& i ) const
+                {
+                    return m_pNode == i.m_pNode;
+                }
+
+                bool operator!=( iterator_type const& i ) const
+                {
+                    return m_pNode != i.m_pNode;
+                }
+            };
+
+        public:
+            typedef iterator_type<false>    iterator;
+            typedef iterator_type<true>     const_iterator;
+
+        protected:
+            link_type   m_pHead;
+            size_t      m_nSize;
+
+        public:
+            rcu_list_bucket()
+                : m_pHead( nullptr )
+                , m_nSize( 0 )
+            {}
+
+            ~rcu_list_bucket()
+            {
+                // No reader can access the bucket in destructor
+                node * p = m_pHead.load( atomics::memory_order_relaxed );
+                while ( p ) {
+                    node * pNext = p->m_pNext.load( atomics::memory_order_relaxed );
+                    node_disposer()( p );
+                    p = pNext;
+                }
+            }
+
+            void clear()
+            {
+                node * p = m_pHead.load( atomics::memory_order_relaxed );
+                m_pHead.store( nullptr, atomics::memory_order_release );
+                m_nSize = 0;
+
+                while ( p ) {
+                    node * pNext = p->m_pNext.load( atomics::memory_order_relaxed );
+                    defer_retire( p );
+                    p = pNext;
+                }
+            }
+
+            iterator begin()                { return iterator( m_pHead.load( atomics::memory_order_relaxed )); }
+            const_iterator begin() const    { return const_iterator( m_pHead.load( atomics::memory_order_relaxed )); }
+            iterator end()                  { return iterator(); }
+            const_iterator end() const      { return const_iterator(); }
+
+            size_t size() const
+            {
+                return m_nSize;
+            }
+
+            // Retires the nodes removed by the current thread; must be called outside of the bucket lock
+            static void retire_deferred()
+            {
+                node *& pList = retired_list();
+                if ( !pList )
+                    return;
+
+                assert( !gc::is_locked());
+
+                node * p = pList;
+                pList = nullptr;
+
+                auto f = [&p]() -> cds::urcu::retired_ptr {
+                    node * pNode = p;
+                    if ( pNode ) {
+                        p = pNode->m_pNextRetired;
+                        return cds::urcu::make_retired_ptr< node_disposer >( pNode );
+                    }
+                    return cds::urcu::make_retired_ptr< node_disposer >( static_cast<node *>( nullptr ));
+                };
+                gc::batch_retire( std::ref( f ));
+            }
+
+        protected:
+            // Searches the first node not less than key; called under the bucket lock
+            template <typename Q, typename Less>
+            link_type * lower_bound( Q const& key, Less less, node *& pCur ) const
+            {
+                link_type * pPrev = const_cast<link_type *>( &m_pHead );
+                pCur = pPrev->load( atomics::memory_order_relaxed );
+                while ( pCur && less( pCur->m_Value, key )) {
+                    pPrev = &pCur->m_pNext;
+                    pCur = pPrev->load( atomics::memory_order_relaxed );
+                }
+                return pPrev;
+            }
+
+            // Lock-free search: the caller does not own the bucket lock
+            template <typename Q, typename Less>
+            bool lookup( Q const& key, Less less ) const
+            {
+                typename gc::scoped_lock rcuLock;
+
+                node * p = m_pHead.load( atomics::memory_order_acquire );
+                while ( p ) {
+                    if ( !less( p->m_Value, key ))
+                        return !less( key, p->m_Value );
+                    p = p->m_pNext.load( atomics::memory_order_acquire );
+                }
+                return false;
+            }
+
+            void link( link_type * pPrev, node * pCur, node * pNew )
+            {
+                pNew->m_pNext.store( pCur, atomics::memory_order_relaxed );
+                pPrev->store( pNew, atomics::memory_order_release );
+                ++m_nSize;
+            }
+
+            void unlink( link_type * pPrev, node * pCur )
+            {
+                // pCur->m_pNext is unchanged, so a reader staying on pCur continues the search
+                pPrev->store( pCur->m_pNext.load( atomics::memory_order_relaxed ), atomics::memory_order_release );
+                --m_nSize;
+                defer_retire( pCur );
+            }
+
+            template <typename Less>
+            void move_node( rcu_list_bucket& from, iterator itWhat, Less less )
+            {
+                // The node is relinked, not copied: a reader of the old bucket may stay on it
+                node * pNode = itWhat.m_pNode;
+                link_type * pPrev = &from.m_pHead;
+                while ( pPrev->load( atomics::memory_order_relaxed ) != pNode )
+                    pPrev = &pPrev->load( atomics::memory_order_relaxed )->m_pNext;
+                pPrev->store( pNode->m_pNext.load( atomics::memory_order_relaxed ), atomics::memory_order_release );
+                --from.m_nSize;
+
+                node * pCur;
+                pPrev = lower_bound( pNode->m_Value, less, pCur );
+                assert( pCur == nullptr || less( pNode->m_Value, pCur->m_Value ));
+                link( pPrev, pCur, pNode );
+            }
+
+            template <typename... Args>
+            static node * alloc_node( Args&&... args )
+            {
+                return node_allocator().MoveNew( std::forward<Args>( args )... );
+            }
+
+            static void free_node( node * p )
+            {
+                node_disposer()( p );
+            }
+
+            static node *& retired_list()
+            {
+                static thread_local node * s_pRetired = nullptr;
+                return s_pRetired;
+            }
+
+            // Retiring under the bucket lock may wait for the grace period, so the node is only queued here
+            static void defer_retire( node * p )
+            {
+                node *& pList = retired_list();
+                p->m_pNextRetired = pList;
+                pList = p;
+            }
+        };
+
+    } // namespace details
+    //@endcond
+
+}}} // namespace cds::container::striped_set
+
+//@cond
+namespace cds { namespace intrusive { namespace striped_set {
+
+    /// \p cds::container::striped_set::rcu_list adapter for hash set bucket
+    template <class RCU, typename T, class Alloc, typename... Options>
+    class adapt< cds::container::striped_set::rcu_list< RCU, T, Alloc >, Options... >
+    {
+    public:
+        typedef cds::container::striped_set::rcu_list< RCU, T, Alloc > container_type; ///< underlying container type
+
+    private:
+        /// Adapted container type
+        class adapted_container
+            : public cds::container::striped_set::adapted_sequential_container
+            , public cds::container::striped_set::details::rcu_list_bucket< RCU, T, Alloc >
+        {
+            typedef cds::container::striped_set::details::rcu_list_bucket< RCU, T, Alloc > base_class;
+            typedef typename base_class::node       node;
+            typedef typename base_class::link_type  link_type;
+
+        public:
+            typedef typename base_class::value_type     value_type;
+            typedef typename base_class::iterator       iterator;
+            typedef typename base_class::const_iterator const_iterator;
+
+            static bool const has_find_with = true;
+            static bool const has_erase_with = true;
+
+        private:
+            typedef typename cds::opt::details::make_comparator_from_option_list< value_type, Options... >::type key_comparator;
+
+            struct find_predicate
+            {
+                template <typename Q1, typename Q2>
+                bool operator()( Q1 const& i1, Q2 const& i2 ) const
+                {
+                    return key_comparator()( i1, i2 ) < 0;
+                }
+            };
+
+        public:
+            template <typename Q, typename Func>
+            bool insert( const Q& val, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( val, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( val, pCur->m_Value ) != 0 ) {
+                    node * pNew = base_class::alloc_node( val );
+                    f( pNew->m_Value );
+                    base_class::link( pPrev, pCur, pNew );
+                    return true;
+                }
+
+                // key already exists
+                return false;
+            }
+
+            template <typename... Args>
+            bool emplace( Args&&... args )
+            {
+                node * pNew = base_class::alloc_node( std::forward<Args>( args )... );
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( pNew->m_Value, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( pNew->m_Value, pCur->m_Value ) != 0 ) {
+                    base_class::link( pPrev, pCur, pNew );
+                    return true;
+                }
+                base_class::free_node( pNew );
+                return false;
+            }
+
+            template <typename Q, typename Func>
+            std::pair<bool, bool> update( const Q& val, Func func, bool bAllowInsert )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( val, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( val, pCur->m_Value ) != 0 ) {
+                    // insert new
+                    if ( !bAllowInsert )
+                        return std::make_pair( false, false );
+
+                    node * pNew = base_class::alloc_node( val );
+                    func( true, pNew->m_Value, val );
+                    base_class::link( pPrev, pCur, pNew );
+                    return std::make_pair( true, true );
+                }
+
+                // already exists
+                func( false, pCur->m_Value, val );
+                return std::make_pair( true, false );
+            }
+
+            template <typename Q, typename Func>
+            bool erase( const Q& key, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( key, pCur->m_Value ) != 0 )
+                    return false;
+
+                // key exists
+                f( pCur->m_Value );
+                base_class::unlink( pPrev, pCur );
+                return true;
+            }
+
+            template <typename Q, typename Less, typename Func>
+            bool erase( Q const& key, Less pred, Func f )
+            {
+                node * pCur;
+                link_type * pPrev = base_class::lower_bound( key, pred, pCur );
+                if ( pCur == nullptr || pred( key, pCur->m_Value ) || pred( pCur->m_Value, key ))
+                    return false;
+
+                // key exists
+                f( pCur->m_Value );
+                base_class::unlink( pPrev, pCur );
+                return true;
+            }
+
+            template <typename Q, typename Func>
+            bool find( Q& val, Func f )
+            {
+                node * pCur;
+                base_class::lower_bound( val, find_predicate(), pCur );
+                if ( pCur == nullptr || key_comparator()( val, pCur->m_Value ) != 0 )
+                    return false;
+
+                // key exists
+                f( pCur->m_Value, val );
+                return true;
+            }
+
+            template <typename Q, typename Less, typename Func>
+            bool find( Q& val, Less pred, Func f )
+            {
+                node * pCur;
+                base_class::lower_bound( val, pred, pCur );
+                if ( pCur == nullptr || pred( val, pCur->m_Value ) || pred( pCur->m_Value, val ))
+                    return false;
+
+                // key exists
+                f( pCur->m_Value, val );
+                return true;
+            }
+
+            template <typename Q>
+            bool optimistic_contains( Q const& key ) const
+            {
+                return base_class::lookup( key, find_predicate());
+            }
+
+            template <typename Q, typename Less>
+            bool optimistic_contains( Q const& key, Less pred ) const
+            {
+                return base_class::lookup( key, pred );
+            }
+
+            void move_item( adapted_container& from, iterator itWhat )
+            {
+                base_class::move_node( from, itWhat, find_predicate());
+            }
+        };
+
+    public:
+        typedef adapted_container type ; ///< Result of \p adapt metafunction
+    };
+}}} // namespace cds::intrusive::striped_set
+//@endcond
+
+#endif // #ifndef CDSLIB_CONTAINER_STRIPED_SET_RCU_LIST_ADAPTER_H
@@ -0,0 +1,135 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_CONTAINER_UNROLLED_SKIP_LIST_MAP_RCU_H
+#define CDSLIB_CONTAINER_UNROLLED_SKIP_LIST_MAP_RCU_H
+
+#include <cds/container/details/unrolled_skip_list_base.h>
+#include <cds/intrusive/skip_list_rcu.h>
+#include <cds/container/impl/unrolled_skip_list_map.h>
+
+namespace cds { namespace container {
+
+    //@cond
+    namespace unrolled_skip_list { namespace details {
+
+        // The index of chunks for RCU.
+        // A thread that holds a chunk lock may wait for RCU grace period when it changes the index,
+        // so the chunk lock is never waited for inside RCU critical section: the chunk found
+        // is locked by try_lock() under RCU lock; on failure the search is repeated after back-off.
+        // The head chunk is not in the index, it is locked outside RCU critical section.
+        // The chunk locked and not removed cannot be retired, so it is safe to use it after RCU unlock
+        template <typename RCU, typename Chunk, typename IndexTraits>
+        class chunk_index< cds::urcu::gc< RCU >, Chunk, IndexTraits >: public cds::intrusive::SkipListSet< cds::urcu::gc< RCU >, Chunk, IndexTraits >
+        {
+            typedef cds::intrusive::SkipListSet< cds::urcu::gc< RCU >, Chunk, IndexTraits > base_class;
+            typedef typename base_class::position position;
+        public:
+            typedef cds::urcu::gc< RCU > gc;
+            typedef Chunk   chunk_type;
+            typedef typename IndexTraits::disposer chunk_disposer;
+
+            // RCU does not use hazard pointers
+            static CDS_CONSTEXPR size_t const c_nHazardPtrCount = 0;
+
+            // Returns the locked chunk with the greatest low key less than key (or equal to key if bInclusive is true).
+            // If the index has no such chunk, returns head locked. The chunk returned is not removed
+            template <typename K, typename Stat>
+            chunk_type * lock_predecessor( K const& key, bool bInclusive, chunk_type& head, Stat& s )
+            {
+                return lock_found( head, s, [this, &key, bInclusive]( position& pos ) {
+                    return this->find_predecessor_( key, typename base_class::key_comparator(), bInclusive, pos );
+                });
+            }
+
+            // Returns the locked chunk with the greatest low key in the index, or head locked if the index is empty.
+            // The chunk returned is not removed
+            template <typename Stat>
+            chunk_type * lock_last( chunk_type& head, Stat& s )
+            {
+                return lock_found( head, s, [this]( position& pos ) { return this->find_max_( pos ); } );
+            }
+
+            // Unlinks the locked removed chunk from the index or retires it if it has not been indexed.
+            // The chunk is unlocked on return
+            void release_chunk( chunk_type& c )
+            {
+                assert( c.m_bRemoved );
+
+                // RCU may free c in unlink() immediately, so c is unlocked before.
+                // The waiters for c lock see m_bRemoved and search again
+                bool const bIndexed = c.m_bIndexed;
+                c.m_Lock.unlock();
+                if ( bIndexed )
+                    CDS_VERIFY( base_class::unlink( c ));
+                else
+                    gc::template retire_ptr< chunk_disposer >( &c );
+            }
+
+        private:
+            template <typename Stat, typename Func>
+            chunk_type * lock_found( chunk_type& head, Stat& s, Func find )
+            {
+                assert( !gc::is_locked());
+
+                typename IndexTraits::back_off bkoff;
+                while ( true ) {
+                    // The index nodes deleted by the search are freed in pos dtor after RCU unlock
+                    position pos;
+                    {
+                        typename base_class::rcu_lock l;
+                        chunk_type * pChunk = find( pos );
+                        if ( !pChunk )
+                            break;
+
+                        if ( pChunk->m_Lock.try_lock()) {
+                            if ( !pChunk->m_bRemoved )
+                                return pChunk;
+
+                            // The chunk is being unlinked from the index, search again
+                            pChunk->m_Lock.unlock();
+                            s.onChunkRemovedRetry();
+                        }
+                    }
+                    bkoff();
+                }
+
+                // The head chunk is never removed, so it can be waited for outside RCU critical section
+                head.m_Lock.lock();
+                return &head;
+            }
+        };
+
+    }} // namespace unrolled_skip_list::details
+    //@endcond
+
+}} // namespace cds::container
+
+#endif  // #ifndef CDSLIB_CONTAINER_UNROLLED_SKIP_LIST_MAP_RCU_H
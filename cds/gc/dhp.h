@@ -35,7 +35,7 @@
 #include <cds/gc/details/hp_common.h>
 #include <cds/details/lib.h>
 #include <cds/threading/model.h>
-#include <cds/intrusive/free_list_selector.h>
+#include <cds/intrusive/free_list_magazine.h>
 #include <cds/details/throw_exception.h>
 #include <cds/details/static_functor.h>
 #include <cds/details/marked_ptr.h>
@@ -58,6 +58,52 @@ namespace cds { namespace gc {
             //@endcond
         };
 
+        //@cond
+        // Memory allocation functions set by smr::set_memory_allocator()
+        CDS_EXPORT_API void* alloc_memory( size_t size );
+        CDS_EXPORT_API void free_memory( void* p );
+
+        // std::allocator interface over alloc_memory() / free_memory()
+        template <typename T>
+        class allocator
+        {
+        public:
+            typedef T   value_type;
+
+            template <typename U>
+            struct rebind {
+                typedef allocator<U> other;
+            };
+
+            allocator() {}
+            allocator( allocator const& ) {}
+            template <class U>
+            explicit allocator( allocator<U> const& ) {}
+
+            static T* allocate( size_t nCount, void const* /*hint*/ = nullptr )
+            {
+                return reinterpret_cast<T*>( alloc_memory( sizeof( value_type ) * nCount ));
+            }
+
+            static void deallocate( T* p, size_t /*nCount*/ )
+            {
+                free_memory( reinterpret_cast<void*>( p ));
+            }
+
+            template <typename U>
+            static void destroy( U* p )
+            {
+                p->~U();
+            }
+        };
+
+        // Free list of guard and retired blocks. The magazines are allocated by alloc_memory(),
+        // so the free list follows smr::set_memory_allocator() like the blocks themselves.
+        // get() may return nullptr while free blocks are in a magazine held by another thread;
+        // then a new block is allocated
+        typedef cds::intrusive::MagazineFreeList< cds::intrusive::FreeListImpl, 32, 16, cds::c_nCacheLineSize, allocator<int>> block_free_list;
+        //@endcond
+
         //@cond
         struct guard_block: public cds::intrusive::FreeListImpl::node
         {
@@ -97,7 +143,7 @@ namespace cds { namespace gc {
             CDS_EXPORT_API ~hp_allocator();
 
         private:
-            cds::intrusive::FreeListImpl    free_list_; ///< list of free \p guard_block
+            block_free_list free_list_; ///< list of free \p guard_block
 #ifdef CDS_ENABLE_HPSTAT
         public:
             atomics::atomic<size_t>         block_allocated_;   ///< count of allocated blocks
@@ -287,7 +333,7 @@ namespace cds { namespace gc {
             CDS_EXPORT_API ~retired_allocator();
 
         private:
-            cds::intrusive::FreeListImpl    free_list_; ///< list of free \p guard_block
+            block_free_list free_list_; ///< list of free \p retired_block
 #ifdef CDS_ENABLE_HPSTAT
         public:
             atomics::atomic<size_t> block_allocated_; ///< Count of allocated blocks
@@ -685,6 +731,11 @@ namespace cds { namespace gc {
 
         %DHP is an adaptive variant of classic \p cds::gc::HP, see @ref cds_garbage_collectors_comparison "Compare HP implementation"
 
+        Free guard blocks and retired blocks are kept in \p cds::intrusive::MagazineFreeList.
+        Its \p get() may return \p nullptr while free blocks are in a magazine held by another thread,
+        so %DHP can allocate a new block even if the free list is not empty.
+        All internal memory, including the magazines, is allocated by the functions set by \p set_memory_allocator().
+
         See \ref cds_how_to_use "How to use" section for details how to apply SMR.
     */
     class DHP
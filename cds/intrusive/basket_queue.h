@@ -34,6 +34,7 @@
 #include <type_traits>
 #include <cds/intrusive/details/single_link_struct.h>
 #include <cds/details/marked_ptr.h>
+#include <cds/intrusive/details/queue_elimination.h>
 
 namespace cds { namespace intrusive {
 
@@ -153,6 +154,12 @@ namespace cds { namespace intrusive {
             counter_type m_AddBasketCount;  ///< Count of events "Enqueue a new item into basket" (only or BasketQueue, for other queue this metric is not used)
             counter_type m_EmptyDequeue;    ///< Count of dequeue from empty queue
 
+            counter_type m_ActiveEnqueueCollision  ; ///< Count of active enqueue collision for elimination back-off
+            counter_type m_ActiveDequeueCollision  ; ///< Count of active dequeue collision for elimination back-off
+            counter_type m_PassiveEnqueueCollision ; ///< Count of passive enqueue collision for elimination back-off
+            counter_type m_PassiveDequeueCollision ; ///< Count of passive dequeue collision for elimination back-off
+            counter_type m_EliminationFailed       ; ///< Count of unsuccessful elimination back-off
+
             /// Register enqueue call
             void onEnqueue()                { ++m_EnqueueCount; }
             /// Register dequeue call
@@ -172,6 +179,24 @@ namespace cds { namespace intrusive {
             /// Register dequeuing from empty queue
             void onEmptyDequeue()           { ++m_EmptyDequeue; }
 
+            /// Register active collision for elimination back-off
+            void onActiveCollision( cds::intrusive::queue_elimination::operation_id opId )
+            {
+                if ( opId == cds::intrusive::queue_elimination::op_enqueue )
+                    ++m_ActiveEnqueueCollision;
+                else
+                    ++m_ActiveDequeueCollision;
+            }
+            /// Register passive collision for elimination back-off
+            void onPassiveCollision( cds::intrusive::queue_elimination::operation_id opId )
+            {
+                if ( opId == cds::intrusive::queue_elimination::op_enqueue )
+                    ++m_PassiveEnqueueCollision;
+                else
+                    ++m_PassiveDequeueCollision;
+            }
+            /// Register unsuccessful elimination back-off
+            void onEliminationFailed()      { ++m_EliminationFailed; }
 
             //@cond
             void reset()
@@ -185,6 +210,12 @@ namespace cds { namespace intrusive {
                 m_TryAddBasket.reset();
                 m_AddBasketCount.reset();
                 m_EmptyDequeue.reset();
+
+                m_ActiveEnqueueCollision.reset();
+                m_ActiveDequeueCollision.reset();
+                m_PassiveEnqueueCollision.reset();
+                m_PassiveDequeueCollision.reset();
+                m_EliminationFailed.reset();
             }
 
             stat& operator +=( stat const& s )
@@ -198,6 +229,12 @@ namespace cds { namespace intrusive {
                 m_TryAddBasket  += s.m_TryAddBasket.get();
                 m_AddBasketCount += s.m_AddBasketCount.get();
                 m_EmptyDequeue  += s.m_EmptyDequeue.get();
+
+                m_ActiveEnqueueCollision  += s.m_ActiveEnqueueCollision.get();
+                m_ActiveDequeueCollision  += s.m_ActiveDequeueCollision.get();
+                m_PassiveEnqueueCollision += s.m_PassiveEnqueueCollision.get();
+                m_PassiveDequeueCollision += s.m_PassiveDequeueCollision.get();
+                m_EliminationFailed       += s.m_EliminationFailed.get();
                 return *this;
             }
             //@endcond
@@ -216,6 +253,9 @@ namespace cds { namespace intrusive {
             void onTryAddBasket()       const {}
             void onAddBasket()          const {}
             void onEmptyDequeue()       const {}
+            void onActiveCollision( cds::intrusive::queue_elimination::operation_id ) const {}
+            void onPassiveCollision( cds::intrusive::queue_elimination::operation_id ) const {}
+            void onEliminationFailed()  const {}
 
             void reset() {}
             empty_stat& operator +=( empty_stat const& )
@@ -259,6 +299,24 @@ namespace cds { namespace intrusive {
 
             /// Padding for internal critical atomic data. Default is \p opt::cache_line_padding
             enum { padding = opt::cache_line_padding };
+
+            /// Enable \ref cds::intrusive::queue_elimination "elimination back-off"; by default, it is disabled
+            /**
+                The following traits is used only if elimination enabled
+            */
+            static CDS_CONSTEXPR const bool enable_elimination = false;
+
+            /// Back-off strategy to wait for elimination, default is 2 microseconds \p cds::backoff::delay_of
+            typedef cds::backoff::delay_of< 2, std::chrono::microseconds > elimination_backoff;
+
+            /// Buffer type for elimination array, default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>
+            typedef opt::v::initialized_static_buffer< int, 4 > buffer;
+
+            /// Random engine to generate a random position in elimination array
+            typedef opt::v::c_rand  random_engine;
+
+            /// Lock type used in elimination, default is cds::sync::spin
+            typedef cds::sync::spin lock_type;
         };
 
 
@@ -280,6 +338,18 @@ namespace cds { namespace intrusive {
             - \p opt::memory_model - C++ memory ordering model. Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
                 or \p opt::v::sequential_consistent (sequentially consisnent memory model).
 
+            - \p opt::enable_elimination - enable \ref cds::intrusive::queue_elimination "elimination back-off" for the queue.
+                Default value is \p false.
+
+            If elimination back-off is enabled, additional options can be specified:
+            - \p opt::buffer - a buffer type for elimination array, see \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+                Default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>.
+            - \p opt::random_engine - a random engine to generate a random position in elimination array.
+                Default is \p opt::v::c_rand.
+            - \p opt::elimination_backoff - back-off strategy to wait for elimination, default is
+                <tt>cds::backoff::delay_of< 2, std::chrono::microseconds ></tt>
+            - \p opt::lock_type - a lock type used in elimination back-off, default is \p cds::sync::spin
+
             Example: declare \p %BasketQueue with item counting and internal statistics
             \code
             typedef cds::intrusive::BasketQueue< cds::gc::HP, Foo,
@@ -457,6 +527,17 @@ namespace cds { namespace intrusive {
 
         static CDS_CONSTEXPR const size_t c_nHazardPtrCount = 6 ; ///< Count of hazard pointer required for the algorithm
 
+    public: // related to elimination back-off
+
+        /// Elimination back-off is enabled or not
+        static CDS_CONSTEXPR const bool enable_elimination = traits::enable_elimination;
+        /// back-off strategy used to wait for elimination
+        typedef typename traits::elimination_backoff elimination_backoff_type;
+        /// Lock type used in elimination back-off
+        typedef typename traits::lock_type elimination_lock_type;
+        /// Random engine used in elimination back-off
+        typedef typename traits::random_engine elimination_random_engine;
+
     protected:
         //@cond
         typedef typename node_type::marked_ptr   marked_ptr;
@@ -464,6 +545,12 @@ namespace cds { namespace intrusive {
 
         // GC and node_type::gc must be the same
         static_assert( std::is_same<gc, typename node_type::gc>::value, "GC and node_type::gc must be the same");
+
+        static_assert( !enable_elimination || std::is_same<typename elimination_random_engine::result_type, unsigned int>::value,
+                       "Random engine result type must be unsigned int");
+
+        typedef cds::intrusive::queue_elimination::details::elimination_backoff< enable_elimination, value_type, traits > elimination_backoff;
+        typedef cds::intrusive::queue_elimination::operation< value_type > operation_desc;
         //@endcond
 
         atomic_marked_ptr    m_pHead ;           ///< Queue's head pointer (aligned)
@@ -482,6 +569,7 @@ namespace cds { namespace intrusive {
         stat                m_Stat  ;           ///< Internal statistics
         //@cond
         size_t const        m_nMaxHops;
+        elimination_backoff m_Backoff;
         //@endcond
 
         //@cond
@@ -491,12 +579,57 @@ namespace cds { namespace intrusive {
             node_type * pNext;
         };
 
+        // Checks if the queue is empty, i.e. all nodes after the head are marked as dequeued.
+        // Used by elimination back-off
+        bool is_empty_for_elimination()
+        {
+            typename gc::template GuardArray<3> guards;
+
+            marked_ptr h = guards.protect( 0, m_pHead, []( marked_ptr p ) -> value_type * { return node_traits::to_value_ptr( p.ptr());});
+            node_type * p = h.ptr();
+            size_t idx = 1;
+            while ( true ) {
+                marked_ptr pNext = guards.protect( idx, p->m_pNext, []( marked_ptr p ) -> value_type * { return node_traits::to_value_ptr( p.ptr());});
+                if ( m_pHead.load( memory_model::memory_order_acquire ) != h )
+                    return false;
+                if ( pNext.ptr() == nullptr )
+                    return true;
+                if ( !pNext.bits())
+                    return false;   // not dequeued item found
+
+                p = pNext.ptr();
+                idx = 3 - idx;
+            }
+        }
+
+        // Tries to eliminate the dequeue with a concurrent enqueue
+        template <typename Backoff>
+        bool eliminate_dequeue( Backoff& bkoff, operation_desc& op, dequeue_result& res )
+        {
+            if ( bkoff.backoff( op, m_Stat, [this]() { return is_empty_for_elimination(); } )) {
+                // The eliminated node has never been linked into the queue,
+                // it is disposed at once; the guard keeps it alive until res is destroyed
+                assert( op.pVal != nullptr );
+                res.guards.assign( 2, op.pVal );
+                res.pNext = node_traits::to_node_ptr( op.pVal );
+                dispose_node( res.pNext );
+                return true;
+            }
+            return false;
+        }
+
         bool do_dequeue( dequeue_result& res, bool bDeque )
         {
             // Note:
             // If bDeque == false then the function is called from empty method and no real dequeuing operation is performed
 
             back_off bkoff;
+            typename elimination_backoff::type ebkoff = m_Backoff.init();
+
+            operation_desc op;
+            if ( enable_elimination )
+                op.idOp = cds::intrusive::queue_elimination::op_dequeue;
+            bool bEliminationTried = false;
 
             marked_ptr h;
             marked_ptr t;
@@ -510,6 +643,13 @@ namespace cds { namespace intrusive {
                 if ( h == m_pHead.load( memory_model::memory_order_acquire )) {
                     if ( h.ptr() == t.ptr()) {
                         if ( !pNext.ptr()) {
+                            if ( enable_elimination && bDeque && !bEliminationTried ) {
+                                // Wait for a concurrent enqueue once, then re-check the queue
+                                bEliminationTried = true;
+                                if ( eliminate_dequeue( ebkoff, op, res ))
+                                    return true;
+                                continue;
+                            }
                             m_Stat.onEmptyDequeue();
                             return false;
                         }
@@ -556,8 +696,11 @@ namespace cds { namespace intrusive {
                     }
                 }
 
-                if ( bDeque )
+                if ( bDeque ) {
                     m_Stat.onDequeueRace();
+                    if ( enable_elimination && eliminate_dequeue( ebkoff, op, res ))
+                        return true;
+                }
                 bkoff();
             }
 
@@ -569,6 +712,43 @@ namespace cds { namespace intrusive {
             return true;
         }
 
+        // Links the chain [pFirst, pLast] of nCount nodes to the tail of the queue with one CAS
+        void do_enqueue_chain( node_type * pFirst, node_type * pLast, size_t nCount )
+        {
+            assert( pFirst != nullptr );
+            assert( pLast != nullptr );
+            assert( pLast->m_pNext.load( atomics::memory_order_relaxed ).ptr() == nullptr );
+
+            typename gc::Guard guard;
+            back_off bkoff;
+
+            marked_ptr t;
+            while ( true ) {
+                t = guard.protect( m_pTail, []( marked_ptr p ) -> value_type * { return node_traits::to_value_ptr( p.ptr());});
+
+                marked_ptr pNext = t->m_pNext.load( memory_model::memory_order_acquire );
+                if ( pNext.ptr() == nullptr ) {
+                    if ( t->m_pNext.compare_exchange_weak( pNext, marked_ptr( pFirst ), memory_model::memory_order_release, atomics::memory_order_relaxed ))
+                        break;
+                }
+                else {
+                    // Tail is misplaced, advance it
+                    m_pTail.compare_exchange_weak( t, marked_ptr( pNext.ptr()), memory_model::memory_order_release, atomics::memory_order_relaxed );
+                    m_Stat.onBadTail();
+                }
+
+                m_Stat.onEnqueueRace();
+                bkoff();
+            }
+
+            m_ItemCounter += nCount;
+            for ( size_t i = 0; i < nCount; ++i )
+                m_Stat.onEnqueue();
+
+            if ( !m_pTail.compare_exchange_strong( t, marked_ptr( pLast ), memory_model::memory_order_release, atomics::memory_order_relaxed ))
+                m_Stat.onAdvanceTailFailed();
+        }
+
         void free_chain( marked_ptr head, marked_ptr newHead )
         {
             // "head" and "newHead" are guarded
@@ -617,6 +797,19 @@ namespace cds { namespace intrusive {
             , m_nMaxHops( 3 )
         {}
 
+        /// Initializes empty queue and elimination back-off data
+        /**
+            This form should be used if you use elimination back-off with dynamically allocated collision array, i.e
+            \p Traits contains <tt>typedef cds::opt::v::initialized_dynamic_buffer buffer</tt>.
+            \p nCollisionCapacity parameter specifies the capacity of collision array.
+        */
+        explicit BasketQueue( size_t nCollisionCapacity )
+            : m_pHead( &m_Dummy )
+            , m_pTail( &m_Dummy )
+            , m_nMaxHops( 3 )
+            , m_Backoff( nCollisionCapacity )
+        {}
+
         /// Destructor clears the queue
         /**
             Since the baskets queue contains at least one item even
@@ -659,6 +852,13 @@ namespace cds { namespace intrusive {
             typename gc::Guard guard;
             typename gc::Guard gNext;
             back_off bkoff;
+            typename elimination_backoff::type ebkoff = m_Backoff.init();
+
+            operation_desc op;
+            if ( enable_elimination ) {
+                op.idOp = cds::intrusive::queue_elimination::op_enqueue;
+                op.pVal = &val;
+            }
 
             marked_ptr t;
             while ( true ) {
@@ -729,6 +929,10 @@ namespace cds { namespace intrusive {
                 }
 
                 m_Stat.onEnqueueRace();
+                if ( enable_elimination && ebkoff.backoff( op, m_Stat, [this]() { return is_empty_for_elimination(); } )) {
+                    // val has been passed to a concurrent dequeue directly
+                    return true;
+                }
             }
 
             ++m_ItemCounter;
@@ -737,6 +941,36 @@ namespace cds { namespace intrusive {
             return true;
         }
 
+        /// Enqueues the items from the range <tt>[first, last)</tt>
+        /**
+            The items are linked into a private chain that is appended to the queue
+            with a single CAS on the tail, so the items are enqueued contiguously
+            in the order of the range. \p Iterator dereferences to <tt>value_type&</tt>.
+
+            Returns the number of enqueued items.
+        */
+        template <typename Iterator>
+        size_t enqueue_batch( Iterator first, Iterator last )
+        {
+            node_type * pFirst = nullptr;
+            node_type * pLast = nullptr;
+            size_t nCount = 0;
+            for ( ; first != last; ++first ) {
+                node_type * pNew = node_traits::to_node_ptr( *first );
+                link_checker::is_empty( pNew );
+                if ( pLast )
+                    pLast->m_pNext.store( marked_ptr( pNew ), memory_model::memory_order_relaxed );
+                else
+                    pFirst = pNew;
+                pLast = pNew;
+                ++nCount;
+            }
+
+            if ( nCount )
+                do_enqueue_chain( pFirst, pLast, nCount );
+            return nCount;
+        }
+
         /// Synonym for \p enqueue() function
         bool push( value_type& val )
         {
@@ -758,6 +992,30 @@ namespace cds { namespace intrusive {
             return nullptr;
         }
 
+        /// Dequeues up to \p nMax items
+        /**
+            The baskets queue dequeues an item by marking the link to it, so each item
+            still costs one CAS; the dequeued chain is unlinked lazily as in \p dequeue().
+            \p f is called for each dequeued item in FIFO order:
+            \code
+            void f( value_type& item );
+            \endcode
+            See \p MSQueue::dequeue() note about item disposing.
+
+            Returns the number of dequeued items, 0 if the queue is empty.
+        */
+        template <typename Func>
+        size_t dequeue_batch( Func f, size_t nMax )
+        {
+            size_t nCount = 0;
+            dequeue_result res;
+            while ( nCount < nMax && do_dequeue( res, true )) {
+                f( *node_traits::to_value_ptr( *res.pNext ));
+                ++nCount;
+            }
+            return nCount;
+        }
+
         /// Synonym for \p dequeue() function
         value_type * pop()
         {
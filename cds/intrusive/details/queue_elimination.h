@@ -0,0 +1,281 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_INTRUSIVE_DETAILS_QUEUE_ELIMINATION_H
+#define CDSLIB_INTRUSIVE_DETAILS_QUEUE_ELIMINATION_H
+
+#include <mutex>        // unique_lock
+#include <cds/algo/elimination.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/opt/buffer.h>
+#include <cds/sync/spinlock.h>
+#include <cds/details/type_padding.h>
+
+namespace cds { namespace intrusive {
+
+    /// Elimination back-off for FIFO queues
+    /** @ingroup cds_intrusive_helper
+        The \ref cds_elimination_description "elimination" technique cannot be applied to a FIFO queue
+        as simply as to a stack: an enqueue can be paired with a dequeue only if all items enqueued before it
+        have been already dequeued, otherwise the dequeue would return an item out of FIFO order.
+        Moir et al. solve it by "aging" the enqueue operation: the enqueue may be eliminated only after
+        the queue head has passed the tail position observed by the enqueue.
+        - [2005] Mark Moir, Daniel Nussbaum, Ori Shalev, Nir Shavit "Using elimination to implement
+            scalable and lock-free FIFO queues"
+
+        The libcds queues do not keep a sequence number in the node, so the implementation uses
+        the strongest form of the age condition: two colliding operations are paired only if the queue
+        is empty. The emptiness is checked by the active side of the collision while it holds the lock
+        of the collision slot, so both the enqueue and the dequeue are pending at the moment the queue
+        is observed empty; the pair is linearized at that moment as "enqueue, then dequeue".
+        It is exactly the case of balanced producers and consumers working on an empty
+        or almost empty queue, for example, a request/response hand-off.
+
+        The elimination back-off is enabled by \p opt::enable_elimination option of queue's traits,
+        it is supported by \p MSQueue, \p MoirQueue and \p BasketQueue.
+    */
+    namespace queue_elimination {
+
+        /// Operation id for the queue elimination back-off
+        enum operation_id {
+            op_enqueue,    ///< enqueue op id
+            op_dequeue     ///< dequeue op id
+        };
+
+        //@cond
+        /// Operation descriptor for the queue elimination back-off
+        template <typename T>
+        struct operation: public cds::algo::elimination::operation_desc
+        {
+            operation_id    idOp;   ///< Op id
+            T *             pVal;   ///< for enqueue: pointer to argument; for dequeue: accepts a return value
+            atomics::atomic<unsigned int> nStatus; ///< Internal elimination status
+
+            operation()
+                : pVal( nullptr )
+                , nStatus( 0 /*op_free*/ )
+            {}
+        };
+
+        namespace details {
+
+            template <bool EnableElimination, typename T, typename Traits>
+            class elimination_backoff;
+
+            template <typename T, typename Traits>
+            class elimination_backoff<false, T, Traits>
+            {
+                typedef typename Traits::back_off   back_off;
+
+                struct wrapper
+                {
+                    back_off m_bkoff;
+
+                    void reset()
+                    {
+                        m_bkoff.reset();
+                    }
+
+                    template <typename Stat, typename EmptyCheck>
+                    bool backoff( operation< T >&, Stat&, EmptyCheck )
+                    {
+                        m_bkoff();
+                        return false;
+                    }
+                };
+
+            public:
+                elimination_backoff()
+                {}
+
+                elimination_backoff( size_t )
+                {}
+
+                typedef wrapper type;
+                type init()
+                {
+                    return wrapper();
+                }
+            };
+
+            template <typename T, typename Traits>
+            class elimination_backoff<true, T, Traits>
+            {
+                /// Back-off for elimination (usually delay)
+                typedef typename Traits::elimination_backoff elimination_backoff_type;
+                /// Lock type used in elimination back-off
+                typedef typename Traits::lock_type elimination_lock_type;
+                /// Random engine used in elimination back-off
+                typedef typename Traits::random_engine elimination_random_engine;
+
+                /// Per-thread elimination record
+                typedef cds::algo::elimination::record  elimination_rec;
+
+                /// Collision array record
+                struct collision_array_record {
+                    elimination_rec *     pRec;
+                    elimination_lock_type lock;
+                };
+
+                /// Collision array used in elimination-backoff; each item is optimized for cache-line size
+                typedef typename Traits::buffer::template rebind<
+                    typename cds::details::type_padding<collision_array_record, cds::c_nCacheLineSize >::type
+                >::other collision_array;
+
+                /// Operation descriptor used in elimination back-off
+                typedef operation< T >  operation_desc;
+
+                /// Elimination back-off data
+                struct elimination_data {
+                    mutable elimination_random_engine randEngine; ///< random engine
+                    collision_array                   collisions; ///< collision array
+
+                    elimination_data()
+                    {}
+                    elimination_data( size_t nCollisionCapacity )
+                        : collisions( nCollisionCapacity )
+                    {}
+                };
+
+                elimination_data m_Elimination;
+
+                enum operation_status {
+                    op_free = 0,
+                    op_waiting = 1,
+                    op_collided = 2
+                };
+
+                typedef std::unique_lock< elimination_lock_type > slot_scoped_lock;
+
+                template <bool Exp2 = collision_array::c_bExp2>
+                typename std::enable_if< Exp2, size_t >::type slot_index() const
+                {
+                    return m_Elimination.randEngine() & (m_Elimination.collisions.capacity() - 1);
+                }
+
+                template <bool Exp2 = collision_array::c_bExp2>
+                typename std::enable_if< !Exp2, size_t >::type slot_index() const
+                {
+                    return m_Elimination.randEngine() % m_Elimination.collisions.capacity();
+                }
+
+            public:
+                elimination_backoff()
+                {
+                    m_Elimination.collisions.zeroize();
+                }
+
+                elimination_backoff( size_t nCollisionCapacity )
+                    : m_Elimination( nCollisionCapacity )
+                {
+                    m_Elimination.collisions.zeroize();
+                }
+
+                typedef elimination_backoff& type;
+
+                type init()
+                {
+                    return *this;
+                }
+
+                void reset()
+                {}
+
+                // isEmpty() is called by the active side of the collision under the slot lock
+                template <typename Stat, typename EmptyCheck>
+                bool backoff( operation_desc& op, Stat& stat, EmptyCheck isEmpty )
+                {
+                    elimination_backoff_type bkoff;
+                    op.nStatus.store( op_waiting, atomics::memory_order_relaxed );
+
+                    elimination_rec * myRec = cds::algo::elimination::init_record( op );
+
+                    collision_array_record& slot = m_Elimination.collisions[ slot_index() ];
+                    {
+                        slot.lock.lock();
+                        elimination_rec * himRec = slot.pRec;
+                        if ( himRec ) {
+                            operation_desc * himOp = static_cast<operation_desc *>( himRec->pOp );
+                            assert( himOp );
+                            if ( himOp->idOp != op.idOp ) {
+                                if ( !isEmpty()) {
+                                    // The queue contains older items, the collision would break FIFO order
+                                    slot.lock.unlock();
+                                    cds::algo::elimination::clear_record();
+                                    stat.onEliminationFailed();
+                                    return false;
+                                }
+
+                                if ( op.idOp == op_enqueue )
+                                    himOp->pVal = op.pVal;
+                                else
+                                    op.pVal = himOp->pVal;
+
+                                slot.pRec = nullptr;
+                                himOp->nStatus.store( op_collided, atomics::memory_order_release );
+                                slot.lock.unlock();
+
+                                cds::algo::elimination::clear_record();
+                                stat.onActiveCollision( op.idOp );
+                                return true;
+                            }
+                        }
+                        slot.pRec = myRec;
+                        slot.lock.unlock();
+                    }
+
+                    // Wait for colliding operation
+                    bkoff( [&op]() CDS_NOEXCEPT -> bool { return op.nStatus.load( atomics::memory_order_acquire ) != op_waiting; } );
+
+                    {
+                        slot_scoped_lock l( slot.lock );
+                        if ( slot.pRec == myRec )
+                            slot.pRec = nullptr;
+                    }
+
+                    bool bCollided = op.nStatus.load( atomics::memory_order_acquire ) == op_collided;
+
+                    if ( !bCollided )
+                        stat.onEliminationFailed();
+                    else
+                        stat.onPassiveCollision( op.idOp );
+
+                    cds::algo::elimination::clear_record();
+                    return bCollided;
+                }
+            };
+
+        } // namespace details
+        //@endcond
+
+    } // namespace queue_elimination
+}} // namespace cds::intrusive
+
+#endif // #ifndef CDSLIB_INTRUSIVE_DETAILS_QUEUE_ELIMINATION_H
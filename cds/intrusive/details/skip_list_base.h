@@ -478,6 +478,8 @@ namespace cds { namespace intrusive {
             event_counter   m_nExtractWhileFind     ; ///< Count of extracted item while searching (RCU only)
             event_counter   m_nMarkFailed           ; ///< Count of failed node marking (logical deletion mark)
             event_counter   m_nEraseContention      ; ///< Count of key erasing contention encountered
+            event_counter   m_nHintHit              ; ///< Count of hinted searches resumed from the hint node
+            event_counter   m_nHintMiss             ; ///< Count of hinted searches started from the head since the hint is not applicable
 
             //@cond
             void onAddNode( unsigned int nHeight )
@@ -525,6 +527,8 @@ namespace cds { namespace intrusive {
             void onExtractMaxRetry()        { ++m_nExtractMaxRetries; }
             void onMarkFailed()             { ++m_nMarkFailed;        }
             void onEraseContention()        { ++m_nEraseContention;   }
+            void onHintHit()                { ++m_nHintHit;           }
+            void onHintMiss()               { ++m_nHintMiss;          }
             //@endcond
         };
 
@@ -567,6 +571,8 @@ namespace cds { namespace intrusive {
             void onExtractMaxRetry()        const {}
             void onMarkFailed()             const {}
             void onEraseContention()        const {}
+            void onHintHit()                const {}
+            void onHintMiss()               const {}
             //@endcond
         };
 
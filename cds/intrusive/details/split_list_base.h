@@ -259,6 +259,12 @@ namespace cds { namespace intrusive {
                 Therefore, \p cds::atomicity::empty_item_counter is not allowed as a type of the option.
 
                 Default is \p cds::atomicity::item_counter; to avoid false sharing you may use \p atomicity::cache_friendly_item_counter
+
+                Each insertion checks the load factor using the value returned by the counter's increment.
+                For heavy multi-threaded modification you may use \p atomicity::sharded_item_counter
+                from <tt>cds/algo/sharded_counter.h</tt>: its increment touches the per-CPU shard only
+                and returns an approximate value, so the load-factor check does not read a shared hot cache line;
+                the bucket table grows a bit later, with up to <tt>Batch * shard_count()</tt> item lag.
             */
             typedef cds::atomicity::item_counter item_counter;
 
@@ -0,0 +1,341 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_INTRUSIVE_FREE_LIST_MAGAZINE_H
+#define CDSLIB_INTRUSIVE_FREE_LIST_MAGAZINE_H
+
+#include <cds/intrusive/free_list_selector.h>
+#include <cds/details/allocator.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/type_padding.h>
+
+#include <thread>
+#include <functional>
+
+namespace cds { namespace intrusive {
+
+    /// Magazine free list
+    /** @ingroup cds_intrusive_freelist
+
+        The free list keeps free nodes in \a magazines - small fixed-size arrays of
+        node pointers. Each thread works with the magazine stored in its slot;
+        the slot is calculated by current thread id like in \p CachedFreeList:
+        \code
+        int slot = std::hash<std::thread::id>()( std::this_thread::get_id()) & (SlotCount - 1);
+        \endcode
+        The thread takes the magazine out of the slot by atomic exchange, so while the thread
+        holds the magazine it is the exclusive owner and \p put() / \p get() are plain
+        array operations; then the magazine is returned back into the slot.
+
+        When the magazine is full, \p put() moves the whole magazine to the global depot and
+        continues with an empty one. When the magazine is empty, \p get() takes a loaded
+        magazine from the depot; if the depot is empty, magazines of other slots are stolen.
+        Thus only one of \p MagazineSize operations touches the shared depot, and the depot
+        exchanges whole magazines by single \p FreeList operation.
+
+        The depot is \p FreeList of magazines, so it inherits ABA-safety of the underlying
+        free list: reference counting of \p cds::intrusive::FreeList or tagged pointer of
+        \p cds::intrusive::TaggedFreeList. Empty magazines are recycled via another
+        \p FreeList, magazines are destroyed only by \p clear() and by the destructor.
+
+        Unlike \p CachedFreeList, \p get() may return \p nullptr when some nodes are
+        in a magazine that is currently held by another thread.
+
+        Template parameters:
+        - \p FreeList - a free-list implementation for the depot: \p FreeList, \p TaggedFreeList.
+            Default is \p FreeListImpl (\p TaggedFreeList if double-width CAS is supported)
+        - \p MagazineSize - number of nodes in the magazine, default is 32
+        - \p SlotCount - number of per-thread magazine slots, a small power-of-two number, default is 16
+        - \p Padding - padding of slots for solving false sharing, default is \p cds::c_nCacheLineSize
+        - \p Alloc - allocator for magazines, default is \p CDS_DEFAULT_ALLOCATOR
+    */
+    template <typename FreeList = FreeListImpl,
+        size_t MagazineSize = 32,
+        size_t SlotCount = 16,
+        unsigned Padding = cds::c_nCacheLineSize,
+        typename Alloc = CDS_DEFAULT_ALLOCATOR
+    >
+    class MagazineFreeList
+    {
+    public:
+        typedef FreeList free_list_type;    ///< Underlying free-list type of the depot
+        typedef typename free_list_type::node node; ///< Free-list node
+
+        static size_t const c_magazine_size = MagazineSize; ///< Magazine size
+        static size_t const c_slot_count = SlotCount;       ///< Slot count
+        static unsigned const c_padding = Padding;          ///< Slot padding
+
+        static_assert( c_magazine_size >= 2, "Magazine size is too small" );
+        static_assert( c_slot_count >= 4, "Slot count is too small" );
+        static_assert( (c_slot_count & (c_slot_count - 1)) == 0, "SlotCount must be power of two" );
+        static_assert( (c_padding & (c_padding - 1)) == 0, "Padding must be power-of-two");
+
+    private:
+        //@cond
+        // A magazine is linked into the depot and into the list of empty magazines via different hooks:
+        // \p FreeList may re-insert the node into the list it has been taken from, so the node cannot migrate between lists
+        struct depot_hook: public free_list_type::node
+        {};
+        struct empty_hook: public free_list_type::node
+        {};
+
+        struct magazine: public depot_hook, public empty_hook
+        {
+            size_t  m_nCount;
+            node*   m_arrNodes[c_magazine_size];
+
+            magazine()
+                : m_nCount( 0 )
+            {}
+
+            bool is_empty() const
+            {
+                return m_nCount == 0;
+            }
+
+            bool is_full() const
+            {
+                return m_nCount == c_magazine_size;
+            }
+
+            void push( node* pNode )
+            {
+                assert( !is_full());
+                m_arrNodes[m_nCount++] = pNode;
+            }
+
+            node* pop()
+            {
+                assert( !is_empty());
+                return m_arrNodes[--m_nCount];
+            }
+        };
+
+        typedef cds::details::Allocator< magazine, Alloc > magazine_allocator;
+        typedef atomics::atomic<magazine*> slot_type;
+        //@endcond
+
+    public:
+        /// Creates empty free list
+        MagazineFreeList()
+        {
+            for ( auto& slot : m_Slots )
+                slot.store( nullptr, atomics::memory_order_relaxed );
+        }
+
+        /// Destroys the free list. Free-list must be empty.
+        /**
+            @warning dtor does not free elements of the list.
+            To free elements you should manually call \p clear() with an appropriate disposer.
+        */
+        ~MagazineFreeList()
+        {
+            assert( empty());
+            clear( []( node* ) {} );
+        }
+
+        /// Puts \p pNode to the free list
+        void put( node* pNode )
+        {
+            slot_type& slot = m_Slots[ get_hash() ];
+            magazine* mag = slot.exchange( nullptr, atomics::memory_order_acquire );
+
+            if ( !mag )
+                mag = alloc_magazine();
+            else if ( mag->is_full()) {
+                // bulk transfer: the whole magazine goes to the depot
+                put_loaded( mag );
+                mag = alloc_magazine();
+            }
+
+            mag->push( pNode );
+            release( slot, mag );
+        }
+
+        /// Gets a node from the free list. If the list is empty, returns \p nullptr
+        node * get()
+        {
+            slot_type& slot = m_Slots[ get_hash() ];
+            magazine* mag = slot.exchange( nullptr, atomics::memory_order_acquire );
+
+            if ( !mag || mag->is_empty()) {
+                magazine* loaded = load_magazine();
+                if ( !loaded ) {
+                    if ( mag )
+                        release( slot, mag );
+                    return nullptr;
+                }
+                if ( mag )
+                    put_empty( mag );
+                mag = loaded;
+            }
+
+            node* p = mag->pop();
+            release( slot, mag );
+            return p;
+        }
+
+        /// Checks whether the free list is empty
+        bool empty() const
+        {
+            if ( !m_Depot.empty())
+                return false;
+
+            for ( auto& slot : m_Slots ) {
+                magazine* mag = slot.load( atomics::memory_order_relaxed );
+                if ( mag && !mag->is_empty())
+                    return false;
+            }
+
+            return true;
+        }
+
+        /// Clears the free list (not atomic)
+        /**
+            For each element \p disp disposer is called to free memory.
+            The \p Disposer interface:
+            \code
+            struct disposer
+            {
+                void operator()( FreeList::node * node );
+            };
+            \endcode
+
+            The magazines are freed too.
+
+            This method must be explicitly called before the free list destructor.
+        */
+        template <typename Disposer>
+        void clear( Disposer disp )
+        {
+            auto dispose_magazine = [&disp]( magazine* mag ) {
+                while ( !mag->is_empty())
+                    disp( mag->pop());
+                magazine_allocator().Delete( mag );
+            };
+
+            for ( auto& slot : m_Slots ) {
+                magazine* mag = slot.load( atomics::memory_order_relaxed );
+                if ( mag ) {
+                    slot.store( nullptr, atomics::memory_order_relaxed );
+                    dispose_magazine( mag );
+                }
+            }
+            m_Depot.clear( [&dispose_magazine]( typename free_list_type::node* p ) { dispose_magazine( from_depot( p )); } );
+            m_EmptyMagazines.clear( [&dispose_magazine]( typename free_list_type::node* p ) { dispose_magazine( from_empty( p )); } );
+        }
+
+    private:
+        //@cond
+        static size_t get_hash()
+        {
+            return std::hash<std::thread::id>()( std::this_thread::get_id()) & (c_slot_count - 1);
+        }
+
+        static magazine* from_depot( typename free_list_type::node* p )
+        {
+            return p ? static_cast<magazine*>( static_cast<depot_hook*>( p )) : nullptr;
+        }
+
+        static magazine* from_empty( typename free_list_type::node* p )
+        {
+            return p ? static_cast<magazine*>( static_cast<empty_hook*>( p )) : nullptr;
+        }
+
+        void put_loaded( magazine* mag )
+        {
+            assert( !mag->is_empty());
+            m_Depot.put( static_cast<depot_hook*>( mag ));
+        }
+
+        void put_empty( magazine* mag )
+        {
+            assert( mag->is_empty());
+            m_EmptyMagazines.put( static_cast<empty_hook*>( mag ));
+        }
+
+        magazine* alloc_magazine()
+        {
+            magazine* mag = from_empty( m_EmptyMagazines.get());
+            if ( mag ) {
+                assert( mag->is_empty());
+                return mag;
+            }
+            return magazine_allocator().New();
+        }
+
+        magazine* load_magazine()
+        {
+            magazine* mag = from_depot( m_Depot.get());
+            if ( mag )
+                return mag;
+
+            // the depot is empty - steal a magazine from other slots
+            for ( auto& slot : m_Slots ) {
+                if ( !slot.load( atomics::memory_order_relaxed ))
+                    continue;
+
+                mag = slot.exchange( nullptr, atomics::memory_order_acquire );
+                if ( mag ) {
+                    if ( !mag->is_empty())
+                        return mag;
+                    put_empty( mag );
+                }
+            }
+
+            return from_depot( m_Depot.get());
+        }
+
+        void release( slot_type& slot, magazine* mag )
+        {
+            magazine* expected = nullptr;
+            if ( slot.compare_exchange_strong( expected, mag, atomics::memory_order_release, atomics::memory_order_relaxed ))
+                return;
+
+            // another thread has installed its magazine into the slot
+            if ( mag->is_empty())
+                put_empty( mag );
+            else
+                put_loaded( mag );
+        }
+        //@endcond
+
+    private:
+        //@cond
+        typedef typename cds::details::type_padding< slot_type, c_padding >::type array_item;
+        array_item      m_Slots[ c_slot_count ];
+        free_list_type  m_Depot;            // loaded magazines
+        free_list_type  m_EmptyMagazines;   // empty magazines for reuse
+        //@endcond
+    };
+
+}} // namespace cds::intrusive
+
+#endif // CDSLIB_INTRUSIVE_FREE_LIST_MAGAZINE_H
@@ -397,6 +397,90 @@ namespace cds { namespace intrusive {
         // + 1 - for help_remove()
         static size_t const c_nHazardPtrCount = c_nMaxHeight * 2 + 3; ///< Count of hazard pointer required for the skip-list
 
+        /// Search hint (finger) for \p insert_hint() and \p find_hint()
+        /**
+            The hint remembers a node visited by the previous hinted operation together with
+            the highest level at which the node is known to be linked. The next hinted operation
+            resumes the search from that node instead of from the head of the skip-list
+            if the node is not deleted and its key is less than the key searched.
+            Otherwise, the search is started from the head as usual, so a stale hint
+            costs only one key comparison.
+
+            The hint contains a guard that protects the node remembered; the guard is allocated
+            on first use.
+            For \p gc::HP the guard is a limited per-thread resource, so keep the hint count small.
+            The hint is thread-private: it cannot be moved across thread boundary
+            and must not outlive the set. Call \p release() to unpin the node remembered.
+        */
+        class hint
+        {
+            //@cond
+            friend class SkipListSet;
+            //@endcond
+        public:
+            /// Creates empty hint
+            hint()
+                : m_Guard( nullptr )
+                , m_pNode( nullptr )
+                , m_nLevel( 0 )
+            {}
+
+            //@cond
+            hint( hint&& src ) CDS_NOEXCEPT
+                : m_Guard( std::move( src.m_Guard ))
+                , m_pNode( src.m_pNode )
+                , m_nLevel( src.m_nLevel )
+            {
+                src.m_pNode = nullptr;
+                src.m_nLevel = 0;
+            }
+
+            hint& operator=( hint&& src ) CDS_NOEXCEPT
+            {
+                m_Guard = std::move( src.m_Guard );
+                m_pNode = src.m_pNode;
+                m_nLevel = src.m_nLevel;
+                src.m_pNode = nullptr;
+                src.m_nLevel = 0;
+                return *this;
+            }
+
+            hint( hint const& ) = delete;
+            hint& operator=( hint const& ) = delete;
+            //@endcond
+
+            /// Checks if the hint is empty
+            bool empty() const
+            {
+                return m_pNode == nullptr;
+            }
+
+            /// Clears the hint
+            void release()
+            {
+                if ( m_Guard.is_linked())
+                    m_Guard.clear();
+                m_pNode = nullptr;
+                m_nLevel = 0;
+            }
+
+        private:
+            //@cond
+            // pNode must be protected by the caller
+            void set( node_type * pNode, unsigned int nLevel )
+            {
+                m_Guard.link();
+                m_Guard.assign( node_traits::to_value_ptr( pNode ));
+                m_pNode = pNode;
+                m_nLevel = nLevel;
+            }
+
+            typename gc::Guard  m_Guard;    // unlinked until the first set()
+            node_type *         m_pNode;    // the node remembered, guarded by m_Guard
+            unsigned int        m_nLevel;   // m_pNode is linked at levels [0..m_nLevel]
+            //@endcond
+        };
+
     protected:
         typedef typename node_type::atomic_marked_ptr   atomic_node_ptr;   ///< Atomic marked node pointer
         typedef typename node_type::marked_ptr          marked_node_ptr;   ///< Node marked pointer
@@ -419,6 +503,8 @@ namespace cds { namespace intrusive {
 
             typename gc::template GuardArray< c_nMaxHeight * 2 > guards;   ///< Guards array for pPrev/pSucc
             node_type *   pCur;   // guarded by one of guards
+            int           nTopLevel; // the search has been started at level nTopLevel; pPrev/pSucc above it are undefined
+            int           nCurLevel; // pCur is linked at levels [0..nCurLevel]
         };
         //@endcond
 
@@ -606,6 +692,74 @@ namespace cds { namespace intrusive {
             }
         }
 
+        /// Inserts new node using search hint
+        /**
+            The function is similar to \ref insert( value_type& val ) but the search
+            is resumed from the node remembered in \p h if it is still valid, see \p hint.
+            After the call \p h refers to the item inserted or to the item with the same key
+            found in the set.
+
+            The hint is profitable when the keys inserted by the thread are close to each other,
+            for example, for the sorted or nearly sorted input.
+        */
+        bool insert_hint( hint& h, value_type& val )
+        {
+            return insert_hint( h, val, []( value_type& ) {} );
+        }
+
+        /// Inserts new node using search hint
+        /**
+            The function is similar to \ref insert( value_type& val, Func f ) but uses
+            the search hint \p h like \ref insert_hint( hint&, value_type& ).
+        */
+        template <typename Func>
+        bool insert_hint( hint& h, value_type& val, Func f )
+        {
+            typename gc::Guard gNew;
+            gNew.assign( &val );
+
+            node_type * pNode = node_traits::to_node_ptr( val );
+            scoped_node_ptr scp( pNode );
+            bool bTowerMade = false;
+
+            // The node height should be known before the search
+            // since the hint is useful only if it covers all levels of the node
+            if ( !pNode->has_tower()) {
+                build_node( pNode );
+                bTowerMade = pNode->has_tower();
+            }
+            unsigned int const nHeight = pNode->height();
+
+            position pos;
+            while ( true )
+            {
+                if ( find_hint_position( h, val, pos, key_comparator(), true, nHeight )) {
+                    // scoped_node_ptr deletes the node tower if we create it
+                    if ( !bTowerMade )
+                        scp.release();
+
+                    h.set( pos.pCur, static_cast<unsigned int>( pos.nCurLevel ));
+                    m_Stat.onInsertFailed();
+                    return false;
+                }
+
+                if ( !insert_at_position( val, pNode, pos, f )) {
+                    m_Stat.onInsertRetry();
+                    continue;
+                }
+
+                increase_height( nHeight );
+                ++m_ItemCounter;
+                m_Stat.onAddNode( nHeight );
+                m_Stat.onInsertSuccess();
+                scp.release();
+
+                // pNode is protected by gNew
+                h.set( pNode, nHeight - 1 );
+                return true;
+            }
+        }
+
         /// Updates the node
         /**
             The operation performs inserting or changing data with lock-free manner.
@@ -1022,6 +1176,40 @@ namespace cds { namespace intrusive {
         }
         //@endcond
 
+        /// Finds \p key using search hint
+        /**
+            The function is similar to \ref cds_intrusive_SkipListSet_hp_find_func "find(Q&, Func)"
+            but the search is resumed from the node remembered in \p h if it is still valid, see \p hint.
+            After the call \p h refers to the item found or, if \p key is not found,
+            to the nearest item preceding \p key.
+
+            The hint is profitable when the keys searched by the thread are close to each other,
+            for example, for the ordered traversal of the key range.
+        */
+        template <typename Q, typename Func>
+        bool find_hint( hint& h, Q& key, Func f )
+        {
+            return find_hint_( h, key, key_comparator(), f );
+        }
+        //@cond
+        template <typename Q, typename Func>
+        bool find_hint( hint& h, Q const& key, Func f )
+        {
+            return find_hint_( h, key, key_comparator(), f );
+        }
+        //@endcond
+
+        /// Checks whether the set contains \p key using search hint
+        /**
+            The function is similar to <tt>contains( key )</tt> but uses
+            the search hint \p h like \p find_hint( hint&, Q&, Func ).
+        */
+        template <typename Q>
+        bool find_hint( hint& h, Q const& key )
+        {
+            return find_hint_( h, key, key_comparator(), [](value_type& , Q const& ) {} );
+        }
+
         /// Finds \p key and return the item found
         /** \anchor cds_intrusive_SkipListSet_hp_get
             The function searches the item with key equal to \p key
@@ -1170,6 +1358,15 @@ namespace cds { namespace intrusive {
 
         template <typename Q, typename Compare >
         bool find_position( Q const& val, position& pos, Compare cmp, bool bStopIfFound )
+        {
+            return find_position( val, pos, cmp, bStopIfFound, m_Head.head(), static_cast<int>( c_nMaxHeight - 1 ));
+        }
+
+        // Searches val starting from pStart at level nStartLevel.
+        // pStart must be guarded, linked at levels [0..nStartLevel] and less than val.
+        // If pStart is deleted the search is restarted from the head.
+        template <typename Q, typename Compare >
+        bool find_position( Q const& val, position& pos, Compare cmp, bool bStopIfFound, node_type * pStart, int nStartLevel )
         {
             node_type * pPred;
             marked_node_ptr pSucc;
@@ -1180,16 +1377,18 @@ namespace cds { namespace intrusive {
             //  pSucc: [nLevel * 2 + 1]
 
         retry:
-            pPred = m_Head.head();
+            pPred = pStart;
+            pos.nTopLevel = nStartLevel;
+            pos.nCurLevel = 0;
             int nCmp = 1;
 
-            for ( int nLevel = static_cast<int>( c_nMaxHeight - 1 ); nLevel >= 0; --nLevel ) {
+            for ( int nLevel = nStartLevel; nLevel >= 0; --nLevel ) {
                 pos.guards.assign( nLevel * 2, node_traits::to_value_ptr( pPred ));
                 while ( true ) {
                     pCur = pos.guards.protect( nLevel * 2 + 1, pPred->next( nLevel ), gc_protect );
                     if ( pCur.bits()) {
                         // pCur.bits() means that pPred is logically deleted
-                        goto retry;
+                        goto restart;
                     }
 
                     if ( pCur.ptr() == nullptr ) {
@@ -1201,13 +1400,13 @@ namespace cds { namespace intrusive {
                     pSucc = pCur->next( nLevel ).load( memory_model::memory_order_acquire );
 
                     if ( pPred->next( nLevel ).load( memory_model::memory_order_acquire ).all() != pCur.ptr())
-                        goto retry;
+                        goto restart;
 
                     if ( pSucc.bits()) {
                         // pCur is marked, i.e. logically deleted
                         // try to help deleting pCur
                         help_remove( nLevel, pPred, pCur );
-                        goto retry;
+                        goto restart;
                     }
                     else {
                         nCmp = cmp( *node_traits::to_value_ptr( pCur.ptr()), val );
@@ -1215,8 +1414,10 @@ namespace cds { namespace intrusive {
                             pPred = pCur.ptr();
                             pos.guards.copy( nLevel * 2, nLevel * 2 + 1 );   // pPrev guard := cur guard
                         }
-                        else if ( nCmp == 0 && bStopIfFound )
+                        else if ( nCmp == 0 && bStopIfFound ) {
+                            pos.nCurLevel = nLevel;
                             goto found;
+                        }
                         else
                             break;
                     }
@@ -1233,6 +1434,12 @@ namespace cds { namespace intrusive {
         found:
             pos.pCur = pCur.ptr();
             return pCur.ptr() && nCmp == 0;
+
+        restart:
+            // The list has been changed near pPred - search from the head
+            pStart = m_Head.head();
+            nStartLevel = static_cast<int>( c_nMaxHeight - 1 );
+            goto retry;
         }
 
         bool find_min_position( position& pos )
@@ -1636,6 +1843,84 @@ namespace cds { namespace intrusive {
             return false;
         }
 
+        template <typename Q, typename Compare>
+        bool find_hint_position( hint& h, Q const& val, position& pos, Compare cmp, bool bStopIfFound, unsigned int nHeight )
+        {
+            // The hint is usable if its node is linked at all levels of the node being inserted
+            // and its key is less than val. The node is guarded by the hint so it is safe
+            // to compare it even if it has been deleted; find_position() checks the deletion mark
+            if ( h.m_pNode && h.m_nLevel + 1 >= nHeight && cmp( *node_traits::to_value_ptr( h.m_pNode ), val ) < 0 ) {
+                m_Stat.onHintHit();
+                return find_position( val, pos, cmp, bStopIfFound, h.m_pNode, static_cast<int>( h.m_nLevel ));
+            }
+
+            m_Stat.onHintMiss();
+            return find_position( val, pos, cmp, bStopIfFound );
+        }
+
+        void set_predecessor_hint( hint& h, position const& pos )
+        {
+            // pos.pPrev[0] is linked at all levels for which it is the predecessor
+            node_type * pPred = pos.pPrev[0];
+            if ( pPred == m_Head.head()) {
+                h.release();
+                return;
+            }
+
+            int nLevel = 0;
+            while ( nLevel < pos.nTopLevel && pos.pPrev[nLevel + 1] == pPred )
+                ++nLevel;
+
+            // pPred is protected by pos.guards
+            h.set( pPred, static_cast<unsigned int>( nLevel ));
+        }
+
+        template <typename Q, typename Compare, typename Func>
+        bool find_hint_( hint& h, Q& val, Compare cmp, Func f )
+        {
+            position pos;
+            if ( find_hint_position( h, val, pos, cmp, true, 1 )) {
+                assert( cmp( *node_traits::to_value_ptr( pos.pCur ), val ) == 0 );
+
+                f( *node_traits::to_value_ptr( pos.pCur ), val );
+                h.set( pos.pCur, static_cast<unsigned int>( pos.nCurLevel ));
+                m_Stat.onFindSlowSuccess();
+                return true;
+            }
+
+            set_predecessor_hint( h, pos );
+            m_Stat.onFindSlowFailed();
+            return false;
+        }
+
+        // Finds the greatest item that is less than val (or equal to val if bInclusive is true).
+        // The item found is protected by guard. Returns nullptr if no such item.
+        template <typename Q, typename Compare>
+        value_type * find_predecessor_( Q const& val, Compare cmp, bool bInclusive, typename gc::Guard& guard )
+        {
+            position pos;
+            node_type * pFound;
+            if ( find_position( val, pos, cmp, bInclusive ) && bInclusive )
+                pFound = pos.pCur;
+            else
+                pFound = pos.pPrev[0];
+
+            if ( pFound == m_Head.head())
+                return nullptr;
+
+            // pFound is protected by pos.guards
+            return guard.assign( node_traits::to_value_ptr( pFound ));
+        }
+
+        // Finds the max item. The item found is protected by guard. Returns nullptr if the set is empty.
+        value_type * find_max_( typename gc::Guard& guard )
+        {
+            position pos;
+            if ( !find_max_position( pos ))
+                return nullptr;
+            return guard.assign( node_traits::to_value_ptr( pos.pCur ));
+        }
+
         template <typename Q, typename Compare>
         guarded_ptr get_with_( Q const& val, Compare cmp )
         {
@@ -133,10 +133,17 @@ namespace cds { namespace intrusive {
     protected:
         //@cond
         typedef typename base_class::dequeue_result dequeue_result;
+        typedef typename base_class::elimination_backoff elimination_backoff;
+        typedef typename base_class::operation_desc operation_desc;
 
         bool do_dequeue( dequeue_result& res )
         {
-            back_off bkoff;
+            typename elimination_backoff::type bkoff = base_class::m_Backoff.init();
+
+            operation_desc op;
+            if ( base_class::enable_elimination )
+                op.idOp = cds::intrusive::queue_elimination::op_dequeue;
+            bool bEliminationTried = false;
 
             node_type * pNext;
             node_type * h;
@@ -145,6 +152,12 @@ namespace cds { namespace intrusive {
                 pNext = res.guards.protect( 1, h->m_pNext, []( node_type * p ) -> value_type * { return node_traits::to_value_ptr( p );});
 
                 if ( pNext == nullptr ) {
+                    if ( base_class::enable_elimination && !bEliminationTried ) {
+                        bEliminationTried = true;
+                        if ( base_class::eliminate_dequeue( bkoff, op, res ))
+                            return true;
+                        continue;
+                    }
                     base_class::m_Stat.onEmptyDequeue();
                     return false;    // queue is empty
                 }
@@ -157,7 +170,8 @@ namespace cds { namespace intrusive {
                 }
 
                 base_class::m_Stat.onDequeueRace();
-                bkoff();
+                if ( base_class::eliminate_dequeue( bkoff, op, res ))
+                    return true;
             }
 
             --base_class::m_ItemCounter;
@@ -32,6 +32,7 @@
 #define CDSLIB_INTRUSIVE_MSPRIORITY_QUEUE_H
 
 #include <mutex>  // std::unique_lock
+#include <type_traits>
 #include <cds/intrusive/details/base.h>
 #include <cds/sync/spinlock.h>
 #include <cds/os/thread.h>
@@ -102,6 +103,9 @@ namespace cds { namespace intrusive {
                 You may specify any type of buffer's value since at instantiation time
                 the \p buffer::rebind member metafunction is called to change type
                 of values stored in the buffer.
+
+                If the buffer is \p cds::opt::v::initialized_segmented_buffer the heap is unbounded:
+                it grows by power-of-two segments when it is full.
             */
             typedef opt::v::initialized_dynamic_buffer<void *>  buffer;
 
@@ -134,7 +138,8 @@ namespace cds { namespace intrusive {
         /// Metafunction converting option list to traits
         /**
             \p Options:
-            - \p opt::buffer - the buffer type for heap array. Possible type are: \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+            - \p opt::buffer - the buffer type for heap array. Possible type are: \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer,
+                \p opt::v::initialized_segmented_buffer (growable heap).
                 Default is \p %opt::v::initialized_dynamic_buffer.
                 You may specify any type of value for the buffer since at instantiation time
                 the \p buffer::rebind member metafunction is called to change the type of values stored in the buffer.
@@ -179,6 +184,13 @@ namespace cds { namespace intrusive {
         workloads. For small heaps it still performs well, but not as well as
         single-lock algorithm.
 
+        By default the heap array has fixed capacity and \p push() fails when the heap is full.
+        With \p opt::v::initialized_segmented_buffer the heap array grows by power-of-two segments:
+        the segment \p k holds the level \p k of the heap, so a node is addressed as segment plus offset.
+        The heap grows under the heap's size lock without copying the existing nodes,
+        thus the node locks remain valid and the concurrent heapify operations are not affected.
+        The memory consumed tracks the max depth of the queue.
+
         Template parameters:
         - \p T - type to be stored in the queue. The priority is a part of \p T type.
         - \p Traits - type traits. See \p mspriority_queue::traits for explanation.
@@ -247,6 +259,18 @@ namespace cds { namespace intrusive {
         typedef typename item_counter::counter_type    counter_type;
         //@endcond
 
+        //@cond
+        // true if the heap array can grow, see opt::v::initialized_segmented_buffer
+        template <typename Buffer>
+        struct is_growable_buffer {
+            template <typename B> static std::true_type test( decltype( &B::grow ));
+            template <typename B> static std::false_type test( ... );
+            static CDS_CONSTEXPR const bool value = decltype( test<Buffer>( nullptr ))::value;
+        };
+        //@endcond
+
+        static CDS_CONSTEXPR const bool c_bGrowable = is_growable_buffer< buffer_type >::value; ///< \p true if the heap grows when full
+
     protected:
         item_counter        m_ItemCounter   ;   ///< Item counter
         mutable lock_type   m_Lock          ;   ///< Heap's size lock
@@ -257,6 +281,7 @@ namespace cds { namespace intrusive {
         /// Constructs empty priority queue
         /**
             For \p cds::opt::v::initialized_static_buffer the \p nCapacity parameter is ignored.
+            For \p cds::opt::v::initialized_segmented_buffer \p nCapacity is the initial capacity.
         */
         MSPriorityQueue( size_t nCapacity )
             : m_Heap( nCapacity )
@@ -271,7 +296,8 @@ namespace cds { namespace intrusive {
         /// Inserts a item into priority queue
         /**
             If the priority queue is full, the function returns \p false,
-            no item has been added.
+            no item has been added. The growable heap (see \p c_bGrowable) is extended
+            instead, so \p push() fails only if the heap cannot grow anymore.
             Otherwise, the function inserts the pointer to \p val into the heap
             and returns \p true.
 
@@ -283,7 +309,7 @@ namespace cds { namespace intrusive {
 
             // Insert new item at bottom of the heap
             m_Lock.lock();
-            if ( m_ItemCounter.value() >= capacity()) {
+            if ( m_ItemCounter.value() >= capacity() && !grow_heap( std::integral_constant<bool, c_bGrowable>())) {
                 // the heap is full
                 m_Lock.unlock();
                 m_Stat.onPushFailed();
@@ -403,6 +429,9 @@ namespace cds { namespace intrusive {
         }
 
         /// Checks if the priority queue is full
+        /**
+            For growable heap the function returns \p true if the next \p push() should extend the heap.
+        */
         bool full() const
         {
             return size() == capacity();
@@ -416,6 +445,9 @@ namespace cds { namespace intrusive {
         }
 
         /// Return capacity of the priority queue
+        /**
+            For growable heap the function returns current capacity.
+        */
         size_t capacity() const
         {
             // m_Heap[0] is not used
@@ -431,6 +463,21 @@ namespace cds { namespace intrusive {
     protected:
         //@cond
 
+        // m_Lock must be locked
+        bool grow_heap( std::false_type ) const
+        {
+            return false;
+        }
+
+        bool grow_heap( std::true_type )
+        {
+            // If the allocation throws, m_Lock is released
+            std::unique_lock<lock_type> l( m_Lock, std::adopt_lock );
+            bool const bGrown = m_Heap.grow();
+            l.release();
+            return bGrown;
+        }
+
         void heapify_after_push( counter_type i, tag_type curId )
         {
             key_comparator  cmp;
@@ -491,10 +538,11 @@ namespace cds { namespace intrusive {
         void heapify_after_pop( node * pParent )
         {
             key_comparator cmp;
-            counter_type const nCapacity = m_Heap.capacity();
 
+            // The capacity of growable heap should be read under the parent's lock:
+            // if a child is beyond the capacity the push of the child will be heapified after the parent is unlocked
             counter_type nParent = 1;
-            for ( counter_type nChild = nParent * 2; nChild < nCapacity; nChild *= 2 ) {
+            for ( counter_type nChild = nParent * 2; nChild < m_Heap.capacity(); nChild *= 2 ) {
                 node* pChild = &m_Heap[ nChild ];
                 pChild->lock();
 
@@ -504,7 +552,7 @@ namespace cds { namespace intrusive {
                 }
 
                 counter_type const nRight = nChild + 1;
-                if ( nRight < nCapacity ) {
+                if ( nRight < m_Heap.capacity()) {
                     node& refRight = m_Heap[nRight];
                     refRight.lock();
 
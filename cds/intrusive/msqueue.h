@@ -34,6 +34,7 @@
 #include <type_traits>
 #include <cds/intrusive/details/single_link_struct.h>
 #include <cds/algo/atomic.h>
+#include <cds/intrusive/details/queue_elimination.h>
 
 namespace cds { namespace intrusive {
 
@@ -105,6 +106,12 @@ namespace cds { namespace intrusive {
             counter_type m_BadTail           ;  ///< Count of events "Tail is not pointed to the last item in the queue"
             counter_type m_EmptyDequeue      ;  ///< Count of dequeue from empty queue
 
+            counter_type m_ActiveEnqueueCollision  ; ///< Count of active enqueue collision for elimination back-off
+            counter_type m_ActiveDequeueCollision  ; ///< Count of active dequeue collision for elimination back-off
+            counter_type m_PassiveEnqueueCollision ; ///< Count of passive enqueue collision for elimination back-off
+            counter_type m_PassiveDequeueCollision ; ///< Count of passive dequeue collision for elimination back-off
+            counter_type m_EliminationFailed       ; ///< Count of unsuccessful elimination back-off
+
             /// Register enqueue call
             void onEnqueue()                { ++m_EnqueueCount; }
             /// Register dequeue call
@@ -120,6 +127,25 @@ namespace cds { namespace intrusive {
             /// Register dequeuing from empty queue
             void onEmptyDequeue()           { ++m_EmptyDequeue; }
 
+            /// Register active collision for elimination back-off
+            void onActiveCollision( cds::intrusive::queue_elimination::operation_id opId )
+            {
+                if ( opId == cds::intrusive::queue_elimination::op_enqueue )
+                    ++m_ActiveEnqueueCollision;
+                else
+                    ++m_ActiveDequeueCollision;
+            }
+            /// Register passive collision for elimination back-off
+            void onPassiveCollision( cds::intrusive::queue_elimination::operation_id opId )
+            {
+                if ( opId == cds::intrusive::queue_elimination::op_enqueue )
+                    ++m_PassiveEnqueueCollision;
+                else
+                    ++m_PassiveDequeueCollision;
+            }
+            /// Register unsuccessful elimination back-off
+            void onEliminationFailed()      { ++m_EliminationFailed; }
+
             //@cond
             void reset()
             {
@@ -130,6 +156,12 @@ namespace cds { namespace intrusive {
                 m_AdvanceTailError.reset();
                 m_BadTail.reset();
                 m_EmptyDequeue.reset();
+
+                m_ActiveEnqueueCollision.reset();
+                m_ActiveDequeueCollision.reset();
+                m_PassiveEnqueueCollision.reset();
+                m_PassiveDequeueCollision.reset();
+                m_EliminationFailed.reset();
             }
 
             stat& operator +=( stat const& s )
@@ -142,6 +174,12 @@ namespace cds { namespace intrusive {
                 m_BadTail += s.m_BadTail.get();
                 m_EmptyDequeue += s.m_EmptyDequeue.get();
 
+                m_ActiveEnqueueCollision += s.m_ActiveEnqueueCollision.get();
+                m_ActiveDequeueCollision += s.m_ActiveDequeueCollision.get();
+                m_PassiveEnqueueCollision += s.m_PassiveEnqueueCollision.get();
+                m_PassiveDequeueCollision += s.m_PassiveDequeueCollision.get();
+                m_EliminationFailed += s.m_EliminationFailed.get();
+
                 return *this;
             }
             //@endcond
@@ -158,6 +196,9 @@ namespace cds { namespace intrusive {
             void onAdvanceTailFailed()      const {}
             void onBadTail()                const {}
             void onEmptyDequeue()           const {}
+            void onActiveCollision( cds::intrusive::queue_elimination::operation_id ) const {}
+            void onPassiveCollision( cds::intrusive::queue_elimination::operation_id ) const {}
+            void onEliminationFailed()      const {}
 
             void reset() {}
             empty_stat& operator +=( empty_stat const& )
@@ -201,6 +242,30 @@ namespace cds { namespace intrusive {
 
             /// Padding for internal critical atomic data. Default is \p opt::cache_line_padding
             enum { padding = opt::cache_line_padding };
+
+            /// Enable \ref cds::intrusive::queue_elimination "elimination back-off"; by default, it is disabled
+            /**
+                The following traits is used only if elimination enabled
+            */
+            static CDS_CONSTEXPR const bool enable_elimination = false;
+
+            /// Back-off strategy to wait for elimination, default is 2 microseconds \p cds::backoff::delay_of
+            typedef cds::backoff::delay_of< 2, std::chrono::microseconds > elimination_backoff;
+
+            /// Buffer type for elimination array
+            /**
+                Possible types are \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+                The buffer can be any size: \p Exp2 template parameter of those classes can be \p false.
+                The size should be selected empirically for your application and hardware, there are no common rules for that.
+                Default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>.
+            */
+            typedef opt::v::initialized_static_buffer< int, 4 > buffer;
+
+            /// Random engine to generate a random position in elimination array
+            typedef opt::v::c_rand  random_engine;
+
+            /// Lock type used in elimination, default is cds::sync::spin
+            typedef cds::sync::spin lock_type;
         };
 
         /// Metafunction converting option list to \p msqueue::traits
@@ -221,6 +286,18 @@ namespace cds { namespace intrusive {
             - \p opt::padding - padding for internal critical atomic data. Default is \p opt::cache_line_padding
             - \p opt::memory_model - C++ memory ordering model. Can be \p opt::v::relaxed_ordering (relaxed memory model, the default)
                 or \p opt::v::sequential_consistent (sequentially consisnent memory model).
+            - \p opt::enable_elimination - enable \ref cds::intrusive::queue_elimination "elimination back-off" for the queue.
+                Default value is \p false.
+
+            If elimination back-off is enabled, additional options can be specified:
+            - \p opt::buffer - a buffer type for elimination array, see \p opt::v::initialized_static_buffer, \p opt::v::initialized_dynamic_buffer.
+                The buffer can be any size: \p Exp2 template parameter of those classes can be \p false.
+                Default is <tt> %opt::v::initialized_static_buffer< any_type, 4 > </tt>.
+            - \p opt::random_engine - a random engine to generate a random position in elimination array.
+                Default is \p opt::v::c_rand.
+            - \p opt::elimination_backoff - back-off strategy to wait for elimination, default is
+                <tt>cds::backoff::delay_of< 2, std::chrono::microseconds ></tt>
+            - \p opt::lock_type - a lock type used in elimination back-off, default is \p cds::sync::spin
 
             Example: declare \p %MSQueue with item counting and internal statistics
             \code
@@ -367,12 +444,29 @@ namespace cds { namespace intrusive {
 
         static CDS_CONSTEXPR const size_t c_nHazardPtrCount = 2; ///< Count of hazard pointer required for the algorithm
 
+    public: // related to elimination back-off
+
+        /// Elimination back-off is enabled or not
+        static CDS_CONSTEXPR const bool enable_elimination = traits::enable_elimination;
+        /// back-off strategy used to wait for elimination
+        typedef typename traits::elimination_backoff elimination_backoff_type;
+        /// Lock type used in elimination back-off
+        typedef typename traits::lock_type elimination_lock_type;
+        /// Random engine used in elimination back-off
+        typedef typename traits::random_engine elimination_random_engine;
+
     protected:
         //@cond
 
         // GC and node_type::gc must be the same
         static_assert((std::is_same<gc, typename node_type::gc>::value), "GC and node_type::gc must be the same");
 
+        static_assert( !enable_elimination || std::is_same<typename elimination_random_engine::result_type, unsigned int>::value,
+                       "Random engine result type must be unsigned int");
+
+        typedef cds::intrusive::queue_elimination::details::elimination_backoff< enable_elimination, value_type, traits > elimination_backoff;
+        typedef cds::intrusive::queue_elimination::operation< value_type > operation_desc;
+
         typedef typename node_type::atomic_node_ptr atomic_node_ptr;
 
         atomic_node_ptr    m_pHead;        ///< Queue's head pointer
@@ -383,6 +477,7 @@ namespace cds { namespace intrusive {
         typename opt::details::apply_padding< node_type, traits::padding >::padding_type pad3_;
         item_counter        m_ItemCounter; ///< Item counter
         stat                m_Stat;        ///< Internal statistics
+        elimination_backoff m_Backoff;     ///< Elimination back-off data
         //@endcond
 
         //@cond
@@ -393,10 +488,48 @@ namespace cds { namespace intrusive {
             node_type * pNext;
         };
 
+        // Checks if the queue is empty; used by elimination back-off. h is the guarded head
+        bool is_empty_at( node_type * h ) const
+        {
+            return h->m_pNext.load( memory_model::memory_order_acquire ) == nullptr
+                && m_pHead.load( memory_model::memory_order_acquire ) == h;
+        }
+
+        bool is_empty_guarded( typename gc::Guard& guard ) const
+        {
+            return is_empty_at( guard.protect( m_pHead, []( node_type * p ) -> value_type * { return node_traits::to_value_ptr( p );}));
+        }
+
+        bool is_empty_guarded( typename gc::template GuardArray<2>& guards ) const
+        {
+            return is_empty_at( guards.protect( 0, m_pHead, []( node_type * p ) -> value_type * { return node_traits::to_value_ptr( p );}));
+        }
+
+        // Tries to eliminate the dequeue with a concurrent enqueue
+        template <typename Backoff>
+        bool eliminate_dequeue( Backoff& bkoff, operation_desc& op, dequeue_result& res )
+        {
+            if ( bkoff.backoff( op, m_Stat, [this, &res]() { return is_empty_guarded( res.guards ); } )) {
+                // The eliminated node has never been linked into the queue.
+                // It is returned as a dequeued item and then disposed by dispose_result()
+                assert( op.pVal != nullptr );
+                node_type * p = node_traits::to_node_ptr( op.pVal );
+                res.guards.assign( 1, op.pVal );
+                res.pHead = res.pNext = p;
+                return true;
+            }
+            return false;
+        }
+
         bool do_dequeue( dequeue_result& res )
         {
             node_type * pNext;
-            back_off bkoff;
+            typename elimination_backoff::type bkoff = m_Backoff.init();
+
+            operation_desc op;
+            if ( enable_elimination )
+                op.idOp = cds::intrusive::queue_elimination::op_dequeue;
+            bool bEliminationTried = false;
 
             node_type * h;
             while ( true ) {
@@ -406,6 +539,13 @@ namespace cds { namespace intrusive {
                     continue;
 
                 if ( pNext == nullptr ) {
+                    if ( enable_elimination && !bEliminationTried ) {
+                        // Wait for a concurrent enqueue once, then re-check the queue
+                        bEliminationTried = true;
+                        if ( eliminate_dequeue( bkoff, op, res ))
+                            return true;
+                        continue;
+                    }
                     m_Stat.onEmptyDequeue();
                     return false;    // empty queue
                 }
@@ -422,7 +562,8 @@ namespace cds { namespace intrusive {
                     break;
 
                 m_Stat.onDequeueRace();
-                bkoff();
+                if ( eliminate_dequeue( bkoff, op, res ))
+                    return true;
             }
 
             --m_ItemCounter;
@@ -433,6 +574,121 @@ namespace cds { namespace intrusive {
             return true;
         }
 
+        // Links the chain [pFirst, pLast] of nCount nodes to the tail of the queue with one CAS
+        void do_enqueue_chain( node_type * pFirst, node_type * pLast, size_t nCount )
+        {
+            assert( pFirst != nullptr );
+            assert( pLast != nullptr );
+            assert( pLast->m_pNext.load( atomics::memory_order_relaxed ) == nullptr );
+
+            typename gc::Guard guard;
+            back_off bkoff;
+
+            node_type * t;
+            while ( true ) {
+                t = guard.protect( m_pTail, []( node_type * p ) -> value_type * { return node_traits::to_value_ptr( p );});
+
+                node_type * pNext = t->m_pNext.load(memory_model::memory_order_acquire);
+                if ( pNext != nullptr ) {
+                    // Tail is misplaced, advance it
+                    m_pTail.compare_exchange_weak( t, pNext, memory_model::memory_order_release, atomics::memory_order_relaxed );
+                    m_Stat.onBadTail();
+                    continue;
+                }
+
+                node_type * tmp = nullptr;
+                if ( t->m_pNext.compare_exchange_strong( tmp, pFirst, memory_model::memory_order_release, atomics::memory_order_relaxed ))
+                    break;
+
+                m_Stat.onEnqueueRace();
+                bkoff();
+            }
+
+            m_ItemCounter += nCount;
+            for ( size_t i = 0; i < nCount; ++i )
+                m_Stat.onEnqueue();
+
+            // The tail may lag behind the end of the chain; concurrent operations advance it step by step
+            if ( !m_pTail.compare_exchange_strong( t, pLast, memory_model::memory_order_release, atomics::memory_order_relaxed ))
+                m_Stat.onAdvanceTailFailed();
+        }
+
+        // Detaches up to nMax items with one head CAS; f( value_type& ) is called for each dequeued item
+        template <typename Func>
+        size_t do_dequeue_batch( Func f, size_t nMax )
+        {
+            if ( nMax == 0 )
+                return 0;
+
+            // guards[0] - head, guards[1] - the last node of the detached chain.
+            // The nodes between them need no guard: they cannot be retired while the head is unchanged
+            typename gc::template GuardArray<2> guards;
+            back_off bkoff;
+
+            node_type * h;
+            node_type * pLast;
+            size_t nCount;
+            while ( true ) {
+                h = guards.protect( 0, m_pHead, []( node_type * p ) -> value_type * { return node_traits::to_value_ptr( p );});
+
+                pLast = h;
+                nCount = 0;
+                bool bRestart = false;
+                while ( nCount < nMax ) {
+                    node_type * pNext = pLast->m_pNext.load( memory_model::memory_order_acquire );
+                    if ( pNext == nullptr )
+                        break;
+
+                    if ( pLast == m_pTail.load( memory_model::memory_order_acquire )) {
+                        // The tail cannot be disposed: stop here or help to advance the tail
+                        if ( nCount == 0 ) {
+                            node_type * t = pLast;
+                            m_pTail.compare_exchange_strong( t, pNext, memory_model::memory_order_release, atomics::memory_order_relaxed );
+                            m_Stat.onBadTail();
+                            bRestart = true;
+                        }
+                        break;
+                    }
+
+                    guards.assign( 1, node_traits::to_value_ptr( pNext ));
+                    if ( m_pHead.load( memory_model::memory_order_acquire ) != h ) {
+                        bRestart = true;
+                        break;
+                    }
+                    pLast = pNext;
+                    ++nCount;
+                }
+
+                if ( bRestart )
+                    continue;
+
+                if ( nCount == 0 ) {
+                    m_Stat.onEmptyDequeue();
+                    return 0;    // empty queue
+                }
+
+                if ( m_pHead.compare_exchange_strong( h, pLast, memory_model::memory_order_acquire, atomics::memory_order_relaxed ))
+                    break;
+
+                m_Stat.onDequeueRace();
+                bkoff();
+            }
+
+            m_ItemCounter -= nCount;
+
+            // Now the chain [h, pLast) is owned by current thread; pLast is the new dummy node
+            node_type * p = h;
+            for ( size_t i = 0; i < nCount; ++i ) {
+                node_type * pNext = p->m_pNext.load( memory_model::memory_order_acquire );
+                f( *node_traits::to_value_ptr( pNext ));
+                m_Stat.onDequeue();
+                dispose_node( p );
+                p = pNext;
+            }
+            assert( p == pLast );
+            return nCount;
+        }
+
         static void clear_links( node_type * pNode )
         {
             pNode->m_pNext.store( nullptr, memory_model::memory_order_release );
@@ -473,6 +729,18 @@ namespace cds { namespace intrusive {
             , m_pTail( &m_Dummy )
         {}
 
+        /// Initializes empty queue and elimination back-off data
+        /**
+            This form should be used if you use elimination back-off with dynamically allocated collision array, i.e
+            \p Traits contains <tt>typedef cds::opt::v::initialized_dynamic_buffer buffer</tt>.
+            \p nCollisionCapacity parameter specifies the capacity of collision array.
+        */
+        explicit MSQueue( size_t nCollisionCapacity )
+            : m_pHead( &m_Dummy )
+            , m_pTail( &m_Dummy )
+            , m_Backoff( nCollisionCapacity )
+        {}
+
         /// Destructor clears the queue
         /**
             Since the Michael & Scott queue contains at least one item even
@@ -503,7 +771,13 @@ namespace cds { namespace intrusive {
             link_checker::is_empty( pNew );
 
             typename gc::Guard guard;
-            back_off bkoff;
+            typename elimination_backoff::type bkoff = m_Backoff.init();
+
+            operation_desc op;
+            if ( enable_elimination ) {
+                op.idOp = cds::intrusive::queue_elimination::op_enqueue;
+                op.pVal = &val;
+            }
 
             node_type * t;
             while ( true ) {
@@ -522,7 +796,10 @@ namespace cds { namespace intrusive {
                     break;
 
                 m_Stat.onEnqueueRace();
-                bkoff();
+                if ( bkoff.backoff( op, m_Stat, [this, &guard]() { return is_empty_guarded( guard ); } )) {
+                    // val has been passed to a concurrent dequeue directly
+                    return true;
+                }
             }
             ++m_ItemCounter;
             m_Stat.onEnqueue();
@@ -568,6 +845,55 @@ namespace cds { namespace intrusive {
             return nullptr;
         }
 
+        /// Enqueues the items from the range <tt>[first, last)</tt>
+        /**
+            The items are linked into a private chain that is appended to the queue
+            with a single CAS on the tail, so the items are enqueued contiguously
+            in the order of the range. \p Iterator dereferences to <tt>value_type&</tt>.
+
+            Returns the number of enqueued items.
+        */
+        template <typename Iterator>
+        size_t enqueue_batch( Iterator first, Iterator last )
+        {
+            node_type * pFirst = nullptr;
+            node_type * pLast = nullptr;
+            size_t nCount = 0;
+            for ( ; first != last; ++first ) {
+                node_type * pNew = node_traits::to_node_ptr( *first );
+                link_checker::is_empty( pNew );
+                if ( pLast )
+                    pLast->m_pNext.store( pNew, memory_model::memory_order_relaxed );
+                else
+                    pFirst = pNew;
+                pLast = pNew;
+                ++nCount;
+            }
+
+            if ( nCount )
+                do_enqueue_chain( pFirst, pLast, nCount );
+            return nCount;
+        }
+
+        /// Dequeues up to \p nMax items
+        /**
+            The function detaches up to \p nMax items with a single CAS on the queue head
+            and calls \p f for each of them in FIFO order:
+            \code
+            void f( value_type& item );
+            \endcode
+            As for \p dequeue(), the item passed to \p f remains in the queue as a dummy node
+            and may be disposed at any time after \p f returns,
+            so the functor should copy the item data it needs.
+
+            Returns the number of dequeued items, 0 if the queue is empty.
+        */
+        template <typename Func>
+        size_t dequeue_batch( Func f, size_t nMax )
+        {
+            return do_dequeue_batch( f, nMax );
+        }
+
         /// Synonym for \ref cds_intrusive_MSQueue_enqueue "enqueue()" function
         bool push( value_type& val )
         {
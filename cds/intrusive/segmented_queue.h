@@ -577,6 +577,41 @@ namespace cds { namespace intrusive {
 
         }
 
+        /// Enqueues the items from the range <tt>[first, last)</tt>
+        /**
+            The tail segment is looked up once and its random permutation of cells is shared by all the items,
+            so the batch costs one CAS per item without re-reading the tail for each one.
+            Like for \p enqueue(), the order of the items inside the segment is not specified.
+            \p Iterator dereferences to <tt>value_type&</tt>.
+
+            Returns the number of enqueued items.
+        */
+        template <typename Iterator>
+        size_t enqueue_batch( Iterator first, Iterator last )
+        {
+            return do_enqueue_batch( [&first, &last]() -> value_type * {
+                if ( first == last )
+                    return nullptr;
+                value_type * p = &*first;
+                ++first;
+                return p;
+            });
+        }
+
+        /// Dequeues up to \p nMax items into array \p pArr
+        /**
+            The head segment is looked up once and scanned for several items.
+            Like for \p dequeue(), the disposer is <b>not</b> called for the returned items.
+
+            Returns the number of dequeued items, 0 if the queue is empty.
+        */
+        size_t dequeue_batch( value_type ** pArr, size_t nMax )
+        {
+            size_t nCount = 0;
+            do_dequeue_batch( [pArr, &nCount]( value_type * p ) { pArr[nCount++] = p; }, nMax );
+            return nCount;
+        }
+
         /// Synonym for \p enqueue(value_type&) member function
         bool push( value_type& val )
         {
@@ -650,6 +685,130 @@ namespace cds { namespace intrusive {
 
     protected:
         //@cond
+        // fNext() returns the next item to enqueue or nullptr at the end of the batch
+        template <typename Func>
+        size_t do_enqueue_batch( Func fNext )
+        {
+            value_type * pVal = fNext();
+            if ( !pVal )
+                return 0;
+
+            typename gc::Guard segmentGuard;
+            segment * pTailSegment = m_SegmentList.tail( segmentGuard );
+            if ( !pTailSegment ) {
+                // no segments, create the new one
+                pTailSegment = m_SegmentList.create_tail( pTailSegment, segmentGuard );
+                assert( pTailSegment );
+            }
+
+            permutation_generator gen( quasi_factor());
+            size_t nCount = 0;
+
+            // See enqueue(): the counter is incremented before inserting
+            ++m_ItemCounter;
+
+            while ( true ) {
+                do {
+                    // LSB is used as a flag in marked pointer
+                    assert( (reinterpret_cast<uintptr_t>( pVal ) & 1) == 0 );
+
+                    typename permutation_generator::integer_type i = gen;
+                    if ( pTailSegment->cells[i].data.load(memory_model::memory_order_relaxed).all()) {
+                        // Cell is not empty, go next
+                        m_Stat.onPushPopulated();
+                    }
+                    else {
+                        // Empty cell found, try to enqueue here
+                        regular_cell nullCell;
+                        if ( pTailSegment->cells[i].data.compare_exchange_strong( nullCell, regular_cell( pVal ),
+                            memory_model::memory_order_release, atomics::memory_order_relaxed ))
+                        {
+                            m_Stat.onPush();
+                            ++nCount;
+
+                            pVal = fNext();
+                            if ( !pVal )
+                                return nCount;
+                            ++m_ItemCounter;
+                        }
+                        else {
+                            assert( nullCell.ptr());
+                            m_Stat.onPushContended();
+                        }
+                    }
+                } while ( gen.next());
+
+                // No available position, create a new segment
+                pTailSegment = m_SegmentList.create_tail( pTailSegment, segmentGuard );
+
+                // Get new permutation
+                gen.reset();
+            }
+        }
+
+        // f( value_type * ) is called for each dequeued item
+        template <typename Func>
+        size_t do_dequeue_batch( Func f, size_t nMax )
+        {
+            if ( nMax == 0 )
+                return 0;
+
+            typename gc::Guard segmentGuard;
+            segment * pHeadSegment = m_SegmentList.head( segmentGuard );
+            size_t nCount = 0;
+
+            permutation_generator gen( quasi_factor());
+            while ( true ) {
+                if ( !pHeadSegment ) {
+                    // Queue is empty
+                    if ( nCount == 0 )
+                        m_Stat.onPopEmpty();
+                    return nCount;
+                }
+
+                bool bHadNullValue = false;
+                do {
+                    typename permutation_generator::integer_type i = gen;
+
+                    // The dequeued item is owned by the caller, no other thread can retire it,
+                    // so the item does not need a guard
+                    regular_cell item = pHeadSegment->cells[i].data.load( memory_model::memory_order_relaxed );
+                    if ( !item.ptr())
+                        bHadNullValue = true;
+                    else if ( !item.bits()) {
+                        // Try to mark the cell as deleted
+                        if ( pHeadSegment->cells[i].data.compare_exchange_strong( item, item | 1,
+                            memory_model::memory_order_acquire, atomics::memory_order_relaxed ))
+                        {
+                            --m_ItemCounter;
+                            m_Stat.onPop();
+
+                            f( item.ptr());
+                            if ( ++nCount == nMax )
+                                return nCount;
+                        }
+                        else {
+                            assert( item.bits());
+                            m_Stat.onPopContended();
+                        }
+                    }
+                } while ( gen.next());
+
+                // If there was an empty cell, the queue is considered empty
+                if ( bHadNullValue ) {
+                    if ( nCount == 0 )
+                        m_Stat.onPopEmpty();
+                    return nCount;
+                }
+
+                // All nodes have been dequeued, we can safely remove the first segment
+                pHeadSegment = m_SegmentList.remove_head( pHeadSegment, segmentGuard );
+
+                // Get new permutation
+                gen.reset();
+            }
+        }
+
         bool do_dequeue( typename gc::Guard& itemGuard )
         {
             typename gc::Guard segmentGuard;
@@ -2050,6 +2050,34 @@ namespace cds { namespace intrusive {
             return pDel ? node_traits::to_value_ptr( pDel ) : nullptr;
         }
 
+        // Finds the greatest item that is less than val (or equal to val if bInclusive is true).
+        // RCU should be locked. Returns nullptr if no such item.
+        template <typename Q, typename Compare>
+        value_type * find_predecessor_( Q const& val, Compare cmp, bool bInclusive, position& pos )
+        {
+            assert( gc::is_locked());
+
+            node_type * pFound;
+            if ( find_position( val, pos, cmp, bInclusive ) && bInclusive )
+                pFound = pos.pCur;
+            else
+                pFound = pos.pPrev[0];
+
+            if ( pFound == m_Head.head())
+                return nullptr;
+            return node_traits::to_value_ptr( pFound );
+        }
+
+        // Finds the max item. RCU should be locked. Returns nullptr if the set is empty.
+        value_type * find_max_( position& pos )
+        {
+            assert( gc::is_locked());
+
+            if ( !find_max_position( pos ))
+                return nullptr;
+            return node_traits::to_value_ptr( pos.pCur );
+        }
+
         void increase_height( unsigned int nHeight )
         {
             unsigned int nCur = m_nHeight.load( memory_model::memory_order_relaxed );
@@ -44,6 +44,59 @@ namespace cds { namespace intrusive {
             Resizing policy for \p intrusive::StripedSet, \p container::StripedSet and \p container::StripedMap.
         */
 
+        //@cond
+        namespace details {
+            // Bucket tables replaced by resizing.
+            // With optimistic reading a reader may still traverse an old table after resizing,
+            // so the old tables are kept until the set is destroyed.
+            // Since the table is doubled on each resizing, the total size of old tables is less than the size of current table.
+            template <class BucketAllocator, bool Keep>
+            class old_bucket_tables
+            {
+            public:
+                typedef typename BucketAllocator::value_type bucket_type;
+
+                void retire( bucket_type * pBuckets, size_t nSize )
+                {
+                    BucketAllocator().Delete( pBuckets, nSize );
+                }
+            };
+
+            template <class BucketAllocator>
+            class old_bucket_tables< BucketAllocator, true >
+            {
+            public:
+                typedef typename BucketAllocator::value_type bucket_type;
+
+            private:
+                static CDS_CONSTEXPR const size_t c_nMaxCount = sizeof( size_t ) * 8;
+
+                bucket_type *   m_arrTables[c_nMaxCount];
+                size_t          m_arrSizes[c_nMaxCount];
+                size_t          m_nCount;
+
+            public:
+                old_bucket_tables()
+                    : m_nCount( 0 )
+                {}
+
+                ~old_bucket_tables()
+                {
+                    for ( size_t i = 0; i < m_nCount; ++i )
+                        BucketAllocator().Delete( m_arrTables[i], m_arrSizes[i] );
+                }
+
+                void retire( bucket_type * pBuckets, size_t nSize )
+                {
+                    assert( m_nCount < c_nMaxCount );
+                    m_arrTables[m_nCount] = pBuckets;
+                    m_arrSizes[m_nCount] = nSize;
+                    ++m_nCount;
+                }
+            };
+        } // namespace details
+        //@endcond
+
     }   // namespace striped_set
 
     /// Striped hash set
@@ -73,7 +126,7 @@ namespace cds { namespace intrusive {
 
         The \p Options are:
         - \p opt::mutex_policy - concurrent access policy.
-            Available policies: \p striped_set::striping, \p striped_set::refinable.
+            Available policies: \p striped_set::striping, \p striped_set::seqlock_striping, \p striped_set::refinable.
             Default is \p %striped_set::striping.
         - \p cds::opt::hash - hash functor. Default option value see <tt>opt::v::hash_selector <opt::none></tt>
             which selects default hash functor for your compiler.
@@ -325,6 +378,10 @@ namespace cds { namespace intrusive {
 
         typedef cds::details::Allocator< bucket_type, allocator_type > bucket_allocator;  ///< bucket allocator type based on allocator_type
 
+        /// \p true if \p contains() reads the bucket without locking, see \p striped_set::seqlock_striping
+        static CDS_CONSTEXPR const bool c_bOptimisticRead = striped_set::details::is_optimistic_policy< mutex_policy >::value
+            && striped_set::details::is_optimistic_bucket< bucket_type >::value;
+
     protected:
         bucket_type *   m_Buckets       ;   ///< Bucket table
         size_t          m_nBucketMask   ;   ///< Bucket table size - 1. m_nBucketMask + 1 should be power of two.
@@ -334,6 +391,8 @@ namespace cds { namespace intrusive {
         mutex_policy    m_MutexPolicy   ;   ///< Mutex policy
         resizing_policy m_ResizingPolicy;   ///< Resizing policy
 
+        striped_set::details::old_bucket_tables< bucket_allocator, c_bOptimisticRead > m_OldBuckets; ///< Old bucket tables (optimistic reading only)
+
         static const size_t c_nMinimalCapacity = 16 ;   ///< Minimal capacity
 
     protected:
@@ -341,6 +400,8 @@ namespace cds { namespace intrusive {
         typedef typename mutex_policy::scoped_cell_lock     scoped_cell_lock;
         typedef typename mutex_policy::scoped_full_lock     scoped_full_lock;
         typedef typename mutex_policy::scoped_resize_lock   scoped_resize_lock;
+        typedef striped_set::details::scoped_retire< bucket_type > scoped_retire;
+        typedef typename striped_set::details::cell_shared_lock< mutex_policy >::type scoped_cell_shared_lock;
         //@endcond
 
     protected:
@@ -354,8 +415,12 @@ namespace cds { namespace intrusive {
         void alloc_bucket_table( size_t nSize )
         {
             assert( cds::beans::is_power2( nSize ));
-            m_nBucketMask = nSize - 1;
             m_Buckets = bucket_allocator().NewArray( nSize );
+
+            // An optimistic reader loads the mask before the table (see optimistic_bucket()),
+            // so it never applies the new (greater) mask to the old table
+            atomics::atomic_thread_fence( atomics::memory_order_release );
+            m_nBucketMask = nSize - 1;
         }
 
         static void free_bucket_table( bucket_type * pBuckets, size_t nSize )
@@ -374,6 +439,16 @@ namespace cds { namespace intrusive {
             return m_Buckets + (nHash & m_nBucketMask);
         }
 
+        bucket_type * optimistic_bucket( size_t nHash ) const CDS_NOEXCEPT
+        {
+            // The bucket table may be being resized right now.
+            // The table is replaced before the mask and old tables are not freed,
+            // so the bucket found is valid even if it is out of date; read_validate() detects that
+            size_t nMask = const_cast<size_t volatile&>( m_nBucketMask );
+            atomics::atomic_thread_fence( atomics::memory_order_acquire );
+            return const_cast<bucket_type * volatile&>( m_Buckets ) + ( nHash & nMask );
+        }
+
         template <typename Q, typename Func>
         bool find_( Q& val, Func f )
         {
@@ -391,6 +466,68 @@ namespace cds { namespace intrusive {
             return bucket( nHash )->find( val, pred, f );
         }
 
+        template <typename Q>
+        bool contains_( Q const& key )
+        {
+            return contains_( key, std::integral_constant< bool, c_bOptimisticRead >());
+        }
+
+        template <typename Q>
+        bool contains_( Q const& key, std::false_type )
+        {
+            size_t nHash = hashing( key );
+            scoped_cell_shared_lock sl( m_MutexPolicy, nHash );
+            return bucket( nHash )->find( key, []( value_type&, Q const& ) {} );
+        }
+
+        template <typename Q>
+        bool contains_( Q const& key, std::true_type )
+        {
+            bool bFound;
+            if ( optimistic_read( hashing( key ), bFound, [&key]( bucket_type& b ) { return b.optimistic_contains( key ); }))
+                return bFound;
+            return contains_( key, std::false_type());
+        }
+
+        template <typename Q, typename Less>
+        bool contains_with_( Q const& key, Less pred )
+        {
+            return contains_with_( key, pred, std::integral_constant< bool, c_bOptimisticRead >());
+        }
+
+        template <typename Q, typename Less>
+        bool contains_with_( Q const& key, Less pred, std::false_type )
+        {
+            size_t nHash = hashing( key );
+            scoped_cell_shared_lock sl( m_MutexPolicy, nHash );
+            return bucket( nHash )->find( key, pred, []( value_type&, Q const& ) {} );
+        }
+
+        template <typename Q, typename Less>
+        bool contains_with_( Q const& key, Less pred, std::true_type )
+        {
+            bool bFound;
+            if ( optimistic_read( hashing( key ), bFound, [&key, &pred]( bucket_type& b ) { return b.optimistic_contains( key, pred ); }))
+                return bFound;
+            return contains_with_( key, pred, std::false_type());
+        }
+
+        // Reads the bucket without locking; returns false if the bucket is being changed too often
+        template <typename Func>
+        bool optimistic_read( size_t nHash, bool& bResult, Func f )
+        {
+            for ( unsigned nAttempt = 0; nAttempt < mutex_policy::c_nReadAttempts; ++nAttempt ) {
+                typename mutex_policy::sequence_type nSeq;
+                if ( !m_MutexPolicy.read_begin( nHash, nSeq ))
+                    break;  // a writer holds the bucket
+
+                bResult = f( *optimistic_bucket( nHash ));
+                if ( m_MutexPolicy.read_validate( nHash, nSeq ))
+                    return true;
+            }
+            return false;
+        }
+
         void internal_resize( size_t nNewCapacity )
         {
             // All locks are already locked!
@@ -414,7 +551,7 @@ namespace cds { namespace intrusive {
                 pCur->clear();
             }
 
-            free_bucket_table( pOldBuckets, nOldCapacity );
+            m_OldBuckets.retire( pOldBuckets, nOldCapacity );
 
             m_ResizingPolicy.reset();
         }
@@ -424,6 +561,7 @@ namespace cds { namespace intrusive {
             size_t nOldCapacity = bucket_count();
             size_t volatile& refBucketMask = m_nBucketMask;
 
+            scoped_retire sr;
             scoped_resize_lock al( m_MutexPolicy );
             if ( al.success()) {
                 if ( nOldCapacity != refBucketMask + 1 ) {
@@ -787,7 +925,7 @@ namespace cds { namespace intrusive {
         template <typename Q>
         bool contains( Q const& key )
         {
-            return find( key, [](value_type&, Q const& ) {} );
+            return contains_( key );
         }
         //@cond
         template <typename Q>
@@ -807,7 +945,7 @@ namespace cds { namespace intrusive {
         template <typename Q, typename Less>
         bool contains( Q const& key, Less pred )
         {
-            return find_with( key, pred, [](value_type& , Q const& ) {} );
+            return contains_with_( key, pred );
         }
         //@cond
         template <typename Q, typename Less>
@@ -824,6 +962,7 @@ namespace cds { namespace intrusive {
         */
         void clear()
         {
+            scoped_retire sr;
             // locks entire array
             scoped_full_lock sl( m_MutexPolicy );
 
@@ -847,6 +986,7 @@ namespace cds { namespace intrusive {
         template <typename Disposer>
         void clear_and_dispose( Disposer disposer )
         {
+            scoped_retire sr;
             // locks entire array
             scoped_full_lock sl( m_MutexPolicy );
 
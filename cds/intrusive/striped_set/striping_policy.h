@@ -36,6 +36,8 @@
 #include <cds/sync/lock_array.h>
 #include <cds/os/thread.h>
 #include <cds/sync/spinlock.h>
+#include <cds/sync/rw_lock.h>
+#include <cds/sync/seqlock.h>
 
 namespace cds { namespace intrusive { namespace striped_set {
 
@@ -54,7 +56,13 @@ namespace cds { namespace intrusive { namespace striped_set {
 
         Template arguments:
         - \p Lock - the type of mutex. The default is \p std::mutex. The mutex type should be default-constructible.
-            Note that a spin-lock is not so good suitable for lock striping for performance reason.
+            Note that a spin-lock is not so good suitable for lock striping for performance reason;
+            the queue locks \p cds::sync::mcs_lock and \p cds::sync::ticket_lock are fair and do not cause
+            cache-line storms under contention.
+            If \p Lock is a reader-writer lock (see \p cds::sync::is_shared_lockable), for example \p cds::sync::rw_spin_lock,
+            the set takes the lock in shared mode in \p contains(), so the lookups in one bucket go in parallel.
+            In that case the bucket container should allow concurrent lookups; for example,
+            \p boost::intrusive::splay_set changes itself on search and is not allowed.
         - \p Alloc - allocator type used for lock array memory allocation. Default is \p CDS_DEFAULT_ALLOCATOR.
     */
     template <class Lock = std::mutex, class Alloc = CDS_DEFAULT_ALLOCATOR >
@@ -82,6 +90,28 @@ namespace cds { namespace intrusive { namespace striped_set {
             {}
         };
 
+        class scoped_cell_reader_lock {
+            lock_array_type&    m_Locks;
+            size_t              m_nCell;
+
+        public:
+            scoped_cell_reader_lock( striping& policy, size_t nHash )
+                : m_Locks( policy.m_Locks )
+                , m_nCell( policy.m_Locks.lock_shared( nHash ))
+            {}
+
+            ~scoped_cell_reader_lock()
+            {
+                m_Locks.unlock_shared( m_nCell );
+            }
+        };
+
+        // The lock for read-only operations: shared if the lock supports shared mode, exclusive otherwise
+        typedef typename std::conditional< cds::sync::is_shared_lockable< lock_type >::value,
+            scoped_cell_reader_lock,
+            scoped_cell_lock
+        >::type scoped_cell_shared_lock;
+
         class scoped_full_lock {
             std::unique_lock< lock_array_type >   m_guard;
         public:
@@ -127,6 +157,64 @@ namespace cds { namespace intrusive { namespace striped_set {
     };
 
 
+    /// Lock striping concurrent access policy with optimistic reading
+    /**
+        This is one of available \p opt::mutex_policy option type for \p StripedSet
+
+        The policy is like \p striping but each lock of the array is a sequence lock \p cds::sync::seq_lock.
+        It allows the set to perform \p contains() without locking: the set reads the bucket and then
+        validates the sequence number of the bucket's lock. On conflict with a writer or a resizing
+        the set retries the read up to \p ReadAttempts times, then it locks the bucket as usual.
+
+        The optimistic reading requires the bucket container that is safe to read concurrently with modification,
+        see \p cds::container::striped_set::rcu_list. For other bucket types the policy works like \p striping.
+        Since the buckets can be read during resizing, \p StripedSet does not free old bucket tables
+        until destruction; their total size is less than the size of current bucket table.
+
+        Template arguments:
+        - \p Lock - the type of mutex, default is \p cds::sync::spin. The writers hold the lock for short time
+            since the readers do not take it.
+        - \p ReadAttempts - number of optimistic read attempts before locking, default is 4
+        - \p Alloc - allocator type used for lock array memory allocation. Default is \p CDS_DEFAULT_ALLOCATOR.
+    */
+    template <class Lock = cds::sync::spin, unsigned ReadAttempts = 4, class Alloc = CDS_DEFAULT_ALLOCATOR >
+    class seqlock_striping: public striping< cds::sync::seq_lock< Lock >, Alloc >
+    {
+        //@cond
+        typedef striping< cds::sync::seq_lock< Lock >, Alloc > base_class;
+        //@endcond
+    public:
+        typedef typename base_class::lock_type          lock_type;      ///< lock type, \p cds::sync::seq_lock<Lock>
+        typedef typename base_class::allocator_type     allocator_type; ///< allocator type
+        typedef typename base_class::lock_array_type    lock_array_type;///< lock array type
+        typedef typename lock_type::sequence_type       sequence_type;  ///< sequence number type
+
+        static CDS_CONSTEXPR const unsigned c_nReadAttempts = ReadAttempts; ///< Number of optimistic read attempts
+        //@cond
+        static_assert( c_nReadAttempts > 0, "ReadAttempts must be positive" );
+        //@endcond
+
+    public:
+        /// Constructor
+        seqlock_striping(
+            size_t nLockCount   ///< The size of lock array. Must be power of two.
+        )
+            : base_class( nLockCount )
+        {}
+
+        //@cond
+        bool read_begin( size_t nHash, sequence_type& nSeq ) const
+        {
+            return base_class::m_Locks.at( base_class::m_Locks.cell( nHash )).read_begin( nSeq );
+        }
+
+        bool read_validate( size_t nHash, sequence_type nSeq ) const
+        {
+            return base_class::m_Locks.at( base_class::m_Locks.cell( nHash )).read_validate( nSeq );
+        }
+        //@endcond
+    };
+
     /// Refinable concurrent access policy
     /**
         This is one of available opt::mutex_policy option type for StripedSet
@@ -379,6 +467,78 @@ namespace cds { namespace intrusive { namespace striped_set {
         }
     };
 
+    //@cond
+    namespace details {
+        template <typename T>
+        struct void_of {
+            typedef void type;
+        };
+
+        // Cell lock for read-only operations: MutexPolicy::scoped_cell_shared_lock if the policy defines it,
+        // MutexPolicy::scoped_cell_lock otherwise
+        template <class MutexPolicy, class = void>
+        struct cell_shared_lock {
+            typedef typename MutexPolicy::scoped_cell_lock type;
+        };
+
+        template <class MutexPolicy>
+        struct cell_shared_lock< MutexPolicy, typename void_of< typename MutexPolicy::scoped_cell_shared_lock >::type >
+        {
+            typedef typename MutexPolicy::scoped_cell_shared_lock type;
+        };
+
+        // Checks whether MutexPolicy supports optimistic reading (see seqlock_striping)
+        template <class MutexPolicy, class = void>
+        struct is_optimistic_policy: public std::false_type
+        {};
+
+        template <class MutexPolicy>
+        struct is_optimistic_policy< MutexPolicy, typename void_of< typename MutexPolicy::sequence_type >::type >: public std::true_type
+        {};
+
+        // Checks whether Bucket can be read concurrently with modification (Bucket::has_optimistic_contains)
+        template <class Bucket, class = void>
+        struct is_optimistic_bucket: public std::false_type
+        {};
+
+        template <class Bucket>
+        struct is_optimistic_bucket< Bucket, typename void_of< decltype( Bucket::has_optimistic_contains ) >::type >
+            : public std::integral_constant< bool, Bucket::has_optimistic_contains >
+        {};
+
+        // Checks whether Bucket defers freeing of removed items (Bucket::has_deferred_retire)
+        template <class Bucket, class = void>
+        struct is_deferred_retire_bucket: public std::false_type
+        {};
+
+        template <class Bucket>
+        struct is_deferred_retire_bucket< Bucket, typename void_of< decltype( Bucket::has_deferred_retire ) >::type >
+            : public std::integral_constant< bool, Bucket::has_deferred_retire >
+        {};
+
+        // Retires the items removed by the current thread, see Bucket::retire_deferred().
+        // The object must be declared before the scoped lock so that it is destroyed after the lock is released
+        template <class Bucket, bool = is_deferred_retire_bucket< Bucket >::value >
+        struct scoped_retire
+        {
+            scoped_retire()
+            {}
+        };
+
+        template <class Bucket>
+        struct scoped_retire< Bucket, true >
+        {
+            scoped_retire()
+            {}
+
+            ~scoped_retire()
+            {
+                Bucket::retire_deferred();
+            }
+        };
+    } // namespace details
+    //@endcond
+
 }}} // namespace cds::intrusive::striped_set
 
 #endif
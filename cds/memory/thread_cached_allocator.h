@@ -0,0 +1,441 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_MEMORY_THREAD_CACHED_ALLOCATOR_H
+#define CDSLIB_MEMORY_THREAD_CACHED_ALLOCATOR_H
+
+#include <cds/intrusive/free_list_selector.h>
+#include <cds/intrusive/free_list_cached.h>
+#include <cds/user_setup/allocator.h>
+#include <type_traits>
+#include <utility>
+
+namespace cds { namespace memory {
+
+    /// \p thread_cached_allocator related definitions
+    /** @ingroup cds_memory_pool
+
+        The pool serves the blocks up to \p c_nMaxBlockSize bytes, grouped into size classes
+        with \p c_nGranularity step. Each size class has a global free list (the depot), that is
+        \p intrusive::CachedFreeList over \p intrusive::FreeList (\p intrusive::TaggedFreeList if DCAS is supported).
+        Each thread has a private cache of up to \p c_nCacheCapacity free blocks per size class;
+        the cache is accessed without any atomic operation. When the cache is empty the thread takes
+        \p c_nTransferSize blocks from the depot, when the cache is full the thread moves
+        \p c_nTransferSize blocks to the depot. The thread cache is moved to the depot when the thread terminates.
+
+        A block freed by a thread goes to the cache of that thread regardless of the thread allocated the block.
+        So, the nodes retired by a garbage collector are reused by the thread reclaiming them:
+        the reclamation does not call \p free() and the next allocation by that thread does not call \p malloc().
+
+        The blocks are never returned to the system: the pool grows up to the peak number of blocks in use.
+        The blocks greater than \p c_nMaxBlockSize are allocated directly by \ref CDS_DEFAULT_ALLOCATOR.
+    */
+    namespace thread_cached {
+
+        /// Size class step and the alignment of the blocks, in bytes
+        static CDS_CONSTEXPR size_t const c_nGranularity = 16;
+
+        /// Number of size classes
+        static CDS_CONSTEXPR size_t const c_nSizeClassCount = 32;
+
+        /// Max block size served by the pool, in bytes
+        static CDS_CONSTEXPR size_t const c_nMaxBlockSize = c_nGranularity * c_nSizeClassCount;
+
+        /// Max number of free blocks of one size class in the thread cache
+        static CDS_CONSTEXPR size_t const c_nCacheCapacity = 32;
+
+        /// Number of blocks moved between the thread cache and the depot at once
+        static CDS_CONSTEXPR size_t const c_nTransferSize = c_nCacheCapacity / 2;
+
+        /// Pool statistics
+        struct stat {
+            size_t  nBlockCreated;  ///< Number of blocks allocated from the system
+            size_t  nDepotPut;      ///< Number of blocks moved from the thread caches to the depot
+            size_t  nDepotGet;      ///< Number of blocks moved from the depot to the thread caches
+            size_t  nLargeAlloc;    ///< Number of allocations greater than \p c_nMaxBlockSize
+        };
+
+        //@cond
+        namespace details {
+
+            typedef std::aligned_storage< c_nGranularity, c_nGranularity >::type unit;
+            typedef CDS_DEFAULT_ALLOCATOR::template rebind< unit >::other unit_allocator;
+
+            typedef cds::intrusive::FreeListImpl            free_list;
+            typedef cds::intrusive::CachedFreeList< free_list > depot_type;
+
+            // The header precedes each block. The header of a pooled block is constructed once
+            // and is kept intact while the block is in use, since the free list may access
+            // the node of a block that has been taken from the list by another thread
+            struct block_header: public free_list::node
+            {
+                uint32_t    m_nSizeClass;   // size class, or c_nSizeClassCount for the large block
+                uint32_t    m_nUnits;       // block size in units including the header, for the large block only
+            };
+
+            static CDS_CONSTEXPR size_t const c_nHeaderUnits = ( sizeof( block_header ) + sizeof( unit ) - 1 ) / sizeof( unit );
+
+            static inline void * to_payload( block_header * p )
+            {
+                return reinterpret_cast<unit *>( p ) + c_nHeaderUnits;
+            }
+
+            static inline block_header * to_header( void * p )
+            {
+                return reinterpret_cast<block_header *>( reinterpret_cast<unit *>( p ) - c_nHeaderUnits );
+            }
+
+            static inline block_header * new_block( size_t nSizeClass, size_t nUnits )
+            {
+                block_header * p = new( unit_allocator().allocate( nUnits )) block_header;
+                p->m_nSizeClass = static_cast<uint32_t>( nSizeClass );
+                p->m_nUnits = static_cast<uint32_t>( nUnits );
+                return p;
+            }
+
+            class pool
+            {
+                struct size_class {
+                    depot_type                  m_Depot;
+                    atomics::atomic<size_t>     m_nBlockCreated;
+                    atomics::atomic<size_t>     m_nDepotPut;
+                    atomics::atomic<size_t>     m_nDepotGet;
+
+                    size_class()
+                        : m_nBlockCreated( 0 )
+                        , m_nDepotPut( 0 )
+                        , m_nDepotGet( 0 )
+                    {}
+                };
+
+            public:
+                pool()
+                    : m_nLargeAlloc( 0 )
+                {}
+
+                static pool& instance()
+                {
+                    // The pool is never destroyed: a block may be freed by a static object destroyed after the pool
+                    static pool * s_pPool = new pool;
+                    return *s_pPool;
+                }
+
+                block_header * get( size_t nSizeClass )
+                {
+                    size_class& sc = m_Classes[nSizeClass];
+                    block_header * p = static_cast<block_header *>( sc.m_Depot.get());
+                    if ( p )
+                        sc.m_nDepotGet.fetch_add( 1, atomics::memory_order_relaxed );
+                    return p;
+                }
+
+                void put( block_header * p )
+                {
+                    size_class& sc = m_Classes[p->m_nSizeClass];
+                    sc.m_Depot.put( p );
+                    sc.m_nDepotPut.fetch_add( 1, atomics::memory_order_relaxed );
+                }
+
+                block_header * create( size_t nSizeClass )
+                {
+                    m_Classes[nSizeClass].m_nBlockCreated.fetch_add( 1, atomics::memory_order_relaxed );
+                    return new_block( nSizeClass, c_nHeaderUnits + nSizeClass + 1 );
+                }
+
+                void * allocate_large( size_t nBytes )
+                {
+                    m_nLargeAlloc.fetch_add( 1, atomics::memory_order_relaxed );
+                    return to_payload( new_block( c_nSizeClassCount, c_nHeaderUnits + ( nBytes + sizeof( unit ) - 1 ) / sizeof( unit )));
+                }
+
+                static void free_large( block_header * p )
+                {
+                    size_t const nUnits = p->m_nUnits;
+                    p->~block_header();
+                    unit_allocator().deallocate( reinterpret_cast<unit *>( p ), nUnits );
+                }
+
+                stat statistics() const
+                {
+                    stat s = stat();
+                    for ( auto const& sc : m_Classes ) {
+                        s.nBlockCreated += sc.m_nBlockCreated.load( atomics::memory_order_relaxed );
+                        s.nDepotPut += sc.m_nDepotPut.load( atomics::memory_order_relaxed );
+                        s.nDepotGet += sc.m_nDepotGet.load( atomics::memory_order_relaxed );
+                    }
+                    s.nLargeAlloc = m_nLargeAlloc.load( atomics::memory_order_relaxed );
+                    return s;
+                }
+
+            private:
+                size_class              m_Classes[c_nSizeClassCount];
+                atomics::atomic<size_t> m_nLargeAlloc;
+            };
+
+            class thread_cache
+            {
+                struct bin {
+                    size_t          m_nCount;
+                    block_header *  m_arrBlock[c_nCacheCapacity];
+                };
+
+            public:
+                thread_cache()
+                {
+                    // The pool should be constructed before the cache
+                    m_pPool = &pool::instance();
+                    for ( auto& b : m_Bins )
+                        b.m_nCount = 0;
+                }
+
+                ~thread_cache()
+                {
+                    flush();
+                    terminated() = true;
+                }
+
+                // Returns nullptr after the cache of current thread has been destroyed
+                static thread_cache * current()
+                {
+                    if ( terminated())
+                        return nullptr;
+                    static thread_local thread_cache s_Cache;
+                    return &s_Cache;
+                }
+
+                block_header * get( size_t nSizeClass )
+                {
+                    bin& b = m_Bins[nSizeClass];
+                    if ( b.m_nCount == 0 ) {
+                        while ( b.m_nCount < c_nTransferSize ) {
+                            block_header * p = m_pPool->get( nSizeClass );
+                            if ( !p )
+                                break;
+                            b.m_arrBlock[b.m_nCount++] = p;
+                        }
+                        if ( b.m_nCount == 0 )
+                            return m_pPool->create( nSizeClass );
+                    }
+                    return b.m_arrBlock[--b.m_nCount];
+                }
+
+                void put( block_header * p )
+                {
+                    bin& b = m_Bins[p->m_nSizeClass];
+                    if ( b.m_nCount == c_nCacheCapacity ) {
+                        for ( size_t i = 0; i < c_nTransferSize; ++i )
+                            m_pPool->put( b.m_arrBlock[--b.m_nCount] );
+                    }
+                    b.m_arrBlock[b.m_nCount++] = p;
+                }
+
+                void flush()
+                {
+                    for ( auto& b : m_Bins ) {
+                        while ( b.m_nCount )
+                            m_pPool->put( b.m_arrBlock[--b.m_nCount] );
+                    }
+                }
+
+            private:
+                static bool& terminated()
+                {
+                    static thread_local bool s_bTerminated = false;
+                    return s_bTerminated;
+                }
+
+            private:
+                pool *  m_pPool;
+                bin     m_Bins[c_nSizeClassCount];
+            };
+
+        } // namespace details
+        //@endcond
+
+        /// Allocates a block of \p nBytes bytes aligned by \p c_nGranularity
+        static inline void * allocate( size_t nBytes )
+        {
+            if ( nBytes > c_nMaxBlockSize )
+                return details::pool::instance().allocate_large( nBytes );
+
+            size_t const nSizeClass = nBytes ? ( nBytes - 1 ) / c_nGranularity : 0;
+            details::thread_cache * pCache = details::thread_cache::current();
+            details::block_header * p;
+            if ( pCache )
+                p = pCache->get( nSizeClass );
+            else {
+                details::pool& thePool = details::pool::instance();
+                p = thePool.get( nSizeClass );
+                if ( !p )
+                    p = thePool.create( nSizeClass );
+            }
+            return details::to_payload( p );
+        }
+
+        /// Frees the block \p p allocated by \p allocate()
+        /**
+            The block goes to the cache of current thread. The size of the block is not needed:
+            the block header keeps its size class.
+        */
+        static inline void deallocate( void * p )
+        {
+            details::block_header * pHeader = details::to_header( p );
+            if ( pHeader->m_nSizeClass == c_nSizeClassCount ) {
+                details::pool::free_large( pHeader );
+                return;
+            }
+
+            details::thread_cache * pCache = details::thread_cache::current();
+            if ( pCache )
+                pCache->put( pHeader );
+            else
+                details::pool::instance().put( pHeader );
+        }
+
+        /// Moves the blocks cached by current thread to the depot
+        /**
+            The function may be called by a long-lived thread that has freed a lot of blocks
+            and will not allocate them anymore. The cache is flushed automatically when the thread terminates.
+        */
+        static inline void flush()
+        {
+            details::thread_cache * pCache = details::thread_cache::current();
+            if ( pCache )
+                pCache->flush();
+        }
+
+        /// Returns the pool statistics summed over all size classes
+        static inline stat statistics()
+        {
+            return details::pool::instance().statistics();
+        }
+
+    } // namespace thread_cached
+
+    /// Thread-caching allocator
+    /** @ingroup cds_memory_pool
+
+        The class gives \p std::allocator interface for the @ref cds::memory::thread_cached "thread-cached pool".
+        It is stateless and can be used as \p opt::allocator option of any container:
+        \code
+        #include <cds/memory/thread_cached_allocator.h>
+        #include <cds/container/skip_list_map_hp.h>
+
+        typedef cds::container::SkipListMap< cds::gc::HP, int, int,
+            typename cds::container::skip_list::make_traits<
+                cds::opt::allocator< cds::memory::thread_cached_allocator<int> >
+            >::type
+        > map_type;
+        \endcode
+        The container's disposer returns a node into the cache of the thread that reclaims the node,
+        so, for example, the nodes freed by hazard pointer scan are reused by the scanning thread without \p malloc/free.
+
+        The type \p T cannot be over-aligned: <tt>alignof(T)</tt> must not be greater than \p thread_cached::c_nGranularity.
+    */
+    template <typename T>
+    class thread_cached_allocator
+    {
+    //@cond
+    public:
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef T           value_type;
+
+        template <class U> struct rebind {
+            typedef thread_cached_allocator<U> other;
+        };
+
+        static_assert( alignof( T ) <= thread_cached::c_nGranularity, "Over-aligned types are not supported" );
+
+    public:
+        thread_cached_allocator() CDS_NOEXCEPT
+        {}
+
+        thread_cached_allocator( const thread_cached_allocator& ) CDS_NOEXCEPT
+        {}
+        template <class U> thread_cached_allocator( const thread_cached_allocator<U>& ) CDS_NOEXCEPT
+        {}
+
+        pointer address( reference x ) const CDS_NOEXCEPT
+        {
+            return &x;
+        }
+        const_pointer address( const_reference x ) const CDS_NOEXCEPT
+        {
+            return &x;
+        }
+        pointer allocate( size_type n, void const * /*hint*/ = nullptr )
+        {
+            return static_cast<pointer>( thread_cached::allocate( n * sizeof( value_type )));
+        }
+        void deallocate( pointer p, size_type /*n*/ ) CDS_NOEXCEPT
+        {
+            thread_cached::deallocate( p );
+        }
+        size_type max_size() const CDS_NOEXCEPT
+        {
+            return size_t( -1 ) / sizeof( value_type );
+        }
+
+        template <class U, class... Args>
+        void construct( U* p, Args&&... args )
+        {
+            new( (void *) p ) U( std::forward<Args>( args )... );
+        }
+
+        template <class U>
+        void destroy( U* p )
+        {
+            p->~U();
+        }
+    //@endcond
+    };
+
+    //@cond
+    template <typename T, typename U>
+    static inline bool operator ==( thread_cached_allocator<T> const&, thread_cached_allocator<U> const& ) CDS_NOEXCEPT
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    static inline bool operator !=( thread_cached_allocator<T> const&, thread_cached_allocator<U> const& ) CDS_NOEXCEPT
+    {
+        return false;
+    }
+    //@endcond
+
+}} // namespace cds::memory
+
+#endif // #ifndef CDSLIB_MEMORY_THREAD_CACHED_ALLOCATOR_H
@@ -34,8 +34,10 @@
 #include <memory.h>
 #include <cds/details/defs.h>
 #include <cds/user_setup/allocator.h>
+#include <cds/os/alloc_aligned.h>
 #include <cds/details/allocator.h>
 #include <cds/algo/int_algo.h>
+#include <cds/algo/atomic.h>
 
 namespace cds { namespace opt {
 
@@ -52,6 +54,9 @@ namespace cds { namespace opt {
             - \p opt::v::uninitialized_static_buffer
             - \p opt::v::initialized_dynamic_buffer
             - \p opt::v::uninitialized_dynamic_buffer
+            - \p opt::v::initialized_segmented_buffer
+            - \p opt::v::uninitialized_huge_page_buffer
+            - \p opt::v::initialized_huge_page_buffer
 
         Uninitialized buffer is just an array of uninitialized elements.
         Each element should be manually constructed, for example with a placement new operator.
@@ -569,6 +574,198 @@ namespace cds { namespace opt {
             //@endcond
         };
 
+
+        /// Growable initialized buffer consisting of power-of-two segments
+        /**
+            One of available type for \p opt::buffer option.
+
+            Unlike \p initialized_dynamic_buffer this buffer may grow at run time.
+            The buffer is an array of segments: segment 0 contains items <tt>[0, 2)</tt>,
+            segment \p k > 0 contains items <tt>[2**k, 2**(k+1))</tt>. Item \p i is addressed
+            as segment <tt>log2(i)</tt> plus offset in the segment.
+            \p grow() appends a new segment that doubles the capacity; existing items are never copied or moved,
+            so the references to them remain valid while the buffer grows.
+
+            The buffer is intended for the containers that support growing, for example, \p cds::intrusive::MSPriorityQueue.
+            The containers which do not know about \p grow() use the buffer as a fixed-size buffer
+            of the initial capacity.
+
+            \p grow() must be serialized by the container, whereas \p operator[] and \p capacity()
+            may be called concurrently with \p grow().
+
+            \par Template parameters:
+                - \p T - item type storing in the buffer
+                - \p Alloc - an allocator used for allocating the segments (\p std::allocator interface)
+        */
+        template <typename T, class Alloc = CDS_DEFAULT_ALLOCATOR>
+        class initialized_segmented_buffer
+        {
+        public:
+            typedef T     value_type;   ///< Value type
+            typedef Alloc allocator;    ///< Allocator type
+            static CDS_CONSTEXPR const bool c_bExp2 = true; ///< The capacity is always a power of two
+
+            /// Max count of segments
+            static CDS_CONSTEXPR const size_t c_nMaxSegmentCount = sizeof( size_t ) * 8 - 1;
+
+            /// Rebind buffer for other template parameters
+            template <typename Q, typename Alloc2= allocator>
+            struct rebind {
+                typedef initialized_segmented_buffer<Q, Alloc2> other;  ///< Rebinding result type
+            };
+
+            //@cond
+            typedef cds::details::Allocator<value_type, allocator>   allocator_type;
+            //@endcond
+
+        private:
+            //@cond
+            atomics::atomic<value_type *>   m_arrSegments[c_nMaxSegmentCount];
+            atomics::atomic<size_t>         m_nCapacity;
+            //@endcond
+
+        public:
+            /// Allocates the segments for \p nCapacity items
+            /**
+                The initial capacity is nearest upper to \p nCapacity power of two, at least 2.
+            */
+            initialized_segmented_buffer( size_t nCapacity )
+                : m_nCapacity( 2 )
+            {
+                for ( size_t i = 0; i < c_nMaxSegmentCount; ++i )
+                    m_arrSegments[i].store( nullptr, atomics::memory_order_relaxed );
+
+                allocator_type a;
+                m_arrSegments[0].store( a.NewArray( 2 ), atomics::memory_order_relaxed );
+
+                size_t const nInitial = beans::ceil2( nCapacity );
+                while ( capacity() < nInitial )
+                    grow();
+            }
+
+            /// Destroys the segments
+            ~initialized_segmented_buffer()
+            {
+                allocator_type a;
+                size_t const nSegmentCount = segment_count();
+                for ( size_t i = 0; i < nSegmentCount; ++i )
+                    a.Delete( m_arrSegments[i].load( atomics::memory_order_relaxed ), segment_size( i ));
+            }
+
+            initialized_segmented_buffer( const initialized_segmented_buffer& ) = delete;
+            initialized_segmented_buffer& operator =( const initialized_segmented_buffer& ) = delete;
+
+            /// Get item \p i
+            value_type& operator []( size_t i )
+            {
+                assert( i < capacity());
+                size_t const nSegment = segment_index( i );
+                return m_arrSegments[nSegment].load( atomics::memory_order_acquire )[ i - segment_start( nSegment ) ];
+            }
+
+            /// Get item \p i, const version
+            const value_type& operator []( size_t i ) const
+            {
+                assert( i < capacity());
+                size_t const nSegment = segment_index( i );
+                return m_arrSegments[nSegment].load( atomics::memory_order_acquire )[ i - segment_start( nSegment ) ];
+            }
+
+            /// Returns current buffer capacity
+            size_t capacity() const CDS_NOEXCEPT
+            {
+                return m_nCapacity.load( atomics::memory_order_acquire );
+            }
+
+            /// Returns max capacity the buffer can grow to
+            static CDS_CONSTEXPR size_t max_capacity() CDS_NOEXCEPT
+            {
+                return size_t( 1 ) << c_nMaxSegmentCount;
+            }
+
+            /// Doubles the capacity of the buffer
+            /**
+                The function allocates a new segment of <tt>capacity()</tt> items.
+                Returns \p false if the buffer has reached \p max_capacity().
+
+                The function is not thread-safe: the concurrent calls of \p grow() must be serialized by the caller.
+            */
+            bool grow()
+            {
+                size_t const nCapacity = m_nCapacity.load( atomics::memory_order_relaxed );
+                size_t const nSegment = segment_count();
+                if ( nSegment >= c_nMaxSegmentCount )
+                    return false;
+
+                allocator_type a;
+                m_arrSegments[nSegment].store( a.NewArray( nCapacity ), atomics::memory_order_release );
+                m_nCapacity.store( nCapacity * 2, atomics::memory_order_release );
+                return true;
+            }
+
+            /// Zeroize the buffer
+            void zeroize()
+            {
+                size_t const nSegmentCount = segment_count();
+                for ( size_t i = 0; i < nSegmentCount; ++i )
+                    memset( m_arrSegments[i].load( atomics::memory_order_relaxed ), 0, segment_size( i ) * sizeof( value_type ));
+            }
+
+        private:
+            //@cond
+            size_t segment_count() const
+            {
+                return beans::log2floor( m_nCapacity.load( atomics::memory_order_relaxed ));
+            }
+
+            static size_t segment_index( size_t i )
+            {
+                return i < 2 ? 0 : beans::log2floor( i );
+            }
+
+            static size_t segment_start( size_t nSegment )
+            {
+                return nSegment == 0 ? 0 : size_t( 1 ) << nSegment;
+            }
+
+            static size_t segment_size( size_t nSegment )
+            {
+                return nSegment == 0 ? 2 : size_t( 1 ) << nSegment;
+            }
+            //@endcond
+        };
+
+        /// Dynamically allocated uninitialized buffer backed by huge pages
+        /**
+            One of available type for \p opt::buffer option.
+
+            This is \p uninitialized_dynamic_buffer allocated by \p cds::OS::huge_page_allocator:
+            a big buffer is mapped with huge pages (if available) and optionally bound to NUMA nodes,
+            a small one is allocated from the heap. See \p cds::OS::huge_page_allocator for details.
+
+            \par Template parameters:
+                - \p T - item type storing in the buffer
+                - \p Policy - huge page policy, see \p cds::OS::huge_page::policy
+                - \p Exp2 - a boolean flag. If it is \p true the buffer capacity must be power of two.
+        */
+        template <typename T, typename Policy = cds::OS::huge_page::default_policy, bool Exp2 = true>
+        using uninitialized_huge_page_buffer = uninitialized_dynamic_buffer< T, cds::OS::huge_page_allocator< int, Policy >, Exp2 >;
+
+        /// Dynamically allocated initialized buffer backed by huge pages
+        /**
+            One of available type for \p opt::buffer option.
+
+            This is \p initialized_dynamic_buffer allocated by \p cds::OS::huge_page_allocator,
+            see \p uninitialized_huge_page_buffer.
+
+            \par Template parameters:
+                - \p T - item type storing in the buffer
+                - \p Policy - huge page policy, see \p cds::OS::huge_page::policy
+                - \p Exp2 - a boolean flag. If it is \p true the buffer capacity must be power of two.
+        */
+        template <typename T, typename Policy = cds::OS::huge_page::default_policy, bool Exp2 = true>
+        using initialized_huge_page_buffer = initialized_dynamic_buffer< T, cds::OS::huge_page_allocator< int, Policy >, Exp2 >;
+
     }   // namespace v
 
 }}  // namespace cds::opt
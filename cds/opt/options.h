@@ -696,7 +696,7 @@ namespace opt {
         \p Random can be any STL random number generator producing
         unsigned integer: \p std::linear_congruential_engine,
         \p std::mersenne_twister_engine, \p std::subtract_with_carry_engine
-        and so on, or \p opt::v::c_rand.
+        and so on, or \p opt::v::c_rand, \p opt::v::xorshift_rand.
 
     */
     template <typename Random>
@@ -916,6 +916,42 @@ namespace cds { namespace opt {
                 return (result_type) std::rand();
             }
         };
+
+        /// Per-thread xorshift random number generator for \p opt::random_engine
+        /**
+            The generator keeps its state in thread-local storage, so the instances of
+            the generator may be shared between threads without any synchronization.
+            It is much cheaper than \p c_rand (\p std::rand() may serialize the callers on an internal lock)
+            and is intended for randomized load balancing in concurrent containers,
+            not for statistical quality.
+
+            If the compiler does not support \p thread_local the generator falls back to \p std::rand().
+        */
+        struct xorshift_rand {
+            typedef unsigned int result_type; ///< Result type
+
+            /// Returns next random number
+            result_type operator()() const
+            {
+#       ifdef CDS_CXX11_THREAD_LOCAL_SUPPORT
+                static thread_local uint32_t s_nState = 0;
+                uint32_t x = s_nState;
+                if ( x == 0 ) {
+                    // The address of thread-local variable is a cheap per-thread seed
+                    x = static_cast<uint32_t>( reinterpret_cast<uintptr_t>( &s_nState ) >> 3 ) * 2654435761u;
+                    if ( x == 0 )
+                        x = 1;
+                }
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                s_nState = x;
+                return static_cast<result_type>( x );
+#       else
+                return static_cast<result_type>( std::rand());
+#       endif
+            }
+        };
     } // namespace v
 
 }} // namespace cds::opt
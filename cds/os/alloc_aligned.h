@@ -55,6 +55,7 @@
 #include <cds/details/is_aligned.h>
 #include <cds/algo/int_algo.h>
 #include <cds/details/throw_exception.h>
+#include <cds/user_setup/cache_line.h>
 
 namespace cds {
     /// OS specific wrappers
@@ -216,6 +217,266 @@ namespace cds {
                 return a.max_size();
             }
         };
+
+        /// \p huge_page_allocator related definitions
+        namespace huge_page {
+
+            /// NUMA memory policy of the block
+            enum numa_mode {
+                numa_default = 0,       ///< The default policy of the thread, usually the memory is allocated on the node of the first touch
+                numa_preferred = 1,     ///< Allocate the memory on the first node of the mask if possible
+                numa_bind = 2,          ///< Allocate the memory on the nodes of the mask only
+                numa_interleave = 3     ///< Interleave the pages over the nodes of the mask
+            };
+
+            /// Memory backing of the block allocated by \p huge_page_allocator
+            enum backing {
+                backing_heap,           ///< The block is allocated from the heap: it is too small, or huge pages are not supported by OS
+                backing_hugetlb,        ///< The block is mapped with explicit huge pages (\p MAP_HUGETLB)
+                backing_transparent,    ///< The block is mapped with regular pages advised to be transparent huge pages (\p MADV_HUGEPAGE)
+                backing_regular         ///< The block is mapped with regular pages, huge pages are not available
+            };
+
+            /// Default min size of the block mapped with huge pages, 1M
+            static CDS_CONSTEXPR size_t const c_nDefaultMinSize = 1024 * 1024;
+
+            /// \p huge_page_allocator policy
+            /**
+                Template parameters:
+                - \p Mode - NUMA memory policy, see \p numa_mode
+                - \p NodeMask - bit mask of NUMA nodes for \p Mode, up to 64 nodes. The mask is restricted
+                    to the nodes the process is allowed to use, so the default "all nodes" mask is valid for any system.
+                - \p MinSize - the blocks smaller than \p MinSize bytes are allocated from the heap
+            */
+            template <numa_mode Mode = numa_default, uint64_t NodeMask = ~uint64_t( 0 ), size_t MinSize = c_nDefaultMinSize>
+            struct policy {
+                static CDS_CONSTEXPR numa_mode const mode = Mode;       ///< NUMA memory policy
+                static CDS_CONSTEXPR uint64_t const node_mask = NodeMask; ///< NUMA node mask
+                static CDS_CONSTEXPR size_t const min_size = MinSize;   ///< Min size of the block mapped with huge pages
+            };
+
+            /// Default policy: huge pages, no NUMA policy
+            typedef policy<> default_policy;
+
+            /// Huge pages interleaved over all allowed NUMA nodes
+            typedef policy< numa_interleave > interleave;
+
+            //@cond
+            namespace details {
+                // The header precedes each block, it occupies whole cache line to keep the block aligned
+                struct header {
+                    size_t  nMapSize;   // mapping size, 0 for the heap block
+                    backing nBacking;
+                    bool    bNumaBound;
+                };
+                static CDS_CONSTEXPR size_t const c_nHeaderSize = c_nCacheLineSize;
+                static_assert( sizeof( header ) <= c_nHeaderSize, "The header size is greater than cache line" );
+
+                static inline header * to_header( void const * p )
+                {
+                    return reinterpret_cast<header *>( reinterpret_cast<char *>( const_cast<void *>( p )) - c_nHeaderSize );
+                }
+
+                static inline void * alloc( size_t nSize, numa_mode nMode, uint64_t nNodeMask, size_t nMinSize )
+                {
+                    size_t const nBlockSize = nSize + c_nHeaderSize;
+                    header * pHeader = nullptr;
+
+#       ifdef CDS_OS_HUGE_PAGE_SUPPORT
+                    if ( nSize >= nMinSize ) {
+                        size_t const nMapSize = ( nBlockSize + c_nHugePageSize - 1 ) & ~( c_nHugePageSize - 1 );
+                        bool bHugeTLB;
+                        bool bAdvised;
+                        void * pMap = huge_page_map( nMapSize, bHugeTLB, bAdvised );
+                        if ( pMap ) {
+                            // The NUMA policy should be set before the first touch of the pages
+                            bool const bNumaBound = nMode != numa_default && set_numa_policy( pMap, nMapSize, static_cast<int>( nMode ), nNodeMask );
+                            pHeader = new( pMap ) header;
+                            pHeader->nMapSize = nMapSize;
+                            pHeader->nBacking = bHugeTLB ? backing_hugetlb : bAdvised ? backing_transparent : backing_regular;
+                            pHeader->bNumaBound = bNumaBound;
+                        }
+                    }
+#       else
+                    CDS_UNUSED( nMode );
+                    CDS_UNUSED( nNodeMask );
+                    CDS_UNUSED( nMinSize );
+#       endif
+
+                    if ( !pHeader ) {
+                        void * pMem = cds::OS::aligned_malloc( nBlockSize, c_nHeaderSize );
+                        if ( !pMem )
+                            CDS_THROW_EXCEPTION( std::bad_alloc());
+                        pHeader = new( pMem ) header;
+                        pHeader->nMapSize = 0;
+                        pHeader->nBacking = backing_heap;
+                        pHeader->bNumaBound = false;
+                    }
+                    return reinterpret_cast<char *>( pHeader ) + c_nHeaderSize;
+                }
+
+                static inline void free( void * p )
+                {
+                    header * pHeader = to_header( p );
+#       ifdef CDS_OS_HUGE_PAGE_SUPPORT
+                    if ( pHeader->nMapSize ) {
+                        huge_page_unmap( pHeader, pHeader->nMapSize );
+                        return;
+                    }
+#       endif
+                    cds::OS::aligned_free( pHeader );
+                }
+            } // namespace details
+            //@endcond
+
+            /// Returns memory backing of the block \p p allocated by \p huge_page_allocator
+            static inline backing get_backing( void const * p )
+            {
+                return details::to_header( p )->nBacking;
+            }
+
+            /// Checks whether NUMA policy has been applied to the block \p p allocated by \p huge_page_allocator
+            static inline bool is_numa_bound( void const * p )
+            {
+                return details::to_header( p )->bNumaBound;
+            }
+        } // namespace huge_page
+
+        /// Huge page allocator
+        /**
+            The allocator is intended for big contiguous arrays like hash set bucket tables and bounded queue buffers.
+            With regular 4K pages, random access to a big array causes many TLB misses;
+            a huge page (2M) covers 512 times more memory by one TLB entry.
+
+            The blocks not less than \p Policy::min_size bytes are mapped by \p mmap:
+            - at first, the allocator tries explicit huge pages (\p MAP_HUGETLB); they are available only if
+              the administrator has reserved them, see <tt>/proc/sys/vm/nr_hugepages</tt>;
+            - otherwise, the allocator maps regular pages aligned by huge page size and advises the kernel
+              to use transparent huge pages (\p MADV_HUGEPAGE);
+            - if the advice fails, the block remains mapped with regular pages.
+
+            Before the first touch of the pages mapped, the allocator applies NUMA memory policy \p Policy::mode
+            for the nodes \p Policy::node_mask via \p mbind system call (\p libnuma is not required).
+            If the policy cannot be applied, for example, the system has no NUMA support, the block is used as is.
+
+            The smaller blocks, and all blocks on the systems other than Linux, are allocated from the heap.
+            \p huge_page::get_backing() returns the actual backing of a block.
+
+            Each block has a cache-line header keeping its size, so \p deallocate() ignores the size argument.
+            The blocks are aligned by \p cds::c_nCacheLineSize.
+
+            The allocator is stateless and can be used as \p opt::allocator option of the containers
+            and as the allocator of \p opt::v::initialized_dynamic_buffer / \p opt::v::uninitialized_dynamic_buffer
+            (see \p opt::v::initialized_huge_page_buffer). Note, if a container allocates its nodes by the same allocator
+            the nodes are allocated from the heap with \p c_nCacheLineSize overhead per node.
+
+            Example: \p MichaelHashSet with huge-page bucket table interleaved over NUMA nodes:
+            \code
+            typedef cds::container::MichaelHashSet< cds::gc::HP, list_type,
+                typename cds::container::michael_set::make_traits<
+                    cds::opt::hash< my_hash >,
+                    cds::opt::allocator< cds::OS::huge_page_allocator< int, cds::OS::huge_page::interleave >>
+                >::type
+            > set_type;
+            \endcode
+
+            Template parameters:
+            - \p T - value type
+            - \p Policy - huge page policy, see \p huge_page::policy
+        */
+        template <typename T, typename Policy = huge_page::default_policy>
+        class huge_page_allocator
+        {
+        public:
+            typedef T           value_type;         ///< value type
+            typedef T *         pointer;            ///< pointer to value type
+            typedef T &         reference;          ///< value reference type
+            typedef T const *   const_pointer;      ///< const pointer to value type
+            typedef T const &   const_reference;    ///< const value reference type
+            typedef size_t      size_type;          ///< size type
+            typedef ptrdiff_t   difference_type;    ///< difference type
+            typedef Policy      policy;             ///< huge page policy
+
+            /// convert an huge_page_allocator<T> to an huge_page_allocator<OTHER>
+            template <class OTHER>
+            struct rebind
+            {
+                typedef huge_page_allocator<OTHER, policy> other; ///< Rebinding result
+            };
+
+        public:
+            //@cond
+            huge_page_allocator() CDS_NOEXCEPT
+            {}
+
+            huge_page_allocator( huge_page_allocator const& ) CDS_NOEXCEPT
+            {}
+
+            template <class OTHER>
+            huge_page_allocator( huge_page_allocator<OTHER, policy> const& ) CDS_NOEXCEPT
+            {}
+
+            pointer address( reference v ) const
+            {
+                return &v;
+            }
+
+            const_pointer address( const_reference v ) const
+            {
+                return &v;
+            }
+            //@endcond
+
+            /// Allocates array of \p nCount elements
+            /**
+                The function, like operator \p new does not return \p nullptr.
+                In no memory situation the function throws \p std::bad_alloc exception.
+            */
+            pointer allocate( size_type nCount, void const * /*hint*/ = nullptr )
+            {
+                return reinterpret_cast<pointer>( huge_page::details::alloc( sizeof( T ) * nCount, policy::mode, policy::node_mask, policy::min_size ));
+            }
+
+            /// Deallocates the block \p p, the size is ignored
+            void deallocate( pointer p, size_type /*nCount*/ )
+            {
+                huge_page::details::free( p );
+            }
+
+            //@cond
+            template <class U, class... Args>
+            void construct( U * p, Args&&... args )
+            {
+                new( (void *) p ) U( std::forward<Args>( args )... );
+            }
+
+            template <class U>
+            void destroy( U * p )
+            {
+                p->~U();
+            }
+
+            size_type max_size() const CDS_NOEXCEPT
+            {
+                return size_t( -1 ) / sizeof( value_type );
+            }
+            //@endcond
+        };
+
+        //@cond
+        template <typename T, typename U, typename Policy>
+        static inline bool operator ==( huge_page_allocator<T, Policy> const&, huge_page_allocator<U, Policy> const& ) CDS_NOEXCEPT
+        {
+            return true;
+        }
+
+        template <typename T, typename U, typename Policy>
+        static inline bool operator !=( huge_page_allocator<T, Policy> const&, huge_page_allocator<U, Policy> const& ) CDS_NOEXCEPT
+        {
+            return false;
+        }
+        //@endcond
+
     }   // namespace OS
 }  // namespace cds
 
@@ -0,0 +1,104 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_OS_FUTEX_H
+#define CDSLIB_OS_FUTEX_H
+
+#include <cds/algo/atomic.h>
+#include <thread>
+#include <chrono>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   include <time.h>
+#   include <cerrno>
+#endif
+
+namespace cds { namespace OS {
+
+    /// Parking a thread on a 32bit word
+    /**
+        The thread calls \p wait() to sleep while the word is equal to an expected value;
+        another thread changes the word and calls \p wake() to wake the sleeper.
+
+        On Linux the functions are thin wrappers over the process-private \p futex(2) system call.
+        On other platforms there is no native support: \p wait() just sleeps for a short time slice
+        and \p wake() does nothing, so the caller should always recheck its condition after \p wait().
+    */
+    struct futex
+    {
+        typedef atomics::atomic<int32_t> word_type; ///< Futex word type
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+        static CDS_CONSTEXPR const bool c_bNative = true;   ///< \p true if the platform has native futex support
+#else
+        static CDS_CONSTEXPR const bool c_bNative = false;  ///< \p true if the platform has native futex support
+#endif
+
+        /// Sleeps while <tt>word == nExpected</tt> but no longer than \p nTimeoutMicroseconds
+        /**
+            Returns \p false if the timeout has expired, \p true otherwise.
+            Note that the function can return spuriously.
+        */
+        static bool wait( word_type& word, int32_t nExpected, unsigned int nTimeoutMicroseconds )
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            static_assert( sizeof( word_type ) == sizeof( int ), "futex word must be int-sized" );
+
+            struct timespec ts;
+            ts.tv_sec = nTimeoutMicroseconds / 1000000;
+            ts.tv_nsec = static_cast<long>( nTimeoutMicroseconds % 1000000 ) * 1000;
+            if ( ::syscall( SYS_futex, reinterpret_cast<int*>( &word ), FUTEX_WAIT_PRIVATE, nExpected, &ts, nullptr, 0 ) == 0 )
+                return true;
+            return errno != ETIMEDOUT;
+#else
+            if ( word.load( atomics::memory_order_acquire ) != nExpected )
+                return true;
+            std::this_thread::sleep_for( std::chrono::microseconds( nTimeoutMicroseconds < 50 ? nTimeoutMicroseconds : 50 ));
+            return word.load( atomics::memory_order_acquire ) != nExpected;
+#endif
+        }
+
+        /// Wakes up one thread sleeping on \p word
+        static void wake( word_type& word )
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            ::syscall( SYS_futex, reinterpret_cast<int*>( &word ), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+#else
+            CDS_UNUSED( word );
+#endif
+        }
+    };
+
+}} // namespace cds::OS
+
+#endif // #ifndef CDSLIB_OS_FUTEX_H
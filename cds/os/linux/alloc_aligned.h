@@ -36,8 +36,134 @@
 #   include <cds/os/libc/alloc_aligned.h>
 #else
 #   include <cds/os/posix/alloc_aligned.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   include <stdint.h>
+
+#   define CDS_OS_HUGE_PAGE_SUPPORT
+#endif
+//@endcond
+
+#ifdef CDS_OS_HUGE_PAGE_SUPPORT
+//@cond none
+namespace cds { namespace OS {
+    CDS_CXX11_INLINE_NAMESPACE namespace Linux {
+
+        /// Huge page size, the mapping made by \p huge_page_map() is aligned by this value
+        static CDS_CONSTEXPR size_t const c_nHugePageSize = 2 * 1024 * 1024;
+
+        /// Maps \p nSize bytes of anonymous memory backed by huge pages if possible
+        /**
+            \p nSize must be a multiple of \p c_nHugePageSize.
+
+            At first, the function tries to map explicit huge pages (\p MAP_HUGETLB).
+            This fails if no huge pages are reserved in the system. Then the function maps regular pages
+            aligned by \p c_nHugePageSize and advises the kernel to back them with transparent huge pages
+            (\p MADV_HUGEPAGE); the advice fails if transparent huge pages are disabled.
+
+            Returns \p nullptr if the memory cannot be mapped at all.
+            On success \p bHugeTLB is \p true if explicit huge pages are mapped,
+            \p bAdvised is \p true if \p MADV_HUGEPAGE advice has been accepted.
+        */
+        static inline void * huge_page_map( size_t nSize, bool& bHugeTLB, bool& bAdvised )
+        {
+            assert( nSize % c_nHugePageSize == 0 );
+            bHugeTLB = false;
+            bAdvised = false;
+
+#   ifdef MAP_HUGETLB
+            void * pHuge = ::mmap( nullptr, nSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+            if ( pHuge != MAP_FAILED ) {
+                bHugeTLB = true;
+                return pHuge;
+            }
+#   endif
+
+            // Over-map to align the block by huge page size, otherwise the kernel cannot use huge pages for it
+            size_t const nMapSize = nSize + c_nHugePageSize;
+            void * pMap = ::mmap( nullptr, nMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+            if ( pMap == MAP_FAILED )
+                return nullptr;
+
+            char * pStart = static_cast<char *>( pMap );
+            char * pAligned = reinterpret_cast<char *>(( reinterpret_cast<uintptr_t>( pStart ) + c_nHugePageSize - 1 ) & ~( uintptr_t( c_nHugePageSize ) - 1 ));
+            size_t const nHead = static_cast<size_t>( pAligned - pStart );
+            if ( nHead )
+                ::munmap( pStart, nHead );
+            if ( nMapSize - nHead > nSize )
+                ::munmap( pAligned + nSize, nMapSize - nHead - nSize );
+
+#   ifdef MADV_HUGEPAGE
+            bAdvised = ::madvise( pAligned, nSize, MADV_HUGEPAGE ) == 0;
+#   endif
+            return pAligned;
+        }
+
+        /// Unmaps the memory mapped by \p huge_page_map()
+        static inline void huge_page_unmap( void * p, size_t nSize )
+        {
+            ::munmap( p, nSize );
+        }
+
+        /// Sets NUMA memory policy for the range <tt>[p, p + nSize)</tt>
+        /**
+            \p nMode is a Linux memory policy mode: 1 - \p MPOL_PREFERRED, 2 - \p MPOL_BIND, 3 - \p MPOL_INTERLEAVE.
+            \p nNodeMask is a bit mask of NUMA nodes (up to 64 nodes), it is restricted to the nodes
+            the process is allowed to use.
+
+            The policy must be set before the pages are touched first time.
+            The function calls \p mbind system call directly, \p libnuma is not required.
+            Returns \p false if the policy cannot be applied (no allowed nodes in \p nNodeMask,
+            the kernel has no NUMA support, or the call is not permitted).
+        */
+        static inline bool set_numa_policy( void * p, size_t nSize, int nMode, uint64_t nNodeMask )
+        {
+#   if defined( SYS_mbind ) && defined( SYS_get_mempolicy )
+            static CDS_CONSTEXPR size_t const c_nMaxNode = 1024;
+            static CDS_CONSTEXPR size_t const c_nWordBits = sizeof( unsigned long ) * 8;
+            unsigned long arrMask[c_nMaxNode / c_nWordBits];
+            unsigned long arrAllowed[c_nMaxNode / c_nWordBits];
+
+            // MPOL_F_MEMS_ALLOWED = 4
+            for ( auto& w : arrAllowed )
+                w = 0;
+            if ( ::syscall( SYS_get_mempolicy, nullptr, arrAllowed, c_nMaxNode, nullptr, 4 ) != 0 )
+                return false;
+
+            bool bEmpty = true;
+            for ( size_t i = 0; i < c_nMaxNode / c_nWordBits; ++i ) {
+                unsigned long w = 0;
+                if ( i * c_nWordBits < 64 )
+                    w = static_cast<unsigned long>( nNodeMask >> ( i * c_nWordBits ));
+                arrMask[i] = w & arrAllowed[i];
+                bEmpty = bEmpty && arrMask[i] == 0;
+            }
+            if ( bEmpty )
+                return false;
+
+            // The kernel uses maxnode - 1 bits of the mask
+            return ::syscall( SYS_mbind, p, nSize, nMode, arrMask, c_nMaxNode + 1, 0 ) == 0;
+#   else
+            CDS_UNUSED( p );
+            CDS_UNUSED( nSize );
+            CDS_UNUSED( nMode );
+            CDS_UNUSED( nNodeMask );
+            return false;
+#   endif
+        }
+    }   // namespace Linux
+
+#ifndef CDS_CXX11_INLINE_NAMESPACE_SUPPORT
+    using Linux::c_nHugePageSize;
+    using Linux::huge_page_map;
+    using Linux::huge_page_unmap;
+    using Linux::set_numa_policy;
 #endif
+
+}} // namespace cds::OS
 //@endcond
+#endif // #ifdef CDS_OS_HUGE_PAGE_SUPPORT
 
 #endif // #ifndef CDSLIB_OS_LINUX_ALLOC_ALIGNED_H
 
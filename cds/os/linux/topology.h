@@ -39,8 +39,15 @@
 #include <cds/threading/model.h>
 
 #include <sys/syscall.h>
+#include <unistd.h>
 #include <sched.h>
 
+//@cond
+#if !defined(CDS_LINUX_NO_rseq) && defined(SYS_rseq)
+#   define CDS_LINUX_RSEQ_ENABLED
+#endif
+//@endcond
+
 namespace cds { namespace OS {
     /// Linux-specific wrappers
     CDS_CXX11_INLINE_NAMESPACE namespace Linux {
@@ -54,6 +61,9 @@ namespace cds { namespace OS {
         private:
             //@cond
             static unsigned int     s_nProcessorCount;
+            static unsigned int     s_nNodeCount;
+            static unsigned int *   s_arrCpuNode;       // NUMA node of each processor
+            static unsigned int     s_nCpuNodeSize;     // size of s_arrCpuNode
             //@endcond
         public:
 
@@ -65,14 +75,35 @@ namespace cds { namespace OS {
 
             /// Get current processor number
             /**
-                Caveat: \p current_processor calls system \p sched_getcpu function
+                If the current thread is attached to libcds and the kernel supports restartable sequences
+                (rseq, Linux 4.18+), the function just reads \p cpu_id field of the thread's rseq area
+                that the kernel updates on each migration of the thread. The area registered by glibc 2.35+
+                is used if any, otherwise libcds registers its own area when the thread is attached
+                (see \p cds::threading::Manager::attachThread()). You may disable rseq usage compiling with
+                <tt>-DCDS_LINUX_NO_rseq</tt>.
+
+                Otherwise, \p current_processor calls system \p sched_getcpu function
                 that may not be defined for target system (\p sched_getcpu is available since glibc 2.6).
                 If \p sched_getcpu is not defined the function emulates "current processor number" using
                 thread-specific data. You may manually disable the \p sched_getcpu usage compiling with
                 <tt>-DCDS_LINUX_NO_sched_getcpu</tt>.
+
+                Note that the result may be out of date as soon as the function returns
+                since the thread may be migrated to another processor at any time.
             */
             static unsigned int current_processor()
             {
+#           ifdef CDS_LINUX_RSEQ_ENABLED
+                if ( threading::Manager::isThreadAttached()) {
+                    int32_t const volatile * pCpu = threading::Manager::thread_data()->m_pCurrentCpu;
+                    if ( pCpu ) {
+                        int32_t const nProcessor = *pCpu;
+                        if ( nProcessor >= 0 )
+                            return static_cast<unsigned int>( nProcessor );
+                    }
+                }
+#           endif
+
             // Compile libcds with -DCDS_LINUX_NO_sched_getcpu if your linux does not have sched_getcpu (glibc version less than 2.6)
 #           if !defined(CDS_LINUX_NO_sched_getcpu) && defined(SYS_getcpu)
                 int nProcessor = ::sched_getcpu();
@@ -105,9 +136,41 @@ namespace cds { namespace OS {
                 return current_processor();
             }
 
+            /// NUMA node count for the system
+            /**
+                The value is read from <tt>/sys/devices/system/node/possible</tt> on library initialization.
+                If the file is not available the system is considered as a single-node system.
+            */
+            static unsigned int node_count()
+            {
+                return s_nNodeCount;
+            }
+
+            /// Get NUMA node of the current processor
+            /**
+                The function maps \p current_processor() to its node by the table built
+                from <tt>/sys/devices/system/node/node<i>N</i>/cpulist</tt> on library initialization,
+                so no system call is made. The result is in range <tt>[0, node_count())</tt>.
+                On a single-node system, or if the processor is not found in the table, the function returns 0.
+            */
+            static unsigned int current_node()
+            {
+                if ( s_nNodeCount > 1 ) {
+                    unsigned int const nProcessor = current_processor();
+                    if ( nProcessor < s_nCpuNodeSize )
+                        return s_arrCpuNode[nProcessor];
+                }
+                return 0;
+            }
+
             //@cond
             static void init();
             static void fini();
+
+            // Called on thread attaching/detaching, see cds::threading::ThreadData
+            // Returns a pointer to the rseq cpu_id field or nullptr if rseq is not available
+            static int32_t const volatile * attach_thread();
+            static void detach_thread();
             //@endcond
         };
     }   // namespace Linux
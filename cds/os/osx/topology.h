@@ -73,6 +73,21 @@ namespace cds { namespace OS {
                 return current_processor();
             }
 
+            /// NUMA node count for the system
+            /**
+                NUMA topology is not detected on this platform, the system is considered as a single-node system.
+            */
+            static unsigned int node_count()
+            {
+                return 1;
+            }
+
+            /// Get NUMA node of the current processor, always 0
+            static unsigned int current_node()
+            {
+                return 0;
+            }
+
             //@cond
             static void init();
             static void fini();
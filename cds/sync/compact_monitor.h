@@ -0,0 +1,307 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_SYNC_COMPACT_MONITOR_H
+#define CDSLIB_SYNC_COMPACT_MONITOR_H
+
+#include <mutex>
+#include <condition_variable>
+#include <cds/sync/monitor.h>
+#include <cds/algo/atomic.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/algo/int_algo.h>
+#include <cds/details/allocator.h>
+#include <cds/opt/options.h> // opt::none
+
+namespace cds { namespace sync {
+
+    /// \p compact_monitor traits
+    struct compact_monitor_traits {
+
+        /// Dummy internal statistics if \p Stat template parameter is \p false
+        struct empty_stat
+        {
+            //@cond
+            void onLock()              const {}
+            void onUnlock()            const {}
+            void onLockContention()    const {}
+            void onUnlockContention()  const {}
+            void onPark()              const {}
+            //@endcond
+        };
+
+        /// Monitor's internal statistics, used if \p Stat template parameter is \p true
+        template <typename Counter = cds::atomicity::event_counter >
+        struct stat
+        {
+            typedef Counter event_counter; ///< measure type
+
+            event_counter m_nLockCount;         ///< Number of monitor \p lock() call
+            event_counter m_nUnlockCount;       ///< Number of monitor \p unlock() call
+            event_counter m_nLockContention;    ///< Number of \p lock() call when the node is already locked
+            event_counter m_nUnlockContention;  ///< Number of \p unlock() call that wakes up parked threads
+            event_counter m_nParkCount;         ///< Number of thread parking
+
+            //@cond
+            void onLock()               { ++m_nLockCount;       }
+            void onUnlock()             { ++m_nUnlockCount;     }
+            void onLockContention()     { ++m_nLockContention;  }
+            void onUnlockContention()   { ++m_nUnlockContention;}
+            void onPark()               { ++m_nParkCount;       }
+            //@endcond
+        };
+    };
+
+    /// @ref cds_sync_monitor "Monitor" with one-word node lock
+    /**
+        The monitor injects one 32-bit word into each node: the lock bit and the "parked" bit.
+        Uncontended \p lock() and \p unlock() are single CAS each, no lock object is allocated.
+
+        On contention, the thread spins with back-off strategy for a while, then it parks:
+        it sets the "parked" bit of the node and waits on the parking slot.
+        The parking slots (a mutex and a condition variable) are preallocated by the monitor;
+        the node is mapped to a slot by its address, so many nodes share one slot.
+        \p unlock() of the node with the "parked" bit wakes up the threads parked on the node's slot.
+
+        Compared with \p pool_monitor, the node injection is smaller (4 bytes instead of pointer and counter)
+        and uncontended path has one atomic RMW instead of three plus pool access.
+        Compared with \p injecting_monitor of \p std::mutex, the node is much smaller.
+
+        Template arguments:
+        - \p BackOff - back-off strategy for spinning before parking, default is \p cds::backoff::Default
+        - \p Stat - enable (\p true) or disable (\p false, the default) monitor's internal statistics.
+
+        <b>How to use</b>
+        \code
+        typedef cds::sync::compact_monitor<> sync_monitor;
+        \endcode
+    */
+    template <typename BackOff = cds::backoff::Default, bool Stat = false >
+    class compact_monitor
+    {
+    public:
+        typedef typename std::conditional<
+            std::is_same< BackOff, cds::opt::none >::value,
+            cds::backoff::yield,
+            BackOff
+        >::type  back_off;  ///< back-off strategy for spinning
+        typedef uint32_t state_type;    ///< Node lock word
+
+        /// Internal statistics
+        typedef typename std::conditional<
+            Stat,
+            typename compact_monitor_traits::stat<>,
+            typename compact_monitor_traits::empty_stat
+        >::type internal_stat;
+
+        /// Default number of parking slots
+        static CDS_CONSTEXPR size_t const c_nDefaultCapacity = 256;
+
+        /// Default number of spins before parking
+        static CDS_CONSTEXPR unsigned const c_nDefaultSpinCount = 64;
+
+    private:
+        //@cond
+        static CDS_CONSTEXPR state_type const c_nLocked = 1;
+        static CDS_CONSTEXPR state_type const c_nParked = 2;
+
+        struct park_slot
+        {
+            std::mutex              m_Mutex;
+            std::condition_variable m_Cond;
+        };
+        typedef cds::details::Allocator< park_slot > slot_allocator;
+
+        park_slot *             m_arrSlots;
+        size_t const            m_nSlotMask;
+        unsigned const          m_nSpinCount;
+        mutable internal_stat   m_Stat;
+        //@endcond
+
+    public:
+        /// Node injection
+        struct node_injection
+        {
+            mutable atomics::atomic<state_type> m_nState;  ///< Lock bit (bit 0) + parked bit (bit 1)
+
+            //@cond
+            node_injection()
+            {
+                m_nState.store( 0, atomics::memory_order_release );
+            }
+
+            ~node_injection()
+            {
+                assert( m_nState.load( atomics::memory_order_relaxed ) == 0 );
+            }
+
+            bool check_free() const
+            {
+                return m_nState.load( atomics::memory_order_relaxed ) == 0;
+            }
+            //@endcond
+        };
+
+        /// Initializes the monitor
+        compact_monitor(
+            size_t nSlotCount = c_nDefaultCapacity,         ///< Number of parking slots, rounded up to power of two
+            unsigned nSpinCount = c_nDefaultSpinCount       ///< Number of spins before parking
+        )
+            : m_nSlotMask( beans::ceil2( nSlotCount ? nSlotCount : c_nDefaultCapacity ) - 1 )
+            , m_nSpinCount( nSpinCount )
+        {
+            m_arrSlots = slot_allocator().NewArray( m_nSlotMask + 1 );
+        }
+
+        //@cond
+        compact_monitor( compact_monitor const& ) = delete;
+        compact_monitor& operator=( compact_monitor const& ) = delete;
+        //@endcond
+
+        /// Frees parking slots
+        ~compact_monitor()
+        {
+            slot_allocator().Delete( m_arrSlots, m_nSlotMask + 1 );
+        }
+
+        /// Makes exclusive access to node \p p
+        template <typename Node>
+        void lock( Node const& p ) const
+        {
+            m_Stat.onLock();
+
+            state_type cur = 0;
+            if ( !p.m_SyncMonitorInjection.m_nState.compare_exchange_strong( cur, c_nLocked,
+                atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+            {
+                lock_slow( p.m_SyncMonitorInjection.m_nState );
+            }
+        }
+
+        /// Unlocks the node \p p
+        template <typename Node>
+        void unlock( Node const& p ) const
+        {
+            m_Stat.onUnlock();
+
+            state_type cur = c_nLocked;
+            if ( !p.m_SyncMonitorInjection.m_nState.compare_exchange_strong( cur, 0,
+                atomics::memory_order_release, atomics::memory_order_relaxed ))
+            {
+                unlock_slow( p.m_SyncMonitorInjection.m_nState );
+            }
+        }
+
+        /// Scoped lock
+        template <typename Node>
+        using scoped_lock = monitor_scoped_lock< compact_monitor, Node >;
+
+        /// Returns the reference to internal statistics
+        /**
+            If class' template argument \p Stat is \p false,
+            the function returns \ref compact_monitor_traits::empty_stat "dummy statistics".
+            Otherwise, it returns the reference to monitor's internal statistics
+            of type \ref compact_monitor_traits::stat.
+        */
+        internal_stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+    private:
+        //@cond
+        park_slot& slot( atomics::atomic<state_type> const& state ) const
+        {
+            uintptr_t h = reinterpret_cast<uintptr_t>( &state );
+            return m_arrSlots[ ( h >> 4 ^ h >> 12 ) & m_nSlotMask ];
+        }
+
+        void lock_slow( atomics::atomic<state_type>& state ) const
+        {
+            m_Stat.onLockContention();
+
+            // Spinning
+            back_off bkoff;
+            for ( unsigned nSpin = 0; nSpin < m_nSpinCount; ++nSpin ) {
+                state_type cur = state.load( atomics::memory_order_relaxed );
+                if ( !( cur & c_nLocked )) {
+                    if ( state.compare_exchange_weak( cur, cur | c_nLocked, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                        return;
+                }
+                else if ( cur & c_nParked ) {
+                    // there are parked threads already, do not waste CPU
+                    break;
+                }
+                bkoff();
+            }
+
+            // Parking
+            park_slot& s = slot( state );
+            std::unique_lock<std::mutex> guard( s.m_Mutex );
+            while ( true ) {
+                state_type cur = state.load( atomics::memory_order_relaxed );
+                if ( !( cur & c_nLocked )) {
+                    // The parked bit is kept: other threads may be parked on the node
+                    if ( state.compare_exchange_weak( cur, cur | c_nLocked, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                        return;
+                    continue;
+                }
+
+                if ( !( cur & c_nParked )
+                    && !state.compare_exchange_weak( cur, cur | c_nParked, atomics::memory_order_relaxed, atomics::memory_order_relaxed ))
+                {
+                    continue;
+                }
+
+                // unlock_slow() changes the state under the slot mutex, so the wake-up cannot be lost
+                m_Stat.onPark();
+                s.m_Cond.wait( guard );
+            }
+        }
+
+        void unlock_slow( atomics::atomic<state_type>& state ) const
+        {
+            assert( state.load( atomics::memory_order_relaxed ) == ( c_nLocked | c_nParked ));
+            m_Stat.onUnlockContention();
+
+            park_slot& s = slot( state );
+            {
+                std::unique_lock<std::mutex> guard( s.m_Mutex );
+                state.store( 0, atomics::memory_order_release );
+            }
+            // The slot is shared by many nodes, so wake up all; the threads parked on other nodes will park again
+            s.m_Cond.notify_all();
+        }
+        //@endcond
+    };
+
+}} // namespace cds::sync
+
+#endif // #ifndef CDSLIB_SYNC_COMPACT_MONITOR_H
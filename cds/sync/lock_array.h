@@ -269,6 +269,29 @@ namespace cds { namespace sync {
             m_arrLocks[nCell].unlock();
         }
 
+        /// Locks a lock at cell \p hint in shared mode
+        /**
+            The function is similar to \p lock() but calls \p lock_shared() of the cell;
+            \p lock_type should be a reader-writer lock, see \p is_shared_lockable.
+
+            Returns the index of locked lock.
+        */
+        template <typename Q>
+        size_t lock_shared( Q const& hint )
+        {
+            size_t nCell = m_SelectCellPolicy( hint, size());
+            assert( nCell < size());
+            m_arrLocks[nCell].lock_shared();
+            return nCell;
+        }
+
+        /// Unlock the shared lock specified by index \p nCell
+        void unlock_shared( size_t nCell )
+        {
+            assert( nCell < size());
+            m_arrLocks[nCell].unlock_shared();
+        }
+
         /// Lock all
         void lock_all()
         {
@@ -285,6 +308,18 @@ namespace cds { namespace sync {
                 pLock->unlock();
         }
 
+        /// Returns the index of the cell for \p hint
+        /**
+            The result is <tt>select_cell_policy( hint, size())</tt>, see \p at().
+        */
+        template <typename Q>
+        size_t cell( Q const& hint ) const
+        {
+            size_t nCell = m_SelectCellPolicy( hint, size());
+            assert( nCell < size());
+            return nCell;
+        }
+
         /// Get lock at cell \p nCell.
         /**
             Precondition: <tt>nCell < size()</tt>
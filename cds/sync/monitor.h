@@ -58,6 +58,9 @@ namespace cds { namespace sync {
             for a node from the pool when needed. When the node is unlocked
             the lock assigned to it is given back to the pool if no thread
             references to that node.
+        - \p sync::compact_monitor injects one 32-bit word into each node. Uncontended locking
+            is a single CAS; on contention the thread spins and then parks on the monitor's
+            preallocated parking slot shared by many nodes.
 
         <b>How to use</b>
 
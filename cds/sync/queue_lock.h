@@ -0,0 +1,426 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_SYNC_QUEUE_LOCK_H
+#define CDSLIB_SYNC_QUEUE_LOCK_H
+
+#include <cds/algo/atomic.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace sync {
+
+    //@cond
+    namespace details {
+
+        // Queue node of MCS and CLH locks
+        struct CDS_DATA_ALIGNMENT( cds::c_nCacheLineSize ) queue_lock_node
+        {
+            atomics::atomic<queue_lock_node *>  m_pNext;    // MCS: successor in the queue
+            atomics::atomic<bool>               m_bLocked;  // MCS: the owner spins while true; CLH: the successor spins while true
+            queue_lock_node *                   m_pNextFree;// next node in the per-thread free-list
+
+            queue_lock_node()
+                : m_pNext( nullptr )
+                , m_bLocked( false )
+                , m_pNextFree( nullptr )
+            {}
+        };
+
+        // Per-thread free-list of queue lock nodes
+        /*
+            A thread needs a node for each queue lock it holds, for example, the full lock
+            of a lock array holds all locks of the array. The nodes are reused, so the steady state
+            has no allocation. CLH nodes migrate between threads: the thread that releases a CLH lock
+            takes the node of its predecessor. The nodes of the free-list are freed on thread exit.
+        */
+        class queue_lock_node_pool
+        {
+            typedef cds::details::Allocator< queue_lock_node > node_allocator;
+
+            queue_lock_node * m_pFree;
+
+        public:
+            queue_lock_node_pool()
+                : m_pFree( nullptr )
+            {}
+
+            ~queue_lock_node_pool()
+            {
+                node_allocator a;
+                while ( m_pFree ) {
+                    queue_lock_node * p = m_pFree;
+                    m_pFree = p->m_pNextFree;
+                    a.Delete( p );
+                }
+            }
+
+            queue_lock_node * alloc()
+            {
+                queue_lock_node * p = m_pFree;
+                if ( p ) {
+                    m_pFree = p->m_pNextFree;
+                    return p;
+                }
+                return node_allocator().New();
+            }
+
+            void free( queue_lock_node * p )
+            {
+                p->m_pNextFree = m_pFree;
+                m_pFree = p;
+            }
+
+            static queue_lock_node_pool& current()
+            {
+                static thread_local queue_lock_node_pool s_pool;
+                return s_pool;
+            }
+        };
+
+    } // namespace details
+    //@endcond
+
+    /// Ticket lock
+    /**
+        FIFO spin-lock: a thread takes a ticket by atomic increment and spins until the ticket is served.
+        Unlike \p spin_lock, the lock is fair and the unlock does not cause the waiters to rush
+        for the lock: only one read-modify-write is performed per acquisition.
+        All waiters still spin on one cache line, so the lock is good for moderate contention.
+
+        Algorithm:
+            [1991] J. Mellor-Crummey, M. Scott. Algorithms for Scalable Synchronization on Shared-Memory Multiprocessors.
+
+        The lock is not recursive.
+
+        Template parameters:
+            - \p Backoff - back-off strategy used while the ticket is not served, default is \p backoff::pause
+    */
+    template <typename Backoff = backoff::pause>
+    class ticket_lock
+    {
+    public:
+        typedef Backoff backoff_strategy;   ///< back-off strategy type
+
+    private:
+        //@cond
+        atomics::atomic<unsigned int>   m_nNext;    // next ticket
+        atomics::atomic<unsigned int>   m_nServing; // ticket being served
+        //@endcond
+
+    public:
+        /// Constructs free (unlocked) lock
+        ticket_lock() CDS_NOEXCEPT
+            : m_nNext( 0 )
+            , m_nServing( 0 )
+        {}
+
+        /// Dummy copy constructor, constructs free lock
+        ticket_lock( ticket_lock const& ) CDS_NOEXCEPT
+            : m_nNext( 0 )
+            , m_nServing( 0 )
+        {}
+
+        /// Destructor. On debug time it checks whether the lock is free
+        ~ticket_lock()
+        {
+            assert( !is_locked());
+        }
+
+        /// Checks if the lock is locked
+        bool is_locked() const CDS_NOEXCEPT
+        {
+            return m_nNext.load( atomics::memory_order_relaxed ) != m_nServing.load( atomics::memory_order_relaxed );
+        }
+
+        /// Tries to lock the object
+        bool try_lock() CDS_NOEXCEPT
+        {
+            unsigned int nServing = m_nServing.load( atomics::memory_order_relaxed );
+            unsigned int nTicket = nServing;
+            return m_nNext.compare_exchange_strong( nTicket, nServing + 1, atomics::memory_order_acquire, atomics::memory_order_relaxed );
+        }
+
+        /// Locks the object, waits while the ticket is not served
+        void lock() CDS_NOEXCEPT_( noexcept( backoff_strategy()()))
+        {
+            unsigned int const nTicket = m_nNext.fetch_add( 1, atomics::memory_order_relaxed );
+            backoff_strategy bkoff;
+            while ( m_nServing.load( atomics::memory_order_acquire ) != nTicket )
+                bkoff();
+        }
+
+        /// Unlocks the object
+        void unlock() CDS_NOEXCEPT
+        {
+            assert( is_locked());
+            m_nServing.store( m_nServing.load( atomics::memory_order_relaxed ) + 1, atomics::memory_order_release );
+        }
+    };
+
+    /// MCS queue lock
+    /**
+        Each waiting thread spins on its own queue node, so the unlock touches the cache line
+        of the successor only. The lock is fair (FIFO) and scales under high contention.
+
+        Algorithm:
+            [1991] J. Mellor-Crummey, M. Scott. Algorithms for Scalable Synchronization on Shared-Memory Multiprocessors.
+
+        The lock has the usual \p lock() / \p unlock() interface and may be used as \p lock_type
+        for any \p libcds container. The queue nodes are taken from a per-thread free-list
+        that uses C++11 \p thread_local. The lock is not recursive; the lock must be released
+        by the thread that has acquired it.
+
+        Template parameters:
+            - \p Backoff - back-off strategy used while waiting, default is \p backoff::pause
+    */
+    template <typename Backoff = backoff::pause>
+    class mcs_lock
+    {
+    public:
+        typedef Backoff backoff_strategy;   ///< back-off strategy type
+
+    private:
+        //@cond
+        typedef details::queue_lock_node node_type;
+
+        atomics::atomic<node_type *> m_pTail;   // last node in the queue
+        node_type *                  m_pOwner;  // node of the owner, accessed by the owner only
+        //@endcond
+
+    public:
+        /// Constructs free (unlocked) lock
+        mcs_lock() CDS_NOEXCEPT
+            : m_pTail( nullptr )
+            , m_pOwner( nullptr )
+        {}
+
+        /// Dummy copy constructor, constructs free lock
+        mcs_lock( mcs_lock const& ) CDS_NOEXCEPT
+            : m_pTail( nullptr )
+            , m_pOwner( nullptr )
+        {}
+
+        /// Destructor. On debug time it checks whether the lock is free
+        ~mcs_lock()
+        {
+            assert( !is_locked());
+        }
+
+        /// Checks if the lock is locked
+        bool is_locked() const CDS_NOEXCEPT
+        {
+            return m_pTail.load( atomics::memory_order_relaxed ) != nullptr;
+        }
+
+        /// Tries to lock the object
+        bool try_lock()
+        {
+            details::queue_lock_node_pool& pool = details::queue_lock_node_pool::current();
+            node_type * pNode = pool.alloc();
+            pNode->m_pNext.store( nullptr, atomics::memory_order_relaxed );
+
+            node_type * pExpected = nullptr;
+            if ( m_pTail.compare_exchange_strong( pExpected, pNode, atomics::memory_order_acq_rel, atomics::memory_order_relaxed )) {
+                m_pOwner = pNode;
+                return true;
+            }
+            pool.free( pNode );
+            return false;
+        }
+
+        /// Locks the object
+        void lock()
+        {
+            node_type * pNode = details::queue_lock_node_pool::current().alloc();
+            pNode->m_pNext.store( nullptr, atomics::memory_order_relaxed );
+            pNode->m_bLocked.store( true, atomics::memory_order_relaxed );
+
+            node_type * pPred = m_pTail.exchange( pNode, atomics::memory_order_acq_rel );
+            if ( pPred ) {
+                pPred->m_pNext.store( pNode, atomics::memory_order_release );
+                backoff_strategy bkoff;
+                while ( pNode->m_bLocked.load( atomics::memory_order_acquire ))
+                    bkoff();
+            }
+            m_pOwner = pNode;
+        }
+
+        /// Unlocks the object, passes the lock to the successor if any
+        void unlock()
+        {
+            node_type * pNode = m_pOwner;
+            assert( pNode );
+            m_pOwner = nullptr;
+
+            node_type * pNext = pNode->m_pNext.load( atomics::memory_order_acquire );
+            if ( !pNext ) {
+                node_type * pExpected = pNode;
+                if ( m_pTail.compare_exchange_strong( pExpected, nullptr, atomics::memory_order_release, atomics::memory_order_relaxed )) {
+                    details::queue_lock_node_pool::current().free( pNode );
+                    return;
+                }
+
+                // A successor is linking itself
+                backoff_strategy bkoff;
+                while ( ( pNext = pNode->m_pNext.load( atomics::memory_order_acquire )) == nullptr )
+                    bkoff();
+            }
+
+            pNext->m_bLocked.store( false, atomics::memory_order_release );
+            details::queue_lock_node_pool::current().free( pNode );
+        }
+    };
+
+    /// CLH queue lock
+    /**
+        The queue is an implicit list: each thread spins on the node of its predecessor.
+        As for \p mcs_lock, the waiters spin on different cache lines, and the lock is fair.
+        Unlike MCS, the unlock is a single store without any read-modify-write, but the thread
+        spins on the node allocated by another thread, that is less suitable for NUMA systems.
+
+        Algorithm:
+            [1993] T. Craig. Building FIFO and priority-queuing spin locks from atomic swap.
+            [1994] P. Magnussen, A. Landin, E. Hagersten. Queue locks on cache coherent multiprocessors.
+
+        The lock has the usual \p lock() / \p unlock() interface and may be used as \p lock_type
+        for any \p libcds container. The queue nodes are taken from a per-thread free-list
+        that uses C++11 \p thread_local. The lock is not recursive; the lock must be released
+        by the thread that has acquired it.
+
+        Template parameters:
+            - \p Backoff - back-off strategy used while waiting, default is \p backoff::pause
+    */
+    template <typename Backoff = backoff::pause>
+    class clh_lock
+    {
+    public:
+        typedef Backoff backoff_strategy;   ///< back-off strategy type
+
+    private:
+        //@cond
+        typedef details::queue_lock_node node_type;
+        typedef cds::details::Allocator< node_type > node_allocator;
+
+        atomics::atomic<node_type *> m_pTail;   // last node in the queue
+        node_type *                  m_pOwner;  // node of the owner, accessed by the owner only
+        node_type *                  m_pPred;   // predecessor's node of the owner, accessed by the owner only
+        //@endcond
+
+    public:
+        /// Constructs free (unlocked) lock
+        clh_lock()
+            : m_pTail( node_allocator().New())
+            , m_pOwner( nullptr )
+            , m_pPred( nullptr )
+        {}
+
+        /// Dummy copy constructor, constructs free lock
+        clh_lock( clh_lock const& )
+            : m_pTail( node_allocator().New())
+            , m_pOwner( nullptr )
+            , m_pPred( nullptr )
+        {}
+
+        /// Destructor. On debug time it checks whether the lock is free
+        ~clh_lock()
+        {
+            assert( !is_locked());
+            node_allocator().Delete( m_pTail.load( atomics::memory_order_relaxed ));
+        }
+
+        /// Checks if the lock is locked
+        bool is_locked() const CDS_NOEXCEPT
+        {
+            return m_pTail.load( atomics::memory_order_acquire )->m_bLocked.load( atomics::memory_order_relaxed );
+        }
+
+        /// Tries to lock the object
+        /**
+            Returns \p false if the lock is held. In rare case of concurrent relocking
+            the function can wait for one critical section of other thread.
+        */
+        bool try_lock()
+        {
+            node_type * pPred = m_pTail.load( atomics::memory_order_acquire );
+            if ( pPred->m_bLocked.load( atomics::memory_order_acquire ))
+                return false;
+
+            details::queue_lock_node_pool& pool = details::queue_lock_node_pool::current();
+            node_type * pNode = pool.alloc();
+            pNode->m_bLocked.store( true, atomics::memory_order_relaxed );
+            if ( m_pTail.compare_exchange_strong( pPred, pNode, atomics::memory_order_acq_rel, atomics::memory_order_relaxed )) {
+                // The tail node may have been reused and locked again between the check and CAS (ABA),
+                // so we must wait for pPred like lock() does. Usually pPred is free here
+                backoff_strategy bkoff;
+                while ( pPred->m_bLocked.load( atomics::memory_order_acquire ))
+                    bkoff();
+                m_pOwner = pNode;
+                m_pPred = pPred;
+                return true;
+            }
+            pool.free( pNode );
+            return false;
+        }
+
+        /// Locks the object
+        void lock()
+        {
+            node_type * pNode = details::queue_lock_node_pool::current().alloc();
+            pNode->m_bLocked.store( true, atomics::memory_order_relaxed );
+
+            node_type * pPred = m_pTail.exchange( pNode, atomics::memory_order_acq_rel );
+            backoff_strategy bkoff;
+            while ( pPred->m_bLocked.load( atomics::memory_order_acquire ))
+                bkoff();
+
+            m_pOwner = pNode;
+            m_pPred = pPred;
+        }
+
+        /// Unlocks the object
+        void unlock()
+        {
+            node_type * pNode = m_pOwner;
+            node_type * pPred = m_pPred;
+            assert( pNode );
+            assert( pPred );
+            m_pOwner = m_pPred = nullptr;
+
+            pNode->m_bLocked.store( false, atomics::memory_order_release );
+
+            // The node of the predecessor is not referenced by anyone, reuse it
+            details::queue_lock_node_pool::current().free( pPred );
+        }
+    };
+
+}} // namespace cds::sync
+
+#endif // #ifndef CDSLIB_SYNC_QUEUE_LOCK_H
@@ -0,0 +1,179 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_SYNC_RW_LOCK_H
+#define CDSLIB_SYNC_RW_LOCK_H
+
+#include <type_traits>
+#include <cds/algo/atomic.h>
+#include <cds/algo/backoff_strategy.h>
+
+namespace cds { namespace sync {
+
+    /// Checks whether \p Lock supports shared (reader) locking
+    /**
+        The metafunction result \p value is \p true if \p Lock has \p lock_shared() and \p unlock_shared()
+        member functions like \p std::shared_timed_mutex.
+        Lock-based containers, for example, \p StripedSet with \p striped_set::striping policy,
+        take such locks in shared mode for read-only operations.
+    */
+    template <typename Lock>
+    struct is_shared_lockable
+    {
+        //@cond
+    private:
+        template <typename T>
+        static auto test( int ) -> decltype( std::declval<T&>().lock_shared(), std::declval<T&>().unlock_shared(), std::true_type());
+
+        template <typename>
+        static std::false_type test( ... );
+
+    public:
+        static CDS_CONSTEXPR const bool value = decltype( test<Lock>( 0 ))::value;
+        //@endcond
+    };
+
+    /// Reader-writer spin lock
+    /**
+        Compact reader-writer lock that occupies one 32-bit word, so it is suitable for arrays of locks
+        (\p lock_array, \p striped_set::striping). Readers enter concurrently; a writer has
+        a preference: when a writer is waiting, new readers wait until the writer is done.
+
+        The lock has both \p std::mutex interface (\p lock(), \p try_lock(), \p unlock())
+        for exclusive access and \p std::shared_timed_mutex interface (\p lock_shared(), \p try_lock_shared(),
+        \p unlock_shared()) for shared access. The lock is not recursive.
+
+        Template parameters:
+            - \p Backoff - back-off strategy used while waiting, default is \p backoff::LockDefault
+    */
+    template <typename Backoff = backoff::LockDefault>
+    class rw_spin_lock
+    {
+    public:
+        typedef Backoff backoff_strategy;   ///< back-off strategy type
+
+    private:
+        //@cond
+        static CDS_CONSTEXPR const uint32_t c_nWriter = 1;        // a writer owns the lock
+        static CDS_CONSTEXPR const uint32_t c_nWriterPending = 2; // a writer is waiting
+        static CDS_CONSTEXPR const uint32_t c_nReader = 4;        // reader count unit
+
+        atomics::atomic<uint32_t> m_nState;
+        //@endcond
+
+    public:
+        /// Constructs free (unlocked) lock
+        rw_spin_lock() CDS_NOEXCEPT
+            : m_nState( 0 )
+        {}
+
+        /// Dummy copy constructor, constructs free lock
+        rw_spin_lock( rw_spin_lock const& ) CDS_NOEXCEPT
+            : m_nState( 0 )
+        {}
+
+        /// Destructor. On debug time it checks whether the lock is free
+        ~rw_spin_lock()
+        {
+            assert( !is_locked());
+        }
+
+        /// Checks if the lock is held by a writer or by a reader
+        bool is_locked() const CDS_NOEXCEPT
+        {
+            return ( m_nState.load( atomics::memory_order_relaxed ) & ~c_nWriterPending ) != 0;
+        }
+
+        /// Tries to lock exclusively
+        bool try_lock() CDS_NOEXCEPT
+        {
+            uint32_t nState = m_nState.load( atomics::memory_order_relaxed );
+            if ( nState & ~c_nWriterPending )
+                return false;
+            return m_nState.compare_exchange_strong( nState, c_nWriter, atomics::memory_order_acquire, atomics::memory_order_relaxed );
+        }
+
+        /// Locks exclusively
+        void lock() CDS_NOEXCEPT_( noexcept( backoff_strategy()()))
+        {
+            backoff_strategy bkoff;
+            while ( true ) {
+                uint32_t nState = m_nState.load( atomics::memory_order_relaxed );
+                if ( ( nState & ~c_nWriterPending ) == 0 ) {
+                    // The writer clears the pending flag; other waiting writers set it again
+                    if ( m_nState.compare_exchange_weak( nState, c_nWriter, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                        return;
+                }
+                else if ( !( nState & c_nWriterPending ))
+                    m_nState.fetch_or( c_nWriterPending, atomics::memory_order_relaxed );
+                bkoff();
+            }
+        }
+
+        /// Unlocks exclusive lock
+        void unlock() CDS_NOEXCEPT
+        {
+            assert( m_nState.load( atomics::memory_order_relaxed ) & c_nWriter );
+            m_nState.fetch_sub( c_nWriter, atomics::memory_order_release );
+        }
+
+        /// Tries to lock in shared mode
+        bool try_lock_shared() CDS_NOEXCEPT
+        {
+            uint32_t nState = m_nState.load( atomics::memory_order_relaxed );
+            while ( !( nState & ( c_nWriter | c_nWriterPending ))) {
+                if ( m_nState.compare_exchange_weak( nState, nState + c_nReader, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                    return true;
+            }
+            return false;
+        }
+
+        /// Locks in shared mode
+        void lock_shared() CDS_NOEXCEPT_( noexcept( backoff_strategy()()))
+        {
+            backoff_strategy bkoff;
+            while ( !try_lock_shared())
+                bkoff();
+        }
+
+        /// Unlocks shared lock
+        void unlock_shared() CDS_NOEXCEPT
+        {
+            assert( m_nState.load( atomics::memory_order_relaxed ) >= c_nReader );
+            m_nState.fetch_sub( c_nReader, atomics::memory_order_release );
+        }
+    };
+
+    /// Reader-writer spin lock with default back-off strategy
+    typedef rw_spin_lock<> rw_spin;
+
+}} // namespace cds::sync
+
+#endif // #ifndef CDSLIB_SYNC_RW_LOCK_H
@@ -0,0 +1,146 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_SYNC_SEQLOCK_H
+#define CDSLIB_SYNC_SEQLOCK_H
+
+#include <cds/algo/atomic.h>
+#include <cds/sync/spinlock.h>
+
+namespace cds { namespace sync {
+
+    /// Sequence lock
+    /**
+        The lock pairs a mutex with a sequence counter. A writer takes the mutex and increments the counter
+        twice: after locking (the counter becomes odd) and before unlocking (the counter becomes even).
+        A reader does not lock anything: it reads the counter by \p read_begin(), reads the protected data
+        and then checks by \p read_validate() that the counter is unchanged. If the counter has been changed
+        the data read may be inconsistent and the reader should retry or fall back to \p lock().
+
+        The reader can see the data in the middle of modification, so the protected data must be safe
+        to read concurrently with writing: the reader must not dereference memory that a writer can free,
+        and it must use atomic loads for the fields the writer changes.
+
+        The lock has \p std::mutex interface (\p lock(), \p try_lock(), \p unlock()),
+        so it can be used in \p lock_array and \p std::unique_lock.
+
+        Template parameters:
+            - \p Lock - the mutex type, default is \p cds::sync::spin
+    */
+    template <class Lock = cds::sync::spin>
+    class seq_lock
+    {
+    public:
+        typedef Lock        lock_type;      ///< Mutex type
+        typedef uint32_t    sequence_type;  ///< Sequence counter type
+
+    private:
+        //@cond
+        atomics::atomic<sequence_type>  m_nSeq;
+        lock_type                       m_Lock;
+        //@endcond
+
+    public:
+        /// Constructs free (unlocked) lock
+        seq_lock()
+            : m_nSeq( 0 )
+        {}
+
+        /// Dummy copy constructor, constructs free lock
+        seq_lock( seq_lock const& )
+            : m_nSeq( 0 )
+        {}
+
+        /// Locks the mutex and opens write section
+        void lock()
+        {
+            m_Lock.lock();
+            begin_write();
+        }
+
+        /// Tries to lock the mutex; opens write section on success
+        bool try_lock()
+        {
+            if ( m_Lock.try_lock()) {
+                begin_write();
+                return true;
+            }
+            return false;
+        }
+
+        /// Closes write section and unlocks the mutex
+        void unlock()
+        {
+            m_nSeq.store( m_nSeq.load( atomics::memory_order_relaxed ) + 1, atomics::memory_order_release );
+            m_Lock.unlock();
+        }
+
+        /// Checks whether the lock is held by a writer
+        bool is_locked() const
+        {
+            return ( m_nSeq.load( atomics::memory_order_relaxed ) & 1 ) != 0;
+        }
+
+        /// Opens read section
+        /**
+            Stores current sequence number to \p nSeq and returns \p true.
+            If a writer holds the lock, the function returns \p false: it makes no sense
+            to read the data in the middle of modification.
+        */
+        bool read_begin( sequence_type& nSeq ) const
+        {
+            nSeq = m_nSeq.load( atomics::memory_order_acquire );
+            return ( nSeq & 1 ) == 0;
+        }
+
+        /// Closes read section
+        /**
+            Returns \p true if no writer has held the lock since \p read_begin() that returned \p nSeq,
+            so the data read is consistent.
+        */
+        bool read_validate( sequence_type nSeq ) const
+        {
+            atomics::atomic_thread_fence( atomics::memory_order_acquire );
+            return m_nSeq.load( atomics::memory_order_relaxed ) == nSeq;
+        }
+
+    private:
+        //@cond
+        void begin_write()
+        {
+            m_nSeq.store( m_nSeq.load( atomics::memory_order_relaxed ) + 1, atomics::memory_order_relaxed );
+            atomics::atomic_thread_fence( atomics::memory_order_release );
+        }
+        //@endcond
+    };
+
+}} // namespace cds::sync
+
+#endif // #ifndef CDSLIB_SYNC_SEQLOCK_H
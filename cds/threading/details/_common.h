@@ -35,6 +35,8 @@
 #include <cds/urcu/details/sh_decl.h>
 #include <cds/algo/elimination_tls.h>
 
+#include <mutex>
+
 namespace cds {
     /// Threading support
     /** \anchor cds_threading
@@ -127,6 +129,55 @@ namespace cds {
     namespace threading {
 
         //@cond
+        /// Owner of a thread slot, see \p thread_slot
+        struct thread_slot_owner
+        {
+            atomics::atomic<size_t> m_nRefCount;    // references from the owner itself and from the threads
+            std::mutex              m_Lock;         // cleanup() and kill() are mutually exclusive
+            bool                    m_bAlive;       // false if the owner has been destroyed, guarded by m_Lock
+
+            thread_slot_owner()
+                : m_nRefCount( 1 )
+                , m_bAlive( true )
+            {}
+
+            // Called on thread detaching for the thread's data if the owner is alive
+            virtual void cleanup( void * pData ) = 0;
+
+            // Calls cleanup() if the owner is alive; the owner cannot be killed while cleanup() is executing
+            void cleanup_if_alive( void * pData )
+            {
+                std::lock_guard<std::mutex> l( m_Lock );
+                if ( m_bAlive )
+                    cleanup( pData );
+            }
+
+            // Marks the owner as destroyed; waits for cleanup() in progress
+            void kill()
+            {
+                std::lock_guard<std::mutex> l( m_Lock );
+                m_bAlive = false;
+            }
+
+            // Destroys the object when the last reference is released
+            virtual void dispose() = 0;
+
+            void add_ref()
+            {
+                m_nRefCount.fetch_add( 1, atomics::memory_order_relaxed );
+            }
+
+            void release()
+            {
+                if ( m_nRefCount.fetch_sub( 1, atomics::memory_order_acq_rel ) == 1 )
+                    dispose();
+            }
+
+        protected:
+            virtual ~thread_slot_owner()
+            {}
+        };
+
         /// Thread-specific data
         struct ThreadData {
 
@@ -142,6 +193,14 @@ namespace cds {
 
             size_t  m_nFakeProcessorNumber  ;   ///< fake "current processor" number
 
+            /// Current processor number maintained by the OS kernel for the thread
+            /**
+                On Linux it is \p cpu_id field of the restartable sequences (rseq) area
+                registered for the thread, see \p cds::OS::Linux::topology::current_processor().
+                \p nullptr if the OS has no such feature.
+            */
+            int32_t const volatile * m_pCurrentCpu;
+
             //@cond
             size_t  m_nAttachCount;
             //@endcond
@@ -149,6 +208,15 @@ namespace cds {
             /// Per-thread elimination record
             cds::algo::elimination::record   m_EliminationRec;
 
+            //@cond
+            struct thread_slot_entry {
+                void *              pData;
+                thread_slot_owner * pOwner;
+            };
+            thread_slot_entry * m_pSlots;       // thread slots indexed by slot id, see thread_slot
+            size_t              m_nSlotCount;   // size of m_pSlots array
+            //@endcond
+
             //@cond
             static CDS_EXPORT_API atomics::atomic<size_t> s_nLastUsedProcNo;
             static CDS_EXPORT_API size_t                  s_nProcCount;
@@ -163,7 +231,10 @@ namespace cds {
                 , m_pSHBRCU( nullptr )
 #endif
                 , m_nFakeProcessorNumber( s_nLastUsedProcNo.fetch_add(1, atomics::memory_order_relaxed) % s_nProcCount )
+                , m_pCurrentCpu( nullptr )
                 , m_nAttachCount(0)
+                , m_pSlots( nullptr )
+                , m_nSlotCount( 0 )
             {}
 
             ~ThreadData()
@@ -174,6 +245,7 @@ namespace cds {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
                 assert( m_pSHBRCU == nullptr );
 #endif
+                assert( m_pSlots == nullptr );
             }
 
             CDS_EXPORT_API void init();
@@ -183,6 +255,22 @@ namespace cds {
             {
                 return m_nFakeProcessorNumber;
             }
+
+            void * get_slot( size_t nSlot, thread_slot_owner const * pOwner ) const
+            {
+                // The slot id may be reused by another owner, so the owner is checked too
+                if ( nSlot < m_nSlotCount && m_pSlots[nSlot].pOwner == pOwner )
+                    return m_pSlots[nSlot].pData;
+                return nullptr;
+            }
+
+            CDS_EXPORT_API void set_slot( size_t nSlot, thread_slot_owner * pOwner, void * pData );
+
+            static CDS_EXPORT_API size_t alloc_slot();
+            static CDS_EXPORT_API void free_slot( size_t nSlot );
+
+        private:
+            void clear_slots();
             //@endcond
         };
         //@endcond
@@ -0,0 +1,158 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_THREADING_THREAD_SLOT_H
+#define CDSLIB_THREADING_THREAD_SLOT_H
+
+#include <cds/threading/model.h>
+
+namespace cds { namespace threading {
+
+    /// Per-thread slot
+    /**
+        The class is a lightweight analogue of \p boost::thread_specific_ptr based on
+        \p cds::threading::ThreadData. Each \p %thread_slot object gets a small integer id
+        from the global registry; the thread's pointer is stored in the slot array of the thread's
+        \p ThreadData at that index. Thus, \p get() is an access to the thread-local \p ThreadData
+        plus an array lookup, without any system call.
+
+        When the thread is detached from \p libcds (\p cds::threading::Manager::detachThread()),
+        the cleanup function \p f passed to the constructor is called for the thread's pointer
+        if the \p %thread_slot object is still alive. When the \p %thread_slot object is destroyed
+        or \p detach() is called, the pointers of all threads are forgotten without calling the cleanup function:
+        the owner of the slot is responsible for freeing the data.
+
+        The slot ids are recycled; a slot of a thread that still refers to a destroyed owner is
+        recognized as empty.
+
+        @note The current thread must be attached to \p libcds to call \p get() and \p reset().
+    */
+    template <typename T>
+    class thread_slot
+    {
+    public:
+        typedef T value_type;   ///< Value type
+        typedef void (* cleanup_func)( value_type * ); ///< Cleanup function type
+
+    private:
+        //@cond
+        struct owner: public thread_slot_owner
+        {
+            cleanup_func const m_Cleanup;
+
+            explicit owner( cleanup_func f )
+                : m_Cleanup( f )
+            {}
+
+            virtual void cleanup( void * pData ) override
+            {
+                if ( m_Cleanup )
+                    m_Cleanup( static_cast<value_type *>( pData ));
+            }
+
+            virtual void dispose() override
+            {
+                delete this;
+            }
+        };
+        //@endcond
+
+    public:
+        /// Allocates a slot
+        explicit thread_slot(
+            cleanup_func f = nullptr   ///< The function called for the thread's pointer on thread detaching
+        )
+            : m_nSlot( ThreadData::alloc_slot())
+            , m_pOwner( new owner( f ))
+        {}
+
+        thread_slot( thread_slot const& ) = delete;
+        thread_slot& operator=( thread_slot const& ) = delete;
+
+        /// Frees the slot
+        ~thread_slot()
+        {
+            detach();
+            ThreadData::free_slot( m_nSlot );
+            m_pOwner->release();
+        }
+
+        /// Disables the cleanup function for all threads
+        /**
+            After the call the cleanup function is not called when a thread is detached.
+            If the cleanup function is executing for a detaching thread, \p detach() waits until it returns.
+            The owner of the slot should call \p detach() before freeing the data the threads refer to.
+            The destructor calls \p detach() too.
+        */
+        void detach()
+        {
+            m_pOwner->kill();
+        }
+
+        /// Returns the pointer for the current thread, \p nullptr if it has not been set
+        value_type * get() const
+        {
+            return static_cast<value_type *>( thread_data()->get_slot( m_nSlot, m_pOwner ));
+        }
+
+        /// Sets the pointer for the current thread
+        /**
+            The previous pointer is replaced without calling the cleanup function.
+        */
+        void reset( value_type * p )
+        {
+            thread_data()->set_slot( m_nSlot, m_pOwner, p );
+        }
+
+        /// Returns the slot id
+        size_t id() const
+        {
+            return m_nSlot;
+        }
+
+    private:
+        //@cond
+        static ThreadData * thread_data()
+        {
+            assert( Manager::isThreadAttached() && "thread_slot: the current thread is not attached to libcds, call cds::threading::Manager::attachThread()" );
+            return Manager::thread_data();
+        }
+        //@endcond
+
+    private:
+        //@cond
+        size_t const    m_nSlot;
+        owner *         m_pOwner;
+        //@endcond
+    };
+
+}} // namespace cds::threading
+
+#endif // #ifndef CDSLIB_THREADING_THREAD_SLOT_H
@@ -109,6 +109,11 @@ namespace cds {
           design, thus being appropriate for use within a general-purpose library, but it has
           relatively higher read-side overhead. The \p libcds contains several implementations of general-purpose
           %RCU: \ref general_instant, \ref general_buffered, \ref general_threaded.
+          On Linux 4.14+ the general-purpose %RCU uses <tt>membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED)</tt>
+          system call in the grace-period detection (like \p liburcu's \p urcu-memb flavour), so the read-side
+          lock needs only a compiler barrier instead of a full memory fence. If the system call is not available
+          the read-side lock falls back to the full fence. You may disable \p membarrier usage
+          compiling \p libcds with <tt>-DCDS_URCU_NO_MEMBARRIER</tt>.
         - \p signal_buffered: the signal-handling %RCU presents an implementation having low read-side overhead and
           requiring only that the application give up one POSIX signal to %RCU update processing.
 
@@ -174,6 +179,28 @@ namespace cds {
         with different template arguments is an error and is not supported.
         However, it is correct when your RCU objects relates to different RCU types.
 
+        @anchor cds_urcu_domain
+        If you need several independent RCU objects of the same type, use RCU domains.
+        A domain is a general-purpose RCU singleton with its own list of reader threads and its own grace periods;
+        it is identified by \ref domain_tag "domain_tag< FlavorTag, Domain >" where \p Domain is any user-defined type.
+        A long read-side critical section in one domain does not delay reclamation in other domains,
+        so, for example, a slow scan of a big container does not hold back a hot small one:
+        \code
+        #include <cds/urcu/general_buffered.h>
+
+        struct big_maps {};
+        struct hot_maps {};
+        typedef cds::urcu::gc< cds::urcu::general_buffered_domain< big_maps >> rcu_big;
+        typedef cds::urcu::gc< cds::urcu::general_buffered_domain< hot_maps >> rcu_hot;
+
+        // The containers based on rcu_big and rcu_hot do not wait for each other's readers
+        typedef cds::container::SkipListMap< rcu_big, int, int > big_map;
+        typedef cds::container::SkipListMap< rcu_hot, int, int > hot_map;
+        \endcode
+        The thread record of a domain is allocated on first use of the domain by the thread
+        attached to \p libcds and is freed when the thread is detached.
+        Domains are supported for \p general_instant, \p general_buffered and \p general_threaded.
+
         In \p libcds, many GC-based ordered list, set and map template classes have %RCU-related specializations
         that hide the %RCU specific details.
 
@@ -259,6 +286,19 @@ namespace cds {
             typedef general_purpose_rcu     rcu_class ; ///< The URCU type
         };
 
+        /// Tag for an independent general-purpose RCU domain
+        /** @anchor domain_tag
+            \p FlavorTag is \p general_instant_tag, \p general_buffered_tag or \p general_threaded_tag,
+            \p Domain is any user-defined type that distinguishes the domain.
+            See \ref cds_urcu_domain "RCU domains".
+        */
+        template <typename FlavorTag, typename Domain>
+        struct domain_tag: public general_purpose_rcu {
+            typedef general_purpose_rcu     rcu_class ; ///< The URCU type
+            typedef FlavorTag               flavor_tag; ///< Tag of RCU flavour
+            typedef Domain                  domain    ; ///< Domain type
+        };
+
 #   ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         /// Tag for signal_buffered URCU
         struct signal_buffered_tag: public signal_handling_rcu {
@@ -33,12 +33,55 @@
 
 #include <cds/urcu/details/gp_decl.h>
 #include <cds/threading/model.h>
+#include <cds/threading/thread_slot.h>
+#include <algorithm>
 
 //@cond
 namespace cds { namespace urcu { namespace details {
 
     // Inlines
 
+    // gp_singleton_instance
+    template <typename RCUtag>
+    inline thread_data< RCUtag > * gp_singleton_instance<RCUtag>::get_thread_record()
+    {
+        return cds::threading::getRCU<RCUtag>();
+    }
+
+    template <typename FlavorTag, typename Domain>
+    inline typename gp_singleton_instance< domain_tag< FlavorTag, Domain >>::thread_record *
+        gp_singleton_instance< domain_tag< FlavorTag, Domain >>::get_thread_record()
+    {
+        assert( s_pThreadSlot != nullptr );
+        thread_record * pRec = s_pThreadSlot->get();
+        if ( !pRec ) {
+            pRec = singleton< domain_tag< FlavorTag, Domain >>::attach_thread();
+            s_pThreadSlot->reset( pRec );
+        }
+        return pRec;
+    }
+
+    template <typename FlavorTag, typename Domain>
+    inline void gp_singleton_instance< domain_tag< FlavorTag, Domain >>::init()
+    {
+        s_pThreadSlot = new cds::threading::thread_slot< thread_record >( detach_thread_record );
+    }
+
+    template <typename FlavorTag, typename Domain>
+    inline void gp_singleton_instance< domain_tag< FlavorTag, Domain >>::fini()
+    {
+        // The cleanup is not called for the threads that are still attached,
+        // their records are freed with the thread list of the domain
+        delete s_pThreadSlot;
+        s_pThreadSlot = nullptr;
+    }
+
+    template <typename FlavorTag, typename Domain>
+    inline void gp_singleton_instance< domain_tag< FlavorTag, Domain >>::detach_thread_record( thread_record * pRec )
+    {
+        singleton< domain_tag< FlavorTag, Domain >>::detach_thread( pRec );
+    }
+
     // gp_thread_gc
     template <typename RCUtag>
     inline gp_thread_gc<RCUtag>::gp_thread_gc()
@@ -56,7 +99,7 @@ namespace cds { namespace urcu { namespace details {
     template <typename RCUtag>
     inline typename gp_thread_gc<RCUtag>::thread_record * gp_thread_gc<RCUtag>::get_thread_record()
     {
-        return cds::threading::getRCU<RCUtag>();
+        return gp_singleton_instance< RCUtag >::get_thread_record();
     }
 
     template <typename RCUtag>
@@ -70,7 +113,11 @@ namespace cds { namespace urcu { namespace details {
             pRec->m_nAccessControl.store( gp_singleton<RCUtag>::instance()->global_control_word(atomics::memory_order_relaxed),
                 atomics::memory_order_relaxed );
 
-            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            // With sys_membarrier the updater executes the full barrier on behalf of the readers
+            if ( gp_membarrier::enabled())
+                CDS_COMPILER_RW_BARRIER;
+            else
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
         }
         else {
             // nested lock
@@ -119,17 +166,71 @@ namespace cds { namespace urcu { namespace details {
     inline void gp_singleton<RCUtag>::flip_and_wait( Backoff& bkoff )
     {
         OS::ThreadId const nullThreadId = OS::c_NullThreadId;
+
+        // Pairs with the compiler-only barrier of access_lock() in membarrier mode:
+        // the readers' control words become visible before we check them
+        if ( gp_membarrier::enabled())
+            gp_membarrier::master_barrier();
+
         m_nGlobalControl.fetch_xor( general_purpose_rcu::c_nControlBit, atomics::memory_order_seq_cst );
 
+        // Snapshot: one pass over all threads collects the readers
+        // that are inside the critical section started before the flip
+        m_arrWaiting.clear();
         for ( thread_record * pRec = m_ThreadList.head( atomics::memory_order_acquire ); pRec; pRec = pRec->m_list.m_pNext ) {
-            while ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) != nullThreadId && check_grace_period( pRec )) {
+            if ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) != nullThreadId && check_grace_period( pRec ))
+                m_arrWaiting.push_back( pRec );
+        }
+
+        // Re-check only the collected readers. A slow reader does not stall the scan:
+        // the back-off is applied only if no reader has left its critical section since the last pass
+        while ( !m_arrWaiting.empty()) {
+            auto itEnd = std::remove_if( m_arrWaiting.begin(), m_arrWaiting.end(), [this, nullThreadId]( thread_record * pRec ) {
+                return pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) == nullThreadId || !check_grace_period( pRec );
+            });
+
+            if ( itEnd != m_arrWaiting.end()) {
+                m_arrWaiting.erase( itEnd, m_arrWaiting.end());
+                bkoff.reset();
+            }
+            else {
                 bkoff();
                 CDS_COMPILER_RW_BARRIER;
             }
-            bkoff.reset();
         }
     }
 
+    template <typename RCUtag>
+    template <class Backoff>
+    inline void gp_singleton<RCUtag>::wait_grace_period( Backoff& bkoff )
+    {
+        // Must be called under the RCU lock: only one grace period is in progress at any time
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_seq_cst );
+        flip_and_wait( bkoff );
+        bkoff.reset();
+        flip_and_wait( bkoff );
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_release );
+    }
+
+    template <typename RCUtag>
+    inline uint64_t gp_singleton<RCUtag>::get_state() const
+    {
+        // The removal that precedes get_state() must be ordered before the read of the sequence
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        uint64_t const nSeq = m_nGPSeq.load( atomics::memory_order_seq_cst );
+
+        // Idle (even): the next grace period is enough;
+        // in progress (odd): the current grace period may have started before the removal,
+        // so the next full one is needed
+        return ( nSeq + 3 ) & ~uint64_t(1);
+    }
+
+    template <typename RCUtag>
+    inline bool gp_singleton<RCUtag>::poll_state( uint64_t nCookie ) const
+    {
+        return m_nGPSeq.load( atomics::memory_order_acquire ) >= nCookie;
+    }
+
 
 }}} // namespace cds:urcu::details
 //@endcond
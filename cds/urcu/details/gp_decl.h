@@ -35,8 +35,14 @@
 #include <cds/details/static_functor.h>
 #include <cds/details/lib.h>
 #include <cds/user_setup/cache_line.h>
+#include <cds/algo/backoff_strategy.h>
+#include <vector>
 
 //@cond
+namespace cds { namespace threading {
+    template <typename T> class thread_slot;
+}} // namespace cds::threading
+
 namespace cds { namespace urcu { namespace details {
 
     // We could derive thread_data from thread_list_record
@@ -58,10 +64,51 @@ namespace cds { namespace urcu { namespace details {
 
 #   undef CDS_GPURCU_DECLARE_THREAD_DATA
 
+    template <typename FlavorTag, typename Domain>
+    struct thread_data< domain_tag< FlavorTag, Domain >>
+    {
+        atomics::atomic<uint32_t>        m_nAccessControl;
+        thread_list_record< thread_data >   m_list;
+        char pad_[cds::c_nCacheLineSize];
+        thread_data(): m_nAccessControl(0) {}
+        explicit thread_data( OS::ThreadId owner ): m_nAccessControl(0), m_list(owner) {}
+        ~thread_data() {}
+    };
+
+    // sys_membarrier() support for general-purpose RCU
+    // If the process is registered for expedited membarrier (Linux 4.14+),
+    // the outermost read-side lock needs only a compiler barrier instead of a full fence:
+    // the updater forces the full barrier on all running threads by membarrier() system call.
+    struct gp_membarrier
+    {
+        // Tries to register the process for expedited membarrier, the result is cached.
+        // Called before the first general-purpose RCU singleton is created,
+        // so the mode never changes while the readers exist
+        static CDS_EXPORT_API bool init();
+
+        // Full barrier on all threads of the process: membarrier() system call
+        // if enabled, otherwise just a fence (the readers use fences in that case)
+        static CDS_EXPORT_API void master_barrier();
+
+        static bool enabled()
+        {
+            return s_bEnabled;
+        }
+
+        static CDS_EXPORT_API bool s_bEnabled;
+    };
+
     template <typename RCUtag>
     struct gp_singleton_instance
     {
         static CDS_EXPORT_API singleton_vtbl *     s_pRCU;
+
+        // Thread record of the current thread is kept in cds::threading::ThreadData
+        static thread_data< RCUtag > * get_thread_record();
+        static void init()
+        {}
+        static void fini()
+        {}
     };
 #if !( CDS_COMPILER == CDS_COMPILER_MSVC || (CDS_COMPILER == CDS_COMPILER_INTEL && CDS_OS_INTERFACE == CDS_OSI_WINDOWS))
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_instant_tag >::s_pRCU;
@@ -69,6 +116,28 @@ namespace cds { namespace urcu { namespace details {
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_threaded_tag >::s_pRCU;
 #endif
 
+    // RCU domain: the thread record is kept in the domain's thread slot
+    // and is allocated on first use by the thread
+    template <typename FlavorTag, typename Domain>
+    struct gp_singleton_instance< domain_tag< FlavorTag, Domain >>
+    {
+        typedef thread_data< domain_tag< FlavorTag, Domain >> thread_record;
+
+        static singleton_vtbl * s_pRCU;
+        static cds::threading::thread_slot< thread_record > * s_pThreadSlot;
+
+        static thread_record * get_thread_record();
+        static void init();
+        static void fini();
+        static void detach_thread_record( thread_record * pRec );
+    };
+
+    template <typename FlavorTag, typename Domain>
+    singleton_vtbl * gp_singleton_instance< domain_tag< FlavorTag, Domain >>::s_pRCU = nullptr;
+
+    template <typename FlavorTag, typename Domain>
+    cds::threading::thread_slot< thread_data< domain_tag< FlavorTag, Domain >>> * gp_singleton_instance< domain_tag< FlavorTag, Domain >>::s_pThreadSlot = nullptr;
+
     template <typename GPRCUtag>
     class gp_thread_gc
     {
@@ -120,6 +189,10 @@ namespace cds { namespace urcu { namespace details {
 
 #   undef CDS_GP_RCU_DECLARE_THREAD_GC
 
+    template <typename FlavorTag, typename Domain>
+    class thread_gc< domain_tag< FlavorTag, Domain >>: public gp_thread_gc< domain_tag< FlavorTag, Domain >>
+    {};
+
     template <class RCUtag>
     class gp_singleton: public singleton_vtbl
     {
@@ -134,14 +207,33 @@ namespace cds { namespace urcu { namespace details {
     protected:
         atomics::atomic<uint32_t>    m_nGlobalControl;
         thread_list< rcu_tag >          m_ThreadList;
+        atomics::atomic<uint64_t>    m_nGPSeq;   // grace period sequence: odd - grace period is in progress
+        std::vector< thread_record * > m_arrWaiting; // readers that block current grace period, guarded by RCU lock
+
+        // Back-off for expedited grace period: short spinning, then yield
+        struct expedited_backoff_traits: public cds::backoff::exponential_const_traits
+        {
+            enum: size_t {
+                lower_bound = 16,
+                upper_bound = 256
+            };
+        };
+        typedef cds::backoff::exponential< expedited_backoff_traits > expedited_back_off;
 
     protected:
         gp_singleton()
             : m_nGlobalControl(1)
-        {}
+            , m_nGPSeq(0)
+        {
+            gp_membarrier::init();
+            rcu_instance::init();
+            m_arrWaiting.reserve( 64 );
+        }
 
         ~gp_singleton()
-        {}
+        {
+            rcu_instance::fini();
+        }
 
     public:
         static gp_singleton * instance()
@@ -173,11 +265,25 @@ namespace cds { namespace urcu { namespace details {
             return m_nGlobalControl.load( mo );
         }
 
+    public: // polled grace periods
+        uint64_t get_state() const;
+        bool poll_state( uint64_t nCookie ) const;
+
     protected:
         bool check_grace_period( thread_record * pRec ) const;
 
         template <class Backoff>
         void flip_and_wait( Backoff& bkoff );
+
+        // Full grace period: two flips of the control bit; advances the grace period sequence
+        template <class Backoff>
+        void wait_grace_period( Backoff& bkoff );
+
+        void expedited_grace_period()
+        {
+            expedited_back_off bkoff;
+            wait_grace_period( bkoff );
+        }
     };
 
 #   define CDS_GP_RCU_DECLARE_SINGLETON( tag_ ) \
@@ -203,6 +309,23 @@ namespace cds { namespace urcu { namespace details {
 
 #   undef CDS_GP_RCU_DECLARE_SINGLETON
 
+    template <typename FlavorTag, typename Domain>
+    class singleton< domain_tag< FlavorTag, Domain >> {
+    public:
+        typedef domain_tag< FlavorTag, Domain > rcu_tag;
+        typedef cds::urcu::details::thread_gc< rcu_tag >   thread_gc;
+    protected:
+        typedef typename thread_gc::thread_record   thread_record;
+        typedef gp_singleton_instance< rcu_tag >    rcu_instance;
+        typedef gp_singleton< rcu_tag >             rcu_singleton;
+    public:
+        static bool isUsed() { return rcu_singleton::isUsed(); }
+        static rcu_singleton * instance() { assert( rcu_instance::s_pRCU ); return static_cast<rcu_singleton *>( rcu_instance::s_pRCU ); }
+        static thread_record * attach_thread() { return instance()->attach_thread(); }
+        static void detach_thread( thread_record * pRec ) { return instance()->detach_thread( pRec ); }
+        static uint32_t global_control_word( atomics::memory_order mo ) { return instance()->global_control_word( mo ); }
+    };
+
 }}} // namespace cds::urcu::details
 //@endcond
 
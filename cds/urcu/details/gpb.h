@@ -28,14 +28,18 @@
     OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+
 #ifndef CDSLIB_URCU_DETAILS_GPB_H
 #define CDSLIB_URCU_DETAILS_GPB_H
 
 #include <mutex>
 #include <limits>
+#include <memory>
+#include <vector>
 #include <cds/urcu/details/gp.h>
 #include <cds/algo/backoff_strategy.h>
 #include <cds/container/vyukov_mpmc_cycle_queue.h>
+#include <cds/threading/thread_slot.h>
 
 namespace cds { namespace urcu {
 
@@ -59,31 +63,45 @@ namespace cds { namespace urcu {
 
         The buffer is considered as full if \p push() returns \p false or the buffer size reaches the RCU threshold.
 
+        <b>Batching mode</b>. If \p Construct() is called with nonzero \p nBatchSize, each attached thread
+        accumulates retired pointers in its own callback list instead of the shared \p Buffer.
+        When the list reaches \p nBatchSize items it is moved as a whole to the lock-free list of pending batches.
+        When the pending batches hold \p nBufferCapacity pointers or more, the retiring thread tries to start
+        a grace period; if another thread is already running it, the retiring thread does not wait
+        and goes on. One grace period frees all batches queued before it started, so
+        the cost of \p synchronize() is amortized over many retired pointers and the updaters
+        do not contend on the shared buffer. \p synchronize() flushes the caller's own list;
+        the list of a detaching thread is moved to the pending batches.
+        The threads that are not attached to \p libcds use the shared buffer.
+
         There is a wrapper \ref cds_urcu_general_buffered_gc "gc<general_buffered>" for \p %general_buffered class
         that provides unified RCU interface. You should use this wrapper class instead \p %general_buffered
 
         Template arguments:
         - \p Buffer - buffer type. Default is \p cds::container::VyukovMPMCCycleQueue
-        - \p Lock - mutex type, default is \p std::mutex
+        - \p Lock - mutex type, default is \p std::mutex. In batching mode the \p Lock should support \p try_lock()
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Tag - RCU tag, \p general_buffered_tag or \ref domain_tag "domain_tag< general_buffered_tag, Domain >"
+            for an independent \ref cds_urcu_domain "RCU domain", see also \p general_buffered_domain
     */
     template <
         class Buffer = cds::container::VyukovMPMCCycleQueue< epoch_retired_ptr >
         ,class Lock = std::mutex
         ,class Backoff = cds::backoff::Default
+        ,class Tag = general_buffered_tag
     >
-    class general_buffered: public details::gp_singleton< general_buffered_tag >
+    class general_buffered: public details::gp_singleton< Tag >
     {
         //@cond
-        typedef details::gp_singleton< general_buffered_tag > base_class;
+        typedef details::gp_singleton< Tag > base_class;
         //@endcond
     public:
-        typedef general_buffered_tag rcu_tag ;  ///< RCU tag
+        typedef Tag     rcu_tag     ;   ///< RCU tag
         typedef Buffer  buffer_type ;   ///< Buffer type
         typedef Lock    lock_type   ;   ///< Lock type
         typedef Backoff back_off    ;   ///< Back-off type
 
-        typedef base_class::thread_gc thread_gc ;   ///< Thread-side RCU part
+        typedef typename base_class::thread_gc thread_gc ;   ///< Thread-side RCU part
         typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
 
         //@cond
@@ -93,6 +111,21 @@ namespace cds { namespace urcu {
     protected:
         //@cond
         typedef details::gp_singleton_instance< rcu_tag >    singleton_ptr;
+
+        // Batch of retired pointers waiting for a grace period
+        struct retired_batch
+        {
+            std::vector< retired_ptr > m_arr;
+            retired_batch *            m_pNext;
+        };
+
+        // Per-thread callback list
+        struct thread_batch
+        {
+            std::vector< retired_ptr > m_arr;
+            thread_batch *             m_pPrev;   // registry of all thread lists
+            thread_batch *             m_pNext;
+        };
         //@endcond
 
     protected:
@@ -101,6 +134,14 @@ namespace cds { namespace urcu {
         atomics::atomic<uint64_t>  m_nCurEpoch;
         lock_type                  m_Lock;
         size_t const               m_nCapacity;
+
+        // Batching mode
+        size_t const                    m_nBatchSize;
+        atomics::atomic<retired_batch *> m_pPending;       // pending batches
+        atomics::atomic<size_t>         m_nPendingCount;  // total count of pointers in pending batches
+        std::unique_ptr< cds::threading::thread_slot< thread_batch > > m_pThreadBatch;
+        std::mutex                      m_RegistryLock;
+        thread_batch *                  m_pRegistry;
         //@endcond
 
     public:
@@ -117,21 +158,39 @@ namespace cds { namespace urcu {
 
     protected:
         //@cond
-        general_buffered( size_t nBufferCapacity )
+        general_buffered( size_t nBufferCapacity, size_t nBatchSize )
             : m_Buffer( nBufferCapacity )
             , m_nCurEpoch(0)
             , m_nCapacity( nBufferCapacity )
-        {}
+            , m_nBatchSize( nBatchSize )
+            , m_pPending( nullptr )
+            , m_nPendingCount( 0 )
+            , m_pRegistry( nullptr )
+        {
+            if ( m_nBatchSize )
+                m_pThreadBatch.reset( new cds::threading::thread_slot< thread_batch >( tls_cleanup ));
+        }
 
         ~general_buffered()
         {
+            // No thread may call the cleanup after that
+            m_pThreadBatch.reset();
+
             clear_buffer( std::numeric_limits< uint64_t >::max());
+            free_batches( m_pPending.exchange( nullptr, atomics::memory_order_acquire ));
+
+            for ( thread_batch * p = m_pRegistry; p; ) {
+                thread_batch * pNext = p->m_pNext;
+                free_ptrs( p->m_arr );
+                delete p;
+                p = pNext;
+            }
         }
 
-        void flip_and_wait()
+        void wait_grace_period()
         {
             back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            base_class::wait_grace_period( bkoff );
         }
 
         void clear_buffer( uint64_t nEpoch )
@@ -161,17 +220,147 @@ namespace cds { namespace urcu {
             }
             return false;
         }
+
+        // Returns the callback list of current thread,
+        // nullptr if batching is off or the thread is not attached to RCU
+        thread_batch * get_thread_batch()
+        {
+            if ( !m_pThreadBatch || !cds::threading::Manager::isThreadAttached()
+              || !singleton_ptr::get_thread_record())
+            {
+                return nullptr;
+            }
+
+            thread_batch * pBatch = m_pThreadBatch->get();
+            if ( !pBatch ) {
+                pBatch = new thread_batch;
+                pBatch->m_arr.reserve( m_nBatchSize );
+                pBatch->m_pPrev = nullptr;
+                {
+                    std::unique_lock< std::mutex > sl( m_RegistryLock );
+                    pBatch->m_pNext = m_pRegistry;
+                    if ( m_pRegistry )
+                        m_pRegistry->m_pPrev = pBatch;
+                    m_pRegistry = pBatch;
+                }
+                m_pThreadBatch->reset( pBatch );
+            }
+            return pBatch;
+        }
+
+        void push_batch( thread_batch& batch, retired_ptr& p )
+        {
+            batch.m_arr.push_back( p );
+            if ( batch.m_arr.size() >= m_nBatchSize && flush_batch( batch ))
+                try_synchronize();
+        }
+
+        // Moves the thread's list to pending batches
+        // Returns true if the pending batches reach the threshold
+        bool flush_batch( thread_batch& batch )
+        {
+            if ( batch.m_arr.empty())
+                return false;
+
+            retired_batch * pBatch = new retired_batch;
+            pBatch->m_arr.swap( batch.m_arr );
+            batch.m_arr.reserve( m_nBatchSize );
+
+            size_t const nCount = pBatch->m_arr.size();
+            retired_batch * pHead = m_pPending.load( atomics::memory_order_relaxed );
+            do {
+                pBatch->m_pNext = pHead;
+            } while ( !m_pPending.compare_exchange_weak( pHead, pBatch, atomics::memory_order_release, atomics::memory_order_relaxed ));
+
+            return m_nPendingCount.fetch_add( nCount, atomics::memory_order_relaxed ) + nCount >= capacity();
+        }
+
+        // Starts the grace period if no other thread does it; never waits for the RCU lock
+        void try_synchronize()
+        {
+            // Cannot wait for a grace period inside read-side critical section
+            if ( thread_gc::is_locked())
+                return;
+
+            uint64_t nEpoch;
+            retired_batch * pBatches;
+            {
+                std::unique_lock<lock_type> sl( m_Lock, std::try_to_lock );
+                if ( !sl.owns_lock())
+                    return;
+                pBatches = grace_period( nEpoch );
+            }
+            clear_buffer( nEpoch );
+            free_batches( pBatches );
+        }
+
+        // Must be called under m_Lock.
+        // Returns the pending batches retired before the grace period
+        retired_batch * grace_period( uint64_t& nEpoch, bool bExpedited = false )
+        {
+            retired_batch * pBatches = m_pPending.exchange( nullptr, atomics::memory_order_acquire );
+            size_t nCount = 0;
+            for ( retired_batch * p = pBatches; p; p = p->m_pNext )
+                nCount += p->m_arr.size();
+            m_nPendingCount.fetch_sub( nCount, atomics::memory_order_relaxed );
+
+            nEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
+            if ( bExpedited )
+                base_class::expedited_grace_period();
+            else
+                wait_grace_period();
+            return pBatches;
+        }
+
+        static void free_ptrs( std::vector< retired_ptr >& arr )
+        {
+            for ( retired_ptr& p : arr )
+                p.free();
+            arr.clear();
+        }
+
+        static void free_batches( retired_batch * pBatch )
+        {
+            while ( pBatch ) {
+                retired_batch * pNext = pBatch->m_pNext;
+                free_ptrs( pBatch->m_arr );
+                delete pBatch;
+                pBatch = pNext;
+            }
+        }
+
+        void detach_batch( thread_batch * pBatch )
+        {
+            flush_batch( *pBatch );
+            {
+                std::unique_lock< std::mutex > sl( m_RegistryLock );
+                if ( pBatch->m_pPrev )
+                    pBatch->m_pPrev->m_pNext = pBatch->m_pNext;
+                else
+                    m_pRegistry = pBatch->m_pNext;
+                if ( pBatch->m_pNext )
+                    pBatch->m_pNext->m_pPrev = pBatch->m_pPrev;
+            }
+            delete pBatch;
+        }
+
+        static void tls_cleanup( thread_batch * pBatch )
+        {
+            instance()->detach_batch( pBatch );
+        }
         //@endcond
 
     public:
         /// Creates singleton object
         /**
             The \p nBufferCapacity parameter defines RCU threshold.
+            If \p nBatchSize is not zero, the batching mode is on: \p nBatchSize
+            is the size of per-thread callback list.
         */
-        static void Construct( size_t nBufferCapacity = 256 )
+        static void Construct( size_t nBufferCapacity = 256, size_t nBatchSize = 0 )
         {
             if ( !singleton_ptr::s_pRCU )
-                singleton_ptr::s_pRCU = new general_buffered( nBufferCapacity );
+                singleton_ptr::s_pRCU = new general_buffered( nBufferCapacity, nBatchSize );
         }
 
         /// Destroys singleton object
@@ -192,17 +381,35 @@ namespace cds { namespace urcu {
             The method pushes \p p pointer to internal buffer.
             When the buffer becomes full \ref synchronize function is called
             to wait for the end of grace period and then to free all pointers from the buffer.
+
+            In batching mode \p p is placed to the callback list of current thread.
         */
         virtual void retire_ptr( retired_ptr& p ) override
         {
-            if ( p.m_p )
-                push_buffer( epoch_retired_ptr( p, m_nCurEpoch.load( atomics::memory_order_relaxed )));
+            if ( p.m_p ) {
+                thread_batch * pBatch = get_thread_batch();
+                if ( pBatch )
+                    push_batch( *pBatch, p );
+                else
+                    push_buffer( epoch_retired_ptr( p, m_nCurEpoch.load( atomics::memory_order_relaxed )));
+            }
         }
 
         /// Retires the pointer chain [\p itFirst, \p itLast)
         template <typename ForwardIterator>
         void batch_retire( ForwardIterator itFirst, ForwardIterator itLast )
         {
+            thread_batch * pBatch = get_thread_batch();
+            if ( pBatch ) {
+                while ( itFirst != itLast ) {
+                    retired_ptr p( *itFirst );
+                    ++itFirst;
+                    if ( p.m_p )
+                        push_batch( *pBatch, p );
+                }
+                return;
+            }
+
             uint64_t nEpoch = m_nCurEpoch.load( atomics::memory_order_relaxed );
             while ( itFirst != itLast ) {
                 epoch_retired_ptr ep( *itFirst, nEpoch );
@@ -215,6 +422,13 @@ namespace cds { namespace urcu {
         template <typename Func>
         void batch_retire( Func e )
         {
+            thread_batch * pBatch = get_thread_batch();
+            if ( pBatch ) {
+                for ( retired_ptr p{ e() }; p.m_p; p = e())
+                    push_batch( *pBatch, p );
+                return;
+            }
+
             uint64_t nEpoch = m_nCurEpoch.load( atomics::memory_order_relaxed );
             for ( retired_ptr p{ e() }; p.m_p; ) {
                 epoch_retired_ptr ep( p, nEpoch );
@@ -224,8 +438,15 @@ namespace cds { namespace urcu {
         }
 
         /// Wait to finish a grace period and then clear the buffer
+        /**
+            In batching mode the callback list of current thread and all pending batches are freed too.
+        */
         void synchronize()
         {
+            thread_batch * pBatch = get_thread_batch();
+            if ( pBatch )
+                flush_batch( *pBatch );
+
             epoch_retired_ptr ep( retired_ptr(), m_nCurEpoch.load( atomics::memory_order_relaxed ));
             synchronize( ep );
         }
@@ -234,26 +455,67 @@ namespace cds { namespace urcu {
         bool synchronize( epoch_retired_ptr& ep )
         {
             uint64_t nEpoch;
+            retired_batch * pBatches;
             atomics::atomic_thread_fence( atomics::memory_order_acquire );
             {
                 std::unique_lock<lock_type> sl( m_Lock );
                 if ( ep.m_p && m_Buffer.push( ep ))
                     return false;
-                nEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
-                flip_and_wait();
-                flip_and_wait();
+                pBatches = grace_period( nEpoch );
             }
             clear_buffer( nEpoch );
+            free_batches( pBatches );
             atomics::atomic_thread_fence( atomics::memory_order_release );
             return true;
         }
         //@endcond
 
+        /// Waits to finish a grace period with minimal latency and then clears the buffer
+        /**
+            The function does not sleep on the slowest reader: it spins briefly and then yields
+            while re-checking the readers found in the critical section.
+            In batching mode the callback list of current thread and all pending batches are freed too.
+        */
+        void synchronize_expedited()
+        {
+            thread_batch * pBatch = get_thread_batch();
+            if ( pBatch )
+                flush_batch( *pBatch );
+
+            uint64_t nEpoch;
+            retired_batch * pBatches;
+            atomics::atomic_thread_fence( atomics::memory_order_acquire );
+            {
+                std::unique_lock<lock_type> sl( m_Lock );
+                pBatches = grace_period( nEpoch, true );
+            }
+            clear_buffer( nEpoch );
+            free_batches( pBatches );
+            atomics::atomic_thread_fence( atomics::memory_order_release );
+        }
+
+        /// Waits for a grace period only if the grace period for \p nCookie has not elapsed yet
+        /**
+            \p nCookie is a value returned by \p get_state(). If \p poll_state( nCookie ) is \p true
+            the function returns immediately.
+        */
+        void cond_synchronize( uint64_t nCookie )
+        {
+            if ( !base_class::poll_state( nCookie ))
+                synchronize();
+        }
+
         /// Returns internal buffer capacity
         size_t capacity() const
         {
             return m_nCapacity;
         }
+
+        /// Returns the size of per-thread callback list, 0 if the batching mode is off
+        size_t batch_size() const
+        {
+            return m_nBatchSize;
+        }
     };
 
     /// User-space general-purpose RCU with deferred (buffered) reclamation (stripped version)
@@ -267,6 +529,20 @@ namespace cds { namespace urcu {
     class general_buffered_stripped: public general_buffered<>
     {};
 
+    /// General-purpose RCU with deferred (buffered) reclamation in independent domain \p Domain
+    /**
+        @headerfile cds/urcu/general_buffered.h
+
+        See \ref cds_urcu_domain "RCU domains".
+    */
+    template <
+        class Domain
+        ,class Buffer = cds::container::VyukovMPMCCycleQueue< epoch_retired_ptr >
+        ,class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+    >
+    using general_buffered_domain = general_buffered< Buffer, Lock, Backoff, domain_tag< general_buffered_tag, Domain >>;
+
 }} // namespace cds::urcu
 
 #endif // #ifndef CDSLIB_URCU_DETAILS_GPB_H
@@ -53,19 +53,22 @@ namespace cds { namespace urcu {
         Template arguments:
         - \p Lock - mutex type, default is \p std::mutex
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Tag - RCU tag, \p general_instant_tag or \ref domain_tag "domain_tag< general_instant_tag, Domain >"
+            for an independent \ref cds_urcu_domain "RCU domain", see also \p general_instant_domain
     */
     template <
         class Lock = std::mutex
        ,class Backoff = cds::backoff::Default
+       ,class Tag = general_instant_tag
     >
-    class general_instant: public details::gp_singleton< general_instant_tag >
+    class general_instant: public details::gp_singleton< Tag >
     {
         //@cond
-        typedef details::gp_singleton< general_instant_tag > base_class;
+        typedef details::gp_singleton< Tag > base_class;
         //@endcond
 
     public:
-        typedef general_instant_tag rcu_tag ;   ///< RCU tag
+        typedef Tag     rcu_tag     ;           ///< RCU tag
         typedef Lock    lock_type   ;           ///< Lock type
         typedef Backoff back_off    ;           ///< Back-off schema type
 
@@ -107,10 +110,10 @@ namespace cds { namespace urcu {
         ~general_instant()
         {}
 
-        void flip_and_wait()
+        void wait_grace_period()
         {
             back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            base_class::wait_grace_period( bkoff );
         }
         //@endcond
 
@@ -181,8 +184,34 @@ namespace cds { namespace urcu {
         {
             assert( !thread_gc::is_locked());
             std::unique_lock<lock_type> sl( m_Lock );
-            flip_and_wait();
-            flip_and_wait();
+            wait_grace_period();
+        }
+
+        /// Waits to finish a grace period with minimal latency
+        /**
+            The function does not sleep on the slowest reader: it spins briefly and then yields
+            while re-checking the readers found in the critical section.
+            If another thread completes a full grace period while the caller waits for the RCU lock,
+            the function returns without starting a new one.
+        */
+        void synchronize_expedited()
+        {
+            assert( !thread_gc::is_locked());
+            uint64_t const nCookie = base_class::get_state();
+            std::unique_lock<lock_type> sl( m_Lock );
+            if ( !base_class::poll_state( nCookie ))
+                base_class::expedited_grace_period();
+        }
+
+        /// Waits for a grace period only if the grace period for \p nCookie has not elapsed yet
+        /**
+            \p nCookie is a value returned by \p get_state(). If \p poll_state( nCookie ) is \p true
+            the function returns immediately.
+        */
+        void cond_synchronize( uint64_t nCookie )
+        {
+            if ( !base_class::poll_state( nCookie ))
+                synchronize();
         }
 
         //@cond
@@ -205,6 +234,19 @@ namespace cds { namespace urcu {
     class general_instant_stripped: public general_instant<>
     {};
 
+    /// General-purpose RCU with immediate reclamation in independent domain \p Domain
+    /**
+        @headerfile cds/urcu/general_instant.h
+
+        See \ref cds_urcu_domain "RCU domains".
+    */
+    template <
+        class Domain
+        ,class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+    >
+    using general_instant_domain = general_instant< Lock, Backoff, domain_tag< general_instant_tag, Domain >>;
+
 }} // namespace cds::urcu
 
 #endif // #ifndef CDSLIB_URCU_DETAILS_GPI_H
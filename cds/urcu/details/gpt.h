@@ -77,17 +77,20 @@ namespace cds { namespace urcu {
         - \p DisposerThread - the reclamation thread class. Default is \ref cds::urcu::dispose_thread,
             see the description of this class for required interface.
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Tag - RCU tag, \p general_threaded_tag or \ref domain_tag "domain_tag< general_threaded_tag, Domain >"
+            for an independent \ref cds_urcu_domain "RCU domain", see also \p general_threaded_domain
     */
     template <
         class Buffer = cds::container::VyukovMPSCCycleQueue< epoch_retired_ptr >
         ,class Lock = std::mutex
         ,class DisposerThread = dispose_thread<Buffer>
         ,class Backoff = cds::backoff::Default
+        ,class Tag = general_threaded_tag
     >
-    class general_threaded: public details::gp_singleton< general_threaded_tag >
+    class general_threaded: public details::gp_singleton< Tag >
     {
         //@cond
-        typedef details::gp_singleton< general_threaded_tag > base_class;
+        typedef details::gp_singleton< Tag > base_class;
         //@endcond
     public:
         typedef Buffer          buffer_type ;   ///< Buffer type
@@ -95,8 +98,8 @@ namespace cds { namespace urcu {
         typedef Backoff         back_off    ;   ///< Back-off scheme
         typedef DisposerThread  disposer_thread ;   ///< Disposer thread type
 
-        typedef general_threaded_tag    rcu_tag ;       ///< Thread-side RCU part
-        typedef base_class::thread_gc   thread_gc ;     ///< Access lock class
+        typedef Tag             rcu_tag ;       ///< Thread-side RCU part
+        typedef typename base_class::thread_gc   thread_gc ;     ///< Access lock class
         typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
 
         //@cond
@@ -144,10 +147,10 @@ namespace cds { namespace urcu {
             , m_nCapacity( nBufferCapacity )
         {}
 
-        void flip_and_wait()
+        void wait_grace_period()
         {
             back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            base_class::wait_grace_period( bkoff );
         }
 
         // Return: true - synchronize has been called, false - otherwise
@@ -244,14 +247,39 @@ namespace cds { namespace urcu {
             synchronize( false );
         }
 
+        /// Waits to finish a grace period with minimal latency and calls disposing thread
+        /**
+            The function does not sleep on the slowest reader: it spins briefly and then yields
+            while re-checking the readers found in the critical section.
+        */
+        void synchronize_expedited()
+        {
+            uint64_t nPrevEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_release );
+            {
+                std::unique_lock<lock_type> sl( m_Lock );
+                base_class::expedited_grace_period();
+            }
+            m_DisposerThread.dispose( m_Buffer, nPrevEpoch, false );
+        }
+
+        /// Waits for a grace period only if the grace period for \p nCookie has not elapsed yet
+        /**
+            \p nCookie is a value returned by \p get_state(). If \p poll_state( nCookie ) is \p true
+            the function returns immediately.
+        */
+        void cond_synchronize( uint64_t nCookie )
+        {
+            if ( !base_class::poll_state( nCookie ))
+                synchronize();
+        }
+
         //@cond
         void synchronize( bool bSync )
         {
             uint64_t nPrevEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_release );
             {
                 std::unique_lock<lock_type> sl( m_Lock );
-                flip_and_wait();
-                flip_and_wait();
+                wait_grace_period();
             }
             m_DisposerThread.dispose( m_Buffer, nPrevEpoch, bSync );
         }
@@ -279,6 +307,21 @@ namespace cds { namespace urcu {
     class general_threaded_stripped: public general_threaded<>
     {};
 
+    /// General-purpose RCU with deferred threaded reclamation in independent domain \p Domain
+    /**
+        @headerfile cds/urcu/general_threaded.h
+
+        See \ref cds_urcu_domain "RCU domains".
+    */
+    template <
+        class Domain
+        ,class Buffer = cds::container::VyukovMPSCCycleQueue< epoch_retired_ptr >
+        ,class Lock = std::mutex
+        ,class DisposerThread = dispose_thread<Buffer>
+        ,class Backoff = cds::backoff::Default
+    >
+    using general_threaded_domain = general_threaded< Buffer, Lock, DisposerThread, Backoff, domain_tag< general_threaded_tag, Domain >>;
+
 }} // namespace cds::urcu
 
 #endif // #ifndef CDSLIB_URCU_DETAILS_GPT_H
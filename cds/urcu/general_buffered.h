@@ -45,22 +45,25 @@ namespace cds { namespace urcu {
             Default is \p cds::container::VyukovMPMCCycleQueue< retired_ptr >
         - \p Lock - mutex type, default is \p std::mutex
         - \p Backoff - back-off schema, default is \p cds::backoff::Default
+        - \p Tag - RCU tag, default is \p general_buffered_tag, see \ref cds_urcu_domain "RCU domains"
     */
     template <
 #ifdef CDS_DOXGEN_INVOKED
         class Buffer = cds::container::VyukovMPMCCycleQueue< retired_ptr >
         ,class Lock = std::mutex
         ,class Backoff = cds::backoff::Default
+        ,class Tag = general_buffered_tag
 #else
         class Buffer
        ,class Lock
        ,class Backoff
+       ,class Tag
 #endif
     >
-    class gc< general_buffered< Buffer, Lock, Backoff > >: public details::gc_common
+    class gc< general_buffered< Buffer, Lock, Backoff, Tag > >: public details::gc_common
     {
     public:
-        typedef general_buffered< Buffer, Lock, Backoff >  rcu_implementation   ;    ///< Wrapped URCU implementation
+        typedef general_buffered< Buffer, Lock, Backoff, Tag >  rcu_implementation   ;    ///< Wrapped URCU implementation
 
         typedef typename rcu_implementation::rcu_tag     rcu_tag     ;   ///< URCU tag
         typedef typename rcu_implementation::thread_gc   thread_gc   ;   ///< Thread-side RCU part
@@ -70,9 +73,13 @@ namespace cds { namespace urcu {
 
     public:
         /// Creates URCU \p %general_buffered singleton.
-        gc( size_t nBufferCapacity = 256 )
+        /**
+            Nonzero \p nBatchSize turns on the batching mode with per-thread callback lists,
+            see \p general_buffered.
+        */
+        gc( size_t nBufferCapacity = 256, size_t nBatchSize = 0 )
         {
-            rcu_implementation::Construct( nBufferCapacity );
+            rcu_implementation::Construct( nBufferCapacity, nBatchSize );
         }
 
         /// Destroys URCU \p %general_instant singleton
@@ -92,6 +99,47 @@ namespace cds { namespace urcu {
             rcu_implementation::instance()->synchronize();
         }
 
+        /// Waits to finish a grace period with minimal latency
+        /**
+            Use this function on latency-sensitive paths instead of \ref synchronize:
+            the waiting thread spins briefly and then yields instead of the long back-off.
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Returns a cookie for polled grace period
+        /**
+            The grace period for the cookie is elapsed when all read-side critical sections
+            that were started before the call have ended. Typical usage:
+            \code
+            // unlink the item from the data structure
+            uint64_t cookie = rcu::get_state();
+            // ... do something else
+            if ( rcu::poll_state( cookie ))
+                delete pItem;   // no reader can see the item
+            else
+                rcu::retire_ptr( pItem, free_func );
+            \endcode
+        */
+        static uint64_t get_state()
+        {
+            return rcu_implementation::instance()->get_state();
+        }
+
+        /// Checks if the grace period for \p nCookie returned by \ref get_state has elapsed
+        static bool poll_state( uint64_t nCookie )
+        {
+            return rcu_implementation::instance()->poll_state( nCookie );
+        }
+
+        /// Waits for the grace period for \p nCookie only if it has not elapsed yet
+        static void cond_synchronize( uint64_t nCookie )
+        {
+            rcu_implementation::instance()->cond_synchronize( nCookie );
+        }
+
         /// Places retired pointer <\p p, \p pFunc> to internal buffer
         /**
             If the buffer is full, \ref synchronize function is invoked.
@@ -160,6 +208,12 @@ namespace cds { namespace urcu {
             return rcu_implementation::instance()->capacity();
         }
 
+        /// Returns the size of per-thread callback list, 0 if the batching mode is off
+        static size_t batch_size()
+        {
+            return rcu_implementation::instance()->batch_size();
+        }
+
         /// Checks if the thread is inside read-side critical section (i.e. the lock is acquired)
         /**
             Usually, this function is used internally to be convinced
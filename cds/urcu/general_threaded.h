@@ -47,7 +47,7 @@ namespace cds { namespace urcu {
         - \p DisposerThread - reclamation thread class, default is \p cds::urcu::dispose_thread
             See \ref cds::urcu::dispose_thread for class interface.
         - \p Backoff - back-off schema, default is \p cds::backoff::Default
-
+        - \p Tag - RCU tag, default is \p general_threaded_tag, see \ref cds_urcu_domain "RCU domains"
     */
     template <
 #ifdef CDS_DOXGEN_INVOKED
@@ -55,17 +55,19 @@ namespace cds { namespace urcu {
         ,class Lock = std::mutex
         ,class DisposerThread = dispose_thread<Buffer>
         ,class Backoff = cds::backoff::Default
+        ,class Tag = general_threaded_tag
 #else
         class Buffer
        ,class Lock
        ,class DisposerThread
        ,class Backoff
+       ,class Tag
 #endif
     >
-    class gc< general_threaded< Buffer, Lock, DisposerThread, Backoff > >: public details::gc_common
+    class gc< general_threaded< Buffer, Lock, DisposerThread, Backoff, Tag > >: public details::gc_common
     {
     public:
-        typedef general_threaded< Buffer, Lock, DisposerThread, Backoff >  rcu_implementation   ;    ///< Wrapped URCU implementation
+        typedef general_threaded< Buffer, Lock, DisposerThread, Backoff, Tag >  rcu_implementation   ;    ///< Wrapped URCU implementation
 
         typedef typename rcu_implementation::rcu_tag     rcu_tag     ;   ///< URCU tag
         typedef typename rcu_implementation::thread_gc   thread_gc   ;   ///< Thread-side RCU part
@@ -98,6 +100,47 @@ namespace cds { namespace urcu {
             rcu_implementation::instance()->synchronize();
         }
 
+        /// Waits to finish a grace period with minimal latency
+        /**
+            Use this function on latency-sensitive paths instead of \ref synchronize:
+            the waiting thread spins briefly and then yields instead of the long back-off.
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Returns a cookie for polled grace period
+        /**
+            The grace period for the cookie is elapsed when all read-side critical sections
+            that were started before the call have ended. Typical usage:
+            \code
+            // unlink the item from the data structure
+            uint64_t cookie = rcu::get_state();
+            // ... do something else
+            if ( rcu::poll_state( cookie ))
+                delete pItem;   // no reader can see the item
+            else
+                rcu::retire_ptr( pItem, free_func );
+            \endcode
+        */
+        static uint64_t get_state()
+        {
+            return rcu_implementation::instance()->get_state();
+        }
+
+        /// Checks if the grace period for \p nCookie returned by \ref get_state has elapsed
+        static bool poll_state( uint64_t nCookie )
+        {
+            return rcu_implementation::instance()->poll_state( nCookie );
+        }
+
+        /// Waits for the grace period for \p nCookie only if it has not elapsed yet
+        static void cond_synchronize( uint64_t nCookie )
+        {
+            rcu_implementation::instance()->cond_synchronize( nCookie );
+        }
+
         /// Retires pointer \p p by the disposer \p pFunc
         /**
             If the buffer is full, \ref synchronize function is invoked.
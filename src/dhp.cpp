@@ -54,31 +54,19 @@ namespace cds { namespace gc { namespace dhp {
         void* ( *s_alloc_memory )( size_t size ) = default_alloc_memory;
         void( *s_free_memory )( void* p ) = default_free_memory;
 
-        template <typename T>
-        class allocator
-        {
-        public:
-            typedef T   value_type;
-
-            allocator() {}
-            allocator( allocator const& ) {}
-            template <class U>
-            explicit allocator( allocator<U> const& ) {}
-
-            static T* allocate( size_t nCount )
-            {
-                return reinterpret_cast<T*>( s_alloc_memory( sizeof( value_type ) * nCount ));
-            }
-
-            static void deallocate( T* p, size_t /*nCount*/ )
-            {
-                s_free_memory( reinterpret_cast<void*>( p ));
-            }
-        };
-
         stat s_postmortem_stat;
     } // namespace
 
+    CDS_EXPORT_API void* alloc_memory( size_t size )
+    {
+        return s_alloc_memory( size );
+    }
+
+    CDS_EXPORT_API void free_memory( void* p )
+    {
+        s_free_memory( p );
+    }
+
     /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
     thread_local thread_data* tls_ = nullptr;
 
@@ -31,15 +31,109 @@
 #include <cds/threading/details/_common.h>
 #include <cds/gc/hp.h>
 #include <cds/gc/dhp.h>
+#include <cds/os/topology.h>
+#include <mutex>
+#include <vector>
+#include <algorithm>
 
 namespace cds { namespace threading {
 
     CDS_EXPORT_API atomics::atomic<size_t> ThreadData::s_nLastUsedProcNo( 0 );
     CDS_EXPORT_API size_t ThreadData::s_nProcCount = 1;
 
+    namespace {
+        // Thread slot id allocator
+        struct slot_registry {
+            std::mutex          lock;
+            std::vector<size_t> free_list;
+            size_t              next_id;
+
+            slot_registry()
+                : next_id( 0 )
+            {}
+
+            static slot_registry& instance()
+            {
+                static slot_registry s_registry;
+                return s_registry;
+            }
+        };
+    } // namespace
+
+    CDS_EXPORT_API size_t ThreadData::alloc_slot()
+    {
+        slot_registry& reg = slot_registry::instance();
+        std::lock_guard<std::mutex> l( reg.lock );
+        if ( reg.free_list.empty())
+            return reg.next_id++;
+
+        size_t nSlot = reg.free_list.back();
+        reg.free_list.pop_back();
+        return nSlot;
+    }
+
+    CDS_EXPORT_API void ThreadData::free_slot( size_t nSlot )
+    {
+        slot_registry& reg = slot_registry::instance();
+        std::lock_guard<std::mutex> l( reg.lock );
+        reg.free_list.push_back( nSlot );
+    }
+
+    CDS_EXPORT_API void ThreadData::set_slot( size_t nSlot, thread_slot_owner * pOwner, void * pData )
+    {
+        assert( pOwner );
+
+        if ( nSlot >= m_nSlotCount ) {
+            if ( !pData )
+                return;
+
+            size_t const nNewCount = std::max( nSlot + 1, std::max( m_nSlotCount * 2, static_cast<size_t>( 8 )));
+            thread_slot_entry * pSlots = new thread_slot_entry[nNewCount];
+            std::copy( m_pSlots, m_pSlots + m_nSlotCount, pSlots );
+            std::fill( pSlots + m_nSlotCount, pSlots + nNewCount, thread_slot_entry{ nullptr, nullptr } );
+            delete[] m_pSlots;
+            m_pSlots = pSlots;
+            m_nSlotCount = nNewCount;
+        }
+
+        thread_slot_entry& slot = m_pSlots[nSlot];
+        if ( slot.pOwner != pOwner ) {
+            // The slot is empty or is occupied by a stale owner with the same slot id
+            if ( slot.pOwner )
+                slot.pOwner->release();
+            if ( pData )
+                pOwner->add_ref();
+            slot.pOwner = pData ? pOwner : nullptr;
+        }
+        else if ( !pData ) {
+            pOwner->release();
+            slot.pOwner = nullptr;
+        }
+        slot.pData = pData;
+    }
+
+    void ThreadData::clear_slots()
+    {
+        for ( size_t i = 0; i < m_nSlotCount; ++i ) {
+            thread_slot_entry& slot = m_pSlots[i];
+            if ( slot.pOwner ) {
+                if ( slot.pData )
+                    slot.pOwner->cleanup_if_alive( slot.pData );
+                slot.pOwner->release();
+            }
+        }
+        delete[] m_pSlots;
+        m_pSlots = nullptr;
+        m_nSlotCount = 0;
+    }
+
     CDS_EXPORT_API void ThreadData::init()
     {
         if ( m_nAttachCount++ == 0 ) {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            m_pCurrentCpu = cds::OS::topology::attach_thread();
+#endif
+
             if ( cds::gc::HP::isUsed() )
                 cds::gc::hp::smr::attach_thread();
             if ( cds::gc::DHP::isUsed() )
@@ -61,6 +155,9 @@ namespace cds { namespace threading {
     CDS_EXPORT_API bool ThreadData::fini()
     {
         if ( --m_nAttachCount == 0 ) {
+            // Thread slots are cleaned up first since the slot data may use GC
+            clear_slots();
+
             if ( cds::gc::DHP::isUsed() )
                 cds::gc::dhp::smr::detach_thread();
             if ( cds::gc::HP::isUsed() )
@@ -84,6 +181,11 @@ namespace cds { namespace threading {
                 m_pSHBRCU = nullptr;
             }
 #endif
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            m_pCurrentCpu = nullptr;
+            cds::OS::topology::detach_thread();
+#endif
             return true;
         }
         return false;
@@ -33,6 +33,22 @@
 #if CDS_OS_TYPE == CDS_OS_LINUX
 
 #include <thread>
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#ifdef CDS_LINUX_RSEQ_ENABLED
+#   if defined(__GLIBC__) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 35 ))
+#       include <sys/rseq.h>
+#       if defined(__has_builtin)
+#           if __has_builtin(__builtin_thread_pointer)
+#               define CDS_LINUX_GLIBC_RSEQ
+#           endif
+#       endif
+#   endif
+#endif
 /*
 #include <unistd.h>
 #include <fstream>
@@ -41,10 +57,112 @@
 namespace cds { namespace OS { CDS_CXX11_INLINE_NAMESPACE namespace Linux {
 
     unsigned int topology::s_nProcessorCount = 0;
+    unsigned int topology::s_nNodeCount = 1;
+    unsigned int * topology::s_arrCpuNode = nullptr;
+    unsigned int topology::s_nCpuNodeSize = 0;
+
+    namespace {
+        unsigned int discover_node_count()
+        {
+            // The file contains a node list like "0" or "0-3"
+            unsigned int nNodeCount = 1;
+            FILE * f = std::fopen( "/sys/devices/system/node/possible", "r" );
+            if ( f ) {
+                unsigned int nFirst;
+                unsigned int nLast;
+                int n = std::fscanf( f, "%u-%u", &nFirst, &nLast );
+                if ( n == 2 )
+                    nNodeCount = nLast + 1;
+                else if ( n == 1 )
+                    nNodeCount = nFirst + 1;
+                std::fclose( f );
+            }
+            return nNodeCount;
+        }
+
+        // Reads a processor list like "0-3,8-11" and calls f( nProcessor ) for each processor of the list
+        template <typename Func>
+        void read_cpu_list( char const * pszFileName, Func f )
+        {
+            FILE * fp = std::fopen( pszFileName, "r" );
+            if ( !fp )
+                return;
+
+            unsigned int nFirst;
+            while ( std::fscanf( fp, "%u", &nFirst ) == 1 ) {
+                unsigned int nLast = nFirst;
+                int ch = std::fgetc( fp );
+                if ( ch == '-' ) {
+                    if ( std::fscanf( fp, "%u", &nLast ) != 1 )
+                        break;
+                    ch = std::fgetc( fp );
+                }
+                for ( unsigned int i = nFirst; i <= nLast; ++i )
+                    f( i );
+                if ( ch != ',' )
+                    break;
+            }
+            std::fclose( fp );
+        }
+
+#ifdef CDS_LINUX_RSEQ_ENABLED
+        // rseq ABI (linux/rseq.h), only the fields of the original 32-byte area are used
+        struct CDS_DATA_ALIGNMENT(32) rseq_area {
+            uint32_t    cpu_id_start;
+            uint32_t    cpu_id;
+            uint64_t    rseq_cs;
+            uint32_t    flags;
+            uint32_t    pad_[3];
+        };
+        static_assert( sizeof( rseq_area ) == 32, "Invalid rseq_area size" );
+
+        // libcds does not use rseq critical sections, so the signature is never checked by the kernel
+        static uint32_t const c_nRseqSignature = 0x53053053;
+        static int const c_nRseqFlagUnregister = 1;
+
+        // The rseq area registered by libcds for the current thread
+        thread_local rseq_area s_Rseq;
+        thread_local bool s_bRseqRegistered = false;
+
+        int32_t const volatile * glibc_rseq_cpu_id()
+        {
+#   ifdef CDS_LINUX_GLIBC_RSEQ
+            if ( __rseq_size > 0 ) {
+                char * pArea = static_cast<char *>( __builtin_thread_pointer()) + __rseq_offset;
+                return reinterpret_cast<int32_t const volatile *>( pArea + offsetof( struct rseq, cpu_id ));
+            }
+#   endif
+            return nullptr;
+        }
+#endif
+    } // namespace
 
     void topology::init()
     {
         s_nProcessorCount = std::thread::hardware_concurrency();
+        s_nNodeCount = discover_node_count();
+
+        if ( s_nNodeCount > 1 ) {
+            // Build processor -> node table for current_node()
+            std::vector< std::pair<unsigned int, unsigned int>> cpuNodes;
+            unsigned int nMaxCpu = 0;
+            for ( unsigned int nNode = 0; nNode < s_nNodeCount; ++nNode ) {
+                char szFileName[64];
+                std::snprintf( szFileName, sizeof( szFileName ), "/sys/devices/system/node/node%u/cpulist", nNode );
+                read_cpu_list( szFileName, [&cpuNodes, &nMaxCpu, nNode]( unsigned int nCpu ) {
+                    cpuNodes.emplace_back( nCpu, nNode );
+                    nMaxCpu = std::max( nMaxCpu, nCpu );
+                });
+            }
+
+            if ( !cpuNodes.empty()) {
+                s_nCpuNodeSize = nMaxCpu + 1;
+                s_arrCpuNode = new unsigned int[s_nCpuNodeSize];
+                std::fill( s_arrCpuNode, s_arrCpuNode + s_nCpuNodeSize, 0u );
+                for ( auto const& cn : cpuNodes )
+                    s_arrCpuNode[cn.first] = cn.second;
+            }
+        }
 /*
          long n = ::sysconf( _SC_NPROCESSORS_ONLN );
          if ( n > 0 )
@@ -73,7 +191,44 @@ namespace cds { namespace OS { CDS_CXX11_INLINE_NAMESPACE namespace Linux {
     }
 
     void topology::fini()
-    {}
+    {
+        delete[] s_arrCpuNode;
+        s_arrCpuNode = nullptr;
+        s_nCpuNodeSize = 0;
+    }
+
+    int32_t const volatile * topology::attach_thread()
+    {
+#ifdef CDS_LINUX_RSEQ_ENABLED
+        // glibc 2.35+ registers rseq area for each thread, the thread can have only one area
+        int32_t const volatile * pCpu = glibc_rseq_cpu_id();
+        if ( pCpu )
+            return pCpu;
+
+        if ( !s_bRseqRegistered ) {
+            s_Rseq.cpu_id_start = 0;
+            s_Rseq.cpu_id = static_cast<uint32_t>( -1 );
+            s_Rseq.rseq_cs = 0;
+            s_Rseq.flags = 0;
+            if ( ::syscall( SYS_rseq, &s_Rseq, sizeof( s_Rseq ), 0, c_nRseqSignature ) != 0 )
+                return nullptr;     // ENOSYS - old kernel, EBUSY - the area is registered by someone else
+            s_bRseqRegistered = true;
+        }
+        return reinterpret_cast<int32_t const volatile *>( &s_Rseq.cpu_id );
+#else
+        return nullptr;
+#endif
+    }
+
+    void topology::detach_thread()
+    {
+#ifdef CDS_LINUX_RSEQ_ENABLED
+        if ( s_bRseqRegistered ) {
+            ::syscall( SYS_rseq, &s_Rseq, sizeof( s_Rseq ), c_nRseqFlagUnregister, c_nRseqSignature );
+            s_bRseqRegistered = false;
+        }
+#endif
+    }
 }}} // namespace cds::OS::Linux
 
 #endif  // #if CDS_OS_TYPE == CDS_OS_LINUX
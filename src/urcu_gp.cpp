@@ -30,10 +30,66 @@
 
 #include <cds/urcu/details/gp.h>
 
+#if CDS_OS_TYPE == CDS_OS_LINUX && !defined(CDS_URCU_NO_MEMBARRIER)
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   ifdef SYS_membarrier
+#       define CDS_URCU_MEMBARRIER_ENABLED
+#   endif
+#endif
+
 namespace cds { namespace urcu { namespace details {
 
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_instant_tag >::s_pRCU = nullptr;
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_buffered_tag >::s_pRCU = nullptr;
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_threaded_tag >::s_pRCU = nullptr;
 
+    CDS_EXPORT_API bool gp_membarrier::s_bEnabled = false;
+
+    namespace {
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        // From linux/membarrier.h
+        static int const c_nMembarrierCmdQuery = 0;
+        static int const c_nMembarrierCmdPrivateExpedited = 1 << 3;
+        static int const c_nMembarrierCmdRegisterPrivateExpedited = 1 << 4;
+
+        int sys_membarrier( int cmd )
+        {
+            return static_cast<int>( ::syscall( SYS_membarrier, cmd, 0 ));
+        }
+#endif
+
+        bool register_membarrier()
+        {
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+            int const nCmds = sys_membarrier( c_nMembarrierCmdQuery );
+            return nCmds > 0
+                && ( nCmds & c_nMembarrierCmdPrivateExpedited )
+                && ( nCmds & c_nMembarrierCmdRegisterPrivateExpedited )
+                && sys_membarrier( c_nMembarrierCmdRegisterPrivateExpedited ) == 0;
+#else
+            return false;
+#endif
+        }
+    } // namespace
+
+    CDS_EXPORT_API bool gp_membarrier::init()
+    {
+        // Thread-safe one-time initialization
+        static bool const s_bRegistered = register_membarrier();
+        s_bEnabled = s_bRegistered;
+        return s_bEnabled;
+    }
+
+    CDS_EXPORT_API void gp_membarrier::master_barrier()
+    {
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        if ( s_bEnabled ) {
+            CDS_VERIFY( sys_membarrier( c_nMembarrierCmdPrivateExpedited ) == 0 );
+            return;
+        }
+#endif
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+    }
+
 }}} // namespace cds::urcu::details
@@ -56,7 +56,8 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_nPassiveWaitWakeup )
             << CDSSTRESS_STAT_OUT( s, m_nInvokeExclusive )
             << CDSSTRESS_STAT_OUT( s, m_nWakeupByNotifying )
-            << CDSSTRESS_STAT_OUT( s, m_nPassiveToCombiner );
+            << CDSSTRESS_STAT_OUT( s, m_nPassiveToCombiner )
+            << CDSSTRESS_STAT_OUT( s, m_nGlobalCombiningCount );
     }
 
 } // namespace cds_test
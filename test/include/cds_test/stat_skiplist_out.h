@@ -83,7 +83,9 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_nEraseWhileFind )
             << CDSSTRESS_STAT_OUT( s, m_nExtractWhileFind )
             << CDSSTRESS_STAT_OUT( s, m_nMarkFailed )
-            << CDSSTRESS_STAT_OUT( s, m_nEraseContention );
+            << CDSSTRESS_STAT_OUT( s, m_nEraseContention )
+            << CDSSTRESS_STAT_OUT( s, m_nHintHit )
+            << CDSSTRESS_STAT_OUT( s, m_nHintMiss );
     }
 
 } // namespace cds_test
@@ -40,7 +40,8 @@ namespace cds_test {
         return o;
     }
 
-    static inline property_stream& operator <<( property_stream& o, cds::intrusive::split_list::stat<> const& s )
+    template <typename Counter>
+    static inline property_stream& operator <<( property_stream& o, cds::intrusive::split_list::stat<Counter> const& s )
     {
         return o
             << CDSSTRESS_STAT_OUT( s, m_nInsertSuccess )
@@ -71,3 +71,32 @@ namespace cds_test {
 
 } // namespace cds_test
 #endif
+
+#if defined(CDSLIB_SYNC_COMPACT_MONITOR_H) && !defined(CDSUNIT_PRINT_COMPACT_MONITOR_STAT_H)
+#define CDSUNIT_PRINT_COMPACT_MONITOR_STAT_H
+
+#include <cds_test/stress_test.h>
+
+namespace cds_test {
+    static inline property_stream& operator <<( property_stream& o, cds::sync::compact_monitor_traits::empty_stat const& /*s*/ )
+    {
+        return o;
+    }
+
+#   define CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, field ) CDSSTRESS_STAT_OUT_( "compact_monitor." #field, s.field.get())
+
+    static inline property_stream& operator <<( property_stream& o, cds::sync::compact_monitor_traits::stat<> const& s )
+    {
+        return o
+            << CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, m_nLockCount )
+            << CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, m_nUnlockCount )
+            << CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, m_nLockContention )
+            << CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, m_nUnlockContention )
+            << CDSSTRESS_COMPACTMONITOR_STAT_OUT( s, m_nParkCount );
+    }
+
+#   undef CDSSTRESS_COMPACTMONITOR_STAT_OUT
+
+} // namespace cds_test
+#endif
+
@@ -0,0 +1,240 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/stress_test.h>
+
+#include <cds/container/chase_lev_deque.h>
+#include <cds/gc/hp.h>
+#include <cds/gc/dhp.h>
+
+#include <vector>
+
+// Work-stealing test for Chase-Lev deque: each thread owns a deque,
+// pushes/pops its own items and steals from random victims when its deque is empty
+namespace {
+
+    static size_t s_nThreadCount = 8;
+    static size_t s_nItemCount = 1000000;   // total item count
+    static size_t s_nInitialCapacity = 16;
+
+    namespace cc = cds::container;
+
+    class deque_steal: public cds_test::stress_fixture
+    {
+    protected:
+        typedef size_t value_type;
+
+        template <class Deque>
+        class Worker: public cds_test::thread
+        {
+            typedef cds_test::thread base_class;
+
+        public:
+            Worker( cds_test::thread_pool& pool, std::vector< std::unique_ptr<Deque>>& deques, atomics::atomic<size_t>& nConsumed, bool bStealHalf )
+                : base_class( pool )
+                , m_Deques( deques )
+                , m_nConsumed( nConsumed )
+                , m_bStealHalf( bStealHalf )
+                , m_arr( new uint8_t[ s_nItemCount ])
+            {}
+
+            Worker( Worker& src )
+                : base_class( src )
+                , m_Deques( src.m_Deques )
+                , m_nConsumed( src.m_nConsumed )
+                , m_bStealHalf( src.m_bStealHalf )
+                , m_arr( new uint8_t[ s_nItemCount ])
+            {}
+
+            virtual thread * clone()
+            {
+                return new Worker( *this );
+            }
+
+            virtual void test()
+            {
+                memset( m_arr.get(), 0, sizeof( m_arr[0] ) * s_nItemCount );
+
+                Deque& myDeque = *m_Deques[ id() ];
+                size_t const nThreadCount = m_Deques.size();
+                size_t const nPerThread = s_nItemCount / nThreadCount;
+                size_t nItem = id() * nPerThread;
+                size_t const nLast = id() + 1 == nThreadCount ? s_nItemCount : nItem + nPerThread;
+
+                value_type v;
+
+                // Producing phase: the owner pushes its items and pops a part of them
+                while ( nItem < nLast ) {
+                    myDeque.push_bottom( nItem++ );
+                    if ( ( nItem & 3 ) == 0 && myDeque.pop_bottom( v ))
+                        consume( v );
+                }
+
+                // Consuming phase: pop own items, steal others' items if the deque is empty
+                while ( m_nConsumed.load( atomics::memory_order_acquire ) < s_nItemCount ) {
+                    if ( myDeque.pop_bottom( v )) {
+                        consume( v );
+                        continue;
+                    }
+
+                    Deque& victim = *m_Deques[ rand( static_cast<unsigned int>( nThreadCount )) ];
+                    if ( &victim == &myDeque )
+                        continue;
+
+                    if ( m_bStealHalf ) {
+                        size_t n = victim.steal_half( [&myDeque]( value_type val ) { myDeque.push_bottom( val ); } );
+                        if ( n )
+                            ++m_nStealHalfSuccess;
+                        else
+                            ++m_nStealFailed;
+                        m_nStolen += n;
+                    }
+                    else if ( victim.steal( v )) {
+                        ++m_nStolen;
+                        consume( v );
+                    }
+                    else
+                        ++m_nStealFailed;
+                }
+            }
+
+        private:
+            void consume( value_type v )
+            {
+                if ( v < s_nItemCount )
+                    ++m_arr[v];
+                else
+                    ++m_nBadValue;
+                ++m_nPopCount;
+                m_nConsumed.fetch_add( 1, atomics::memory_order_release );
+            }
+
+        public:
+            std::vector< std::unique_ptr<Deque>>& m_Deques;
+            atomics::atomic<size_t>& m_nConsumed;
+            bool const          m_bStealHalf;
+            std::unique_ptr< uint8_t[] > m_arr;
+            size_t              m_nPopCount = 0;
+            size_t              m_nStolen = 0;
+            size_t              m_nStealFailed = 0;
+            size_t              m_nStealHalfSuccess = 0;
+            size_t              m_nBadValue = 0;
+        };
+
+    public:
+        static void SetUpTestCase()
+        {
+            cds_test::config const& cfg = get_config( "deque_steal" );
+
+            s_nThreadCount = cfg.get_size_t( "ThreadCount", s_nThreadCount );
+            s_nItemCount = cfg.get_size_t( "ItemCount", s_nItemCount );
+            s_nInitialCapacity = cfg.get_size_t( "InitialCapacity", s_nInitialCapacity );
+
+            if ( s_nThreadCount < 2 )
+                s_nThreadCount = 2;
+            if ( s_nItemCount < s_nThreadCount )
+                s_nItemCount = s_nThreadCount * 1000;
+            if ( s_nInitialCapacity == 0 )
+                s_nInitialCapacity = 2;
+        }
+
+    protected:
+        template <class Deque>
+        void test( bool bStealHalf )
+        {
+            cds_test::thread_pool& pool = get_pool();
+
+            std::vector< std::unique_ptr<Deque>> deques;
+            for ( size_t i = 0; i < s_nThreadCount; ++i )
+                deques.emplace_back( new Deque( s_nInitialCapacity ));
+            atomics::atomic<size_t> nConsumed( 0 );
+
+            pool.add( new Worker<Deque>( pool, deques, nConsumed, bStealHalf ), s_nThreadCount );
+
+            propout() << std::make_pair( "thread_count", s_nThreadCount )
+                << std::make_pair( "item_count", s_nItemCount )
+                << std::make_pair( "initial_capacity", s_nInitialCapacity )
+                << std::make_pair( "steal_half", bStealHalf );
+
+            std::chrono::milliseconds duration = pool.run();
+
+            propout() << std::make_pair( "duration", duration );
+
+            // analyze result
+            std::unique_ptr< uint8_t[] > arr( new uint8_t[ s_nItemCount ] );
+            memset( arr.get(), 0, sizeof( arr[0] ) * s_nItemCount );
+
+            size_t nTotalPops = 0;
+            size_t nStolen = 0;
+            size_t nStealFailed = 0;
+            size_t nStealHalfSuccess = 0;
+            for ( size_t i = 0; i < pool.size(); ++i ) {
+                Worker<Deque>& w = static_cast<Worker<Deque>&>( pool.get( i ));
+                EXPECT_EQ( w.m_nBadValue, 0u ) << "thread " << i;
+                for ( size_t k = 0; k < s_nItemCount; ++k )
+                    arr[k] += w.m_arr[k];
+                nTotalPops += w.m_nPopCount;
+                nStolen += w.m_nStolen;
+                nStealFailed += w.m_nStealFailed;
+                nStealHalfSuccess += w.m_nStealHalfSuccess;
+            }
+
+            propout() << std::make_pair( "stolen_count", nStolen )
+                << std::make_pair( "steal_failed", nStealFailed )
+                << std::make_pair( "steal_half_success", nStealHalfSuccess );
+
+            EXPECT_EQ( nTotalPops, s_nItemCount );
+            for ( size_t k = 0; k < s_nItemCount; ++k )
+                ASSERT_EQ( arr[k], 1 ) << "item=" << k;
+            for ( auto& dq : deques )
+                EXPECT_TRUE( dq->empty());
+
+            pool.clear();
+        }
+    };
+
+#define CDSSTRESS_ChaseLevDeque_F( gc_type, gc_name ) \
+    TEST_F( deque_steal, ChaseLevDeque_##gc_name ) \
+    { \
+        typedef cc::ChaseLevDeque< gc_type, value_type > deque_type; \
+        test< deque_type >( false ); \
+    } \
+    TEST_F( deque_steal, ChaseLevDeque_##gc_name##_steal_half ) \
+    { \
+        typedef cc::ChaseLevDeque< gc_type, value_type > deque_type; \
+        test< deque_type >( true ); \
+    }
+
+    CDSSTRESS_ChaseLevDeque_F( cds::gc::HP, HP )
+    CDSSTRESS_ChaseLevDeque_F( cds::gc::DHP, DHP )
+
+#undef CDSSTRESS_ChaseLevDeque_F
+
+} // namespace
@@ -32,6 +32,7 @@
 
 #include <cds/intrusive/free_list.h>
 #include <cds/intrusive/free_list_cached.h>
+#include <cds/intrusive/free_list_magazine.h>
 #ifdef CDS_DCAS_SUPPORT
 #   include <cds/intrusive/free_list_tagged.h>
 #endif
@@ -168,6 +169,9 @@ namespace {
     typedef cds::intrusive::CachedFreeList<cds::intrusive::FreeList> cached_free_list;
     CDSSTRESS_FREELIST_F( CachedFreeList, cached_free_list )
 
+    typedef cds::intrusive::MagazineFreeList<cds::intrusive::FreeList> magazine_free_list;
+    CDSSTRESS_FREELIST_F( MagazineFreeList, magazine_free_list )
+
 #ifdef CDS_DCAS_SUPPORT
     TEST_F( put_get, TaggetFreeList )
     {
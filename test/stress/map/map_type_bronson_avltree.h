@@ -35,6 +35,7 @@
 
 #include <cds/memory/vyukov_queue_pool.h>
 #include <cds/sync/pool_monitor.h>
+#include <cds/sync/compact_monitor.h>
 #include <cds/container/bronson_avltree_map_rcu.h>
 
 #include <cds_test/stat_bronson_avltree_out.h>
@@ -183,6 +184,27 @@ namespace map {
         typedef BronsonAVLTreeMap< rcu_gpt, Key, Value, BronsonAVLTreeMap_less_pool_bounded_stat > BronsonAVLTreeMap_rcu_gpt_less_pool_bounded_stat;
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef BronsonAVLTreeMap< rcu_shb, Key, Value, BronsonAVLTreeMap_less_pool_bounded_stat > BronsonAVLTreeMap_rcu_shb_less_pool_bounded_stat;
+#endif
+        struct BronsonAVLTreeMap_less_compact: public BronsonAVLTreeMap_less
+        {
+            typedef cds::sync::compact_monitor<> sync_monitor;
+        };
+        typedef BronsonAVLTreeMap< rcu_gpi, Key, Value, BronsonAVLTreeMap_less_compact > BronsonAVLTreeMap_rcu_gpi_less_compact;
+        typedef BronsonAVLTreeMap< rcu_gpb, Key, Value, BronsonAVLTreeMap_less_compact > BronsonAVLTreeMap_rcu_gpb_less_compact;
+        typedef BronsonAVLTreeMap< rcu_gpt, Key, Value, BronsonAVLTreeMap_less_compact > BronsonAVLTreeMap_rcu_gpt_less_compact;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef BronsonAVLTreeMap< rcu_shb, Key, Value, BronsonAVLTreeMap_less_compact > BronsonAVLTreeMap_rcu_shb_less_compact;
+#endif
+        struct BronsonAVLTreeMap_less_compact_stat: public BronsonAVLTreeMap_less
+        {
+            typedef cc::bronson_avltree::stat<> stat;
+            typedef cds::sync::compact_monitor< cds::opt::none, true > sync_monitor;
+        };
+        typedef BronsonAVLTreeMap< rcu_gpi, Key, Value, BronsonAVLTreeMap_less_compact_stat > BronsonAVLTreeMap_rcu_gpi_less_compact_stat;
+        typedef BronsonAVLTreeMap< rcu_gpb, Key, Value, BronsonAVLTreeMap_less_compact_stat > BronsonAVLTreeMap_rcu_gpb_less_compact_stat;
+        typedef BronsonAVLTreeMap< rcu_gpt, Key, Value, BronsonAVLTreeMap_less_compact_stat > BronsonAVLTreeMap_rcu_gpt_less_compact_stat;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef BronsonAVLTreeMap< rcu_shb, Key, Value, BronsonAVLTreeMap_less_compact_stat > BronsonAVLTreeMap_rcu_shb_less_compact_stat;
 #endif
     };
 
@@ -219,6 +241,7 @@ namespace map {
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_shb_less_pool_simple_stat,  key_type, value_type ) \
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_shb_less_pool_lazy,         key_type, value_type ) \
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_shb_less_pool_lazy_stat,    key_type, value_type ) \
+        CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_shb_less_compact_stat,      key_type, value_type ) \
 
 #else
 #   define CDSSTRESS_BronsonAVLTreeMap_SHRCU( fixture, test_case, key_type, value_type )
@@ -235,6 +258,8 @@ namespace map {
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpb_less_pool_simple_stat,  key_type, value_type ) \
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpb_less_pool_lazy,         key_type, value_type ) \
         CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpt_less_pool_lazy_stat,    key_type, value_type ) \
+        CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpi_less_compact,           key_type, value_type ) \
+        CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpt_less_compact_stat,      key_type, value_type ) \
         CDSSTRESS_BronsonAVLTreeMap_SHRCU( fixture, test_case, key_type, value_type )
 
 #else
@@ -251,6 +276,8 @@ namespace map {
     CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpt_less_pool_simple_stat,  key_type, value_type ) \
     CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpt_less_pool_lazy,         key_type, value_type ) \
     CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpb_less_pool_lazy_stat,    key_type, value_type ) \
+    CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpb_less_compact,           key_type, value_type ) \
+    CDSSTRESS_BronsonAVLTreeMap_case( fixture, test_case, BronsonAVLTreeMap_rcu_gpb_less_compact_stat,      key_type, value_type ) \
     CDSSTRESS_BronsonAVLTreeMap_1( fixture, test_case, key_type, value_type ) \
 
 }   // namespace map
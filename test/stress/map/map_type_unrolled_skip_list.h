@@ -0,0 +1,288 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSUNIT_MAP_TYPE_UNROLLED_SKIP_LIST_H
+#define CDSUNIT_MAP_TYPE_UNROLLED_SKIP_LIST_H
+
+#include "map_type.h"
+
+#include <cds/container/unrolled_skip_list_map_hp.h>
+#include <cds/container/unrolled_skip_list_map_dhp.h>
+#include <cds/container/unrolled_skip_list_map_rcu.h>
+
+#include <cds_test/stat_unrolled_skiplist_out.h>
+
+namespace map {
+
+    template <class GC, typename Key, typename T, typename Traits = cc::unrolled_skip_list::traits >
+    class UnrolledSkipListMap : public cc::UnrolledSkipListMap< GC, Key, T, Traits >
+    {
+        typedef cc::UnrolledSkipListMap< GC, Key, T, Traits > base_class;
+    public:
+        // extract_min() / extract_max() return an owning pointer instead of guarded_ptr
+        typedef typename base_class::value_ptr guarded_ptr;
+
+        template <typename Config>
+        UnrolledSkipListMap( Config const& /*cfg*/)
+            : base_class()
+        {}
+
+        std::pair<Key, bool> extract_min_key()
+        {
+            auto vp = base_class::extract_min();
+            if ( vp )
+                return std::make_pair( vp->first, true );
+            return std::make_pair( Key(), false );
+        }
+
+        std::pair<Key, bool> extract_max_key()
+        {
+            auto vp = base_class::extract_max();
+            if ( vp )
+                return std::make_pair( vp->first, true );
+            return std::make_pair( Key(), false );
+        }
+
+        // The extracted item is owned by value_ptr, so RCU need not be locked
+        static CDS_CONSTEXPR bool const c_bExtractLockExternal = false;
+
+        // for testing
+        static CDS_CONSTEXPR bool const c_bExtractSupported = true;
+        static CDS_CONSTEXPR bool const c_bLoadFactorDepended = false;
+        static CDS_CONSTEXPR bool const c_bEraseExactKey = false;
+    };
+
+    struct tag_UnrolledSkipListMap;
+
+    template <typename Key, typename Value>
+    struct map_type< tag_UnrolledSkipListMap, Key, Value >: public map_type_base< Key, Value >
+    {
+        typedef map_type_base< Key, Value >      base_class;
+        typedef typename base_class::key_compare compare;
+        typedef typename base_class::key_less    less;
+
+        class traits_UnrolledSkipListMap_less: public cc::unrolled_skip_list::make_traits <
+                co::less< less >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_hp_less;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_dhp_less;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_rcu_gpi_less;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_rcu_gpb_less;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_rcu_gpt_less;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_less > UnrolledSkipListMap_rcu_shb_less;
+#endif
+
+        class traits_UnrolledSkipListMap_less_stat: public cc::unrolled_skip_list::make_traits <
+                co::less< less >
+                ,co::stat< cc::unrolled_skip_list::stat<> >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_hp_less_stat;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_dhp_less_stat;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_rcu_gpi_less_stat;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_rcu_gpb_less_stat;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_rcu_gpt_less_stat;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_less_stat > UnrolledSkipListMap_rcu_shb_less_stat;
+#endif
+
+        class traits_UnrolledSkipListMap_cmp: public cc::unrolled_skip_list::make_traits <
+                co::compare< compare >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_hp_cmp;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_dhp_cmp;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_rcu_gpi_cmp;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_rcu_gpb_cmp;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_rcu_gpt_cmp;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_cmp > UnrolledSkipListMap_rcu_shb_cmp;
+#endif
+
+        class traits_UnrolledSkipListMap_less_chunk16_stat: public cc::unrolled_skip_list::make_traits <
+                co::less< less >
+                ,cc::unrolled_skip_list::chunk_capacity< 16 >
+                ,co::stat< cc::unrolled_skip_list::stat<> >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_hp_less_chunk16_stat;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_dhp_less_chunk16_stat;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_rcu_gpi_less_chunk16_stat;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_rcu_gpb_less_chunk16_stat;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_rcu_gpt_less_chunk16_stat;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_less_chunk16_stat > UnrolledSkipListMap_rcu_shb_less_chunk16_stat;
+#endif
+
+        class traits_UnrolledSkipListMap_less_chunk64: public cc::unrolled_skip_list::make_traits <
+                co::less< less >
+                ,cc::unrolled_skip_list::chunk_capacity< 64 >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_hp_less_chunk64;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_dhp_less_chunk64;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_rcu_gpi_less_chunk64;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_rcu_gpb_less_chunk64;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_rcu_gpt_less_chunk64;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_less_chunk64 > UnrolledSkipListMap_rcu_shb_less_chunk64;
+#endif
+
+        class traits_UnrolledSkipListMap_less_seqcst: public cc::unrolled_skip_list::make_traits <
+                co::less< less >
+                ,co::memory_model< co::v::sequential_consistent >
+                ,co::item_counter< cds::atomicity::cache_friendly_item_counter >
+            >::type
+        {};
+        typedef UnrolledSkipListMap< cds::gc::HP, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_hp_less_seqcst;
+        typedef UnrolledSkipListMap< cds::gc::DHP, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_dhp_less_seqcst;
+        typedef UnrolledSkipListMap< rcu_gpi, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_rcu_gpi_less_seqcst;
+        typedef UnrolledSkipListMap< rcu_gpb, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_rcu_gpb_less_seqcst;
+        typedef UnrolledSkipListMap< rcu_gpt, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_rcu_gpt_less_seqcst;
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+        typedef UnrolledSkipListMap< rcu_shb, Key, Value, traits_UnrolledSkipListMap_less_seqcst > UnrolledSkipListMap_rcu_shb_less_seqcst;
+#endif
+    };
+
+    template <typename GC, typename K, typename T, typename Traits >
+    static inline void print_stat( cds_test::property_stream& o, UnrolledSkipListMap< GC, K, T, Traits > const& m )
+    {
+        o << m.statistics();
+    }
+
+}   // namespace map
+
+#define CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, unrolled_map_type, key_type, value_type ) \
+    TEST_F( fixture, unrolled_map_type ) \
+    { \
+        typedef map::map_type< tag_UnrolledSkipListMap, key_type, value_type >::unrolled_map_type map_type; \
+        test_case<map_type>(); \
+    }
+
+#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL > 1
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU_2( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_less_seqcst, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU_2( fixture, test_case, key_type, value_type )
+#endif
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL == 1
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_cmp,         key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_less_chunk16_stat, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_less_chunk64, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU_1( fixture, test_case, key_type, value_type )
+#endif
+
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_less,        key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_shb_less_stat,   key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_SHRCU_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_SHRCU_2( fixture, test_case, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_UnrolledSkipListMap_SHRCU( fixture, test_case, key_type, value_type )
+#endif
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL > 1
+#   define CDSSTRESS_UnrolledSkipListMap_HP_2( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_less_seqcst,      key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_less_seqcst,     key_type, value_type ) \
+
+#   define CDSSTRESS_UnrolledSkipListMap_RCU_2( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_less_seqcst, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_less_seqcst, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpt_less_seqcst, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_UnrolledSkipListMap_HP_2( fixture, test_case, key_type, value_type )
+#   define CDSSTRESS_UnrolledSkipListMap_RCU_2( fixture, test_case, key_type, value_type )
+#endif
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL == 1
+#   define CDSSTRESS_UnrolledSkipListMap_HP_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_less,            key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_less_stat,        key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_cmp,              key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_less_chunk16_stat, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_less_chunk64,     key_type, value_type ) \
+
+#   define CDSSTRESS_UnrolledSkipListMap_RCU_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_less,        key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_less_stat,   key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpt_less_stat,   key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_cmp,         key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_cmp,         key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_less_chunk16_stat, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpt_less_chunk16_stat, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_less_chunk64, key_type, value_type ) \
+        CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpt_less_chunk64, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_UnrolledSkipListMap_HP_1( fixture, test_case, key_type, value_type )
+#   define CDSSTRESS_UnrolledSkipListMap_RCU_1( fixture, test_case, key_type, value_type )
+#endif
+
+#define CDSSTRESS_UnrolledSkipListMap_HP( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_less,             key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_less_stat,       key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_cmp,             key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_hp_less_chunk16_stat, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_dhp_less_chunk64,    key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_HP_1( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_HP_2( fixture, test_case, key_type, value_type ) \
+
+#define CDSSTRESS_UnrolledSkipListMap_RCU( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_less,        key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_less_stat,   key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpt_less,        key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpb_less_chunk16_stat, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_case( fixture, test_case, UnrolledSkipListMap_rcu_gpi_less_chunk64, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_SHRCU( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_RCU_1( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_RCU_2( fixture, test_case, key_type, value_type ) \
+
+#define CDSSTRESS_UnrolledSkipListMap( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_HP( fixture, test_case, key_type, value_type ) \
+    CDSSTRESS_UnrolledSkipListMap_RCU( fixture, test_case, key_type, value_type ) \
+
+#endif // ifndef CDSUNIT_MAP_TYPE_UNROLLED_SKIP_LIST_H
@@ -213,6 +213,17 @@ namespace {
     CDSSTRESS_MSPriorityQueue( pqueue_pop, MSPriorityQueue_dyn_cmp )
     //CDSSTRESS_MSPriorityQueue( pqueue_pop, MSPriorityQueue_dyn_mutex ) // too slow
 
+    // The heap starts small and grows by segments
+#define CDSSTRESS_MSPriorityQueue_segmented( fixture_t, pqueue_t ) \
+    TEST_F( fixture_t, pqueue_t ) \
+    { \
+        typedef pqueue::Types<pqueue::simple_value>::pqueue_t pqueue_type; \
+        pqueue_type pq( 1024 ); \
+        test( pq ); \
+    }
+    CDSSTRESS_MSPriorityQueue_segmented( pqueue_pop, MSPriorityQueue_segmented_less )
+    CDSSTRESS_MSPriorityQueue_segmented( pqueue_pop, MSPriorityQueue_segmented_less_stat )
+
 #define CDSSTRESS_MSPriorityQueue_static( fixture_t, pqueue_t ) \
     TEST_F( fixture_t, pqueue_t ) \
     { \
@@ -38,6 +38,7 @@
 
 #include <cds/container/mspriority_queue.h>
 #include <cds/container/fcpriority_queue.h>
+#include <cds/container/multi_priority_queue.h>
 
 #include <cds/container/ellen_bintree_set_hp.h>
 #include <cds/container/ellen_bintree_set_dhp.h>
@@ -411,6 +412,18 @@ namespace pqueue {
         {};
         typedef cc::MSPriorityQueue< Value, traits_MSPriorityQueue_dyn_cmp > MSPriorityQueue_dyn_cmp;
 
+        struct traits_MSPriorityQueue_segmented: public cc::mspriority_queue::traits
+        {
+            typedef co::v::initialized_segmented_buffer< char > buffer;
+        };
+        typedef cc::MSPriorityQueue< Value, traits_MSPriorityQueue_segmented > MSPriorityQueue_segmented_less;
+
+        struct traits_MSPriorityQueue_segmented_less_stat: public traits_MSPriorityQueue_segmented
+        {
+            typedef cc::mspriority_queue::stat<> stat;
+        };
+        typedef cc::MSPriorityQueue< Value, traits_MSPriorityQueue_segmented_less_stat > MSPriorityQueue_segmented_less_stat;
+
         struct traits_MSPriorityQueue_dyn_mutex : public
             cc::mspriority_queue::make_traits <
                 co::buffer< co::v::initialized_dynamic_buffer< char > >
@@ -685,6 +698,15 @@ namespace pqueue {
             ,traits_FCPQueue_stat
         > FCPQueue_boost_stable_vector_stat;
 
+        // MultiPriorityQueue
+        struct traits_MultiPQueue_stat : public
+            cc::multi_priority_queue::make_traits <
+                co::stat< cc::multi_priority_queue::stat<> >
+            >::type
+        {};
+        typedef cc::MultiPriorityQueue< Value > MultiPQueue;
+        typedef cc::MultiPriorityQueue< Value, traits_MultiPQueue_stat > MultiPQueue_stat;
+
         /// Standard priority_queue
         typedef details::StdPQueue< Value, std::vector<Value>, cds::sync::spin> StdPQueue_vector_spin;
         typedef details::StdPQueue< Value, std::vector<Value>, std::mutex >  StdPQueue_vector_mutex;
@@ -719,6 +741,23 @@ namespace cds_test {
             << static_cast<cds::algo::flat_combining::stat<> const&>(s);
     }
 
+    static inline property_stream& operator <<( property_stream& o, cds::container::multi_priority_queue::empty_stat const& /*s*/ )
+    {
+        return o;
+    }
+
+    static inline property_stream& operator <<( property_stream& o, cds::container::multi_priority_queue::stat<> const& s )
+    {
+        return o
+            << CDSSTRESS_STAT_OUT( s, m_nPushCount )
+            << CDSSTRESS_STAT_OUT( s, m_nPopCount )
+            << CDSSTRESS_STAT_OUT( s, m_nPopFailCount )
+            << CDSSTRESS_STAT_OUT( s, m_nPushContention )
+            << CDSSTRESS_STAT_OUT( s, m_nPopContention )
+            << CDSSTRESS_STAT_OUT( s, m_nPopEmptyPair )
+            << CDSSTRESS_STAT_OUT( s, m_nPopScan );
+    }
+
     static inline property_stream& operator <<( property_stream& o, cds::container::mspriority_queue::empty_stat const& /*s*/ )
     {
         return o;
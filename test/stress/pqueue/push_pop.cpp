@@ -228,6 +228,17 @@ namespace {
     CDSSTRESS_MSPriorityQueue( pqueue_push_pop, MSPriorityQueue_dyn_cmp )
     //CDSSTRESS_MSPriorityQueue( pqueue_push_pop, MSPriorityQueue_dyn_mutex ) // too slow
 
+    // The heap starts small and grows by segments
+#define CDSSTRESS_MSPriorityQueue_segmented( fixture_t, pqueue_t ) \
+    TEST_F( fixture_t, pqueue_t ) \
+    { \
+        typedef pqueue::Types<pqueue::simple_value>::pqueue_t pqueue_type; \
+        pqueue_type pq( 1024 ); \
+        test( pq ); \
+    }
+    CDSSTRESS_MSPriorityQueue_segmented( pqueue_push_pop, MSPriorityQueue_segmented_less )
+    CDSSTRESS_MSPriorityQueue_segmented( pqueue_push_pop, MSPriorityQueue_segmented_less_stat )
+
 #define CDSSTRESS_MSPriorityQueue_static( fixture_t, pqueue_t ) \
     TEST_F( fixture_t, pqueue_t ) \
     { \
@@ -241,6 +252,17 @@ namespace {
     //CDSSTRESS_MSPriorityQueue( pqueue_push_pop, MSPriorityQueue_static_mutex )
 
 
+    // MultiPriorityQueue is relaxed, so only push_pop test is applicable
+#define CDSSTRESS_MultiPriorityQueue( fixture_t, pqueue_t ) \
+    TEST_F( fixture_t, pqueue_t ) \
+    { \
+        typedef pqueue::Types<pqueue::simple_value>::pqueue_t pqueue_type; \
+        pqueue_type pq( pqueue_type::c_nDefaultHeapFactor * ( s_nPushThreadCount + s_nPopThreadCount )); \
+        test( pq ); \
+    }
+    CDSSTRESS_MultiPriorityQueue( pqueue_push_pop, MultiPQueue )
+    CDSSTRESS_MultiPriorityQueue( pqueue_push_pop, MultiPQueue_stat )
+
 #define CDSSTRESS_PriorityQueue( fixture_t, pqueue_t ) \
     TEST_F( fixture_t, pqueue_t ) \
     { \
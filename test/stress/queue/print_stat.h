@@ -45,7 +45,12 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_AdvanceTailError )
             << CDSSTRESS_STAT_OUT( s, m_BadTail )
             << CDSSTRESS_STAT_OUT( s, m_TryAddBasket )
-            << CDSSTRESS_STAT_OUT( s, m_AddBasketCount );
+            << CDSSTRESS_STAT_OUT( s, m_AddBasketCount )
+            << CDSSTRESS_STAT_OUT( s, m_ActiveEnqueueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_ActiveDequeueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_PassiveEnqueueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_PassiveDequeueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_EliminationFailed );
     }
 
     static inline property_stream& operator <<( property_stream& o, cds::intrusive::basket_queue::empty_stat const& /*s*/ )
@@ -63,7 +68,12 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_EmptyDequeue )
             << CDSSTRESS_STAT_OUT( s, m_DequeueRace )
             << CDSSTRESS_STAT_OUT( s, m_AdvanceTailError )
-            << CDSSTRESS_STAT_OUT( s, m_BadTail );
+            << CDSSTRESS_STAT_OUT( s, m_BadTail )
+            << CDSSTRESS_STAT_OUT( s, m_ActiveEnqueueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_ActiveDequeueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_PassiveEnqueueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_PassiveDequeueCollision )
+            << CDSSTRESS_STAT_OUT( s, m_EliminationFailed );
     }
 
     static inline property_stream& operator <<( property_stream& o, cds::intrusive::msqueue::empty_stat const& /*s*/ )
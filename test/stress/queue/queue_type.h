@@ -220,6 +220,18 @@ namespace fc_details{
         typedef cds::container::MoirQueue< cds::gc::HP, Value, traits_MSQueue_stat > MoirQueue_HP_stat;
         typedef cds::container::MoirQueue< cds::gc::DHP, Value, traits_MSQueue_stat > MoirQueue_DHP_stat;
 
+        // MSQueue + elimination
+        struct traits_MSQueue_elimination: public
+            cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        {};
+        typedef cds::container::MSQueue< cds::gc::HP,  Value, traits_MSQueue_elimination > MSQueue_HP_elimination;
+        typedef cds::container::MSQueue< cds::gc::DHP, Value, traits_MSQueue_elimination > MSQueue_DHP_elimination;
+        typedef cds::container::MoirQueue< cds::gc::HP, Value, traits_MSQueue_elimination > MoirQueue_HP_elimination;
+        typedef cds::container::MoirQueue< cds::gc::DHP, Value, traits_MSQueue_elimination > MoirQueue_DHP_elimination;
+
 
         // OptimisticQueue
         typedef cds::container::OptimisticQueue< cds::gc::HP, Value > OptimisticQueue_HP;
@@ -406,6 +418,15 @@ namespace fc_details{
         typedef cds::container::BasketQueue< cds::gc::HP,  Value, traits_BasketQueue_stat > BasketQueue_HP_stat;
         typedef cds::container::BasketQueue< cds::gc::DHP, Value, traits_BasketQueue_stat > BasketQueue_DHP_stat;
 
+        struct traits_BasketQueue_elimination : public
+            cds::container::basket_queue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat< cds::container::basket_queue::stat<> >
+            >::type
+        {};
+        typedef cds::container::BasketQueue< cds::gc::HP,  Value, traits_BasketQueue_elimination > BasketQueue_HP_elimination;
+        typedef cds::container::BasketQueue< cds::gc::DHP, Value, traits_BasketQueue_elimination > BasketQueue_DHP_elimination;
+
 
         // RWQueue
         typedef cds::container::RWQueue< Value > RWQueue_Spin;
@@ -456,6 +477,15 @@ namespace fc_details{
         {
             typedef cds::container::fcqueue::stat<> stat;
         };
+        struct traits_FCQueue_adaptive_wait:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::adaptive<>>
+            >::type
+        {};
+        struct traits_FCQueue_adaptive_wait_stat: traits_FCQueue_adaptive_wait
+        {
+            typedef cds::container::fcqueue::stat<> stat;
+        };
         struct traits_FCQueue_elimination:
             public cds::container::fcqueue::make_traits<
                 cds::opt::enable_elimination< true >
@@ -467,6 +497,19 @@ namespace fc_details{
                 ,cds::opt::stat< cds::container::fcqueue::stat<> >
             >::type
         {};
+        struct traits_FCQueue_hierarchical:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        {};
+        struct traits_FCQueue_hierarchical_stat: traits_FCQueue_hierarchical
+        {
+            typedef cds::container::fcqueue::stat<> stat;
+        };
+        struct traits_FCQueue_hierarchical_elimination_stat: traits_FCQueue_hierarchical_stat
+        {
+            static CDS_CONSTEXPR const bool enable_elimination = true;
+        };
 
         typedef cds::container::FCQueue< Value > FCQueue_deque;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_stat > FCQueue_deque_stat;
@@ -476,10 +519,16 @@ namespace fc_details{
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_single_mutex_multi_condvar_stat> FCQueue_deque_wait_sm_stat;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_multi_mutex_multi_condvar> FCQueue_deque_wait_mm;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_multi_mutex_multi_condvar_stat> FCQueue_deque_wait_mm_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_adaptive_wait> FCQueue_deque_wait_ad;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_adaptive_wait_stat> FCQueue_deque_wait_ad_stat;
 
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_elimination > FCQueue_deque_elimination;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_elimination_stat > FCQueue_deque_elimination_stat;
 
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_hierarchical > FCQueue_deque_hierarchical;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_hierarchical_stat > FCQueue_deque_hierarchical_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_hierarchical_elimination_stat > FCQueue_deque_hierarchical_elimination_stat;
+
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>> FCQueue_list;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_stat> FCQueue_list_stat;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_single_mutex_single_condvar> FCQueue_list_wait_ss;
@@ -488,6 +537,8 @@ namespace fc_details{
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_single_mutex_multi_condvar_stat> FCQueue_list_wait_sm_stat;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_multi_mutex_multi_condvar> FCQueue_list_wait_mm;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_multi_mutex_multi_condvar_stat> FCQueue_list_wait_mm_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_adaptive_wait> FCQueue_list_wait_ad;
+        typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_adaptive_wait_stat> FCQueue_list_wait_ad_stat;
 
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_elimination > FCQueue_list_elimination;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_elimination_stat > FCQueue_list_elimination_stat;
@@ -711,11 +762,14 @@ namespace cds_test {
         CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_ss      ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_sm      ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_mm      ) \
+        CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_ad      ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_elimination  ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_ss       ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_sm       ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_mm       ) \
+        CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_ad       ) \
         CDSSTRESS_Queue_F( test_fixture, FCQueue_list_elimination   ) \
+        CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_hierarchical ) \
 
 #   define CDSSTRESS_FCDeque_1( test_fixture ) \
         CDSSTRESS_Queue_F( test_fixture, FCDequeL_mutex             ) \
@@ -794,6 +848,8 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, MSQueue_HP_stat    ) \
     CDSSTRESS_Queue_F( test_fixture, MSQueue_DHP        ) \
     CDSSTRESS_Queue_F( test_fixture, MSQueue_DHP_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, MSQueue_HP_elimination  ) \
+    CDSSTRESS_Queue_F( test_fixture, MSQueue_DHP_elimination ) \
     CDSSTRESS_MSQueue_1( test_fixture )
 
 #define CDSSTRESS_MoirQueue( test_fixture ) \
@@ -801,6 +857,8 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, MoirQueue_HP_stat  ) \
     CDSSTRESS_Queue_F( test_fixture, MoirQueue_DHP      ) \
     CDSSTRESS_Queue_F( test_fixture, MoirQueue_DHP_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, MoirQueue_HP_elimination  ) \
+    CDSSTRESS_Queue_F( test_fixture, MoirQueue_DHP_elimination ) \
     CDSSTRESS_MoirQueue_1( test_fixture )
 
 #define CDSSTRESS_OptimsticQueue( test_fixture ) \
@@ -815,6 +873,8 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, BasketQueue_HP_stat    ) \
     CDSSTRESS_Queue_F( test_fixture, BasketQueue_DHP        ) \
     CDSSTRESS_Queue_F( test_fixture, BasketQueue_DHP_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, BasketQueue_HP_elimination  ) \
+    CDSSTRESS_Queue_F( test_fixture, BasketQueue_DHP_elimination ) \
     CDSSTRESS_BasketQueue_1( test_fixture )
 
 #define CDSSTRESS_FCQueue( test_fixture ) \
@@ -823,12 +883,16 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_ss_stat ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_sm_stat ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_mm_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_wait_ad_stat ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_elimination_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_hierarchical_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_hierarchical_elimination_stat ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list               ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_stat          ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_ss_stat  ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_sm_stat  ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_mm_stat  ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_list_wait_ad_stat  ) \
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_elimination_stat ) \
     CDSSTRESS_FCQueue_1( test_fixture )
 
@@ -353,11 +353,26 @@ namespace stack {
                 cds::opt::lock_type< std::mutex >
             >::type
         {};
+        struct traits_FCStack_hierarchical_stat:
+            public cds::container::fcstack::make_traits<
+                cds::opt::stat< cds::container::fcstack::stat<> >,
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        {};
+        struct traits_FCStack_hierarchical_elimination_stat:
+            public cds::container::fcstack::make_traits<
+                cds::opt::stat< cds::container::fcstack::stat<> >,
+                cds::opt::enable_elimination< true >,
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        {};
 
         typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_mutex > FCStack_deque_mutex;
         typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_stat > FCStack_deque_stat;
         typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_elimination > FCStack_deque_elimination;
         typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_elimination_stat > FCStack_deque_elimination_stat;
+        typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_hierarchical_stat > FCStack_deque_hierarchical_stat;
+        typedef cds::container::FCStack< T, std::stack<T, std::deque<T> >, traits_FCStack_hierarchical_elimination_stat > FCStack_deque_hierarchical_elimination_stat;
         typedef cds::container::FCStack< T, std::stack<T, std::vector<T> > > FCStack_vector;
         typedef cds::container::FCStack< T, std::stack<T, std::vector<T> >, traits_FCStack_mutex > FCStack_vector_mutex;
         typedef cds::container::FCStack< T, std::stack<T, std::vector<T> >, traits_FCStack_stat > FCStack_vector_stat;
@@ -534,6 +549,8 @@ namespace cds_test {
     CDSSTRESS_Stack_F( test_fixture, FCStack_deque_stat ) \
     CDSSTRESS_Stack_F( test_fixture, FCStack_deque_elimination ) \
     CDSSTRESS_Stack_F( test_fixture, FCStack_deque_elimination_stat ) \
+    CDSSTRESS_Stack_F( test_fixture, FCStack_deque_hierarchical_stat ) \
+    CDSSTRESS_Stack_F( test_fixture, FCStack_deque_hierarchical_elimination_stat ) \
     CDSSTRESS_Stack_F( test_fixture, FCStack_vector ) \
     CDSSTRESS_Stack_F( test_fixture, FCStack_vector_mutex ) \
     CDSSTRESS_Stack_F( test_fixture, FCStack_vector_stat ) \
@@ -0,0 +1,116 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "test_chase_lev_deque.h"
+
+#include <cds/gc/hp.h>
+#include <cds/container/chase_lev_deque.h>
+
+namespace {
+    namespace cc = cds::container;
+    typedef cds::gc::HP gc_type;
+
+    class ChaseLevDeque_HP : public cds_test::chase_lev_deque
+    {
+    protected:
+        void SetUp()
+        {
+            typedef cc::ChaseLevDeque< gc_type, int > deque_type;
+
+            cds::gc::hp::GarbageCollector::Construct( deque_type::c_nHazardPtrCount, 1, 16 );
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            cds::gc::hp::GarbageCollector::Destruct( true );
+        }
+    };
+
+    TEST_F( ChaseLevDeque_HP, defaulted )
+    {
+        typedef cc::ChaseLevDeque< gc_type, int > deque_type;
+
+        deque_type dq;
+        test( dq );
+    }
+
+    TEST_F( ChaseLevDeque_HP, small_array )
+    {
+        typedef cc::ChaseLevDeque< gc_type, size_t > deque_type;
+
+        // the internal array grows several times
+        deque_type dq( 2 );
+        test( dq );
+    }
+
+    TEST_F( ChaseLevDeque_HP, stat )
+    {
+        typedef cc::ChaseLevDeque< gc_type, int,
+            typename cc::chase_lev_deque::make_traits<
+                cds::opt::stat< cc::chase_lev_deque::stat<> >
+                , cds::opt::back_off< cds::backoff::pause >
+            >::type
+        > deque_type;
+
+        deque_type dq( 4 );
+        test( dq );
+        EXPECT_NE( dq.statistics().m_GrowCount.get(), 0u );
+        EXPECT_EQ( dq.statistics().m_PushCount.get(), dq.statistics().m_PopCount.get() + dq.statistics().m_StealCount.get());
+    }
+
+    TEST_F( ChaseLevDeque_HP, pointer )
+    {
+        struct task {
+            int n;
+        };
+        typedef cc::ChaseLevDeque< gc_type, task*,
+            typename cc::chase_lev_deque::make_traits<
+                cds::opt::padding< 16 >
+            >::type
+        > deque_type;
+
+        task arr[10];
+        deque_type dq( 4 );
+        for ( int i = 0; i < 10; ++i ) {
+            arr[i].n = i;
+            ASSERT_TRUE( dq.push_bottom( arr + i ));
+        }
+
+        task* p;
+        ASSERT_TRUE( dq.steal( p ));
+        ASSERT_EQ( p->n, 0 );
+        ASSERT_TRUE( dq.pop_bottom( p ));
+        ASSERT_EQ( p->n, 9 );
+        ASSERT_EQ( dq.size(), 8u );
+    }
+
+} // namespace
@@ -0,0 +1,129 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSUNIT_DEQUE_TEST_CHASE_LEV_DEQUE_H
+#define CDSUNIT_DEQUE_TEST_CHASE_LEV_DEQUE_H
+
+#include <cds_test/check_size.h>
+#include <vector>
+
+namespace cds_test {
+
+    class chase_lev_deque : public ::testing::Test
+    {
+    protected:
+        template <typename Deque>
+        void test( Deque& dq )
+        {
+            typedef typename Deque::value_type value_type;
+            size_t const nSize = 100;
+            value_type v;
+
+            ASSERT_TRUE( dq.empty());
+            ASSERT_CONTAINER_SIZE( dq, 0 );
+            ASSERT_FALSE( dq.pop_bottom( v ));
+            ASSERT_FALSE( dq.steal( v ));
+
+            // push_bottom/pop_bottom: LIFO
+            for ( size_t i = 0; i < nSize; ++i ) {
+                ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( i )));
+                ASSERT_CONTAINER_SIZE( dq, i + 1 );
+            }
+            ASSERT_FALSE( dq.empty());
+            ASSERT_GE( dq.capacity(), nSize );
+
+            for ( size_t i = nSize; i > 0; --i ) {
+                ASSERT_TRUE( dq.pop_bottom( v ));
+                ASSERT_EQ( v, static_cast<value_type>( i - 1 ));
+            }
+            ASSERT_TRUE( dq.empty());
+            ASSERT_FALSE( dq.pop_bottom( v ));
+
+            // push_bottom/steal: FIFO
+            for ( size_t i = 0; i < nSize; ++i )
+                ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( i )));
+            for ( size_t i = 0; i < nSize; ++i ) {
+                ASSERT_TRUE( dq.steal( v ));
+                ASSERT_EQ( v, static_cast<value_type>( i ));
+                ASSERT_CONTAINER_SIZE( dq, nSize - i - 1 );
+            }
+            ASSERT_TRUE( dq.empty());
+            ASSERT_FALSE( dq.steal( v ));
+
+            // mixed: steal from the top, pop from the bottom
+            for ( size_t i = 0; i < nSize; ++i )
+                ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( i )));
+            for ( size_t i = 0; i < nSize / 2; ++i ) {
+                ASSERT_TRUE( dq.steal( v ));
+                ASSERT_EQ( v, static_cast<value_type>( i ));
+                ASSERT_TRUE( dq.pop_bottom( v ));
+                ASSERT_EQ( v, static_cast<value_type>( nSize - i - 1 ));
+            }
+            ASSERT_TRUE( dq.empty());
+
+            // steal_half
+            for ( size_t i = 0; i < nSize; ++i )
+                ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( i )));
+
+            std::vector<value_type> stolen;
+            ASSERT_EQ( dq.steal_half( [&stolen]( value_type val ) { stolen.push_back( val ); } ), nSize / 2 );
+            ASSERT_EQ( stolen.size(), nSize / 2 );
+            for ( size_t i = 0; i < stolen.size(); ++i )
+                ASSERT_EQ( stolen[i], static_cast<value_type>( i ));
+            ASSERT_CONTAINER_SIZE( dq, nSize - nSize / 2 );
+
+            value_type arr[10];
+            ASSERT_EQ( dq.steal_half( arr, sizeof( arr ) / sizeof( arr[0] )), 10u );
+            for ( size_t i = 0; i < 10; ++i )
+                ASSERT_EQ( arr[i], static_cast<value_type>( nSize / 2 + i ));
+            ASSERT_CONTAINER_SIZE( dq, nSize - nSize / 2 - 10 );
+
+            // the last item is stolen by steal_half
+            dq.clear();
+            ASSERT_TRUE( dq.empty());
+            ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( 42 )));
+            ASSERT_EQ( dq.steal_half( arr, 10 ), 1u );
+            ASSERT_EQ( arr[0], static_cast<value_type>( 42 ));
+            ASSERT_TRUE( dq.empty());
+            ASSERT_EQ( dq.steal_half( arr, 10 ), 0u );
+
+            // clear
+            for ( size_t i = 0; i < nSize; ++i )
+                ASSERT_TRUE( dq.push_bottom( static_cast<value_type>( i )));
+            ASSERT_FALSE( dq.empty());
+            dq.clear();
+            ASSERT_TRUE( dq.empty());
+            ASSERT_CONTAINER_SIZE( dq, 0 );
+        }
+    };
+
+} // namespace cds_test
+
+#endif // CDSUNIT_DEQUE_TEST_CHASE_LEV_DEQUE_H
@@ -0,0 +1,122 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSUNIT_LIST_TEST_UNROLLED_LIST_H
+#define CDSUNIT_LIST_TEST_UNROLLED_LIST_H
+
+#include "test_list_hp.h"
+
+namespace cds_test {
+
+    class unrolled_list : public list_hp
+    {
+    protected:
+        template <typename List>
+        void test_split_merge( List& l )
+        {
+            // Precondition: list is empty
+            // Postcondition: list is empty
+
+            // Several items per node: inserting and erasing enough items splits and merges the nodes
+            static const size_t nSize = List::c_nNodeCapacity * 32;
+            typedef typename List::value_type value_type;
+
+            std::vector<int> keys;
+            keys.reserve( nSize );
+            for ( size_t i = 0; i < nSize; ++i )
+                keys.push_back( static_cast<int>( i ));
+            shuffle( keys.begin(), keys.end());
+
+            ASSERT_TRUE( l.empty());
+
+            for ( int key : keys ) {
+                EXPECT_TRUE( l.insert( key ));
+                EXPECT_FALSE( l.insert( key ));
+            }
+            EXPECT_CONTAINER_SIZE( l, nSize );
+
+            int nExpected = 0;
+            for ( auto it = l.cbegin(); it != l.cend(); ++it ) {
+                EXPECT_EQ( it->nKey, nExpected );
+                EXPECT_EQ( it->nVal, nExpected * 2 );
+                ++nExpected;
+            }
+            EXPECT_EQ( static_cast<size_t>( nExpected ), nSize );
+
+            // The changes made by update() survive node replacement
+            for ( int key : keys ) {
+                auto pair = l.update( key, []( bool bNew, value_type& item, int k ) {
+                    EXPECT_FALSE( bNew );
+                    item.nVal = k * 3;
+                }, false );
+                EXPECT_TRUE( pair.first );
+                EXPECT_FALSE( pair.second );
+            }
+
+            // Erase odd keys
+            for ( int key : keys ) {
+                if ( key & 1 ) {
+                    EXPECT_TRUE( l.erase( key ));
+                }
+            }
+            EXPECT_CONTAINER_SIZE( l, nSize / 2 );
+
+            for ( int key : keys ) {
+                if ( key & 1 ) {
+                    EXPECT_FALSE( l.contains( key ));
+                }
+                else {
+                    EXPECT_TRUE( l.find( key, []( value_type& item, int k ) {
+                        EXPECT_EQ( item.nKey, k );
+                        EXPECT_EQ( item.nVal, k * 3 );
+                    }));
+                }
+            }
+
+            nExpected = 0;
+            for ( auto& item : l ) {
+                EXPECT_EQ( item.nKey, nExpected );
+                nExpected += 2;
+            }
+            EXPECT_EQ( static_cast<size_t>( nExpected ), nSize );
+
+            // Erase the rest in ascending order to merge the sparse nodes
+            for ( size_t i = 0; i < nSize; i += 2 )
+                EXPECT_TRUE( l.erase( static_cast<int>( i )));
+
+            EXPECT_TRUE( l.empty());
+            EXPECT_CONTAINER_SIZE( l, 0 );
+            EXPECT_TRUE( l.begin() == l.end());
+        }
+    };
+
+} // namespace cds_test
+
+#endif // CDSUNIT_LIST_TEST_UNROLLED_LIST_H
@@ -33,6 +33,7 @@
 #include <cds/container/michael_list_hp.h>
 #include <cds/container/split_list_map.h>
 #include <cds/intrusive/free_list.h>
+#include <cds/algo/sharded_counter.h>
 
 namespace {
     namespace cc = cds::container;
@@ -164,6 +165,28 @@ namespace {
         test( m );
     }
 
+    TEST_F( SplitListMichaelMap_HP, sharded_counter )
+    {
+        struct map_traits: public cc::split_list::traits
+        {
+            typedef cc::michael_list_tag ordered_list;
+            typedef hash1 hash;
+            typedef cds::atomicity::sharded_item_counter<> item_counter;
+            typedef cc::split_list::stat< cds::atomicity::sharded_event_counter<>> stat;
+
+            struct ordered_list_traits: public cc::michael_list::traits
+            {
+                typedef cmp compare;
+                typedef base_class::less less;
+            };
+        };
+        typedef cc::SplitListMap< gc_type, key_type, value_type, map_traits > map_type;
+
+        map_type m( kSize, 4 );
+        test( m );
+        EXPECT_GE( m.statistics().m_nInsertSuccess.get(), static_cast<size_t>( kSize ));
+    }
+
     TEST_F( SplitListMichaelMap_HP, back_off )
     {
         struct map_traits: public cc::split_list::traits
@@ -0,0 +1,320 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_MAP_H
+#define CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_MAP_H
+
+#include "test_map_data.h"
+
+namespace cds_test {
+
+    class unrolled_skiplist_map: public map_fixture
+    {
+    public:
+        static size_t const kSize = 1000;
+
+    protected:
+        template <class Map>
+        void test( Map& m )
+        {
+            // Precondition: map is empty
+            // Postcondition: map is empty
+
+            EXPECT_TRUE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, 0 );
+
+            typedef typename Map::value_type map_pair;
+            typedef typename Map::value_ptr value_ptr;
+            size_t const kkSize = kSize;
+
+            std::vector<key_type> arrKeys;
+            for ( int i = 0; i < static_cast<int>(kkSize); ++i )
+                arrKeys.push_back( key_type( i ));
+            shuffle( arrKeys.begin(), arrKeys.end());
+
+            value_ptr vp;
+            EXPECT_FALSE( m.get_min());
+            EXPECT_FALSE( m.get_max());
+            EXPECT_FALSE( m.extract_min());
+            EXPECT_FALSE( m.extract_max());
+
+            // insert/find
+            for ( auto const& i : arrKeys ) {
+                value_type val( i.nKey );
+
+                EXPECT_FALSE( m.contains( i.nKey ));
+                EXPECT_FALSE( m.contains( i ));
+                EXPECT_FALSE( m.find( i, []( map_pair const& ) {
+                    EXPECT_TRUE( false );
+                } ));
+                EXPECT_FALSE( m.get( i.nKey ));
+
+                std::pair< bool, bool > updResult;
+
+                switch ( i.nKey % 8 ) {
+                case 0:
+                    EXPECT_TRUE( m.insert( i ));
+                    EXPECT_FALSE( m.insert( i ));
+                    EXPECT_TRUE( m.find( i.nKey, []( map_pair& v ) {
+                        v.second.nVal = v.first.nKey;
+                        v.second.strVal = std::to_string( v.first.nKey );
+                    } ));
+                    break;
+                case 1:
+                    EXPECT_TRUE( m.insert( std::to_string( i.nKey )));
+                    EXPECT_FALSE( m.insert( std::to_string( i.nKey )));
+                    EXPECT_TRUE( m.find( i.nKey, []( map_pair& v ) {
+                        v.second.nVal = v.first.nKey;
+                        v.second.strVal = std::to_string( v.first.nKey );
+                    } ));
+                    break;
+                case 2:
+                    EXPECT_TRUE( m.insert( i, val ));
+                    EXPECT_FALSE( m.insert( i, val ));
+                    break;
+                case 3:
+                    EXPECT_TRUE( m.insert( val.strVal, i.nKey ));
+                    EXPECT_FALSE( m.insert( val.strVal, i.nKey ));
+                    break;
+                case 4:
+                    EXPECT_TRUE( m.insert_with( i.nKey, []( map_pair& v ) {
+                        v.second.nVal = v.first.nKey;
+                        v.second.strVal = std::to_string( v.first.nKey );
+                    } ));
+                    EXPECT_FALSE( m.insert_with( i.nKey, []( map_pair& ) {
+                        EXPECT_TRUE( false );
+                    } ));
+                    break;
+                case 5:
+                    updResult = m.update( i.nKey, []( bool, map_pair& ) {
+                        EXPECT_TRUE( false );
+                    }, false );
+                    EXPECT_FALSE( updResult.first );
+                    EXPECT_FALSE( updResult.second );
+
+                    updResult = m.update( i, []( bool bNew, map_pair& v ) {
+                        EXPECT_TRUE( bNew );
+                        v.second.nVal = v.first.nKey;
+                        v.second.strVal = std::to_string( v.first.nKey );
+                    } );
+                    EXPECT_TRUE( updResult.first );
+                    EXPECT_TRUE( updResult.second );
+
+                    updResult = m.update( i.nKey, []( bool bNew, map_pair& v ) {
+                        EXPECT_FALSE( bNew );
+                        EXPECT_EQ( v.first.nKey, v.second.nVal );
+                        v.second.strVal = std::to_string( v.second.nVal );
+                    }, false );
+                    EXPECT_TRUE( updResult.first );
+                    EXPECT_FALSE( updResult.second );
+                    break;
+                case 6:
+                    EXPECT_TRUE( m.emplace( i.nKey ));
+                    EXPECT_FALSE( m.emplace( i.nKey ));
+                    EXPECT_TRUE( m.find( i.nKey, []( map_pair& v ) {
+                        v.second.nVal = v.first.nKey;
+                        v.second.strVal = std::to_string( v.first.nKey );
+                    } ));
+                    break;
+                case 7:
+                    {
+                        std::string str = val.strVal;
+                        EXPECT_TRUE( m.emplace( i, std::move( str )));
+                        EXPECT_TRUE( str.empty());
+                        str = val.strVal;
+                        EXPECT_FALSE( m.emplace( i, std::move( str )));
+                        EXPECT_FALSE( str.empty());
+                    }
+                    break;
+                }
+
+                EXPECT_TRUE( m.contains( i.nKey ));
+                EXPECT_TRUE( m.contains( i ));
+                EXPECT_TRUE( m.find( i, []( map_pair const& v ) {
+                    EXPECT_EQ( v.first.nKey, v.second.nVal );
+                    EXPECT_EQ( std::to_string( v.first.nKey ), v.second.strVal );
+                } ));
+
+                vp = m.get( i.nKey );
+                ASSERT_TRUE( vp );
+                EXPECT_EQ( vp->first.nKey, i.nKey );
+                EXPECT_EQ( vp->second.nVal, i.nKey );
+            }
+
+            EXPECT_FALSE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, kkSize );
+
+            vp = m.get_min();
+            ASSERT_TRUE( vp );
+            EXPECT_EQ( vp->first.nKey, 0 );
+            vp = m.get_max();
+            ASSERT_TRUE( vp );
+            EXPECT_EQ( vp->first.nKey, static_cast<int>( kkSize - 1 ));
+
+            // erase/extract
+            shuffle( arrKeys.begin(), arrKeys.end());
+            for ( auto const& i : arrKeys ) {
+                EXPECT_TRUE( m.contains( i.nKey ));
+
+                switch ( i.nKey % 4 ) {
+                case 0:
+                    EXPECT_TRUE( m.erase( i ));
+                    EXPECT_FALSE( m.erase( i ));
+                    break;
+                case 1:
+                    EXPECT_TRUE( m.erase( i.nKey, []( map_pair& v ) {
+                        EXPECT_EQ( v.first.nKey, v.second.nVal );
+                    } ));
+                    EXPECT_FALSE( m.erase( i.nKey, []( map_pair& ) {
+                        EXPECT_TRUE( false );
+                    } ));
+                    break;
+                case 2:
+                    EXPECT_TRUE( m.erase( std::to_string( i.nKey )));
+                    EXPECT_FALSE( m.erase( std::to_string( i.nKey )));
+                    break;
+                case 3:
+                    vp = m.extract( i.nKey );
+                    ASSERT_TRUE( vp );
+                    EXPECT_EQ( vp->first.nKey, i.nKey );
+                    EXPECT_EQ( vp->second.nVal, i.nKey );
+                    EXPECT_EQ( vp->second.strVal, std::to_string( i.nKey ));
+                    EXPECT_FALSE( m.extract( i.nKey ));
+                    break;
+                }
+
+                EXPECT_FALSE( m.contains( i.nKey ));
+                EXPECT_FALSE( m.get( i ));
+            }
+            EXPECT_TRUE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, 0 );
+
+            // extract_min/extract_max
+            for ( auto const& i : arrKeys )
+                EXPECT_TRUE( m.insert( i, value_type( i.nKey )));
+            EXPECT_CONTAINER_SIZE( m, kkSize );
+
+            int nMin = 0;
+            int nMax = static_cast<int>( kkSize ) - 1;
+            while ( nMin <= nMax ) {
+                vp = m.extract_min();
+                ASSERT_TRUE( vp );
+                EXPECT_EQ( vp->first.nKey, nMin );
+                EXPECT_EQ( vp->second.nVal, nMin );
+                ++nMin;
+
+                vp = m.extract_max();
+                ASSERT_TRUE( vp );
+                EXPECT_EQ( vp->first.nKey, nMax );
+                EXPECT_EQ( vp->second.nVal, nMax );
+                --nMax;
+            }
+            EXPECT_TRUE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, 0 );
+            EXPECT_FALSE( m.extract_min());
+            EXPECT_FALSE( m.extract_max());
+
+            // clear
+            for ( auto const& i : arrKeys )
+                EXPECT_TRUE( m.insert( i ));
+            EXPECT_FALSE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, kkSize );
+
+            m.clear();
+
+            EXPECT_TRUE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, 0 );
+            for ( auto const& i : arrKeys )
+                EXPECT_FALSE( m.contains( i ));
+        }
+
+        template <class Map>
+        void test_split_merge( Map& m )
+        {
+            // Precondition: map is empty
+            // Postcondition: map is empty
+
+            // Inserting in ascending and descending order splits the first and the last chunk only,
+            // erasing every other key makes the chunks sparse and merges them
+            static const int nSize = static_cast<int>( Map::c_nChunkCapacity * 64 );
+
+            ASSERT_TRUE( m.empty());
+
+            for ( int key = 0; key < nSize; key += 2 )
+                EXPECT_TRUE( m.insert( key, value_type( key )));
+            for ( int key = nSize - 1; key > 0; key -= 2 )
+                EXPECT_TRUE( m.insert( key, value_type( key )));
+            EXPECT_CONTAINER_SIZE( m, static_cast<size_t>( nSize ));
+
+            for ( int key = 0; key < nSize; ++key ) {
+                EXPECT_TRUE( m.find( key, [key]( typename Map::value_type const& v ) {
+                    EXPECT_EQ( v.first.nKey, key );
+                    EXPECT_EQ( v.second.nVal, key );
+                } ));
+            }
+
+            for ( int key = 0; key < nSize; key += 2 )
+                EXPECT_TRUE( m.erase( key ));
+            EXPECT_CONTAINER_SIZE( m, static_cast<size_t>( nSize / 2 ));
+
+            for ( int key = 0; key < nSize; ++key ) {
+                if ( key & 1 ) {
+                    EXPECT_TRUE( m.contains( key ));
+                }
+                else {
+                    EXPECT_FALSE( m.contains( key ));
+                }
+            }
+
+            typename Map::value_ptr vp = m.get_max();
+            ASSERT_TRUE( vp );
+            EXPECT_EQ( vp->first.nKey, nSize - 1 );
+
+            // Erase from the end: the last chunks become empty
+            for ( int key = nSize - 1; key > 0; key -= 2 ) {
+                EXPECT_TRUE( m.erase( key ));
+                vp = m.get_max();
+                if ( key > 1 ) {
+                    ASSERT_TRUE( vp );
+                    EXPECT_EQ( vp->first.nKey, key - 2 );
+                }
+                else {
+                    EXPECT_FALSE( vp );
+                }
+            }
+
+            EXPECT_TRUE( m.empty());
+            EXPECT_CONTAINER_SIZE( m, 0 );
+        }
+    };
+
+} // namespace cds_test
+
+#endif // CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_MAP_H
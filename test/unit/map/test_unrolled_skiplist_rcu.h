@@ -0,0 +1,254 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_RCU_H
+#define CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_RCU_H
+
+#include "test_unrolled_skiplist_map.h"
+#include <cds/container/unrolled_skip_list_map_rcu.h>
+
+#include <thread>
+
+namespace cc = cds::container;
+
+template <class RCU>
+class UnrolledSkipListMap: public cds_test::unrolled_skiplist_map
+{
+    typedef cds_test::unrolled_skiplist_map base_class;
+public:
+    typedef cds::urcu::gc<RCU> rcu_type;
+
+protected:
+    template <typename Map>
+    void test_concurrent( Map& m )
+    {
+        // Precondition: map is empty
+        // Postcondition: map is empty
+
+        // The threads work with interleaving keys, so the chunks are split and merged concurrently
+        static const int c_nThreadCount = 4;
+        static const int c_nKeyCount = static_cast<int>( Map::c_nChunkCapacity * 32 );
+
+        ASSERT_TRUE( m.empty());
+
+        std::vector< std::thread > threads;
+        for ( int nThread = 0; nThread < c_nThreadCount; ++nThread ) {
+            threads.emplace_back( [&m, nThread]() {
+                cds::threading::Manager::attachThread();
+                for ( int nPass = 0; nPass < 4; ++nPass ) {
+                    for ( int key = nThread; key < c_nKeyCount; key += c_nThreadCount )
+                        EXPECT_TRUE( m.insert( key, value_type( key )));
+                    for ( int key = nThread; key < c_nKeyCount; key += c_nThreadCount ) {
+                        EXPECT_TRUE( m.find( key, [key]( typename Map::value_type const& v ) {
+                            EXPECT_EQ( v.second.nVal, key );
+                        } ));
+                    }
+                    for ( int key = nThread; key < c_nKeyCount; key += c_nThreadCount )
+                        EXPECT_TRUE( m.erase( key ));
+                }
+                cds::threading::Manager::detachThread();
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        EXPECT_TRUE( m.empty());
+        EXPECT_CONTAINER_SIZE( m, 0 );
+    }
+
+    void SetUp()
+    {
+        RCU::Construct();
+        cds::threading::Manager::attachThread();
+    }
+
+    void TearDown()
+    {
+        cds::threading::Manager::detachThread();
+        RCU::Destruct();
+    }
+};
+
+TYPED_TEST_CASE_P( UnrolledSkipListMap );
+
+TYPED_TEST_P( UnrolledSkipListMap, compare )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::compare< typename TestFixture::cmp >
+        >::type
+    > map_type;
+
+    map_type m;
+    this->test( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, less )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< typename TestFixture::less >
+        >::type
+    > map_type;
+
+    map_type m;
+    this->test( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, cmpmix )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< typename TestFixture::less >
+            ,cds::opt::compare< typename TestFixture::cmp >
+        >::type
+    > map_type;
+
+    map_type m;
+    this->test( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, item_counting )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef typename TestFixture::cmp compare;
+        typedef cds::atomicity::item_counter item_counter;
+    };
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    this->test( m );
+    this->test_split_merge( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, chunk_capacity )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< typename TestFixture::less >
+            ,cc::unrolled_skip_list::chunk_capacity< 8 >
+            ,cds::opt::item_counter< cds::atomicity::item_counter >
+        >::type
+    > map_type;
+    static_assert( map_type::c_nChunkCapacity == 8, "Wrong chunk capacity" );
+
+    map_type m;
+    this->test( m );
+    this->test_split_merge( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, stat )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef typename TestFixture::less less;
+        typedef cds::atomicity::item_counter item_counter;
+        typedef cc::unrolled_skip_list::stat<> stat;
+        enum: size_t { chunk_capacity = 16 };
+    };
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    this->test( m );
+    this->test_split_merge( m );
+
+    EXPECT_NE( m.statistics().m_nChunkSplit.get(), 0u );
+    EXPECT_NE( m.statistics().m_nChunkMerge.get(), 0u );
+    EXPECT_EQ( m.statistics().m_nChunkIndexFailed.get(), 0u );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, mutex_xorshift )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef typename TestFixture::cmp compare;
+        typedef cds::atomicity::item_counter item_counter;
+        typedef std::mutex lock_type;
+        typedef cc::skip_list::xorshift24 random_level_generator;
+        typedef cds::opt::v::sequential_consistent memory_model;
+    };
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    this->test( m );
+    this->test_split_merge( m );
+}
+
+TYPED_TEST_P( UnrolledSkipListMap, concurrent )
+{
+    typedef typename TestFixture::rcu_type   rcu_type;
+    typedef typename TestFixture::key_type   key_type;
+    typedef typename TestFixture::value_type value_type;
+
+    typedef cc::UnrolledSkipListMap< rcu_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< typename TestFixture::less >
+            ,cc::unrolled_skip_list::chunk_capacity< 8 >
+            ,cds::opt::item_counter< cds::atomicity::item_counter >
+        >::type
+    > map_type;
+
+    map_type m;
+    this->test_concurrent( m );
+}
+
+REGISTER_TYPED_TEST_CASE_P( UnrolledSkipListMap,
+    compare, less, cmpmix, item_counting, chunk_capacity, stat, mutex_xorshift, concurrent
+);
+
+#endif // CDSUNIT_MAP_TEST_UNROLLED_SKIPLIST_RCU_H
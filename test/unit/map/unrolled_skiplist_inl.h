@@ -0,0 +1,135 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Shared test cases of UnrolledSkipListMap, the fixture is defined by the includer
+
+TEST_F( CDSTEST_FIXTURE_NAME, compare )
+{
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::compare< cmp >
+        >::type
+    > map_type;
+
+    map_type m;
+    test( m );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, less )
+{
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< base_class::less >
+        >::type
+    > map_type;
+
+    map_type m;
+    test( m );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, cmpmix )
+{
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< base_class::less >
+            ,cds::opt::compare< cmp >
+        >::type
+    > map_type;
+
+    map_type m;
+    test( m );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, item_counting )
+{
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef cmp compare;
+        typedef cds::atomicity::item_counter item_counter;
+    };
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    test( m );
+    test_split_merge( m );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, chunk_capacity )
+{
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type,
+        typename cc::unrolled_skip_list::make_traits<
+            cds::opt::less< base_class::less >
+            ,cc::unrolled_skip_list::chunk_capacity< 8 >
+            ,cds::opt::item_counter< cds::atomicity::item_counter >
+        >::type
+    > map_type;
+    static_assert( map_type::c_nChunkCapacity == 8, "Wrong chunk capacity" );
+
+    map_type m;
+    test( m );
+    test_split_merge( m );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, stat )
+{
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef base_class::less less;
+        typedef cds::atomicity::item_counter item_counter;
+        typedef cc::unrolled_skip_list::stat<> stat;
+        enum: size_t { chunk_capacity = 16 };
+    };
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    test( m );
+    test_split_merge( m );
+
+    EXPECT_NE( m.statistics().m_nChunkSplit.get(), 0u );
+    EXPECT_NE( m.statistics().m_nChunkMerge.get(), 0u );
+    EXPECT_EQ( m.statistics().m_nChunkIndexFailed.get(), 0u );
+}
+
+TEST_F( CDSTEST_FIXTURE_NAME, mutex_xorshift )
+{
+    struct map_traits: public cc::unrolled_skip_list::traits
+    {
+        typedef cmp compare;
+        typedef cds::atomicity::item_counter item_counter;
+        typedef std::mutex lock_type;
+        typedef cc::skip_list::xorshift24 random_level_generator;
+        typedef cds::opt::v::sequential_consistent memory_model;
+    };
+    typedef cc::UnrolledSkipListMap< gc_type, key_type, value_type, map_traits > map_type;
+
+    map_type m;
+    test( m );
+    test_split_merge( m );
+}
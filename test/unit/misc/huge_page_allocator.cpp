@@ -0,0 +1,174 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/os/alloc_aligned.h>
+#include <cds/opt/buffer.h>
+#include <cds/details/allocator.h>
+#include <cds/container/vyukov_mpmc_cycle_queue.h>
+
+namespace {
+
+    class huge_page_allocator: public ::testing::Test
+    {
+    protected:
+        static size_t const c_nLargeCount = 1024 * 1024;
+
+        template <typename Allocator>
+        void test_large()
+        {
+            typedef typename Allocator::template rebind<size_t>::other allocator_type;
+            allocator_type a;
+
+            size_t * p = a.allocate( c_nLargeCount );
+            ASSERT_TRUE( p != nullptr );
+            EXPECT_EQ( reinterpret_cast<uintptr_t>( p ) % cds::c_nCacheLineSize, 0u );
+
+            cds::OS::huge_page::backing const b = cds::OS::huge_page::get_backing( p );
+#ifdef CDS_OS_HUGE_PAGE_SUPPORT
+            EXPECT_NE( b, cds::OS::huge_page::backing_heap );
+#else
+            EXPECT_EQ( b, cds::OS::huge_page::backing_heap );
+#endif
+            if ( cds::OS::huge_page::is_numa_bound( p )) {
+                EXPECT_NE( b, cds::OS::huge_page::backing_heap );
+            }
+
+            for ( size_t i = 0; i < c_nLargeCount; ++i )
+                p[i] = i;
+            for ( size_t i = 0; i < c_nLargeCount; ++i )
+                EXPECT_EQ( p[i], i );
+
+            a.deallocate( p, c_nLargeCount );
+        }
+    };
+
+    size_t const huge_page_allocator::c_nLargeCount;
+
+    TEST_F( huge_page_allocator, small )
+    {
+        cds::OS::huge_page_allocator<int> a;
+        int * p = a.allocate( 100 );
+        EXPECT_EQ( reinterpret_cast<uintptr_t>( p ) % cds::c_nCacheLineSize, 0u );
+        EXPECT_EQ( cds::OS::huge_page::get_backing( p ), cds::OS::huge_page::backing_heap );
+        EXPECT_FALSE( cds::OS::huge_page::is_numa_bound( p ));
+        for ( int i = 0; i < 100; ++i )
+            p[i] = i;
+        a.deallocate( p, 100 );
+
+        // Small blocks are allocated from the heap even if NUMA policy is specified
+        cds::OS::huge_page_allocator< int, cds::OS::huge_page::interleave > ai;
+        p = ai.allocate( 100 );
+        EXPECT_EQ( cds::OS::huge_page::get_backing( p ), cds::OS::huge_page::backing_heap );
+        EXPECT_FALSE( cds::OS::huge_page::is_numa_bound( p ));
+        ai.deallocate( p, 100 );
+    }
+
+    TEST_F( huge_page_allocator, large )
+    {
+        test_large< cds::OS::huge_page_allocator<int>>();
+    }
+
+    TEST_F( huge_page_allocator, numa )
+    {
+        // The policy may be rejected by the system, for example, if the kernel has no NUMA support;
+        // the memory is usable anyway
+        test_large< cds::OS::huge_page_allocator< int, cds::OS::huge_page::interleave >>();
+        test_large< cds::OS::huge_page_allocator< int, cds::OS::huge_page::policy< cds::OS::huge_page::numa_bind, 1 >>>();
+        test_large< cds::OS::huge_page_allocator< int, cds::OS::huge_page::policy< cds::OS::huge_page::numa_preferred, 1 >>>();
+    }
+
+    TEST_F( huge_page_allocator, min_size )
+    {
+        // All blocks are mapped
+        typedef cds::OS::huge_page_allocator< int, cds::OS::huge_page::policy< cds::OS::huge_page::numa_default, ~uint64_t( 0 ), 1 >> allocator_type;
+        allocator_type a;
+        int * p = a.allocate( 1 );
+#ifdef CDS_OS_HUGE_PAGE_SUPPORT
+        EXPECT_NE( cds::OS::huge_page::get_backing( p ), cds::OS::huge_page::backing_heap );
+#endif
+        *p = 42;
+        a.deallocate( p, 1 );
+    }
+
+    TEST_F( huge_page_allocator, new_block )
+    {
+        // Like FeldmanHashSet head node: NewBlock() allocates more than sizeof(T), Delete() frees one item
+        struct head {
+            size_t  nSize;
+            size_t  arr[1];
+
+            explicit head( size_t n )
+                : nSize( n )
+            {}
+        };
+
+        typedef cds::details::Allocator< head, cds::OS::huge_page_allocator<int>> allocator_type;
+        allocator_type a;
+        head * p = a.NewBlock( sizeof( head ) + sizeof( size_t ) * ( c_nLargeCount - 1 ), c_nLargeCount );
+        EXPECT_EQ( p->nSize, c_nLargeCount );
+#ifdef CDS_OS_HUGE_PAGE_SUPPORT
+        EXPECT_NE( cds::OS::huge_page::get_backing( p ), cds::OS::huge_page::backing_heap );
+#endif
+        for ( size_t i = 0; i < c_nLargeCount; ++i )
+            p->arr[i] = i;
+        a.Delete( p );
+    }
+
+    TEST_F( huge_page_allocator, buffer )
+    {
+        {
+            cds::opt::v::initialized_huge_page_buffer< size_t > buf( c_nLargeCount );
+            EXPECT_EQ( buf.capacity(), c_nLargeCount );
+            for ( size_t i = 0; i < buf.capacity(); ++i )
+                buf[i] = i;
+            EXPECT_EQ( buf[c_nLargeCount - 1], c_nLargeCount - 1 );
+        }
+
+        typedef cds::container::VyukovMPMCCycleQueue< size_t,
+            typename cds::container::vyukov_queue::make_traits<
+                cds::opt::buffer< cds::opt::v::uninitialized_huge_page_buffer< void *, cds::OS::huge_page::interleave >>
+            >::type
+        > queue_type;
+
+        queue_type q( c_nLargeCount );
+        EXPECT_EQ( q.capacity(), c_nLargeCount );
+        for ( size_t i = 0; i < c_nLargeCount; ++i )
+            EXPECT_TRUE( q.push( i ));
+        EXPECT_FALSE( q.push( c_nLargeCount ));
+        for ( size_t i = 0; i < c_nLargeCount; ++i ) {
+            size_t v;
+            ASSERT_TRUE( q.pop( v ));
+            EXPECT_EQ( v, i );
+        }
+        EXPECT_TRUE( q.empty());
+    }
+
+} // namespace
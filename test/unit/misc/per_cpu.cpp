@@ -0,0 +1,126 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/algo/per_cpu.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class per_cpu: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+        }
+    };
+
+    TEST_F( per_cpu, current_processor )
+    {
+        unsigned int const nProcCount = cds::OS::topology::processor_count();
+        ASSERT_GT( nProcCount, 0u );
+
+#if CDS_OS_TYPE == CDS_OS_LINUX && defined(CDS_LINUX_RSEQ_ENABLED) && !defined(CDS_LINUX_NO_sched_getcpu)
+        // rseq fast path agrees with sched_getcpu() unless the thread has been migrated in between
+        if ( cds::threading::Manager::thread_data()->m_pCurrentCpu ) {
+            bool bMatch = false;
+            for ( int i = 0; i < 1000 && !bMatch; ++i ) {
+                unsigned int nCpu = cds::OS::topology::current_processor();
+                bMatch = static_cast<int>( nCpu ) == ::sched_getcpu();
+            }
+            EXPECT_TRUE( bMatch );
+        }
+#endif
+
+        std::vector<std::thread> threads;
+        for ( unsigned int i = 0; i < 4; ++i ) {
+            threads.emplace_back( []() {
+                cds::threading::Manager::attachThread();
+                for ( int k = 0; k < 1000; ++k )
+                    cds::OS::topology::current_processor();
+                cds::threading::Manager::detachThread();
+
+                // not attached thread uses slow path
+                cds::OS::topology::current_processor();
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+    }
+
+    TEST_F( per_cpu, cells )
+    {
+        typedef cds::algo::per_cpu< atomics::atomic<size_t>> counter_type;
+
+        {
+            counter_type c;
+            EXPECT_GE( c.size(), static_cast<size_t>( cds::OS::topology::processor_count()));
+            EXPECT_EQ( c.size() & ( c.size() - 1 ), 0u );
+        }
+
+        counter_type c( 5 );
+        ASSERT_EQ( c.size(), 8u );
+        for ( auto const& cell : c )
+            EXPECT_EQ( cell.load(), 0u );
+
+        // cells do not share cache lines
+        for ( size_t i = 1; i < c.size(); ++i ) {
+            EXPECT_GE( reinterpret_cast<uintptr_t>( &c[i] ) - reinterpret_cast<uintptr_t>( &c[i - 1] ), cds::c_nCacheLineSize );
+        }
+        EXPECT_EQ( reinterpret_cast<uintptr_t>( &c[0] ) % cds::c_nCacheLineSize, 0u );
+
+        size_t const c_nThreadCount = 4;
+        size_t const c_nPassCount = 10000;
+        std::vector<std::thread> threads;
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( [&c]() {
+                cds::threading::Manager::attachThread();
+                for ( size_t k = 0; k < c_nPassCount; ++k )
+                    c.local().fetch_add( 1, atomics::memory_order_relaxed );
+                cds::threading::Manager::detachThread();
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        size_t nTotal = 0;
+        for ( auto const& cell : c )
+            nTotal += cell.load( atomics::memory_order_relaxed );
+        EXPECT_EQ( nTotal, c_nThreadCount * c_nPassCount );
+    }
+
+} // namespace
@@ -0,0 +1,119 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/algo/sharded_counter.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class sharded_counter: public ::testing::Test
+    {
+    protected:
+        static size_t const c_nThreadCount = 4;
+        static size_t const c_nPassCount = 50000;
+
+        template <typename Counter>
+        void test_mt()
+        {
+            Counter c;
+
+            std::vector<std::thread> threads;
+            for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+                threads.emplace_back( [&c, i]() {
+                    cds::threading::Manager::attachThread();
+                    for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                        ++c;
+                        if ( pass & 1 )
+                            c.inc( 2 );
+                        if ( i & 1 )
+                            --c;
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+
+            size_t const nExpected = c_nThreadCount * c_nPassCount * 2 - c_nThreadCount / 2 * c_nPassCount;
+            EXPECT_EQ( c.value(), nExpected );
+        }
+    };
+
+    TEST_F( sharded_counter, item_counter )
+    {
+        typedef cds::atomicity::sharded_item_counter< 8 > counter_type;
+        counter_type c;
+
+        EXPECT_GE( c.shard_count(), 1u );
+        EXPECT_EQ( c.value(), 0u );
+        EXPECT_EQ( c.approx_value(), 0u );
+
+        // the result of increment is approximate: other shards are not counted
+        for ( size_t i = 0; i < 7; ++i )
+            EXPECT_LE( c++, i );
+        EXPECT_EQ( c.value(), 7u );
+        // no shard reaches the batch, nothing is folded yet
+        EXPECT_EQ( c.approx_value(), 0u );
+
+        EXPECT_LE( ++c, 8u );
+        EXPECT_EQ( c.value(), 8u );
+        EXPECT_LE( c.approx_value(), 8u );
+
+        c += 100;
+        EXPECT_EQ( c.value(), 108u );
+        EXPECT_GE( c.approx_value() + c.shard_count() * counter_type::c_nBatch, 108u );
+
+        c -= 100;
+        EXPECT_EQ( c.value(), 8u );
+        for ( size_t i = 0; i < 8; ++i )
+            --c;
+        EXPECT_EQ( c.value(), 0u );
+        EXPECT_EQ( static_cast<size_t>( c ), 0u );
+
+        c.inc( 5 );
+        c.reset();
+        EXPECT_EQ( c.value(), 0u );
+        EXPECT_EQ( c.approx_value(), 0u );
+
+        // event_counter interface
+        c = 10;
+        EXPECT_EQ( c.get(), 10u );
+        EXPECT_EQ( c.approx_value(), 10u );
+    }
+
+    TEST_F( sharded_counter, item_counter_mt )
+    {
+        test_mt< cds::atomicity::sharded_item_counter<>>();
+        test_mt< cds::atomicity::sharded_item_counter< 1 >>();
+    }
+
+} // namespace
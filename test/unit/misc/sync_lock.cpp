@@ -0,0 +1,238 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds/sync/queue_lock.h>
+#include <cds/sync/rw_lock.h>
+#include <cds/sync/spinlock.h>
+#include <cds/sync/compact_monitor.h>
+#include <cds_test/ext_gtest.h>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+namespace {
+
+    static_assert( cds::sync::is_shared_lockable< cds::sync::rw_spin >::value, "rw_spin_lock must be shared lockable" );
+    static_assert( !cds::sync::is_shared_lockable< cds::sync::spin >::value, "spin_lock is not shared lockable" );
+    static_assert( !cds::sync::is_shared_lockable< cds::sync::mcs_lock<> >::value, "mcs_lock is not shared lockable" );
+
+    class SyncLock: public ::testing::Test
+    {
+    protected:
+        static size_t const c_nThreadCount = 4;
+        static size_t const c_nPassCount = 20000;
+
+        template <typename Lock>
+        void test_single()
+        {
+            Lock l;
+            ASSERT_FALSE( l.is_locked());
+
+            l.lock();
+            EXPECT_TRUE( l.is_locked());
+            EXPECT_FALSE( l.try_lock());
+            l.unlock();
+            EXPECT_FALSE( l.is_locked());
+
+            ASSERT_TRUE( l.try_lock());
+            EXPECT_TRUE( l.is_locked());
+            l.unlock();
+            EXPECT_FALSE( l.is_locked());
+
+            {
+                std::unique_lock<Lock> guard( l );
+                EXPECT_TRUE( l.is_locked());
+            }
+            EXPECT_FALSE( l.is_locked());
+
+            // nested locks of different instances
+            Lock l2;
+            l.lock();
+            l2.lock();
+            EXPECT_TRUE( l.is_locked());
+            EXPECT_TRUE( l2.is_locked());
+            l.unlock();
+            EXPECT_FALSE( l.is_locked());
+            EXPECT_TRUE( l2.is_locked());
+            l2.unlock();
+            EXPECT_FALSE( l2.is_locked());
+        }
+
+        template <typename Lock>
+        void test_mt()
+        {
+            Lock l;
+            size_t nCounter = 0;
+
+            std::vector<std::thread> threads;
+            for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+                threads.emplace_back( [&l, &nCounter]() {
+                    for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                        if ( pass & 1 ) {
+                            std::unique_lock<Lock> guard( l );
+                            ++nCounter;
+                        }
+                        else {
+                            while ( !l.try_lock())
+                                std::this_thread::yield();
+                            ++nCounter;
+                            l.unlock();
+                        }
+                    }
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+
+            EXPECT_FALSE( l.is_locked());
+            EXPECT_EQ( nCounter, c_nThreadCount * c_nPassCount );
+        }
+    };
+
+    TEST_F( SyncLock, ticket_lock )
+    {
+        test_single< cds::sync::ticket_lock<> >();
+        test_mt< cds::sync::ticket_lock<> >();
+    }
+
+    TEST_F( SyncLock, mcs_lock )
+    {
+        test_single< cds::sync::mcs_lock<> >();
+        test_mt< cds::sync::mcs_lock<> >();
+    }
+
+    TEST_F( SyncLock, clh_lock )
+    {
+        test_single< cds::sync::clh_lock<> >();
+        test_mt< cds::sync::clh_lock<> >();
+    }
+
+    TEST_F( SyncLock, rw_spin_lock )
+    {
+        typedef cds::sync::rw_spin lock_type;
+
+        test_single< lock_type >();
+        test_mt< lock_type >();
+
+        lock_type l;
+        l.lock_shared();
+        EXPECT_TRUE( l.is_locked());
+        EXPECT_TRUE( l.try_lock_shared());
+        EXPECT_FALSE( l.try_lock());
+        l.unlock_shared();
+        EXPECT_FALSE( l.try_lock());
+        l.unlock_shared();
+        EXPECT_FALSE( l.is_locked());
+
+        l.lock();
+        EXPECT_FALSE( l.try_lock_shared());
+        l.unlock();
+        EXPECT_FALSE( l.is_locked());
+
+        // readers and writers
+        size_t nCounter = 0;
+        atomics::atomic<size_t> nReadErrors( 0 );
+        std::vector<std::thread> threads;
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( [&l, &nCounter]() {
+                for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                    std::unique_lock<lock_type> guard( l );
+                    ++nCounter;
+                    ++nCounter;
+                }
+            });
+            threads.emplace_back( [&l, &nCounter, &nReadErrors]() {
+                for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                    l.lock_shared();
+                    if ( nCounter & 1 )
+                        nReadErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                    l.unlock_shared();
+                }
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        EXPECT_FALSE( l.is_locked());
+        EXPECT_EQ( nCounter, c_nThreadCount * c_nPassCount * 2 );
+        EXPECT_EQ( nReadErrors.load(), 0u );
+    }
+
+
+    TEST_F( SyncLock, compact_monitor )
+    {
+        typedef cds::sync::compact_monitor< cds::backoff::yield, true > monitor_type;
+        struct node {
+            monitor_type::node_injection m_SyncMonitorInjection;
+            size_t nCounter = 0;
+        };
+
+        // two slots and two spins only: nodes share slots and contended threads are parked
+        monitor_type m( 2, 2 );
+        node arrNodes[3];
+
+        m.lock( arrNodes[0] );
+        EXPECT_FALSE( arrNodes[0].m_SyncMonitorInjection.check_free());
+        EXPECT_TRUE( arrNodes[1].m_SyncMonitorInjection.check_free());
+        m.unlock( arrNodes[0] );
+        EXPECT_TRUE( arrNodes[0].m_SyncMonitorInjection.check_free());
+        {
+            monitor_type::scoped_lock<node> guard( m, arrNodes[1] );
+            EXPECT_FALSE( arrNodes[1].m_SyncMonitorInjection.check_free());
+        }
+        EXPECT_TRUE( arrNodes[1].m_SyncMonitorInjection.check_free());
+        EXPECT_EQ( m.statistics().m_nLockContention.get(), 0u );
+
+        std::vector<std::thread> threads;
+        for ( size_t i = 0; i < c_nThreadCount * 2; ++i ) {
+            threads.emplace_back( [&m, &arrNodes, i]() {
+                for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                    node& n = arrNodes[( pass + i ) % 3];
+                    monitor_type::scoped_lock<node> guard( m, n );
+                    ++n.nCounter;
+                }
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        size_t nTotal = 0;
+        for ( auto& n : arrNodes ) {
+            EXPECT_TRUE( n.m_SyncMonitorInjection.check_free());
+            nTotal += n.nCounter;
+        }
+        EXPECT_EQ( nTotal, c_nThreadCount * 2 * c_nPassCount );
+
+        auto const& stat = m.statistics();
+        EXPECT_EQ( stat.m_nLockCount.get(), stat.m_nUnlockCount.get());
+        EXPECT_EQ( stat.m_nLockCount.get(), nTotal + 2 );
+    }
+
+} // namespace
@@ -0,0 +1,206 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/memory/thread_cached_allocator.h>
+#include <cds/details/allocator.h>
+#include <cds/container/skip_list_map_hp.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class thread_cached_allocator: public ::testing::Test
+    {
+    protected:
+        static size_t const c_nThreadCount = 4;
+        static size_t const c_nItemCount = 2000;
+
+        struct foo {
+            size_t  nKey;
+            char    arr[40];
+
+            foo()
+                : nKey( 0 )
+            {}
+
+            explicit foo( size_t n )
+                : nKey( n )
+            {}
+        };
+
+        struct large {
+            char    arr[cds::memory::thread_cached::c_nMaxBlockSize + 1];
+        };
+    };
+
+    TEST_F( thread_cached_allocator, reuse )
+    {
+        typedef cds::details::Allocator< foo, cds::memory::thread_cached_allocator<int>> allocator_type;
+        allocator_type a;
+
+        // Flush the blocks cached by the previous tests
+        cds::memory::thread_cached::flush();
+
+        foo * p = a.New( 1u );
+        EXPECT_EQ( p->nKey, 1u );
+        EXPECT_EQ( reinterpret_cast<uintptr_t>( p ) % cds::memory::thread_cached::c_nGranularity, 0u );
+        a.Delete( p );
+
+        // The block freed goes to the thread cache and is reused by the next allocation
+        cds::memory::thread_cached::stat const before = cds::memory::thread_cached::statistics();
+        for ( size_t i = 0; i < 100; ++i ) {
+            foo * q = a.New( i );
+            EXPECT_EQ( q, p );
+            EXPECT_EQ( q->nKey, i );
+            a.Delete( q );
+        }
+        cds::memory::thread_cached::stat const after = cds::memory::thread_cached::statistics();
+        EXPECT_EQ( after.nBlockCreated, before.nBlockCreated );
+        EXPECT_EQ( after.nDepotGet, before.nDepotGet );
+
+        // NewBlock allocates a block greater than sizeof(foo) but Delete does not pass the size:
+        // the block should return to its own size class
+        foo * pBlock = a.NewBlock( sizeof( foo ) * 3, 5u );
+        EXPECT_EQ( pBlock->nKey, 5u );
+        a.Delete( pBlock );
+        p = a.New( 6u );
+        EXPECT_NE( p, pBlock );
+        a.Delete( p );
+        p = reinterpret_cast<foo *>( a.NewBlock( sizeof( foo ) * 3, 7u ));
+        EXPECT_EQ( p, pBlock );
+        a.Delete( p );
+
+        // Large blocks bypass the pool
+        typedef cds::details::Allocator< large, cds::memory::thread_cached_allocator<int>> large_allocator;
+        large * pLarge = large_allocator().New();
+        EXPECT_EQ( reinterpret_cast<uintptr_t>( pLarge ) % cds::memory::thread_cached::c_nGranularity, 0u );
+        large_allocator().Delete( pLarge );
+        EXPECT_EQ( cds::memory::thread_cached::statistics().nLargeAlloc, after.nLargeAlloc + 1 );
+
+        // Array allocation
+        size_t * arr = cds::details::Allocator< size_t, cds::memory::thread_cached_allocator<int>>().NewArray( 10, size_t( 42 ));
+        for ( size_t i = 0; i < 10; ++i )
+            EXPECT_EQ( arr[i], 42u );
+        cds::details::Allocator< size_t, cds::memory::thread_cached_allocator<int>>().Delete( arr, 10 );
+    }
+
+    TEST_F( thread_cached_allocator, cross_thread )
+    {
+        typedef cds::details::Allocator< foo, cds::memory::thread_cached_allocator<int>> allocator_type;
+        static size_t const nCount = cds::memory::thread_cached::c_nCacheCapacity * 8;
+
+        // The producer allocates the blocks, the consumer frees them:
+        // the consumer cache overflows and the blocks are moved to the depot
+        std::vector<foo *> arr;
+        std::thread producer( [&arr]() {
+            allocator_type a;
+            for ( size_t i = 0; i < nCount; ++i )
+                arr.push_back( a.New( i ));
+        });
+        producer.join();
+
+        cds::memory::thread_cached::stat const before = cds::memory::thread_cached::statistics();
+        std::thread consumer( [&arr]() {
+            allocator_type a;
+            for ( size_t i = 0; i < nCount; ++i ) {
+                EXPECT_EQ( arr[i]->nKey, i );
+                a.Delete( arr[i] );
+            }
+        });
+        consumer.join();
+
+        cds::memory::thread_cached::stat const after = cds::memory::thread_cached::statistics();
+        // All blocks are in the depot: the consumer's cache is flushed on thread exit
+        EXPECT_EQ( after.nDepotPut - before.nDepotPut, nCount );
+
+        // Other thread reuses the blocks without allocating new ones
+        std::thread reuser( [&arr]() {
+            allocator_type a;
+            for ( size_t i = 0; i < nCount; ++i )
+                arr[i] = a.New( i );
+            for ( size_t i = 0; i < nCount; ++i )
+                a.Delete( arr[i] );
+        });
+        reuser.join();
+        EXPECT_EQ( cds::memory::thread_cached::statistics().nBlockCreated, after.nBlockCreated );
+    }
+
+    TEST_F( thread_cached_allocator, container )
+    {
+        typedef cds::container::SkipListMap< cds::gc::HP, size_t, foo,
+            typename cds::container::skip_list::make_traits<
+                cds::opt::allocator< cds::memory::thread_cached_allocator<int>>
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+            >::type
+        > map_type;
+
+        cds::gc::hp::GarbageCollector::Construct( map_type::c_nHazardPtrCount + 1, c_nThreadCount + 1, 16 );
+        cds::threading::Manager::attachThread();
+        {
+            map_type m;
+
+            std::vector<std::thread> threads;
+            for ( size_t t = 0; t < c_nThreadCount; ++t ) {
+                threads.emplace_back( [&m, t]() {
+                    cds::threading::Manager::attachThread();
+                    for ( size_t pass = 0; pass < 10; ++pass ) {
+                        for ( size_t i = t; i < c_nItemCount; i += c_nThreadCount )
+                            EXPECT_TRUE( m.insert( i, foo( i )));
+                        for ( size_t i = t; i < c_nItemCount; i += c_nThreadCount ) {
+                            EXPECT_TRUE( m.find( i, [i]( std::pair<size_t const, foo>& item ) {
+                                EXPECT_EQ( item.second.nKey, i );
+                            }));
+                        }
+                        if ( pass < 9 ) {
+                            for ( size_t i = t; i < c_nItemCount; i += c_nThreadCount )
+                                EXPECT_TRUE( m.erase( i ));
+                        }
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+
+            EXPECT_EQ( m.size(), static_cast<size_t>( c_nItemCount ));
+            size_t nExpected = 0;
+            for ( auto it = m.cbegin(); it != m.cend(); ++it ) {
+                EXPECT_EQ( it->first, nExpected );
+                EXPECT_EQ( it->second.nKey, nExpected );
+                ++nExpected;
+            }
+            EXPECT_EQ( nExpected, static_cast<size_t>( c_nItemCount ));
+        }
+        cds::threading::Manager::detachThread();
+        cds::gc::hp::GarbageCollector::Destruct( true );
+    }
+
+} // namespace
@@ -0,0 +1,181 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/threading/thread_slot.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class thread_slot: public ::testing::Test
+    {
+    protected:
+        struct item {
+            int nValue;
+            int nCleanupCount;
+
+            item()
+                : nValue( 0 )
+                , nCleanupCount( 0 )
+            {}
+        };
+
+        static void cleanup( item * p )
+        {
+            ++p->nCleanupCount;
+        }
+
+        void SetUp()
+        {
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+        }
+    };
+
+    TEST_F( thread_slot, get_reset )
+    {
+        typedef cds::threading::thread_slot< item > slot_type;
+
+        item i1, i2;
+        {
+            slot_type s1( cleanup );
+            slot_type s2( cleanup );
+            EXPECT_NE( s1.id(), s2.id());
+
+            EXPECT_TRUE( s1.get() == nullptr );
+            EXPECT_TRUE( s2.get() == nullptr );
+
+            s1.reset( &i1 );
+            EXPECT_EQ( s1.get(), &i1 );
+            EXPECT_TRUE( s2.get() == nullptr );
+
+            s2.reset( &i2 );
+            EXPECT_EQ( s1.get(), &i1 );
+            EXPECT_EQ( s2.get(), &i2 );
+
+            s1.reset( nullptr );
+            EXPECT_TRUE( s1.get() == nullptr );
+            EXPECT_EQ( s2.get(), &i2 );
+
+            s1.reset( &i2 );
+            EXPECT_EQ( s1.get(), &i2 );
+        }
+
+        // cleanup is not called when the slot is destroyed
+        EXPECT_EQ( i1.nCleanupCount, 0 );
+        EXPECT_EQ( i2.nCleanupCount, 0 );
+    }
+
+    TEST_F( thread_slot, reused_id )
+    {
+        typedef cds::threading::thread_slot< item > slot_type;
+
+        item i1;
+        size_t nId;
+        {
+            slot_type s1( cleanup );
+            nId = s1.id();
+            s1.reset( &i1 );
+            EXPECT_EQ( s1.get(), &i1 );
+        }
+
+        // The id of the destroyed slot is reused, the value of old slot is not visible
+        slot_type s2( cleanup );
+        EXPECT_EQ( s2.id(), nId );
+        EXPECT_TRUE( s2.get() == nullptr );
+        EXPECT_EQ( i1.nCleanupCount, 0 );
+    }
+
+    TEST_F( thread_slot, detach )
+    {
+        typedef cds::threading::thread_slot< item > slot_type;
+
+        const size_t c_nThreadCount = 8;
+        std::vector< item > items( c_nThreadCount );
+        slot_type s( cleanup );
+
+        {
+            std::vector< std::thread > threads;
+            for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+                threads.emplace_back( [&s, &items, i]() {
+                    cds::threading::Manager::attachThread();
+                    EXPECT_TRUE( s.get() == nullptr );
+                    s.reset( &items[i] );
+                    EXPECT_EQ( s.get(), &items[i] );
+                    s.get()->nValue = static_cast<int>( i );
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+        }
+
+        // each thread calls cleanup for its own item on detaching
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            EXPECT_EQ( items[i].nValue, static_cast<int>( i ));
+            EXPECT_EQ( items[i].nCleanupCount, 1 );
+        }
+        EXPECT_TRUE( s.get() == nullptr );
+    }
+
+    TEST_F( thread_slot, detach_slot )
+    {
+        typedef cds::threading::thread_slot< item > slot_type;
+
+        item i1;
+        slot_type s( cleanup );
+        atomics::atomic<int> nStage( 0 );
+
+        std::thread t( [&s, &i1, &nStage]() {
+            cds::threading::Manager::attachThread();
+            s.reset( &i1 );
+            nStage.store( 1, atomics::memory_order_release );
+            while ( nStage.load( atomics::memory_order_acquire ) != 2 )
+                std::this_thread::yield();
+            cds::threading::Manager::detachThread();
+        });
+
+        while ( nStage.load( atomics::memory_order_acquire ) != 1 )
+            std::this_thread::yield();
+
+        // After detach() the cleanup function is not called for the threads being detached
+        s.detach();
+        nStage.store( 2, atomics::memory_order_release );
+        t.join();
+
+        EXPECT_EQ( i1.nCleanupCount, 0 );
+    }
+
+} // namespace
@@ -0,0 +1,381 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/urcu/general_instant.h>
+#include <cds/urcu/general_buffered.h>
+#include <cds/urcu/general_threaded.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+    class urcu_gp: public ::testing::Test
+    {
+    protected:
+        struct item {
+            atomics::atomic<size_t> nValue;
+            atomics::atomic<bool>   bAlive;
+        };
+
+        static size_t const c_nReaderCount = 3;
+        static size_t const c_nUpdateCount = 2000;
+
+        // Readers must never see an item the updater has reclaimed after synchronize()
+        template <typename RCU>
+        void test( bool bExpedited = false, size_t nReaderCount = c_nReaderCount, size_t nUpdateCount = c_nUpdateCount )
+        {
+            RCU rcu;
+            typedef typename RCU::scoped_lock rcu_lock;
+
+            item items[2];
+            items[0].nValue.store( 0 );
+            items[0].bAlive.store( true );
+            items[1].nValue.store( 0 );
+            items[1].bAlive.store( false );
+
+            atomics::atomic<item *> pCurrent( &items[0] );
+            atomics::atomic<bool> bStop( false );
+            atomics::atomic<size_t> nErrors( 0 );
+
+            std::vector<std::thread> readers;
+            for ( size_t i = 0; i < nReaderCount; ++i ) {
+                readers.emplace_back( [&]() {
+                    cds::threading::Manager::attachThread();
+                    while ( !bStop.load( atomics::memory_order_relaxed )) {
+                        rcu_lock l;
+                        item * p = pCurrent.load( atomics::memory_order_acquire );
+                        if ( !p->bAlive.load( atomics::memory_order_relaxed ))
+                            nErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                        p->nValue.load( atomics::memory_order_relaxed );
+                        if ( !p->bAlive.load( atomics::memory_order_relaxed ))
+                            nErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+
+            cds::threading::Manager::attachThread();
+            for ( size_t n = 0; n < nUpdateCount; ++n ) {
+                item * pOld = &items[n & 1];
+                item * pNew = &items[( n + 1 ) & 1];
+                pNew->nValue.store( n, atomics::memory_order_relaxed );
+                pNew->bAlive.store( true, atomics::memory_order_relaxed );
+                pCurrent.store( pNew, atomics::memory_order_release );
+
+                if ( bExpedited )
+                    rcu.synchronize_expedited();
+                else
+                    rcu.synchronize();
+                // No reader can access pOld now
+                pOld->bAlive.store( false, atomics::memory_order_relaxed );
+            }
+            cds::threading::Manager::detachThread();
+
+            bStop.store( true );
+            for ( auto& t : readers )
+                t.join();
+
+            EXPECT_EQ( nErrors.load(), 0u );
+        }
+
+        template <typename RCU>
+        void test_poll_state( RCU& rcu )
+        {
+            cds::threading::Manager::attachThread();
+
+            uint64_t cookie = rcu.get_state();
+            EXPECT_FALSE( rcu.poll_state( cookie ));
+            rcu.synchronize();
+            EXPECT_TRUE( rcu.poll_state( cookie ));
+
+            // The grace period has elapsed, no wait
+            rcu.cond_synchronize( cookie );
+
+            uint64_t cookie2 = rcu.get_state();
+            EXPECT_GT( cookie2, cookie );
+            EXPECT_FALSE( rcu.poll_state( cookie2 ));
+            rcu.cond_synchronize( cookie2 );
+            EXPECT_TRUE( rcu.poll_state( cookie2 ));
+            EXPECT_TRUE( rcu.poll_state( cookie ));
+
+            cds::threading::Manager::detachThread();
+        }
+
+        struct batch_item {
+            atomics::atomic<bool>  bAlive;
+            batch_item *           pNext;
+        };
+
+        static atomics::atomic<size_t> s_nDisposed;
+
+        static void dispose_item( batch_item * p )
+        {
+            p->bAlive.store( false, atomics::memory_order_relaxed );
+            s_nDisposed.fetch_add( 1, atomics::memory_order_relaxed );
+        }
+
+        static size_t const c_nWriterCount = 3;
+        static size_t const c_nRetireCount = 20000;
+
+        // Writers replace the current item and retire the old one; readers must never see a disposed item
+        template <typename RCU>
+        void test_batch( RCU& rcu )
+        {
+            typedef typename RCU::scoped_lock rcu_lock;
+
+            std::vector<batch_item> items( c_nWriterCount * ( c_nRetireCount + 1 ));
+            for ( auto& i : items )
+                i.bAlive.store( true );
+
+            s_nDisposed.store( 0 );
+            atomics::atomic<batch_item *> pCurrent( &items.back());
+            atomics::atomic<bool> bStop( false );
+            atomics::atomic<size_t> nErrors( 0 );
+
+            std::vector<std::thread> readers;
+            for ( size_t i = 0; i < c_nReaderCount; ++i ) {
+                readers.emplace_back( [&]() {
+                    cds::threading::Manager::attachThread();
+                    while ( !bStop.load( atomics::memory_order_relaxed )) {
+                        rcu_lock l;
+                        batch_item * p = pCurrent.load( atomics::memory_order_acquire );
+                        if ( !p->bAlive.load( atomics::memory_order_relaxed ))
+                            nErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+
+            std::vector<std::thread> writers;
+            for ( size_t i = 0; i < c_nWriterCount; ++i ) {
+                writers.emplace_back( [&, i]() {
+                    cds::threading::Manager::attachThread();
+                    for ( size_t n = 0; n < c_nRetireCount; ++n ) {
+                        batch_item * pOld = pCurrent.exchange( &items[i * c_nRetireCount + n], atomics::memory_order_acq_rel );
+                        rcu.retire_ptr( pOld, reinterpret_cast<cds::urcu::free_retired_ptr_func>( dispose_item ));
+                    }
+                    // The callback list of the thread is moved to pending batches
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : writers )
+                t.join();
+
+            bStop.store( true );
+            for ( auto& t : readers )
+                t.join();
+
+            EXPECT_EQ( nErrors.load(), 0u );
+
+            // Frees all pending batches
+            cds::threading::Manager::attachThread();
+            rcu.synchronize();
+            cds::threading::Manager::detachThread();
+            EXPECT_EQ( s_nDisposed.load(), c_nWriterCount * c_nRetireCount );
+        }
+    };
+
+    atomics::atomic<size_t> urcu_gp::s_nDisposed( 0 );
+
+    struct domain_slow {};
+    struct domain_fast {};
+
+    // A reader holding the lock in one domain must not delay the grace periods of another domain
+    template <typename SlowRCU, typename FastRCU>
+    void test_domains()
+    {
+        SlowRCU slowRCU;
+        FastRCU fastRCU;
+
+        atomics::atomic<int> nReaderState( 0 );  // 1 - locked, 2 - release
+        std::thread reader( [&]() {
+            cds::threading::Manager::attachThread();
+            {
+                typename SlowRCU::scoped_lock l;
+                nReaderState.store( 1, atomics::memory_order_release );
+                while ( nReaderState.load( atomics::memory_order_acquire ) != 2 )
+                    std::this_thread::yield();
+            }
+            cds::threading::Manager::detachThread();
+        });
+
+        while ( nReaderState.load( atomics::memory_order_acquire ) != 1 )
+            std::this_thread::yield();
+
+        cds::threading::Manager::attachThread();
+        uint64_t slowCookie = slowRCU.get_state();
+
+        // The other domain does not see the reader
+        for ( int i = 0; i < 100; ++i ) {
+            uint64_t cookie = fastRCU.get_state();
+            fastRCU.synchronize();
+            EXPECT_TRUE( fastRCU.poll_state( cookie ));
+        }
+        EXPECT_FALSE( slowRCU.poll_state( slowCookie ));
+
+        atomics::atomic<bool> bDone( false );
+        std::thread updater( [&]() {
+            cds::threading::Manager::attachThread();
+            slowRCU.synchronize();
+            bDone.store( true, atomics::memory_order_release );
+            cds::threading::Manager::detachThread();
+        });
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ));
+        EXPECT_FALSE( bDone.load( atomics::memory_order_acquire ));
+        EXPECT_FALSE( slowRCU.poll_state( slowCookie ));
+
+        nReaderState.store( 2, atomics::memory_order_release );
+        updater.join();
+        reader.join();
+
+        EXPECT_TRUE( bDone.load());
+        EXPECT_TRUE( slowRCU.poll_state( slowCookie ));
+        cds::threading::Manager::detachThread();
+    }
+
+    TEST_F( urcu_gp, general_instant )
+    {
+        test< cds::urcu::gc< cds::urcu::general_instant<>>>();
+    }
+
+    TEST_F( urcu_gp, general_buffered )
+    {
+        test< cds::urcu::gc< cds::urcu::general_buffered<>>>();
+    }
+
+    TEST_F( urcu_gp, general_instant_expedited )
+    {
+        test< cds::urcu::gc< cds::urcu::general_instant<>>>( true );
+    }
+
+    TEST_F( urcu_gp, general_buffered_expedited )
+    {
+        test< cds::urcu::gc< cds::urcu::general_buffered<>>>( true );
+    }
+
+    TEST_F( urcu_gp, general_threaded_expedited )
+    {
+        test< cds::urcu::gc< cds::urcu::general_threaded<>>>( true );
+    }
+
+    TEST_F( urcu_gp, many_readers )
+    {
+        test< cds::urcu::gc< cds::urcu::general_buffered<>>>( false, 16, 200 );
+        test< cds::urcu::gc< cds::urcu::general_instant<>>>( true, 16, 200 );
+    }
+
+    TEST_F( urcu_gp, poll_state )
+    {
+        {
+            cds::urcu::gc< cds::urcu::general_instant<>> rcu;
+            test_poll_state( rcu );
+        }
+        {
+            cds::urcu::gc< cds::urcu::general_buffered<>> rcu;
+            test_poll_state( rcu );
+        }
+        {
+            cds::urcu::gc< cds::urcu::general_threaded<>> rcu;
+            test_poll_state( rcu );
+        }
+    }
+
+    TEST_F( urcu_gp, general_buffered_batch )
+    {
+        cds::urcu::gc< cds::urcu::general_buffered<>> rcu( 1024, 64 );
+        EXPECT_EQ( rcu.batch_size(), 64u );
+        test_batch( rcu );
+    }
+
+    TEST_F( urcu_gp, general_buffered_no_batch )
+    {
+        cds::urcu::gc< cds::urcu::general_buffered<>> rcu( 1024 );
+        EXPECT_EQ( rcu.batch_size(), 0u );
+        test_batch( rcu );
+    }
+
+    TEST_F( urcu_gp, general_buffered_batch_destruct )
+    {
+        s_nDisposed.store( 0 );
+        std::vector<batch_item> items( 100 );
+        {
+            cds::urcu::gc< cds::urcu::general_buffered<>> rcu( 1024, 64 );
+            cds::threading::Manager::attachThread();
+            for ( auto& i : items )
+                rcu.retire_ptr( &i, reinterpret_cast<cds::urcu::free_retired_ptr_func>( dispose_item ));
+
+            // One full batch is pending, the rest is in the thread's callback list
+            EXPECT_EQ( s_nDisposed.load(), 0u );
+            cds::threading::Manager::detachThread();
+        }
+        EXPECT_EQ( s_nDisposed.load(), items.size());
+    }
+
+    TEST_F( urcu_gp, general_instant_domain )
+    {
+        test< cds::urcu::gc< cds::urcu::general_instant_domain< domain_fast >>>();
+    }
+
+    TEST_F( urcu_gp, general_buffered_domain )
+    {
+        test< cds::urcu::gc< cds::urcu::general_buffered_domain< domain_fast >>>();
+    }
+
+    TEST_F( urcu_gp, general_threaded_domain )
+    {
+        test< cds::urcu::gc< cds::urcu::general_threaded_domain< domain_fast >>>();
+    }
+
+    TEST_F( urcu_gp, independent_domains )
+    {
+        test_domains<
+            cds::urcu::gc< cds::urcu::general_buffered_domain< domain_slow >>,
+            cds::urcu::gc< cds::urcu::general_buffered_domain< domain_fast >>
+        >();
+        test_domains<
+            cds::urcu::gc< cds::urcu::general_instant_domain< domain_slow >>,
+            cds::urcu::gc< cds::urcu::general_instant_domain< domain_fast >>
+        >();
+
+        // The global singleton and a domain of the same flavour are independent too
+        test_domains<
+            cds::urcu::gc< cds::urcu::general_buffered<>>,
+            cds::urcu::gc< cds::urcu::general_buffered_domain< domain_fast >>
+        >();
+        test_domains<
+            cds::urcu::gc< cds::urcu::general_buffered_domain< domain_slow >>,
+            cds::urcu::gc< cds::urcu::general_buffered<>>
+        >();
+    }
+
+} // namespace
@@ -67,6 +67,25 @@ namespace cds_test {
         test( pq );
     }
 
+    TEST_F( FCPQueue, deque_hierarchical_stat )
+    {
+        typedef cds::container::FCPriorityQueue<
+            value_type
+            ,std::priority_queue<
+                value_type
+                ,std::deque<value_type>
+                ,less
+            >
+            ,cds::container::fcpqueue::make_traits<
+                cds::opt::stat< cds::container::fcpqueue::stat<> >
+                ,cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        > pqueue_type;
+
+        pqueue_type pq;
+        test( pq );
+    }
+
     TEST_F( FCPQueue, deque_stat_single_mutex_single_condvar )
     {
         typedef cds::container::FCPriorityQueue<
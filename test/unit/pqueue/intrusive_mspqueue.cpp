@@ -144,10 +144,46 @@ namespace {
                 ASSERT_EQ( disp.m_nCallCount, pq.capacity());
             }
         }
+
+        template <class PQueue>
+        void test_growable( PQueue& pq )
+        {
+            static_assert( PQueue::c_bGrowable, "The heap should be growable" );
+
+            data_array<value_type> arr( base_class::c_nCapacity * 4 );
+            value_type * pFirst = arr.begin();
+            value_type * pLast = arr.end();
+
+            ASSERT_TRUE( pq.empty());
+            size_t const nInitialCapacity = pq.capacity();
+            ASSERT_LT( nInitialCapacity, arr.size());
+
+            // Push test: the heap grows instead of failing
+            size_t nSize = 0;
+            for ( value_type * p = pFirst; p < pLast; ++p ) {
+                ASSERT_TRUE( pq.push( *p ));
+                ASSERT_EQ( pq.size(), ++nSize );
+                ASSERT_LE( pq.size(), pq.capacity());
+            }
+            ASSERT_GT( pq.capacity(), nInitialCapacity );
+
+            // Pop test: the order is strict
+            key_type nPrev = base_class::c_nMinValue + key_type( arr.size());
+            while ( !pq.empty()) {
+                value_type * p = pq.pop();
+                ASSERT_TRUE( p != nullptr );
+                EXPECT_EQ( p->k, nPrev - 1 );
+                nPrev = p->k;
+                ASSERT_EQ( pq.size(), --nSize );
+            }
+            EXPECT_EQ( nPrev, base_class::c_nMinValue );
+            ASSERT_TRUE( pq.pop() == nullptr );
+        }
     };
 
     typedef cds::opt::v::initialized_dynamic_buffer< char > dyn_buffer_type;
     typedef cds::opt::v::initialized_static_buffer< char, IntrusiveMSPQueue::c_nCapacity > static_buffer_type;
+    typedef cds::opt::v::initialized_segmented_buffer< char > segmented_buffer_type;
 
     TEST_F( IntrusiveMSPQueue, dynamic )
     {
@@ -267,4 +303,31 @@ namespace {
         test( *pq );
     }
 
+    TEST_F( IntrusiveMSPQueue, segmented )
+    {
+        struct traits : public cds::intrusive::mspriority_queue::traits
+        {
+            typedef segmented_buffer_type buffer;
+        };
+        typedef cds::intrusive::MSPriorityQueue< value_type, traits > pqueue;
+
+        pqueue pq( 0 );
+        ASSERT_EQ( pq.capacity(), 1u );
+        test_growable( pq );
+    }
+
+    TEST_F( IntrusiveMSPQueue, segmented_less_mutex )
+    {
+        typedef cds::intrusive::MSPriorityQueue< value_type,
+            cds::intrusive::mspriority_queue::make_traits<
+                cds::opt::buffer< segmented_buffer_type >
+                ,cds::opt::less< less >
+                ,cds::opt::lock_type<std::mutex>
+            >::type
+        > pqueue;
+
+        pqueue pq( 16 );
+        test_growable( pq );
+    }
+
 } // namespace
@@ -160,10 +160,64 @@ namespace {
                 ASSERT_EQ( disp.m_nCallCount, pq.capacity());
             }
         }
+
+        template <class PQueue>
+        void test_growable( PQueue& pq )
+        {
+            static_assert( PQueue::c_bGrowable, "The heap should be growable" );
+
+            data_array<value_type> arr( base_class::c_nCapacity * 4 );
+            value_type * pFirst = arr.begin();
+            value_type * pLast = arr.end();
+
+            ASSERT_TRUE( pq.empty());
+            ASSERT_EQ( pq.size(), 0u );
+            size_t const nInitialCapacity = pq.capacity();
+            ASSERT_LT( nInitialCapacity, arr.size());
+
+            // Push test: the heap grows instead of failing
+            size_t nSize = 0;
+            for ( value_type * p = pFirst; p < pLast; ++p ) {
+                if ( nSize & 1 )
+                    ASSERT_TRUE( pq.push( *p ));
+                else
+                    ASSERT_TRUE( pq.emplace( p->k, p->v ));
+                ASSERT_EQ( pq.size(), ++nSize );
+                ASSERT_LE( pq.size(), pq.capacity());
+            }
+            ASSERT_GT( pq.capacity(), nInitialCapacity );
+
+            // Pop test: the order is strict
+            key_type nPrev = base_class::c_nMinValue + key_type( arr.size());
+            value_type kv( 0 );
+            while ( !pq.empty()) {
+                ASSERT_TRUE( pq.pop( kv ));
+                EXPECT_EQ( kv.k, nPrev - 1 );
+                nPrev = kv.k;
+                ASSERT_EQ( pq.size(), --nSize );
+            }
+            EXPECT_EQ( nPrev, base_class::c_nMinValue );
+            ASSERT_FALSE( pq.pop( kv ));
+
+            // The capacity is not shrunk, the next pushes use the segments allocated
+            size_t const nCapacity = pq.capacity();
+            for ( value_type * p = pFirst; p < pLast; ++p )
+                ASSERT_TRUE( pq.push( *p ));
+            ASSERT_EQ( pq.capacity(), nCapacity );
+            ASSERT_EQ( pq.size(), arr.size());
+
+            {
+                disposer disp;
+                pq.clear_with( std::ref( disp ));
+                ASSERT_TRUE( pq.empty());
+                ASSERT_EQ( disp.m_nCallCount, arr.size());
+            }
+        }
     };
 
     typedef cds::opt::v::initialized_dynamic_buffer< char > dyn_buffer_type;
     typedef cds::opt::v::initialized_static_buffer< char, MSPQueue::c_nCapacity > static_buffer_type;
+    typedef cds::opt::v::initialized_segmented_buffer< char > segmented_buffer_type;
 
     TEST_F( MSPQueue, dynamic )
     {
@@ -282,4 +336,32 @@ namespace {
         test( *pq );
     }
 
+    TEST_F( MSPQueue, segmented )
+    {
+        typedef cds::container::MSPriorityQueue< value_type,
+            cds::container::mspriority_queue::make_traits<
+                cds::opt::buffer< segmented_buffer_type >
+            >::type
+        > pqueue;
+
+        pqueue pq( 2 );
+        test_growable( pq );
+    }
+
+    TEST_F( MSPQueue, segmented_cmp_stat )
+    {
+        typedef cds::container::MSPriorityQueue< value_type,
+            cds::container::mspriority_queue::make_traits<
+                cds::opt::buffer< segmented_buffer_type >
+                ,cds::opt::compare< compare >
+                ,cds::opt::stat< cds::container::mspriority_queue::stat<> >
+            >::type
+        > pqueue;
+
+        pqueue pq( 100 );
+        ASSERT_EQ( pq.capacity(), 127u );
+        test_growable( pq );
+        EXPECT_EQ( pq.statistics().m_nPushFailCount.get(), 0u );
+    }
+
 } // namespace
@@ -0,0 +1,240 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "test_data.h"
+#include <cds/container/multi_priority_queue.h>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+    struct disposer {
+        size_t   m_nCallCount;
+
+        disposer()
+            : m_nCallCount( 0 )
+        {}
+
+        template <typename T>
+        void operator()( T& )
+        {
+            ++m_nCallCount;
+        }
+    };
+
+    class MultiPQueue : public cds_test::PQueueTest
+    {
+        typedef cds_test::PQueueTest base_class;
+    protected:
+        // MultiPriorityQueue is relaxed: pop() returns an item with high priority
+        // but not necessarily the top one, so the test checks the content only
+        template <class PQueue>
+        void test( PQueue& pq )
+        {
+            data_array<value_type> arr( base_class::c_nCapacity );
+            value_type * pFirst = arr.begin();
+            value_type * pLast = arr.end();
+
+            ASSERT_TRUE( pq.empty());
+            ASSERT_EQ( pq.size(), 0u );
+
+            // pop from empty queue
+            value_type kv( 0 );
+            ASSERT_FALSE( pq.pop( kv ));
+            ASSERT_EQ( kv.k, 0 );
+
+            size_t nSize = 0;
+
+            // Push test
+            for ( value_type * p = pFirst; p < pLast; ++p ) {
+                switch ( pq.size() & 3 ) {
+                case 0:
+                    ASSERT_TRUE( pq.push_with( [p]( value_type& dest ) { dest = *p; } ));
+                    break;
+                case 1:
+                    ASSERT_TRUE( pq.emplace( p->k, p->v ));
+                    break;
+                case 2:
+                    ASSERT_TRUE( pq.emplace( std::make_pair( p->k, p->v )));
+                    break;
+                default:
+                    ASSERT_TRUE( pq.push( *p ));
+                }
+                ASSERT_TRUE( !pq.empty());
+                ASSERT_EQ( pq.size(), ++nSize );
+            }
+
+            // Pop test
+            std::vector<bool> popped( arr.size(), false );
+            while ( !pq.empty()) {
+                key_type key;
+                if ( pq.size() & 1 ) {
+                    ASSERT_TRUE( pq.pop( kv ));
+                    key = kv.k;
+                    EXPECT_EQ( kv.k, kv.v );
+                }
+                else {
+                    ASSERT_TRUE( pq.pop_with( [&key]( value_type& src ) { key = src.k;  } ));
+                }
+
+                ASSERT_GE( key, static_cast<key_type>( base_class::c_nMinValue ));
+                size_t const nIdx = static_cast<size_t>( key - base_class::c_nMinValue );
+                ASSERT_LT( nIdx, popped.size());
+                ASSERT_FALSE( popped[nIdx] );
+                popped[nIdx] = true;
+
+                --nSize;
+                ASSERT_EQ( pq.size(), nSize );
+            }
+            ASSERT_EQ( nSize, 0u );
+            for ( size_t i = 0; i < popped.size(); ++i )
+                EXPECT_TRUE( popped[i] ) << "i=" << i;
+
+            ASSERT_TRUE( pq.empty());
+            ASSERT_FALSE( pq.pop( kv ));
+
+            // Relaxed pop order: the first popped item is the top of one of the heaps,
+            // so it is in the upper half of the keys with overwhelming probability
+            for ( value_type * p = pFirst; p < pLast; ++p )
+                ASSERT_TRUE( pq.push( *p ));
+            ASSERT_TRUE( pq.pop( kv ));
+            EXPECT_GE( kv.k, static_cast<key_type>( base_class::c_nMinValue + base_class::c_nCapacity / 2 ));
+            pq.clear();
+            ASSERT_TRUE( pq.empty());
+
+            // Clear test
+            for ( value_type * p = pFirst; p < pLast; ++p ) {
+                ASSERT_TRUE( pq.push( *p ));
+            }
+            ASSERT_TRUE( !pq.empty());
+            ASSERT_EQ( pq.size(), arr.size());
+            pq.clear();
+            ASSERT_TRUE( pq.empty());
+            ASSERT_EQ( pq.size(), 0u );
+
+            // clear_with test
+            for ( value_type * p = pFirst; p < pLast; ++p ) {
+                ASSERT_TRUE( pq.push( *p ));
+            }
+            ASSERT_TRUE( !pq.empty());
+            ASSERT_EQ( pq.size(), arr.size());
+
+            {
+                disposer disp;
+                pq.clear_with( std::ref( disp ));
+                ASSERT_TRUE( pq.empty());
+                ASSERT_EQ( pq.size(), 0u );
+                ASSERT_EQ( disp.m_nCallCount, arr.size());
+            }
+        }
+    };
+
+    TEST_F( MultiPQueue, defaulted )
+    {
+        typedef cds::container::MultiPriorityQueue< value_type > pqueue;
+
+        pqueue pq;
+        ASSERT_GE( pq.heap_count(), 2u );
+        test( pq );
+    }
+
+    TEST_F( MultiPQueue, cmp )
+    {
+        typedef cds::container::MultiPriorityQueue< value_type,
+            cds::container::multi_priority_queue::make_traits<
+                cds::opt::compare< compare >
+            >::type
+        > pqueue;
+
+        pqueue pq( 8 );
+        ASSERT_EQ( pq.heap_count(), 8u );
+        test( pq );
+    }
+
+    TEST_F( MultiPQueue, less )
+    {
+        typedef cds::container::MultiPriorityQueue< value_type,
+            cds::container::multi_priority_queue::make_traits<
+                cds::opt::less< less >
+            >::type
+        > pqueue;
+
+        pqueue pq( 1 );
+        ASSERT_EQ( pq.heap_count(), 2u );
+        test( pq );
+    }
+
+    TEST_F( MultiPQueue, cmp_less )
+    {
+        struct pqueue_traits : public cds::container::multi_priority_queue::traits
+        {
+            typedef MultiPQueue::less less;
+            typedef MultiPQueue::compare compare;
+        };
+        typedef cds::container::MultiPriorityQueue< value_type, pqueue_traits > pqueue;
+
+        pqueue pq( 4 );
+        test( pq );
+    }
+
+    TEST_F( MultiPQueue, mutex )
+    {
+        typedef cds::container::MultiPriorityQueue< value_type,
+            cds::container::multi_priority_queue::make_traits<
+                cds::opt::compare< compare >
+                ,cds::opt::lock_type< std::mutex >
+                ,cds::opt::random_engine< cds::opt::v::c_rand >
+            >::type
+        > pqueue;
+
+        pqueue pq( 4 );
+        test( pq );
+    }
+
+    TEST_F( MultiPQueue, stat )
+    {
+        typedef cds::container::MultiPriorityQueue< value_type,
+            cds::container::multi_priority_queue::make_traits<
+                cds::opt::less< less >
+                ,cds::opt::padding< 16 >
+                ,cds::opt::stat< cds::container::multi_priority_queue::stat<>>
+            >::type
+        > pqueue;
+
+        pqueue pq( 16 );
+        test( pq );
+
+        EXPECT_EQ( pq.statistics().m_nPushCount.get(), 4u * c_nCapacity );
+        EXPECT_EQ( pq.statistics().m_nPopCount.get(), c_nCapacity + 1u );
+        EXPECT_GT( pq.statistics().m_nPopFailCount.get(), 0u );
+        EXPECT_GT( pq.statistics().m_nPopScan.get(), 0u );
+    }
+
+} // namespace
@@ -111,7 +111,7 @@ namespace cds_test {
             T * end()   { return pLast; }
             size_t size() const
             {
-                return pLast - pFirst;
+                return pLast - pFirst.get();
             }
         };
     };
@@ -136,5 +136,59 @@ namespace {
         test_string( q );
     }
 
+
+    TEST_F( BasketQueue_HP, elimination )
+    {
+        typedef cds::container::BasketQueue< gc_type, int,
+            typename cds::container::basket_queue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::basket_queue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test( q );
+    }
+
+    TEST_F( BasketQueue_HP, elimination_dynamic_buffer )
+    {
+        typedef cds::container::BasketQueue< gc_type, int,
+            typename cds::container::basket_queue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::buffer< cds::opt::v::initialized_dynamic_buffer< int > >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+            >::type
+        > test_queue;
+
+        test_queue q( 8 );
+        test( q );
+    }
+
+    TEST_F( BasketQueue_HP, batch )
+    {
+        typedef cds::container::BasketQueue< gc_type, int,
+            typename cds::container::basket_queue::make_traits <
+                cds::opt::item_counter< cds::atomicity::item_counter >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_batch( q );
+    }
+
+    TEST_F( BasketQueue_HP, batch_elimination )
+    {
+        typedef cds::container::BasketQueue< gc_type, int,
+            typename cds::container::basket_queue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat< cds::container::basket_queue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_batch( q );
+    }
+
 } // namespace
 
@@ -32,7 +32,12 @@
 #include <cds/container/fcqueue.h>
 #include <test/include/cds_test/fc_hevy_value.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <list>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -217,6 +222,38 @@ namespace {
         test( q );
     }
 
+    TEST_F( FCQueue, not_attached_thread )
+    {
+        typedef cds::container::FCQueue<int> queue_type;
+
+        const int c_nThreadCount = 4;
+        const int c_nItemCount = 1000;
+        queue_type q;
+
+        // The threads are not attached to libcds, the kernel uses unbound publication records
+        std::vector< std::thread > threads;
+        for ( int i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( [&q]() {
+                for ( int k = 0; k < c_nItemCount; ++k )
+                    EXPECT_TRUE( q.push( k ));
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        ASSERT_EQ( q.size(), static_cast<size_t>( c_nThreadCount * c_nItemCount ));
+
+        std::thread popper( [&q]() {
+            int nSum = 0;
+            int v;
+            while ( q.pop( v ))
+                nSum += v;
+            EXPECT_EQ( nSum, c_nThreadCount * c_nItemCount * ( c_nItemCount - 1 ) / 2 );
+        });
+        popper.join();
+        ASSERT_TRUE( q.empty());
+    }
+
     TEST_F( FCQueue, std_deque_move )
     {
         typedef cds::container::FCQueue<std::string> queue_type;
@@ -298,6 +335,62 @@ namespace {
         test_heavy( q );
     }
 
+    TEST_F( FCQueue, std_adaptive_heavy_value )
+    {
+        typedef fc_test::heavy_value<> ValueType;
+        typedef cds::container::FCQueue<ValueType, std::queue< ValueType, std::deque<ValueType>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::adaptive<> >
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test_heavy( q );
+    }
+
+    TEST_F( FCQueue, std_adaptive_no_lost_wakeup )
+    {
+        // Long parking and no yielding: the waiters park almost at once,
+        // so a lost wakeup delays the operation for the whole parking duration
+        typedef cds::algo::flat_combining::wait_strategy::adaptive< 500, 16, 0 > wait_strategy;
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::wait_strategy< wait_strategy >
+            >::type
+        > queue_type;
+
+        const int c_nThreadCount = 8;
+        const int c_nItemCount = 2000;
+        queue_type q;
+        std::atomic<bool> bStart( false );
+
+        std::vector< std::chrono::steady_clock::duration > maxLatency( c_nThreadCount, std::chrono::steady_clock::duration::zero());
+        std::vector< std::thread > threads;
+        for ( int i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( [&q, &bStart, &maxLatency, i]() {
+                while ( !bStart.load( std::memory_order_acquire ))
+                    std::this_thread::yield();
+
+                auto& latency = maxLatency[i];
+                int v;
+                for ( int k = 0; k < c_nItemCount; ++k ) {
+                    auto const start = std::chrono::steady_clock::now();
+                    EXPECT_TRUE( q.push( k ));
+                    auto const mid = std::chrono::steady_clock::now();
+                    q.pop( v );
+                    auto const end = std::chrono::steady_clock::now();
+                    latency = std::max( latency, std::max( mid - start, end - mid ));
+                }
+            });
+        }
+        bStart.store( true, std::memory_order_release );
+        for ( auto& t : threads )
+            t.join();
+
+        for ( auto const& latency : maxLatency )
+            EXPECT_LT( std::chrono::duration_cast<std::chrono::milliseconds>( latency ).count(), wait_strategy::c_nWaitMilliseconds / 2 );
+    }
+
     TEST_F( FCQueue, std_single_mutex_single_condvar )
     {
         typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
@@ -372,6 +465,33 @@ namespace {
         test( q );
     }
 
+    TEST_F( FCQueue, std_deque_hierarchical )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+                , cds::opt::stat< cds::container::fcqueue::stat<> >
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_hierarchical_elimination_single_mutex_multi_condvar )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+                , cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::single_mutex_multi_condvar<2>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
     TEST_F( FCQueue, std_list )
     {
         typedef cds::container::FCQueue<int, std::queue< int, std::list<int>>> queue_type;
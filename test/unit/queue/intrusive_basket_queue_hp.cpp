@@ -196,5 +196,48 @@ namespace {
         check_array( arr );
     }
 
+
+    TEST_F( IntrusiveBasketQueue_HP, base_elimination )
+    {
+        typedef cds::intrusive::BasketQueue< gc_type, base_item_type,
+            typename ci::basket_queue::make_traits<
+                ci::opt::disposer< mock_disposer >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< ci::basket_queue::stat<> >
+                , cds::opt::enable_elimination< true >
+            >::type
+        > test_queue;
+
+        std::vector<base_item_type> arr;
+        arr.resize( 100 );
+        {
+            test_queue q;
+            test( q, arr );
+        }
+        gc_type::scan();
+        check_array( arr );
+    }
+
+    TEST_F( IntrusiveBasketQueue_HP, base_batch )
+    {
+        typedef cds::intrusive::BasketQueue< gc_type, base_item_type,
+            typename ci::basket_queue::make_traits<
+                ci::opt::disposer< mock_disposer >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< ci::basket_queue::stat<> >
+            >::type
+        > test_queue;
+
+        std::vector<base_item_type> arr;
+        arr.resize( 100 );
+        {
+            test_queue q;
+            test_batch( q, arr );
+        }
+        gc_type::scan();
+        for ( auto const& item : arr )
+            ASSERT_EQ( item.nDisposeCount, 1 );
+    }
+
 } // namespace
 
@@ -183,5 +183,50 @@ namespace {
         check_array( arr );
     }
 
+
+    TEST_F( IntrusiveMSQueue_DHP, base_elimination )
+    {
+        typedef cds::intrusive::MSQueue< gc_type, base_item_type,
+            typename ci::msqueue::make_traits<
+                ci::opt::disposer< mock_disposer >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< ci::msqueue::stat<> >
+                , cds::opt::enable_elimination< true >
+                , ci::opt::hook< ci::msqueue::base_hook< ci::opt::gc<gc_type>>>
+            >::type
+        > test_queue;
+
+        std::vector<base_item_type> arr;
+        arr.resize( 100 );
+        {
+            test_queue q;
+            test( q, arr );
+        }
+        gc_type::scan();
+        check_array( arr );
+    }
+
+    TEST_F( IntrusiveMSQueue_DHP, base_batch )
+    {
+        typedef cds::intrusive::MSQueue< gc_type, base_item_type,
+            typename ci::msqueue::make_traits<
+                ci::opt::disposer< mock_disposer >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< ci::msqueue::stat<> >
+                , ci::opt::hook< ci::msqueue::base_hook< ci::opt::gc<gc_type>>>
+            >::type
+        > test_queue;
+
+        std::vector<base_item_type> arr;
+        arr.resize( 100 );
+        {
+            test_queue q;
+            test_batch( q, arr );
+        }
+        gc_type::scan();
+        for ( auto const& item : arr )
+            ASSERT_EQ( item.nDisposeCount, 1 );
+    }
+
 } // namespace
 
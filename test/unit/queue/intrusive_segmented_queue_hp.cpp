@@ -162,5 +162,24 @@ namespace {
         check_array( arr );
     }
 
+    TEST_F( IntrusiveSegmentedQueue_HP, batch )
+    {
+        struct queue_traits : public cds::intrusive::segmented_queue::traits
+        {
+            typedef Disposer disposer;
+            typedef cds::atomicity::item_counter item_counter;
+        };
+        typedef cds::intrusive::SegmentedQueue< gc_type, item, queue_traits > queue_type;
+
+        std::vector<typename queue_type::value_type> arr;
+        {
+            queue_type q( c_QuasiFactor );
+            test_batch( q, arr );
+        }
+        queue_type::gc::force_dispose();
+        for ( auto const& i : arr )
+            EXPECT_EQ( i.nDisposeCount, 0u );
+    }
+
 } // namespace
 
@@ -136,5 +136,36 @@ namespace {
         test_string( q );
     }
 
+
+    TEST_F( MoirQueue_DHP, elimination )
+    {
+        typedef cds::container::MoirQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test( q );
+    }
+
+    TEST_F( MoirQueue_DHP, elimination_mt )
+    {
+        // one collision slot for all threads
+        typedef cds::container::MoirQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::buffer< cds::opt::v::initialized_static_buffer< int, 1 > >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_elimination( q );
+    }
+
 } // namespace
 
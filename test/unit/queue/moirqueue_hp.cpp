@@ -136,5 +136,20 @@ namespace {
         test_string( q );
     }
 
+
+    TEST_F( MoirQueue_HP, elimination )
+    {
+        typedef cds::container::MoirQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test( q );
+    }
+
 } // namespace
 
@@ -136,5 +136,75 @@ namespace {
         test_string( q );
     }
 
+
+    TEST_F( MSQueue_DHP, elimination )
+    {
+        typedef cds::container::MSQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test( q );
+    }
+
+    TEST_F( MSQueue_DHP, elimination_mt )
+    {
+        // one collision slot for all threads
+        typedef cds::container::MSQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::buffer< cds::opt::v::initialized_static_buffer< int, 1 > >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_elimination( q );
+    }
+
+    TEST_F( MSQueue_DHP, elimination_dynamic_buffer )
+    {
+        typedef cds::container::MSQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::buffer< cds::opt::v::initialized_dynamic_buffer< int > >
+                , cds::opt::item_counter< cds::atomicity::item_counter >
+            >::type
+        > test_queue;
+
+        test_queue q( 8 );
+        test( q );
+    }
+
+    TEST_F( MSQueue_DHP, batch )
+    {
+        typedef cds::container::MSQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::item_counter< cds::atomicity::item_counter >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_batch( q );
+    }
+
+    TEST_F( MSQueue_DHP, batch_elimination )
+    {
+        typedef cds::container::MSQueue< gc_type, int,
+            typename cds::container::msqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat< cds::container::msqueue::stat<> >
+            >::type
+        > test_queue;
+
+        test_queue q;
+        test_batch( q );
+    }
+
 } // namespace
 
@@ -0,0 +1,132 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <cds/intrusive/msqueue.h>
+#include <cds/threading/model.h>
+
+#include <thread>
+
+namespace {
+    namespace ci = cds::intrusive;
+    namespace qe = cds::intrusive::queue_elimination;
+
+    // Drives the queue elimination back-off directly by two threads.
+    // The collision array has one slot, so the first thread waits in the slot as passive side
+    // and the second one finds it as active side
+    class QueueElimination: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+        }
+
+        struct traits: public ci::msqueue::traits
+        {
+            typedef cds::opt::v::initialized_static_buffer< int, 1 > buffer;
+            typedef cds::backoff::delay_of< 1000 > elimination_backoff;    // 1 second
+        };
+
+        typedef int value_type;
+        typedef qe::details::elimination_backoff< true, value_type, traits > elimination_backoff;
+        typedef qe::operation< value_type > operation_desc;
+        typedef ci::msqueue::stat<> stat;
+
+        // Calls backoff() for a dequeue in a separate thread and for an enqueue of val in the current thread
+        void collide( elimination_backoff& bkoff, stat& s, bool bEmpty, value_type& val, operation_desc& opDeq, bool& bDeqResult, bool& bEnqResult )
+        {
+            opDeq.idOp = qe::op_dequeue;
+            std::thread deq( [&bkoff, &s, &opDeq, &bDeqResult, bEmpty]() {
+                cds::threading::Manager::attachThread();
+                bDeqResult = bkoff.backoff( opDeq, s, [bEmpty]() { return bEmpty; } );
+                cds::threading::Manager::detachThread();
+            });
+
+            operation_desc opEnq;
+            opEnq.idOp = qe::op_enqueue;
+            opEnq.pVal = &val;
+            bEnqResult = bkoff.backoff( opEnq, s, [bEmpty]() { return bEmpty; } );
+
+            deq.join();
+        }
+    };
+
+    TEST_F( QueueElimination, collision )
+    {
+        elimination_backoff bkoff;
+        stat s;
+        value_type val = 42;
+        operation_desc opDeq;
+        bool bDeqResult = false;
+        bool bEnqResult = false;
+
+        collide( bkoff, s, true, val, opDeq, bDeqResult, bEnqResult );
+
+        // The queue is empty, the enqueue and the dequeue are eliminated
+        EXPECT_TRUE( bEnqResult );
+        EXPECT_TRUE( bDeqResult );
+        EXPECT_EQ( opDeq.pVal, &val );
+
+        EXPECT_EQ( s.m_ActiveEnqueueCollision.get() + s.m_ActiveDequeueCollision.get(), 1u );
+        EXPECT_EQ( s.m_PassiveEnqueueCollision.get() + s.m_PassiveDequeueCollision.get(), 1u );
+        EXPECT_EQ( s.m_ActiveEnqueueCollision.get(), s.m_PassiveDequeueCollision.get());
+        EXPECT_EQ( s.m_ActiveDequeueCollision.get(), s.m_PassiveEnqueueCollision.get());
+        EXPECT_EQ( s.m_EliminationFailed.get(), 0u );
+    }
+
+    TEST_F( QueueElimination, fifo_guard )
+    {
+        elimination_backoff bkoff;
+        stat s;
+        value_type val = 42;
+        operation_desc opDeq;
+        bool bDeqResult = true;
+        bool bEnqResult = true;
+
+        collide( bkoff, s, false, val, opDeq, bDeqResult, bEnqResult );
+
+        // The queue contains older items: the active side refuses the collision,
+        // the passive side waits until timeout
+        EXPECT_FALSE( bEnqResult );
+        EXPECT_FALSE( bDeqResult );
+        EXPECT_TRUE( opDeq.pVal == nullptr );
+
+        EXPECT_EQ( s.m_ActiveEnqueueCollision.get() + s.m_ActiveDequeueCollision.get(), 0u );
+        EXPECT_EQ( s.m_PassiveEnqueueCollision.get() + s.m_PassiveDequeueCollision.get(), 0u );
+        EXPECT_EQ( s.m_EliminationFailed.get(), 2u );
+    }
+
+} // namespace
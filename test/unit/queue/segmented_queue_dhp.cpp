@@ -132,5 +132,18 @@ namespace {
         test_string( q );
     }
 
+    TEST_F( SegmentedQueue_DHP, batch )
+    {
+        struct traits : public cds::container::segmented_queue::traits
+        {
+            typedef cds::atomicity::item_counter item_counter;
+        };
+        typedef cds::container::SegmentedQueue< gc_type, int, traits > test_queue;
+
+        test_queue q( c_QuasiFactor );
+        ASSERT_EQ( q.quasi_factor(), cds::beans::ceil2( c_QuasiFactor ));
+        test_batch( q );
+    }
+
 } // namespace
 
@@ -32,6 +32,10 @@
 #define CDSUNIT_QUEUE_TEST_GENERIC_QUEUE_H
 
 #include <cds_test/check_size.h>
+#include <cds/threading/model.h>
+#include <vector>
+#include <algorithm>
+#include <thread>
 
 namespace cds_test {
 
@@ -137,6 +141,144 @@ namespace cds_test {
             ASSERT_CONTAINER_SIZE( q, 0 );
         }
 
+        template <typename Queue>
+        void test_batch( Queue& q )
+        {
+            typedef typename Queue::value_type value_type;
+
+            const size_t nSize = 100;
+            std::vector<value_type> src( nSize );
+            std::vector<value_type> dst( nSize );
+            for ( size_t i = 0; i < nSize; ++i )
+                src[i] = static_cast<value_type>( i );
+
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+
+            // batch from/to empty range
+            ASSERT_EQ( q.dequeue_batch( dst.data(), nSize ), 0u );
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.begin()), 0u );
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+
+            // enqueue_batch mixed with enqueue
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.begin() + nSize / 2 ), nSize / 2 );
+            ASSERT_CONTAINER_SIZE( q, nSize / 2 );
+            ASSERT_TRUE( q.enqueue( src[nSize / 2] ));
+            ASSERT_EQ( q.enqueue_batch( src.begin() + nSize / 2 + 1, src.end()), nSize - nSize / 2 - 1 );
+            ASSERT_FALSE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, nSize );
+
+            // dequeue_batch by portions
+            ASSERT_EQ( q.dequeue_batch( dst.data(), 0 ), 0u );
+            ASSERT_CONTAINER_SIZE( q, nSize );
+            size_t nCount = 0;
+            while ( nCount < nSize ) {
+                size_t const nPortion = q.dequeue_batch( dst.data() + nCount, 7 );
+                ASSERT_EQ( nPortion, std::min<size_t>( 7, nSize - nCount ));
+                nCount += nPortion;
+                ASSERT_CONTAINER_SIZE( q, nSize - nCount );
+            }
+            for ( size_t i = 0; i < nSize; ++i )
+                ASSERT_EQ( dst[i], src[i] );
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+            ASSERT_EQ( q.dequeue_batch( dst.data(), nSize ), 0u );
+
+            // dequeue_batch_with mixed with dequeue
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.end()), nSize );
+            ASSERT_CONTAINER_SIZE( q, nSize );
+
+            value_type it;
+            ASSERT_TRUE( q.dequeue( it ));
+            ASSERT_EQ( it, src[0] );
+
+            size_t nNext = 1;
+            auto f = [&nNext, &src]( value_type& v ) { EXPECT_EQ( v, src[nNext] ); ++nNext; };
+            ASSERT_EQ( q.dequeue_batch_with( f, nSize ), nSize - 1 );
+            ASSERT_EQ( nNext, nSize );
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+        }
+
+        // Producers and consumers hand off items through an almost empty queue,
+        // so the elimination back-off of the queue pairs enqueues with dequeues.
+        // An enqueue tries the elimination only if its tail CAS fails; on a single processor
+        // such a race is very rare, so the collisions are checked on multiprocessor only.
+        // The threads are attached to libcds, so the queue must be based on a GC without thread limit
+        template <class Queue>
+        void test_elimination( Queue& q )
+        {
+            typedef typename Queue::value_type value_type;
+
+            static size_t const c_nProducerCount = 4;
+            static size_t const c_nConsumerCount = 4;
+            static size_t const c_nItemCount = 10000;   // per producer
+
+            bool const bMultiProcessor = std::thread::hardware_concurrency() > 1;
+            size_t const nMaxRound = bMultiProcessor ? 20 : 1;
+
+            auto const& stat = q.statistics();
+            for ( size_t nRound = 0; nRound < nMaxRound; ++nRound ) {
+                atomics::atomic<size_t> nDequeued( 0 );
+                std::vector< std::thread > threads;
+
+                for ( size_t nProducer = 0; nProducer < c_nProducerCount; ++nProducer ) {
+                    threads.emplace_back( [&q, nProducer]() {
+                        cds::threading::Manager::attachThread();
+                        for ( size_t i = 0; i < c_nItemCount; ++i ) {
+                            // elimination is possible only when the queue is empty
+                            while ( q.size() > c_nProducerCount )
+                                std::this_thread::yield();
+                            EXPECT_TRUE( q.enqueue( static_cast<value_type>( nProducer * c_nItemCount + i )));
+                        }
+                        cds::threading::Manager::detachThread();
+                    });
+                }
+
+                for ( size_t nConsumer = 0; nConsumer < c_nConsumerCount; ++nConsumer ) {
+                    threads.emplace_back( [&q, &nDequeued]() {
+                        cds::threading::Manager::attachThread();
+
+                        // The items of each producer must be dequeued in FIFO order
+                        std::vector<size_t> arrNext( c_nProducerCount, 0 );
+                        value_type v;
+                        while ( nDequeued.load( atomics::memory_order_relaxed ) < c_nProducerCount * c_nItemCount ) {
+                            if ( q.dequeue( v )) {
+                                size_t const nProducer = static_cast<size_t>( v ) / c_nItemCount;
+                                size_t const nItem = static_cast<size_t>( v ) % c_nItemCount;
+                                EXPECT_LT( nProducer, c_nProducerCount );
+                                if ( nProducer < c_nProducerCount ) {
+                                    EXPECT_GE( nItem, arrNext[nProducer] ) << "producer=" << nProducer;
+                                    arrNext[nProducer] = nItem + 1;
+                                }
+                                nDequeued.fetch_add( 1, atomics::memory_order_relaxed );
+                            }
+                        }
+                        cds::threading::Manager::detachThread();
+                    });
+                }
+
+                for ( auto& t : threads )
+                    t.join();
+
+                ASSERT_EQ( nDequeued.load(), c_nProducerCount * c_nItemCount );
+                ASSERT_TRUE( q.empty());
+                ASSERT_CONTAINER_SIZE( q, 0 );
+
+                if ( stat.m_ActiveEnqueueCollision.get() + stat.m_ActiveDequeueCollision.get() != 0
+                  && stat.m_PassiveEnqueueCollision.get() + stat.m_PassiveDequeueCollision.get() != 0 )
+                {
+                    break;
+                }
+            }
+
+            if ( bMultiProcessor ) {
+                EXPECT_NE( stat.m_ActiveEnqueueCollision.get() + stat.m_ActiveDequeueCollision.get(), 0u );
+                EXPECT_NE( stat.m_PassiveEnqueueCollision.get() + stat.m_PassiveDequeueCollision.get(), 0u );
+            }
+        }
+
         template <class Queue>
         void test_string( Queue& q )
         {
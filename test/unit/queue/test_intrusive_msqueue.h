@@ -32,6 +32,7 @@
 #define CDSUNIT_QUEUE_TEST_INTRUSIVE_MSQUEUE_H
 
 #include <cds_test/check_size.h>
+#include <algorithm>
 
 namespace cds_test {
 
@@ -152,6 +153,47 @@ namespace cds_test {
             ASSERT_EQ( arr[nSize - 1].nDisposeCount, 1 ); // this element is in the queue yet
             ASSERT_EQ( arr[nSize].nDisposeCount, 1 );
         }
+
+        template <typename Queue, typename Data>
+        void test_batch( Queue& q, Data& arr )
+        {
+            typedef typename Queue::value_type value_type;
+            size_t nSize = arr.size();
+
+            for ( size_t i = 0; i < nSize; ++i )
+                arr[i].nVal = static_cast<int>(i);
+
+            size_t nCount = 0;
+            auto f = [&nCount]( value_type& v ) { EXPECT_EQ( v.nVal, static_cast<int>( nCount )); ++nCount; };
+
+            ASSERT_TRUE( q.empty());
+            ASSERT_EQ( q.dequeue_batch( f, nSize ), 0u );
+            ASSERT_EQ( q.enqueue_batch( arr.begin(), arr.begin()), 0u );
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+
+            ASSERT_EQ( q.enqueue_batch( arr.begin(), arr.end()), nSize );
+            ASSERT_FALSE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, nSize );
+
+            ASSERT_EQ( q.dequeue_batch( f, 0 ), 0u );
+            while ( nCount < nSize ) {
+                size_t const nPrev = nCount;
+                ASSERT_EQ( q.dequeue_batch( f, 7 ), std::min<size_t>( 7, nSize - nPrev ));
+                ASSERT_EQ( nCount, std::min<size_t>( nPrev + 7, nSize ));
+                ASSERT_CONTAINER_SIZE( q, nSize - nCount );
+            }
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+            ASSERT_EQ( q.dequeue_batch( f, nSize ), 0u );
+
+            Queue::gc::scan();
+            --nSize; // last element of array is in queue yet as a dummy item
+            for ( size_t i = 0; i < nSize; ++i ) {
+                ASSERT_EQ( arr[i].nDisposeCount, 1 );
+            }
+            ASSERT_EQ( arr[nSize].nDisposeCount, 0 );
+        }
     };
 
 } // namespace cds_test
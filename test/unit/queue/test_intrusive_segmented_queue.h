@@ -32,6 +32,7 @@
 #define CDSUNIT_QUEUE_TEST_INTRUSIVE_SEGMENTED_QUEUE_H
 
 #include <cds_test/check_size.h>
+#include <vector>
 
 namespace cds_test {
 
@@ -184,6 +185,51 @@ namespace cds_test {
             EXPECT_CONTAINER_SIZE( q, val.size());
             EXPECT_TRUE( !q.empty());
         }
+
+        template <typename Queue, typename Data>
+        void test_batch( Queue& q, Data& val )
+        {
+            typedef typename Queue::value_type value_type;
+            val.resize( 100 );
+            for ( size_t i = 0; i < val.size(); ++i )
+                val[i].nValue = static_cast<int>( i );
+
+            std::vector<value_type *> dst( val.size(), nullptr );
+
+            ASSERT_TRUE( q.empty());
+            ASSERT_EQ( q.dequeue_batch( dst.data(), dst.size()), 0u );
+            ASSERT_EQ( q.enqueue_batch( val.begin(), val.begin()), 0u );
+            ASSERT_TRUE( q.empty());
+
+            ASSERT_EQ( q.enqueue_batch( val.begin(), val.end()), val.size());
+            EXPECT_CONTAINER_SIZE( q, val.size());
+
+            size_t nCount = 0;
+            while ( nCount < val.size()) {
+                size_t const nPortion = q.dequeue_batch( dst.data() + nCount, 7 );
+                ASSERT_NE( nPortion, 0u );
+                for ( size_t i = nCount; i < nCount + nPortion; ++i ) {
+                    ASSERT_TRUE( dst[i] != nullptr );
+                    int nMin = int( i / q.quasi_factor()) * int( q.quasi_factor());
+                    int nMax = nMin + int( q.quasi_factor()) - 1;
+                    EXPECT_TRUE( nMin <= dst[i]->nValue && dst[i]->nValue <= nMax ) << nMin << " <= " << dst[i]->nValue << " <= " << nMax;
+                }
+                nCount += nPortion;
+                EXPECT_CONTAINER_SIZE( q, val.size() - nCount );
+            }
+            EXPECT_TRUE( q.empty());
+            ASSERT_EQ( q.dequeue_batch( dst.data(), dst.size()), 0u );
+
+            // each item has been dequeued exactly once, Disposer has not been called
+            std::vector<bool> seen( val.size(), false );
+            for ( size_t i = 0; i < dst.size(); ++i ) {
+                ASSERT_FALSE( seen[ dst[i]->nValue ] );
+                seen[ dst[i]->nValue ] = true;
+            }
+            Queue::gc::force_dispose();
+            for ( size_t i = 0; i < val.size(); ++i )
+                EXPECT_EQ( val[i].nDisposeCount, 0u );
+        }
     };
 
 } // namespace cds_test
@@ -32,6 +32,7 @@
 #define CDSUNIT_QUEUE_TEST_SEGMENTED_QUEUE_H
 
 #include <cds_test/check_size.h>
+#include <vector>
 
 namespace cds_test {
 
@@ -162,6 +163,63 @@ namespace cds_test {
             ASSERT_CONTAINER_SIZE( q, 0 );
         }
 
+        template <typename Queue>
+        void test_batch( Queue& q )
+        {
+            typedef typename Queue::value_type value_type;
+
+            const size_t nSize = 100;
+            std::vector<value_type> src( nSize );
+            std::vector<value_type> dst( nSize );
+            for ( size_t i = 0; i < nSize; ++i )
+                src[i] = static_cast<value_type>( i );
+
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+
+            ASSERT_EQ( q.dequeue_batch( dst.data(), nSize ), 0u );
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.begin()), 0u );
+            ASSERT_TRUE( q.empty());
+
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.end()), nSize );
+            ASSERT_FALSE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, nSize );
+
+            // the order inside a segment is unspecified but segments are dequeued in FIFO order
+            size_t nCount = 0;
+            while ( nCount < nSize ) {
+                size_t const nPortion = q.dequeue_batch( dst.data() + nCount, 7 );
+                ASSERT_NE( nPortion, 0u );
+                for ( size_t i = nCount; i < nCount + nPortion; ++i ) {
+                    int nMin = int( i / q.quasi_factor()) * int( q.quasi_factor());
+                    int nMax = nMin + int( q.quasi_factor()) - 1;
+                    EXPECT_LE( nMin, dst[i] );
+                    EXPECT_LE( dst[i], nMax );
+                }
+                nCount += nPortion;
+                ASSERT_CONTAINER_SIZE( q, nSize - nCount );
+            }
+            ASSERT_EQ( nCount, nSize );
+            ASSERT_TRUE( q.empty());
+
+            std::vector<bool> seen( nSize, false );
+            for ( size_t i = 0; i < nSize; ++i ) {
+                ASSERT_FALSE( seen[ dst[i] ] );
+                seen[ dst[i] ] = true;
+            }
+
+            // dequeue_batch_with
+            ASSERT_EQ( q.enqueue_batch( src.begin(), src.end()), nSize );
+            ASSERT_CONTAINER_SIZE( q, nSize );
+            nCount = 0;
+            auto f = [&nCount, &seen]( value_type& v ) { EXPECT_TRUE( seen[v] ); seen[v] = false; ++nCount; };
+            while ( q.dequeue_batch_with( f, nSize ) != 0 );
+            ASSERT_EQ( nCount, nSize );
+            ASSERT_TRUE( q.empty());
+            ASSERT_CONTAINER_SIZE( q, 0 );
+            ASSERT_EQ( q.dequeue_batch_with( f, nSize ), 0u );
+        }
+
         template <class Queue>
         void test_string( Queue& q )
         {
@@ -205,3 +205,84 @@ TEST_F( CDSTEST_FIXTURE_NAME, turbo16 )
     set_type s;
     test( s );
 }
+
+TEST_F( CDSTEST_FIXTURE_NAME, hint )
+{
+    struct set_traits: public cc::skip_list::traits
+    {
+        typedef cmp compare;
+        typedef cds::atomicity::item_counter item_counter;
+        typedef cc::skip_list::stat<> stat;
+    };
+    typedef cc::SkipListSet< gc_type, int_item, set_traits >set_type;
+
+    set_type s;
+    test( s );
+
+    int const nSize = 1000;
+    {
+        typename set_type::hint h;
+        EXPECT_TRUE( h.empty());
+
+        // sorted input: even keys only
+        for ( int i = 0; i < nSize; i += 2 ) {
+            EXPECT_TRUE( s.insert_hint( h, int_item( i )));
+            EXPECT_FALSE( h.empty());
+        }
+        EXPECT_EQ( s.size(), static_cast<size_t>( nSize / 2 ));
+
+        // duplicates
+        for ( int i = 0; i < nSize; i += 2 )
+            EXPECT_FALSE( s.insert_hint( h, int_item( i )));
+
+        h.release();
+        EXPECT_TRUE( h.empty());
+
+        // ordered traversal of the key range
+        for ( int i = 0; i < nSize; ++i ) {
+            int nFound = -1;
+            bool bFound = s.find_hint( h, i, [&nFound]( int_item& item, int const& ) { nFound = item.nKey; } );
+            if ( i % 2 == 0 ) {
+                EXPECT_TRUE( bFound ) << "key=" << i;
+                EXPECT_EQ( nFound, i );
+            }
+            else {
+                EXPECT_FALSE( bFound ) << "key=" << i;
+                EXPECT_EQ( nFound, -1 );
+            }
+        }
+
+        // the node remembered is erased
+        EXPECT_TRUE( s.find_hint( h, 500 ));
+        EXPECT_TRUE( s.erase( 500 ));
+        EXPECT_FALSE( s.find_hint( h, 500 ));
+        EXPECT_TRUE( s.find_hint( h, 502 ));
+        EXPECT_TRUE( s.insert_hint( h, int_item( 501 )));
+        EXPECT_TRUE( s.find_hint( h, 501 ));
+
+        // the hint is ahead of the key
+        EXPECT_TRUE( s.find_hint( h, 0 ));
+        EXPECT_TRUE( s.insert_hint( h, int_item( -1 )));
+        EXPECT_TRUE( s.contains( -1 ));
+
+        // odd keys in reverse order
+        for ( int i = nSize - 1; i > 0; i -= 2 ) {
+            if ( i != 501 ) {
+                EXPECT_TRUE( s.insert_hint( h, int_item( i ))) << "key=" << i;
+            }
+        }
+        EXPECT_EQ( s.size(), static_cast<size_t>( nSize ));
+
+        for ( int i = -1; i < nSize; ++i ) {
+            if ( i != 500 ) {
+                EXPECT_TRUE( s.find_hint( h, i )) << "key=" << i;
+            }
+        }
+    }
+
+    EXPECT_NE( s.statistics().m_nHintHit.get(), 0u );
+    EXPECT_NE( s.statistics().m_nHintMiss.get(), 0u );
+
+    s.clear();
+    EXPECT_TRUE( s.empty());
+}
@@ -189,6 +189,31 @@ namespace {
         test<stack_type>();
     }
 
+    TEST_F( FCStack, deque_hierarchical )
+    {
+        struct stack_traits : public
+            cds::container::fcstack::make_traits <
+            cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            , cds::opt::stat< cds::container::fcstack::stat<> >
+            > ::type
+        {};
+        typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::deque<unsigned int>>, stack_traits > stack_type;
+        test<stack_type>();
+    }
+
+    TEST_F( FCStack, deque_hierarchical_elimination )
+    {
+        struct stack_traits : public
+            cds::container::fcstack::make_traits <
+            cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            , cds::opt::enable_elimination < true >
+            , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+            > ::type
+        {};
+        typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::deque<unsigned int>>, stack_traits > stack_type;
+        test<stack_type>();
+    }
+
     TEST_F( FCStack, vector_based )
     {
         typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::vector<unsigned int>>> stack_type;
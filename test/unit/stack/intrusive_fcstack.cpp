@@ -426,6 +426,19 @@ namespace {
         test<stack_type>();
     }
 
+    TEST_F( IntrusiveFCStack, list_hierarchical_elimination_stat )
+    {
+        typedef base_hook_item< boost::intrusive::list_base_hook<> > value_type;
+        typedef cds::intrusive::FCStack< value_type, boost::intrusive::list< value_type >,
+            cds::intrusive::fcstack::make_traits<
+            cds::opt::enable_elimination< true >
+            , cds::opt::stat< cds::intrusive::fcstack::stat<> >
+            , cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        > stack_type;
+        test<stack_type>();
+    }
+
     TEST_F( IntrusiveFCStack, list_member )
     {
         typedef member_hook_item< boost::intrusive::list_member_hook<> > value_type;
@@ -0,0 +1,327 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/fixture.h>
+#include <cds/container/fcmap.h>
+
+#include <unordered_map>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class FCMap: public cds_test::fixture
+    {
+    protected:
+        struct value_type {
+            int nVal;
+            std::string strVal;
+
+            value_type()
+                : nVal( 0 )
+            {}
+        };
+
+        static size_t const kSize = 1000;
+
+        void SetUp()
+        {
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+        }
+
+        template <class Map>
+        void test( Map& m )
+        {
+            typedef typename Map::value_type map_pair;
+
+            ASSERT_TRUE( m.empty());
+            ASSERT_EQ( m.size(), 0u );
+
+            std::vector<int> arrKeys;
+            for ( int i = 0; i < static_cast<int>( kSize ); ++i )
+                arrKeys.push_back( i );
+            shuffle( arrKeys.begin(), arrKeys.end());
+
+            // insert/find
+            for ( int key : arrKeys ) {
+                ASSERT_FALSE( m.contains( key ));
+                ASSERT_FALSE( m.find( key, []( map_pair& ) { EXPECT_TRUE( false ); } ));
+
+                std::pair<bool, bool> updResult;
+                switch ( key % 4 ) {
+                case 0:
+                    ASSERT_TRUE( m.insert( key ));
+                    ASSERT_FALSE( m.insert( key ));
+                    ASSERT_TRUE( m.find( key, []( map_pair& v ) {
+                        v.second.nVal = v.first;
+                        v.second.strVal = std::to_string( v.first );
+                    }));
+                    break;
+                case 1:
+                    {
+                        value_type val;
+                        val.nVal = key;
+                        val.strVal = std::to_string( key );
+                        ASSERT_TRUE( m.insert( key, val ));
+                        ASSERT_FALSE( m.insert( key, val ));
+                    }
+                    break;
+                case 2:
+                    ASSERT_TRUE( m.insert_with( key, []( map_pair& v ) {
+                        v.second.nVal = v.first;
+                        v.second.strVal = std::to_string( v.first );
+                    }));
+                    ASSERT_FALSE( m.insert_with( key, []( map_pair& ) { EXPECT_TRUE( false ); } ));
+                    break;
+                case 3:
+                    updResult = m.update( key, []( bool, map_pair& ) { EXPECT_TRUE( false ); }, false );
+                    ASSERT_FALSE( updResult.first );
+                    ASSERT_FALSE( updResult.second );
+
+                    updResult = m.update( key, []( bool bNew, map_pair& v ) {
+                        EXPECT_TRUE( bNew );
+                        v.second.nVal = v.first;
+                    });
+                    ASSERT_TRUE( updResult.first );
+                    ASSERT_TRUE( updResult.second );
+
+                    updResult = m.update( key, []( bool bNew, map_pair& v ) {
+                        EXPECT_FALSE( bNew );
+                        EXPECT_EQ( v.first, v.second.nVal );
+                        v.second.strVal = std::to_string( v.second.nVal );
+                    });
+                    ASSERT_TRUE( updResult.first );
+                    ASSERT_FALSE( updResult.second );
+                    break;
+                }
+
+                ASSERT_TRUE( m.contains( key ));
+                ASSERT_TRUE( m.find( key, []( map_pair& v ) {
+                    EXPECT_EQ( v.first, v.second.nVal );
+                    EXPECT_EQ( std::to_string( v.first ), v.second.strVal );
+                }));
+            }
+            ASSERT_FALSE( m.empty());
+            ASSERT_EQ( m.size(), kSize );
+
+            shuffle( arrKeys.begin(), arrKeys.end());
+
+            // erase
+            for ( int key : arrKeys ) {
+                ASSERT_TRUE( m.contains( key ));
+                if ( key & 1 ) {
+                    ASSERT_TRUE( m.erase( key ));
+                    ASSERT_FALSE( m.erase( key ));
+                }
+                else {
+                    ASSERT_TRUE( m.erase( key, []( map_pair& v ) {
+                        EXPECT_EQ( v.first, v.second.nVal );
+                    }));
+                    ASSERT_FALSE( m.erase( key, []( map_pair& ) { EXPECT_TRUE( false ); } ));
+                }
+                ASSERT_FALSE( m.contains( key ));
+            }
+            ASSERT_TRUE( m.empty());
+            ASSERT_EQ( m.size(), 0u );
+
+            // clear
+            for ( int key : arrKeys )
+                ASSERT_TRUE( m.insert( key ));
+            ASSERT_FALSE( m.empty());
+            ASSERT_EQ( m.size(), kSize );
+
+            m.clear();
+            ASSERT_TRUE( m.empty());
+            ASSERT_EQ( m.size(), 0u );
+        }
+
+        // Several threads work on the same small key range, so the combiner gets batches
+        // with repeated keys
+        template <class Map>
+        void test_concurrent( Map& m )
+        {
+            typedef typename Map::value_type map_pair;
+
+            size_t const nThreadCount = 8;
+            int const nKeyCount = 64;
+            int const nPassCount = 2000;
+
+            std::vector< std::thread > threads;
+            for ( size_t nThread = 0; nThread < nThreadCount; ++nThread ) {
+                threads.emplace_back( [&m, nThread, nKeyCount, nPassCount]() {
+                    cds::threading::Manager::attachThread();
+                    for ( int i = 0; i < nPassCount; ++i ) {
+                        int key = static_cast<int>(( i * 7 + nThread ) % nKeyCount );
+                        switch ( i % 4 ) {
+                        case 0:
+                            m.insert( key );
+                            break;
+                        case 1:
+                            m.update( key, []( bool, map_pair& v ) { ++v.second.nVal; } );
+                            break;
+                        case 2:
+                            m.find( key, []( map_pair& v ) { EXPECT_GE( v.second.nVal, 0 ); } );
+                            break;
+                        case 3:
+                            m.erase( key );
+                            break;
+                        }
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+
+            size_t nCount = 0;
+            for ( int key = 0; key < nKeyCount; ++key ) {
+                if ( m.erase( key ))
+                    ++nCount;
+            }
+            EXPECT_LE( nCount, static_cast<size_t>( nKeyCount ));
+            EXPECT_TRUE( m.empty());
+        }
+    };
+
+    size_t const FCMap::kSize;
+
+    TEST_F( FCMap, std_map )
+    {
+        typedef cds::container::FCMap< int, value_type > map_type;
+
+        map_type m;
+        test( m );
+    }
+
+    TEST_F( FCMap, std_map_stat )
+    {
+        typedef cds::container::FCMap< int, value_type, std::map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::stat< cds::container::fcmap::stat<> >
+            >::type
+        > map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+
+        map_type::stat const& s = m.statistics();
+        EXPECT_GE( s.m_nInsertSuccess.get() + s.m_nUpdateNew.get(), kSize * 2 );
+        EXPECT_GE( s.m_nEraseSuccess.get(), kSize );
+        EXPECT_LE( s.m_nSharedLookup.get(), s.m_nBatchedOps.get());
+    }
+
+    TEST_F( FCMap, std_map_mutex )
+    {
+        typedef cds::container::FCMap< int, value_type, std::map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::lock_type< std::mutex >
+            >::type
+        > map_type;
+
+        map_type m( 4, 8 );
+        test( m );
+        test_concurrent( m );
+    }
+
+    TEST_F( FCMap, std_map_adaptive_wait )
+    {
+        typedef cds::container::FCMap< int, value_type, std::map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::adaptive<1, 64, 4>>
+                , cds::opt::stat< cds::container::fcmap::stat<> >
+            >::type
+        > map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+    }
+
+    TEST_F( FCMap, std_map_parallel_combining )
+    {
+        typedef cds::container::FCMap< int, value_type, std::map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::parallel_combining< true >
+                , cds::opt::stat< cds::container::fcmap::stat<> >
+            >::type
+        > map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+
+        map_type::stat const& s = m.statistics();
+        EXPECT_LE( s.m_nDelegatedCount.get(), s.m_nFindSuccess.get() + s.m_nFindFailed.get());
+    }
+
+    TEST_F( FCMap, std_unordered_map_parallel_combining_adaptive_wait )
+    {
+        typedef cds::container::FCMap< int, value_type, std::unordered_map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::parallel_combining< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::adaptive<>>
+            >::type
+        > map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+    }
+
+    TEST_F( FCMap, std_unordered_map )
+    {
+        typedef cds::container::FCMap< int, value_type, std::unordered_map< int, value_type >> map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+    }
+
+    TEST_F( FCMap, std_unordered_map_hierarchical )
+    {
+        typedef cds::container::FCMap< int, value_type, std::unordered_map< int, value_type >,
+            cds::container::fcmap::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+                , cds::opt::stat< cds::container::fcmap::stat<> >
+            >::type
+        > map_type;
+
+        map_type m;
+        test( m );
+        test_concurrent( m );
+    }
+
+} // namespace
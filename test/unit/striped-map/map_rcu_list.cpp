@@ -0,0 +1,72 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds/urcu/general_buffered.h>
+#include <cds/container/striped_map/rcu_list.h>
+#include "test_striped_map.h"
+
+namespace {
+    typedef cds::urcu::general_buffered<>   rcu_implementation;
+    typedef cds::urcu::gc< rcu_implementation > rcu_type;
+
+    // rcu_list requires RCU singleton for all tests of this file
+    class RCUEnvironment: public ::testing::Environment
+    {
+    public:
+        void SetUp() override
+        {
+            rcu_implementation::Construct();
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown() override
+        {
+            cds::threading::Manager::detachThread();
+            rcu_implementation::Destruct();
+        }
+    };
+
+    ::testing::Environment * const rcu_environment = ::testing::AddGlobalTestEnvironment( new RCUEnvironment );
+
+    struct test_traits
+    {
+        typedef cc::striped_set::rcu_list< rcu_type, std::pair< cds_test::striped_map_fixture::key_type const, cds_test::striped_map_fixture::value_type >> container_type;
+
+        // rcu_list relinks the nodes when resizing, copy policy is ignored
+        struct copy_policy {};
+
+        static bool const c_hasFindWith = true;
+        static bool const c_hasEraseWith = true;
+    };
+
+    INSTANTIATE_TYPED_TEST_CASE_P( RcuList, StripedMap, test_traits );
+    INSTANTIATE_TYPED_TEST_CASE_P( RcuList, RefinableMap, test_traits );
+
+} // namespace
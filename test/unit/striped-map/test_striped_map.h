@@ -34,6 +34,7 @@
 #include "test_map_data.h"
 
 #include <cds/container/striped_map.h>
+#include <cds/sync/queue_lock.h>
 
 namespace {
     namespace cc = cds::container;
@@ -525,6 +526,48 @@ namespace {
         this->test( m );
     }
 
+    TYPED_TEST_P( StripedMap, rw_spinlock )
+    {
+        typedef cc::StripedMap<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::striping< cds::sync::rw_spin >>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > map_type;
+
+        map_type m;
+        this->test( m );
+    }
+
+    TYPED_TEST_P( StripedMap, mcs_lock )
+    {
+        typedef cc::StripedMap<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::striping< cds::sync::mcs_lock<> >>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > map_type;
+
+        map_type m;
+        this->test( m );
+    }
+
+    TYPED_TEST_P( StripedMap, seqlock )
+    {
+        typedef cc::StripedMap<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::seqlock_striping<>>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > map_type;
+
+        map_type m;
+        this->test( m );
+    }
+
     TYPED_TEST_P( StripedMap, load_factor_resizing )
     {
         typedef cc::StripedMap<
@@ -817,7 +860,7 @@ namespace {
     }
 
     REGISTER_TYPED_TEST_CASE_P( StripedMap,
-        compare, less, cmpmix, spinlock, load_factor_resizing, load_factor_resizing_rt, single_bucket_resizing, single_bucket_resizing_rt, copy_policy_copy, copy_policy_move, copy_policy_swap, copy_policy_special
+        compare, less, cmpmix, spinlock, rw_spinlock, mcs_lock, seqlock, load_factor_resizing, load_factor_resizing_rt, single_bucket_resizing, single_bucket_resizing_rt, copy_policy_copy, copy_policy_move, copy_policy_swap, copy_policy_special
     );
 
     REGISTER_TYPED_TEST_CASE_P( RefinableMap,
@@ -0,0 +1,283 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/fixture.h>
+#include <cds/container/fcset.h>
+
+#include <unordered_set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class FCSet: public cds_test::fixture
+    {
+    protected:
+        struct int_item {
+            int nKey;
+            int nVal;
+
+            int_item( int key )
+                : nKey( key )
+                , nVal( 0 )
+            {}
+
+            bool operator <( int_item const& rhs ) const
+            {
+                return nKey < rhs.nKey;
+            }
+
+            bool operator ==( int_item const& rhs ) const
+            {
+                return nKey == rhs.nKey;
+            }
+        };
+
+        struct hash {
+            size_t operator()( int_item const& item ) const
+            {
+                return std::hash<int>()( item.nKey );
+            }
+        };
+
+        static size_t const kSize = 1000;
+
+        void SetUp()
+        {
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+        }
+
+        template <class Set>
+        void test( Set& s )
+        {
+            typedef typename Set::value_type value_type;
+
+            ASSERT_TRUE( s.empty());
+            ASSERT_EQ( s.size(), 0u );
+
+            std::vector<int> arrKeys;
+            for ( int i = 0; i < static_cast<int>( kSize ); ++i )
+                arrKeys.push_back( i );
+            shuffle( arrKeys.begin(), arrKeys.end());
+
+            // insert/find
+            for ( int key : arrKeys ) {
+                ASSERT_FALSE( s.contains( key ));
+                ASSERT_FALSE( s.find( key, []( value_type&, int const& ) { EXPECT_TRUE( false ); } ));
+
+                std::pair<bool, bool> updResult;
+                switch ( key % 3 ) {
+                case 0:
+                    ASSERT_TRUE( s.insert( key ));
+                    ASSERT_FALSE( s.insert( key ));
+                    ASSERT_TRUE( s.find( key, []( value_type& item, int const& k ) {
+                        EXPECT_EQ( item.nKey, k );
+                        item.nVal = item.nKey * 2;
+                    }));
+                    break;
+                case 1:
+                    ASSERT_TRUE( s.insert( key, []( value_type& item ) { item.nVal = item.nKey * 2; } ));
+                    ASSERT_FALSE( s.insert( key, []( value_type& ) { EXPECT_TRUE( false ); } ));
+                    break;
+                case 2:
+                    updResult = s.update( key, []( bool, value_type&, int const& ) { EXPECT_TRUE( false ); }, false );
+                    ASSERT_FALSE( updResult.first );
+                    ASSERT_FALSE( updResult.second );
+
+                    updResult = s.update( key, []( bool bNew, value_type& item, int const& k ) {
+                        EXPECT_TRUE( bNew );
+                        EXPECT_EQ( item.nKey, k );
+                        item.nVal = item.nKey;
+                    });
+                    ASSERT_TRUE( updResult.first );
+                    ASSERT_TRUE( updResult.second );
+
+                    updResult = s.update( key, []( bool bNew, value_type& item, int const& ) {
+                        EXPECT_FALSE( bNew );
+                        item.nVal *= 2;
+                    });
+                    ASSERT_TRUE( updResult.first );
+                    ASSERT_FALSE( updResult.second );
+                    break;
+                }
+
+                ASSERT_TRUE( s.contains( key ));
+                int k = key;
+                ASSERT_TRUE( s.find( k, []( value_type& item, int& kk ) {
+                    EXPECT_EQ( item.nKey, kk );
+                    EXPECT_EQ( item.nKey * 2, item.nVal );
+                }));
+            }
+            ASSERT_FALSE( s.empty());
+            ASSERT_EQ( s.size(), kSize );
+
+            shuffle( arrKeys.begin(), arrKeys.end());
+
+            // erase
+            for ( int key : arrKeys ) {
+                ASSERT_TRUE( s.contains( key ));
+                if ( key & 1 ) {
+                    ASSERT_TRUE( s.erase( key ));
+                    ASSERT_FALSE( s.erase( key ));
+                }
+                else {
+                    ASSERT_TRUE( s.erase( key, []( value_type const& item ) {
+                        EXPECT_EQ( item.nKey * 2, item.nVal );
+                    }));
+                    ASSERT_FALSE( s.erase( key, []( value_type const& ) { EXPECT_TRUE( false ); } ));
+                }
+                ASSERT_FALSE( s.contains( key ));
+            }
+            ASSERT_TRUE( s.empty());
+            ASSERT_EQ( s.size(), 0u );
+
+            // clear
+            for ( int key : arrKeys )
+                ASSERT_TRUE( s.insert( key ));
+            ASSERT_FALSE( s.empty());
+            ASSERT_EQ( s.size(), kSize );
+
+            s.clear();
+            ASSERT_TRUE( s.empty());
+            ASSERT_EQ( s.size(), 0u );
+        }
+
+        template <class Set>
+        void test_concurrent( Set& s )
+        {
+            typedef typename Set::value_type value_type;
+
+            size_t const nThreadCount = 8;
+            int const nKeyCount = 64;
+            int const nPassCount = 2000;
+
+            std::vector< std::thread > threads;
+            for ( size_t nThread = 0; nThread < nThreadCount; ++nThread ) {
+                threads.emplace_back( [&s, nThread, nKeyCount, nPassCount]() {
+                    cds::threading::Manager::attachThread();
+                    for ( int i = 0; i < nPassCount; ++i ) {
+                        int key = static_cast<int>(( i * 5 + nThread ) % nKeyCount );
+                        switch ( i % 3 ) {
+                        case 0:
+                            s.update( key, []( bool, value_type& item, int const& ) { ++item.nVal; } );
+                            break;
+                        case 1:
+                            s.contains( key );
+                            break;
+                        case 2:
+                            s.erase( key );
+                            break;
+                        }
+                    }
+                    cds::threading::Manager::detachThread();
+                });
+            }
+            for ( auto& t : threads )
+                t.join();
+
+            for ( int key = 0; key < nKeyCount; ++key )
+                s.erase( key );
+            EXPECT_TRUE( s.empty());
+        }
+    };
+
+    size_t const FCSet::kSize;
+
+    TEST_F( FCSet, std_set )
+    {
+        typedef cds::container::FCSet< int_item > set_type;
+
+        set_type s;
+        test( s );
+        test_concurrent( s );
+    }
+
+    TEST_F( FCSet, std_set_stat )
+    {
+        typedef cds::container::FCSet< int_item, std::set< int_item >,
+            cds::container::fcset::make_traits<
+                cds::opt::stat< cds::container::fcset::stat<> >
+            >::type
+        > set_type;
+
+        set_type s;
+        test( s );
+        test_concurrent( s );
+
+        set_type::stat const& st = s.statistics();
+        EXPECT_GE( st.m_nInsertSuccess.get() + st.m_nUpdateNew.get(), kSize * 2 );
+        EXPECT_LE( st.m_nSharedLookup.get(), st.m_nBatchedOps.get());
+    }
+
+    TEST_F( FCSet, std_unordered_set )
+    {
+        typedef cds::container::FCSet< int_item, std::unordered_set< int_item, hash >> set_type;
+
+        set_type s( 4, 8 );
+        test( s );
+        test_concurrent( s );
+    }
+
+    TEST_F( FCSet, std_set_parallel_combining )
+    {
+        typedef cds::container::FCSet< int_item, std::set< int_item >,
+            cds::container::fcset::make_traits<
+                cds::opt::parallel_combining< true >
+                , cds::opt::stat< cds::container::fcset::stat<> >
+            >::type
+        > set_type;
+
+        set_type s;
+        test( s );
+        test_concurrent( s );
+
+        set_type::stat const& st = s.statistics();
+        EXPECT_LE( st.m_nDelegatedCount.get(), st.m_nFindSuccess.get() + st.m_nFindFailed.get());
+    }
+
+    TEST_F( FCSet, std_unordered_set_hierarchical )
+    {
+        typedef cds::container::FCSet< int_item, std::unordered_set< int_item, hash >,
+            cds::container::fcset::make_traits<
+                cds::opt::kernel_selector< cds::algo::flat_combining::kernel_selector::hierarchical >
+            >::type
+        > set_type;
+
+        set_type s;
+        test( s );
+        test_concurrent( s );
+    }
+
+} // namespace
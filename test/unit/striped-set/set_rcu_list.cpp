@@ -0,0 +1,141 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds/urcu/general_buffered.h>
+#include <cds/container/striped_set/rcu_list.h>
+#include "test_striped_set.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+    typedef cds::urcu::general_buffered<>   rcu_implementation;
+    typedef cds::urcu::gc< rcu_implementation > rcu_type;
+
+    // rcu_list requires RCU singleton for all tests of this file
+    class RCUEnvironment: public ::testing::Environment
+    {
+    public:
+        void SetUp() override
+        {
+            rcu_implementation::Construct();
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown() override
+        {
+            cds::threading::Manager::detachThread();
+            rcu_implementation::Destruct();
+        }
+    };
+
+    ::testing::Environment * const rcu_environment = ::testing::AddGlobalTestEnvironment( new RCUEnvironment );
+
+    struct test_traits
+    {
+        typedef cc::striped_set::rcu_list< rcu_type, cds_test::container_set::int_item > container_type;
+
+        // rcu_list relinks the nodes when resizing, copy policy is ignored
+        struct copy_policy {};
+
+        static bool const c_hasFindWith = true;
+        static bool const c_hasEraseWith = true;
+    };
+
+    INSTANTIATE_TYPED_TEST_CASE_P( RcuList, StripedSet, test_traits );
+    INSTANTIATE_TYPED_TEST_CASE_P( RcuList, RefinableSet, test_traits );
+
+    class StripedSet_RcuList: public ::testing::Test
+    {
+    protected:
+        static size_t const c_nReaderCount = 3;
+        static size_t const c_nWriterCount = 2;
+        static int const    c_nKeyCount = 2000;
+        static size_t const c_nPassCount = 20;
+    };
+
+    TEST_F( StripedSet_RcuList, optimistic_read )
+    {
+        typedef cc::StripedSet<
+            cc::striped_set::rcu_list< rcu_type, int >,
+            cds::opt::mutex_policy< cc::striped_set::seqlock_striping<>>,
+            cds::opt::less< std::less<int>>,
+            cds::opt::resizing_policy< cc::striped_set::load_factor_resizing<2>>
+        > set_type;
+        static_assert( set_type::c_bOptimisticRead, "set_type must support optimistic reading" );
+
+        set_type s;
+
+        // even keys are always in the set, odd keys are inserted and erased by writers
+        for ( int key = 0; key < c_nKeyCount; key += 2 )
+            ASSERT_TRUE( s.insert( key ));
+
+        atomics::atomic<size_t> nWritersDone( 0 );
+        atomics::atomic<size_t> nReadErrors( 0 );
+
+        std::vector<std::thread> threads;
+        for ( size_t i = 0; i < c_nWriterCount; ++i ) {
+            threads.emplace_back( [&s, &nWritersDone, i]() {
+                cds::threading::Manager::attachThread();
+                for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                    for ( int key = 1 + static_cast<int>( i ) * 2; key < c_nKeyCount; key += static_cast<int>( c_nWriterCount ) * 2 )
+                        s.insert( key );
+                    for ( int key = 1 + static_cast<int>( i ) * 2; key < c_nKeyCount; key += static_cast<int>( c_nWriterCount ) * 2 )
+                        s.erase( key );
+                }
+                nWritersDone.fetch_add( 1, atomics::memory_order_release );
+                cds::threading::Manager::detachThread();
+            });
+        }
+        for ( size_t i = 0; i < c_nReaderCount; ++i ) {
+            threads.emplace_back( [&s, &nWritersDone, &nReadErrors]() {
+                cds::threading::Manager::attachThread();
+                while ( nWritersDone.load( atomics::memory_order_acquire ) < c_nWriterCount ) {
+                    for ( int key = 0; key < c_nKeyCount; key += 2 ) {
+                        if ( !s.contains( key ))
+                            nReadErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                        if ( s.contains( c_nKeyCount + key ))
+                            nReadErrors.fetch_add( 1, atomics::memory_order_relaxed );
+                    }
+                }
+                cds::threading::Manager::detachThread();
+            });
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        EXPECT_EQ( nReadErrors.load(), 0u );
+        EXPECT_EQ( s.size(), static_cast<size_t>( c_nKeyCount / 2 ));
+        EXPECT_GT( s.bucket_count(), 16u );
+        for ( int key = 0; key < c_nKeyCount; ++key )
+            EXPECT_EQ( s.contains( key ), key % 2 == 0 ) << "key=" << key;
+    }
+
+} // namespace
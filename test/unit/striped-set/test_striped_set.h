@@ -34,6 +34,7 @@
 #include "test_set.h"
 
 #include <cds/container/striped_set.h>
+#include <cds/sync/queue_lock.h>
 
 namespace {
     namespace cc = cds::container;
@@ -464,6 +465,48 @@ namespace {
         this->test( s );
     }
 
+    TYPED_TEST_P( StripedSet, rw_spinlock )
+    {
+        typedef cc::StripedSet<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::striping< cds::sync::rw_spin >>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > set_type;
+
+        set_type s;
+        this->test( s );
+    }
+
+    TYPED_TEST_P( StripedSet, mcs_lock )
+    {
+        typedef cc::StripedSet<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::striping< cds::sync::mcs_lock<> >>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > set_type;
+
+        set_type s;
+        this->test( s );
+    }
+
+    TYPED_TEST_P( StripedSet, seqlock )
+    {
+        typedef cc::StripedSet<
+            typename TestFixture::container_type,
+            cds::opt::mutex_policy< cc::striped_set::seqlock_striping<>>,
+            cds::opt::hash< typename TestFixture::hash1 >,
+            cds::opt::less< typename TestFixture::less >,
+            cds::opt::compare< typename TestFixture::cmp >
+        > set_type;
+
+        set_type s;
+        this->test( s );
+    }
+
     TYPED_TEST_P( StripedSet, load_factor_resizing )
     {
         typedef cc::StripedSet<
@@ -756,7 +799,7 @@ namespace {
     }
 
     REGISTER_TYPED_TEST_CASE_P( StripedSet,
-        compare, less, cmpmix, spinlock, load_factor_resizing, load_factor_resizing_rt, single_bucket_resizing, single_bucket_resizing_rt, copy_policy_copy, copy_policy_move, copy_policy_swap, copy_policy_special
+        compare, less, cmpmix, spinlock, rw_spinlock, mcs_lock, seqlock, load_factor_resizing, load_factor_resizing_rt, single_bucket_resizing, single_bucket_resizing_rt, copy_policy_copy, copy_policy_move, copy_policy_swap, copy_policy_special
         );
 
     REGISTER_TYPED_TEST_CASE_P( RefinableSet,
@@ -34,6 +34,7 @@
 #include "test_tree_map_data.h"
 #include <cds/container/bronson_avltree_map_rcu.h>
 #include <cds/sync/pool_monitor.h>
+#include <cds/sync/compact_monitor.h>
 #include <cds/memory/vyukov_queue_pool.h>
 
 namespace {
@@ -677,6 +678,25 @@ namespace {
         this->test( m );
     }
 
+    TYPED_TEST_P( BronsonAVLTreeMapPtr, compact_sync_monitor )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+        typedef typename TestFixture::key_type key_type;
+        typedef typename TestFixture::value_type value_type;
+
+        struct map_traits: public bronson_traits
+        {
+            typedef typename TestFixture::cmp    compare;
+            typedef cds::atomicity::item_counter item_counter;
+            typedef cds::sync::compact_monitor<> sync_monitor;
+        };
+
+        typedef cc::BronsonAVLTreeMap< rcu_type, key_type, value_type*, map_traits > map_type;
+
+        map_type m;
+        this->test( m );
+    }
+
     TYPED_TEST_P( BronsonAVLTreeMapPtr, rcu_check_deadlock )
     {
         typedef typename TestFixture::rcu_type rcu_type;
@@ -718,7 +738,7 @@ namespace {
     }
 
     REGISTER_TYPED_TEST_CASE_P( BronsonAVLTreeMapPtr,
-        compare, less, cmpmix, stat, item_counting, relaxed_insert, seq_cst, sync_monitor, lazy_sync_monitor, rcu_check_deadlock, rcu_no_check_deadlock
+        compare, less, cmpmix, stat, item_counting, relaxed_insert, seq_cst, sync_monitor, lazy_sync_monitor, compact_sync_monitor, rcu_check_deadlock, rcu_no_check_deadlock
     );
 
 